@@ -270,9 +270,14 @@ void preCommitCallback(id<MTLCommandBuffer> commandBuffer,
       @autoreleasepool
       {
           riveLock();
-          // Guard: renderer might have been destroyed during teardown.
+          // Guard: renderer might have been destroyed during teardown. The
+          // frame still has to complete, or it holds its render target.
           if (rt == nil || rt->_riveRenderer == nil)
           {
+              if (rt != nil)
+              {
+                  rt->_readWriteRing.nextRead();
+              }
               riveUnlock();
               if (nativeRenderTexture)
               {
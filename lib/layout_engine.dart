@@ -289,6 +289,10 @@ abstract class LayoutNode {
     return makeLayoutNodeExternal(ref);
   }
 
+  /// Computed layouts of [nodes], in order, fetched with a single call into
+  /// the layout engine.
+  static List<Layout> layoutsOf(List<LayoutNode> nodes) => getLayouts(nodes);
+
   void setStyle(LayoutStyle style);
 
   LayoutNodeType get nodeType;
@@ -326,3 +330,23 @@ abstract class LayoutNode {
   Layout get layout;
   LayoutPadding get layoutPadding;
 }
+
+/// Records structural and style edits to any number of nodes and applies them
+/// with a single call into the layout engine, instead of one call per edit.
+abstract class LayoutTreeBatch {
+  static LayoutTreeBatch make() {
+    return makeLayoutTreeBatch();
+  }
+
+  void insertChild(LayoutNode parent, LayoutNode child, int index);
+  void removeChild(LayoutNode parent, LayoutNode child);
+  void clearChildren(LayoutNode parent);
+  void setStyle(LayoutNode node, LayoutStyle style);
+  void setNodeType(LayoutNode node, LayoutNodeType type);
+  void markDirty(LayoutNode node);
+
+  /// Applies the recorded edits in order and clears the batch.
+  void apply();
+
+  void dispose();
+}
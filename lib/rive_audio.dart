@@ -15,6 +15,12 @@ abstract class AudioEngine {
     return loadAudioSource(bytes);
   }
 
+  /// Number of threads used to decode sources into buffered ones. Only takes
+  /// effect before the first source is buffered, 0 picks a default based on
+  /// the number of cores.
+  static set decodeThreadCount(int threadCount) =>
+      setDecodeThreadCount(threadCount);
+
   void dispose();
 
   /// Sample rate in hz.
@@ -379,6 +379,337 @@ abstract class TextShapeResult {
   BreakLinesResult breakLines(double width, TextAlign alignment, TextWrap wrap);
 }
 
+/// Shaping and line breaking results for a whole set of paragraphs, read in
+/// place from the single flat buffer built by [Font.layout].
+///
+/// Glyph data is exposed as typed views over that buffer, indexed by a
+/// layout wide glyph index (a run's glyphs start at its
+/// [TextLayoutRun.firstGlyph]). [paragraphs] and [lines] wrap the same views
+/// in the regular [Paragraph], [GlyphRun] and [GlyphLine] shapes.
+///
+/// See native/src/text_layout_buffer.hpp for the format.
+abstract class TextLayout {
+  static const int version = 1;
+
+  /// Native layout flag asking for glyph outlines.
+  static const int glyphOutlinesFlag = 1 << 0;
+
+  static const int _headerSize = 96;
+  static const int _paragraphSize = 24;
+  static const int _runSize = 40;
+  static const int _lineSize = 32;
+  static const int _outlineSize = 16;
+
+  final ByteData data;
+
+  /// Width the lines were aligned to, the widest line when laid out with
+  /// auto width.
+  final double width;
+  final int paragraphCount;
+  final int runCount;
+  final int glyphCount;
+  final int lineCount;
+
+  final Uint16List glyphIds;
+  final Uint32List textIndices;
+  final Float32List advances;
+
+  /// Each run has glyphCount + 1 positions, starting at its
+  /// [TextLayoutRun.firstX].
+  final Float32List xpos;
+
+  /// Interleaved x and y offsets, two per glyph.
+  final Float32List offsets;
+
+  /// Index into the shared outlines for each glyph, empty unless the layout
+  /// was made with glyph outlines.
+  final Uint32List glyphOutlines;
+  final Uint8List verbs;
+
+  /// Interleaved x and y outline points.
+  final Float32List points;
+
+  TextLayout(this.data)
+      : width = data.getFloat32(8, Endian.little),
+        paragraphCount = data.getUint32(16, Endian.little),
+        runCount = data.getUint32(20, Endian.little),
+        glyphCount = data.getUint32(24, Endian.little),
+        lineCount = data.getUint32(28, Endian.little),
+        glyphIds = data.buffer.asUint16List(
+            data.offsetInBytes + data.getUint32(52, Endian.little),
+            data.getUint32(24, Endian.little)),
+        textIndices = data.buffer.asUint32List(
+            data.offsetInBytes + data.getUint32(56, Endian.little),
+            data.getUint32(24, Endian.little)),
+        advances = data.buffer.asFloat32List(
+            data.offsetInBytes + data.getUint32(60, Endian.little),
+            data.getUint32(24, Endian.little)),
+        xpos = data.buffer.asFloat32List(
+            data.offsetInBytes + data.getUint32(64, Endian.little),
+            data.getUint32(24, Endian.little) +
+                data.getUint32(20, Endian.little)),
+        offsets = data.buffer.asFloat32List(
+            data.offsetInBytes + data.getUint32(68, Endian.little),
+            data.getUint32(24, Endian.little) * 2),
+        glyphOutlines = data.getUint32(76, Endian.little) == 0
+            ? Uint32List(0)
+            : data.buffer.asUint32List(
+                data.offsetInBytes + data.getUint32(76, Endian.little),
+                data.getUint32(24, Endian.little)),
+        verbs = data.buffer.asUint8List(
+            data.offsetInBytes + data.getUint32(84, Endian.little),
+            data.getUint32(36, Endian.little)),
+        points = data.buffer.asFloat32List(
+            data.offsetInBytes + data.getUint32(88, Endian.little),
+            data.getUint32(40, Endian.little) * 2) {
+    assert(data.lengthInBytes >= _headerSize);
+    assert(data.getUint32(0, Endian.little) == version);
+  }
+
+  /// Resolves the native font address stored with each run.
+  @protected
+  Font fontAt(int address);
+
+  void dispose();
+
+  int _offset(int headerOffset) => data.getUint32(headerOffset, Endian.little);
+
+  TextLayoutRun runAt(int index) =>
+      TextLayoutRun._(this, _offset(48) + index * _runSize);
+
+  late final List<Paragraph> paragraphs = List.generate(
+    paragraphCount,
+    (index) {
+      var offset = _offset(44) + index * _paragraphSize;
+      var firstRun = data.getUint32(offset, Endian.little);
+      var count = data.getUint32(offset + 4, Endian.little);
+      return _TextLayoutParagraph(
+        data.getUint32(offset + 16, Endian.little),
+        List.generate(count, (i) => runAt(firstRun + i)),
+      );
+    },
+    growable: false,
+  );
+
+  /// Lines for each paragraph, run indices are relative to the paragraph.
+  late final List<List<GlyphLine>> lines = List.generate(
+    paragraphCount,
+    (index) {
+      var offset = _offset(44) + index * _paragraphSize;
+      var firstLine = data.getUint32(offset + 8, Endian.little);
+      var count = data.getUint32(offset + 12, Endian.little);
+      var linesOffset = _offset(72);
+      return List<GlyphLine>.generate(
+        count,
+        (i) => _TextLayoutLine(
+            data, linesOffset + (firstLine + i) * _lineSize),
+        growable: false,
+      );
+    },
+    growable: false,
+  );
+
+  bool get hasGlyphOutlines => glyphOutlines.isNotEmpty;
+
+  /// The outline of the glyph at the layout wide [glyphIndex], or null if the
+  /// layout was made without glyph outlines. The outline is a view over this
+  /// layout and does not need to be disposed separately.
+  RawPath? glyphOutline(int glyphIndex) {
+    if (!hasGlyphOutlines) {
+      return null;
+    }
+    var offset = _offset(80) + glyphOutlines[glyphIndex] * _outlineSize;
+    var firstVerb = data.getUint32(offset, Endian.little);
+    var verbCount = data.getUint32(offset + 4, Endian.little);
+    var firstPoint = data.getUint32(offset + 8, Endian.little);
+    var pointCount = data.getUint32(offset + 12, Endian.little);
+    return _TextLayoutOutline(
+      Uint8List.sublistView(verbs, firstVerb, firstVerb + verbCount),
+      Float32List.sublistView(
+          points, firstPoint * 2, (firstPoint + pointCount) * 2),
+    );
+  }
+}
+
+/// A run in a [TextLayout], reading its glyphs from the layout's views.
+class TextLayoutRun extends GlyphRun {
+  final TextLayout layout;
+  final int _offset;
+
+  TextLayoutRun._(this.layout, this._offset);
+
+  int _uint32(int field) =>
+      layout.data.getUint32(_offset + field, Endian.little);
+
+  // Read as two words, 64 bit reads aren't supported on the web.
+  @override
+  Font get font => layout.fontAt(_uint32(0) + _uint32(4) * 0x100000000);
+
+  @override
+  double get fontSize => layout.data.getFloat32(_offset + 8, Endian.little);
+
+  @override
+  double get lineHeight => layout.data.getFloat32(_offset + 12, Endian.little);
+
+  @override
+  double get letterSpacing =>
+      layout.data.getFloat32(_offset + 16, Endian.little);
+
+  @override
+  int get styleId => _uint32(20);
+
+  @override
+  int get level => _uint32(24);
+
+  @override
+  TextDirection get direction =>
+      level & 1 == 1 ? TextDirection.rtl : TextDirection.ltr;
+
+  int get firstGlyph => _uint32(28);
+
+  @override
+  int get glyphCount => _uint32(32);
+
+  int get firstX => _uint32(36);
+
+  @override
+  int glyphIdAt(int index) => layout.glyphIds[firstGlyph + index];
+
+  @override
+  int textIndexAt(int index) => layout.textIndices[firstGlyph + index];
+
+  @override
+  double advanceAt(int index) => layout.advances[firstGlyph + index];
+
+  @override
+  double xAt(int index) => layout.xpos[firstX + index];
+
+  @override
+  Vec2D offsetAt(int index) {
+    var o = (firstGlyph + index) * 2;
+    return Vec2D.fromValues(layout.offsets[o], layout.offsets[o + 1]);
+  }
+}
+
+class _TextLayoutParagraph extends Paragraph {
+  @override
+  final int level;
+
+  @override
+  final List<GlyphRun> runs;
+
+  _TextLayoutParagraph(this.level, this.runs) : super(runs);
+}
+
+class _TextLayoutLine extends GlyphLine {
+  final ByteData _data;
+  final int _offset;
+
+  _TextLayoutLine(this._data, this._offset);
+
+  @override
+  int get startRun => _data.getUint32(_offset, Endian.little);
+
+  @override
+  int get startIndex => _data.getUint32(_offset + 4, Endian.little);
+
+  @override
+  int get endRun => _data.getUint32(_offset + 8, Endian.little);
+
+  @override
+  int get endIndex => _data.getUint32(_offset + 12, Endian.little);
+
+  @override
+  double get startX => _data.getFloat32(_offset + 16, Endian.little);
+
+  @override
+  double get top => _data.getFloat32(_offset + 20, Endian.little);
+
+  @override
+  double get baseline => _data.getFloat32(_offset + 24, Endian.little);
+
+  @override
+  double get bottom => _data.getFloat32(_offset + 28, Endian.little);
+}
+
+class _TextLayoutPathCommand extends RawPathCommand {
+  final Float32List _points;
+  final int _pointIndex;
+
+  _TextLayoutPathCommand(super.verb, this._points, this._pointIndex);
+
+  @override
+  Vec2D point(int index) {
+    var base = (_pointIndex + index) * 2;
+    return Vec2D.fromValues(_points[base], _points[base + 1]);
+  }
+}
+
+class _TextLayoutOutlineIterator implements Iterator<RawPathCommand> {
+  final Uint8List _verbs;
+  final Float32List _points;
+  int _verbIndex = -1;
+  int _pointIndex = 0;
+  RawPathCommand? _current;
+
+  _TextLayoutOutlineIterator(this._verbs, this._points);
+
+  @override
+  RawPathCommand get current => _current!;
+
+  @override
+  bool moveNext() {
+    if (++_verbIndex >= _verbs.length) {
+      return false;
+    }
+    // Like the other raw path iterators, point(0) of everything but a move is
+    // the previous end point.
+    switch (_verbs[_verbIndex]) {
+      case 0:
+        _current =
+            _TextLayoutPathCommand(RawPathVerb.move, _points, _pointIndex);
+        _pointIndex += 1;
+        break;
+      case 1:
+        _current =
+            _TextLayoutPathCommand(RawPathVerb.line, _points, _pointIndex - 1);
+        _pointIndex += 1;
+        break;
+      case 2:
+        _current =
+            _TextLayoutPathCommand(RawPathVerb.quad, _points, _pointIndex - 1);
+        _pointIndex += 2;
+        break;
+      case 4:
+        _current = _TextLayoutPathCommand(
+            RawPathVerb.cubic, _points, _pointIndex - 1);
+        _pointIndex += 3;
+        break;
+      case 5:
+        _current = _TextLayoutPathCommand(
+            RawPathVerb.close, _points, _pointIndex - 1);
+        break;
+      default:
+        throw Exception('Unexpected nativeVerb: ${_verbs[_verbIndex]}');
+    }
+    return true;
+  }
+}
+
+class _TextLayoutOutline extends RawPath {
+  final Uint8List _verbs;
+  final Float32List _points;
+
+  _TextLayoutOutline(this._verbs, this._points);
+
+  @override
+  Iterator<RawPathCommand> get iterator =>
+      _TextLayoutOutlineIterator(_verbs, _points);
+
+  @override
+  void dispose() {}
+}
+
 /// A representation of a styled section of text in Rive.
 class TextRun {
   final Font font;
@@ -562,11 +893,7 @@ abstract class Font {
     TextDirection? direction,
   });
 
-  TextShapeResult shapeCodeUnits(
-    List<int> codeUnits,
-    List<TextRun> runs, {
-    TextDirection? direction,
-  }) {
+  static void _syncFallbackFonts() {
     if (_fallbackFontsEnabled != _fallbackFontsActuallyEnabled) {
       if (_fallbackFontsEnabled) {
         enableFallbackFonts();
@@ -575,6 +902,14 @@ abstract class Font {
       }
       _fallbackFontsActuallyEnabled = _fallbackFontsEnabled;
     }
+  }
+
+  TextShapeResult shapeCodeUnits(
+    List<int> codeUnits,
+    List<TextRun> runs, {
+    TextDirection? direction,
+  }) {
+    _syncFallbackFonts();
     return computeShape(
       codeUnits,
       runs,
@@ -587,14 +922,7 @@ abstract class Font {
     List<TextRun> runs, {
     TextDirection? direction,
   }) {
-    if (_fallbackFontsEnabled != _fallbackFontsActuallyEnabled) {
-      if (_fallbackFontsEnabled) {
-        enableFallbackFonts();
-      } else {
-        disableFallbackFonts();
-      }
-      _fallbackFontsActuallyEnabled = _fallbackFontsEnabled;
-    }
+    _syncFallbackFonts();
     return computeShape(
       text.runes.toList(),
       runs,
@@ -602,6 +930,65 @@ abstract class Font {
     );
   }
 
+  @protected
+  TextLayout? computeLayout(
+    List<int> codeUnits,
+    List<TextRun> runs, {
+    required double width,
+    required TextAlign align,
+    required TextWrap wrap,
+    required bool glyphOutlines,
+    TextDirection? direction,
+  });
+
+  /// Shapes and line breaks [codeUnits] in one native call, returning the
+  /// whole result as a single [TextLayout] instead of a [TextShapeResult]
+  /// and per paragraph [BreakLinesResult]s. A [width] of -1 sizes the lines
+  /// to the widest paragraph. Pass [glyphOutlines] to also get the outline of
+  /// every glyph used, which saves a [getPath] call per glyph.
+  ///
+  /// Returns null when there is nothing to lay out.
+  TextLayout? layoutCodeUnits(
+    List<int> codeUnits,
+    List<TextRun> runs, {
+    double width = -1,
+    TextAlign align = TextAlign.left,
+    TextWrap wrap = TextWrap.wrap,
+    bool glyphOutlines = false,
+    TextDirection? direction,
+  }) {
+    _syncFallbackFonts();
+    return computeLayout(
+      codeUnits,
+      runs,
+      width: width,
+      align: align,
+      wrap: wrap,
+      glyphOutlines: glyphOutlines,
+      direction: direction,
+    );
+  }
+
+  /// See [layoutCodeUnits].
+  TextLayout? layout(
+    String text,
+    List<TextRun> runs, {
+    double width = -1,
+    TextAlign align = TextAlign.left,
+    TextWrap wrap = TextWrap.wrap,
+    bool glyphOutlines = false,
+    TextDirection? direction,
+  }) =>
+      layoutCodeUnits(
+        text.runes.toList(),
+        runs,
+        width: width,
+        align: align,
+        wrap: wrap,
+        glyphOutlines: glyphOutlines,
+        direction: direction,
+      );
+
   ui.Path getUiPath(int glyphId) {
     var path = ui.Path();
     var rawPath = getPath(glyphId);
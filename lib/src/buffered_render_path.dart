@@ -1,5 +1,3 @@
-import 'dart:typed_data';
-
 import 'package:rive_native/rive_native.dart';
 
 class PrivatePathVerb {
@@ -35,42 +33,16 @@ abstract class BufferedRenderPath extends RenderPath {
     points.clear();
   }
 
-  ByteData get scratchBufferByteData;
-
-  void appendCommands(int commandCount);
+  /// Appends the whole buffered path to the native path being built, in a
+  /// single call. [points] holds x,y pairs consumed in order by [verbs].
+  void appendPathData(List<int> verbs, List<double> points);
   void updateRenderPath();
 
   void update() {
     if (verbs.isEmpty) {
       return;
     }
-    final view = scratchBufferByteData;
-
-    int offset = 0;
-    int pointIndex = 0;
-    int commandCount = 0;
-    for (final verb in verbs) {
-      int pointCount = PrivatePathVerb.pointCount(verb);
-      int requiredSize = pointCount * 8 + 1;
-      if (requiredSize + offset >= view.lengthInBytes) {
-        appendCommands(commandCount);
-        offset = 0;
-        commandCount = 0;
-      }
-
-      view.setUint8(offset++, verb);
-      for (int i = 0; i < pointCount; i++) {
-        view.setFloat32(offset, points[pointIndex++], Endian.little);
-        offset += 4;
-        view.setFloat32(offset, points[pointIndex++], Endian.little);
-        offset += 4;
-      }
-
-      commandCount++;
-    }
-    if (commandCount > 0) {
-      appendCommands(commandCount);
-    }
+    appendPathData(verbs, points);
     updateRenderPath();
 
     resetBuffer();
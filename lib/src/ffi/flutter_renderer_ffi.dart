@@ -59,15 +59,16 @@ typedef UpdateVertexBuffer = Pointer<
 
 typedef MakeImagePointer = Pointer<
     NativeFunction<Void Function(Pointer<Void>, Uint64, Pointer<Uint8>, Size)>>;
-typedef DeleteImagePointer = Pointer<NativeFunction<Void Function(Uint64)>>;
-typedef DeleteRendererPointer
-    = Pointer<NativeFunction<Void Function(Pointer<Void>)>>;
-typedef DeletePathPointer = Pointer<NativeFunction<Void Function(Uint64)>>;
-typedef DeletePaintPointer = Pointer<NativeFunction<Void Function(Uint64)>>;
-typedef DeleteVertexBufferPointer
-    = Pointer<NativeFunction<Void Function(Uint64)>>;
-typedef DeleteIndexBufferPointer
-    = Pointer<NativeFunction<Void Function(Uint64)>>;
+// Deletions arrive batched, as a list of ids per resource type (renderer
+// addresses for renderers).
+typedef DeleteBatchPointer
+    = Pointer<NativeFunction<Void Function(Pointer<Uint64>, Size)>>;
+typedef DeleteImagePointer = DeleteBatchPointer;
+typedef DeleteRendererPointer = DeleteBatchPointer;
+typedef DeletePathPointer = DeleteBatchPointer;
+typedef DeletePaintPointer = DeleteBatchPointer;
+typedef DeleteVertexBufferPointer = DeleteBatchPointer;
+typedef DeleteIndexBufferPointer = DeleteBatchPointer;
 
 final void Function(
   Pointer<Void>,
@@ -175,7 +176,7 @@ class FFIFlutterFactory extends FFIFactory implements Finalizable {
     _initFactoryCallbacks(
       pointer,
       Pointer.fromFunction(_decodeImageFromNative),
-      Pointer.fromFunction(_deleteImage),
+      Pointer.fromFunction(_deleteImages),
       Pointer.fromFunction(_drawNativePath),
       Pointer.fromFunction(_drawNativeImage),
       Pointer.fromFunction(_drawNativeMesh),
@@ -187,31 +188,41 @@ class FFIFlutterFactory extends FFIFactory implements Finalizable {
       Pointer.fromFunction(_updateNativePaint),
       Pointer.fromFunction(_updateIndexBuffer),
       Pointer.fromFunction(_updateVertexBuffer),
-      Pointer.fromFunction(_deleteRenderPath),
-      Pointer.fromFunction(_deleteRenderPaint),
-      Pointer.fromFunction(_deleteVertexBuffer),
-      Pointer.fromFunction(_deleteIndexBuffer),
-      Pointer.fromFunction(_deleteRenderer),
+      Pointer.fromFunction(_deleteRenderPaths),
+      Pointer.fromFunction(_deleteRenderPaints),
+      Pointer.fromFunction(_deleteVertexBuffers),
+      Pointer.fromFunction(_deleteIndexBuffers),
+      Pointer.fromFunction(_deleteRenderers),
     );
   }
 
-  static void _deleteRenderer(Pointer<Void> renderer) {
-    if (_canvasLookup[renderer.address]?.target == null) {
-      _canvasLookup.remove(renderer.address);
+  static void _removeAll(Map<int, Object> lookup, Pointer<Uint64> ids,
+      int count) {
+    for (int i = 0; i < count; i++) {
+      lookup.remove(ids[i]);
     }
   }
 
-  static void _deleteRenderPath(int path) {
-    _pathLookup.remove(path);
+  static void _deleteRenderers(Pointer<Uint64> renderers, int count) {
+    for (int i = 0; i < count; i++) {
+      var address = renderers[i];
+      if (_canvasLookup[address]?.target == null) {
+        _canvasLookup.remove(address);
+      }
+    }
   }
 
-  static void _deleteRenderPaint(int paint) => _paintLookup.remove(paint);
+  static void _deleteRenderPaths(Pointer<Uint64> paths, int count) =>
+      _removeAll(_pathLookup, paths, count);
+
+  static void _deleteRenderPaints(Pointer<Uint64> paints, int count) =>
+      _removeAll(_paintLookup, paints, count);
 
-  static void _deleteVertexBuffer(int buffer) =>
-      _vertexBufferLookup.remove(buffer);
+  static void _deleteVertexBuffers(Pointer<Uint64> buffers, int count) =>
+      _removeAll(_vertexBufferLookup, buffers, count);
 
-  static void _deleteIndexBuffer(int buffer) =>
-      _indexBufferLookup.remove(buffer);
+  static void _deleteIndexBuffers(Pointer<Uint64> buffers, int count) =>
+      _removeAll(_indexBufferLookup, buffers, count);
 
   static void _drawNativeMesh(
       Pointer<Void> renderer,
@@ -223,6 +234,23 @@ class FFIFlutterFactory extends FFIFactory implements Finalizable {
       int indexCount,
       int blendModeValue,
       double opacity) {
+    var uiCanvas = _canvasLookup[renderer.address]?.target;
+    if (uiCanvas != null) {
+      _drawMesh(uiCanvas, renderImage, vertices, uvs, indices, vertexCount,
+          indexCount, blendModeValue, opacity);
+    }
+  }
+
+  static void _drawMesh(
+      ui.Canvas uiCanvas,
+      int renderImage,
+      int vertices,
+      int uvs,
+      int indices,
+      int vertexCount,
+      int indexCount,
+      int blendModeValue,
+      double opacity) {
     var image = FFIFlutterFactory.images[renderImage];
     var vertexBuffer = _vertexBufferLookup[vertices];
     var uvBuffer = _vertexBufferLookup[uvs];
@@ -237,9 +265,8 @@ class FFIFlutterFactory extends FFIFactory implements Finalizable {
       textureCoordinates: uvBuffer,
       indices: indexBuffer,
     );
-    var uiCanvas = _canvasLookup[renderer.address]?.target;
     var uiImage = image?.image;
-    if (uiImage != null && uiCanvas != null) {
+    if (uiImage != null) {
       uiCanvas.drawVertices(
         drawVertices,
         ui.BlendMode.srcOver,
@@ -374,11 +401,14 @@ class FFIFlutterFactory extends FFIFactory implements Finalizable {
   }
 
   static void _updateNativePaint(int paint, Pointer<Uint8> data, int size) {
+    _readPaint(paint, BinaryReader.fromList(data.asTypedList(size)));
+  }
+
+  static void _readPaint(int paint, BinaryReader reader) {
     var uiPaint = _paintLookup[paint];
     if (uiPaint == null) {
       _paintLookup[paint] = uiPaint = ui.Paint();
     }
-    var reader = BinaryReader.fromList(data.asTypedList(size));
     var dirt = reader.readUint16();
     if ((dirt & PaintDirtFromNative.style) != 0) {
       uiPaint.style = reader.readUint8() == 0
@@ -477,6 +507,145 @@ class FFIFlutterFactory extends FFIFactory implements Finalizable {
     }
   }
 
+  /// Plays back a command buffer recorded by a native FlutterRenderer (see
+  /// FlutterRenderCommand in flutter_renderer.cpp) onto [canvas].
+  static void playback(ui.Canvas canvas, Uint8List commands) {
+    var reader = BinaryReader.fromList(commands);
+    while (!reader.isEOF) {
+      switch (reader.readUint8()) {
+        case _RenderCommand.save:
+          canvas.save();
+          break;
+        case _RenderCommand.restore:
+          canvas.restore();
+          break;
+        case _RenderCommand.transform:
+          var xx = reader.readFloat32();
+          var xy = reader.readFloat32();
+          var yx = reader.readFloat32();
+          var yy = reader.readFloat32();
+          var tx = reader.readFloat32();
+          var ty = reader.readFloat32();
+          canvas.transform(Float64List.fromList(
+              [xx, xy, 0, 0, yx, yy, 0, 0, 0, 0, 1, 0, tx, ty, 0, 1]));
+          break;
+        case _RenderCommand.updatePaint:
+          _readPaint(reader.readVarUint(), reader);
+          break;
+        case _RenderCommand.updatePath:
+          _readPath(reader);
+          break;
+        case _RenderCommand.drawPath:
+          var uiPath = _pathLookup[reader.readVarUint()];
+          var uiPaint = _paintLookup[reader.readVarUint()];
+          assert(uiPath != null && uiPaint != null);
+          if (uiPath != null && uiPaint != null) {
+            canvas.drawPath(uiPath, uiPaint);
+          }
+          break;
+        case _RenderCommand.clipPath:
+          var uiPath = _pathLookup[reader.readVarUint()];
+          if (uiPath != null) {
+            canvas.clipPath(uiPath);
+          }
+          break;
+        case _RenderCommand.drawImage:
+          var image = images[reader.readVarUint()];
+          var blendModeValue = reader.readUint8();
+          var opacity = reader.readFloat32();
+          var uiImage = image?.image;
+          if (uiImage != null) {
+            canvas.drawImage(
+              uiImage,
+              ui.Offset.zero,
+              ui.Paint()
+                ..blendMode = ui.BlendMode.values[blendModeValue]
+                ..filterQuality = ui.FilterQuality.high
+                ..color = ui.Color.fromRGBO(255, 255, 255, opacity),
+            );
+          }
+          break;
+        case _RenderCommand.updateVertexBuffer:
+          var id = reader.readVarUint();
+          var count = reader.readUint32();
+          _vertexBufferLookup[id] = List.generate(count,
+              (_) => ui.Offset(reader.readFloat32(), reader.readFloat32()),
+              growable: false);
+          break;
+        case _RenderCommand.updateIndexBuffer:
+          var id = reader.readVarUint();
+          var count = reader.readUint32();
+          var indices = Uint16List(count);
+          for (int i = 0; i < count; i++) {
+            indices[i] = reader.readUint16();
+          }
+          _indexBufferLookup[id] = indices;
+          break;
+        case _RenderCommand.drawMesh:
+          var image = reader.readVarUint();
+          var vertices = reader.readVarUint();
+          var uvs = reader.readVarUint();
+          var indices = reader.readVarUint();
+          var vertexCount = reader.readUint32();
+          var indexCount = reader.readUint32();
+          var blendModeValue = reader.readUint8();
+          var opacity = reader.readFloat32();
+          _drawMesh(canvas, image, vertices, uvs, indices, vertexCount,
+              indexCount, blendModeValue, opacity);
+          break;
+        default:
+          assert(false, 'unknown render command');
+          return;
+      }
+    }
+  }
+
+  static void _readPath(BinaryReader reader) {
+    var path = reader.readVarUint();
+    var fillRule = reader.readUint8();
+    var verbCount = reader.readUint32();
+    var pointCount = reader.readUint32();
+    var verbsStart = reader.readIndex;
+    var pointsStart = verbsStart + verbCount;
+    var uiPath = _pathLookup[path];
+    if (uiPath == null) {
+      _pathLookup[path] = uiPath = ui.Path();
+    } else {
+      uiPath.reset();
+    }
+    uiPath.fillType = fillRule < ui.PathFillType.values.length
+        ? ui.PathFillType.values[fillRule]
+        : ui.PathFillType.nonZero;
+    var buffer = reader.buffer;
+    var points = pointsStart;
+    double x(int index) =>
+        buffer.getFloat32(points + index * 8, Endian.host);
+    double y(int index) =>
+        buffer.getFloat32(points + index * 8 + 4, Endian.host);
+    for (int i = 0; i < verbCount; i++) {
+      var verb = buffer.getUint8(verbsStart + i);
+      switch (verb) {
+        case PrivatePathVerb.move:
+          uiPath.moveTo(x(0), y(0));
+          break;
+        case PrivatePathVerb.line:
+          uiPath.lineTo(x(0), y(0));
+          break;
+        case PrivatePathVerb.quad:
+          uiPath.quadraticBezierTo(x(0), y(0), x(1), y(1));
+          break;
+        case PrivatePathVerb.cubic:
+          uiPath.cubicTo(x(0), y(0), x(1), y(1), x(2), y(2));
+          break;
+        case PrivatePathVerb.close:
+          uiPath.close();
+          break;
+      }
+      points += PrivatePathVerb.pointCount(verb) * 8;
+    }
+    reader.readIndex = pointsStart + pointCount * 8;
+  }
+
   @override
   Future<void> completedDecodingFile(bool success) async {
     if (success) {
@@ -493,9 +662,8 @@ class FFIFlutterFactory extends FFIFactory implements Finalizable {
     }
   }
 
-  static void _deleteImage(int image) {
-    images.remove(image);
-  }
+  static void _deleteImages(Pointer<Uint64> ids, int count) =>
+      _removeAll(images, ids, count);
 
   @override
   Future<RenderImage?> decodeImage(Uint8List bytes) {
@@ -552,19 +720,68 @@ final Pointer<NativeFunction<Void Function(Pointer<Void>)>>
 final void Function(Pointer<Void>) _deleteFlutterRenderer =
     _deleteFlutterRendererNative.asFunction();
 
+final void Function(Pointer<Void>, bool) _flutterRendererSetRecording =
+    nativeLib
+        .lookup<NativeFunction<Void Function(Pointer<Void>, Bool)>>(
+            'flutterRendererSetRecording')
+        .asFunction();
+final int Function(Pointer<Void>) _flutterRendererCommandsSize = nativeLib
+    .lookup<NativeFunction<Uint64 Function(Pointer<Void>)>>(
+        'flutterRendererCommandsSize')
+    .asFunction();
+final Pointer<Uint8> Function(Pointer<Void>) _flutterRendererTakeCommands =
+    nativeLib
+        .lookup<NativeFunction<Pointer<Uint8> Function(Pointer<Void>)>>(
+            'flutterRendererTakeCommands')
+        .asFunction();
+
+/// Opcodes of the native FlutterRenderCommand enum.
+abstract class _RenderCommand {
+  static const int save = 0;
+  static const int restore = 1;
+  static const int transform = 2;
+  static const int updatePaint = 3;
+  static const int updatePath = 4;
+  static const int drawPath = 5;
+  static const int clipPath = 6;
+  static const int drawImage = 7;
+  static const int updateVertexBuffer = 8;
+  static const int updateIndexBuffer = 9;
+  static const int drawMesh = 10;
+}
+
 class FlutterRendererFFI extends FFIRiveRenderer
     implements Finalizable, FlutterRenderer {
   @override
   final ui.Canvas canvas;
   static final _finalizer = NativeFinalizer(_deleteFlutterRendererNative);
 
+  final bool _recording;
+
   FlutterRendererFFI(this.canvas)
-      : super.fromPointer(
+      : _recording = FlutterRenderer.recordCommands,
+        super.fromPointer(
           _makeFlutterRenderer((rive.Factory.flutter as FFIFactory).pointer),
           rive.Factory.flutter,
         ) {
     FFIFlutterFactory.canvasLookup[pointer.address] = WeakReference(canvas);
     _finalizer.attach(this, pointer.cast(), detach: this);
+    if (_recording) {
+      _flutterRendererSetRecording(pointer, true);
+    }
+  }
+
+  @override
+  void flush() {
+    if (!_recording || pointer == nullptr) {
+      return;
+    }
+    var size = _flutterRendererCommandsSize(pointer);
+    if (size == 0) {
+      return;
+    }
+    FFIFlutterFactory.playback(
+        canvas, _flutterRendererTakeCommands(pointer).asTypedList(size));
   }
 
   @override
@@ -572,6 +789,7 @@ class FlutterRendererFFI extends FFIRiveRenderer
     if (pointer == nullptr) {
       return;
     }
+    flush();
     _finalizer.detach(this);
     _deleteFlutterRenderer(pointer);
     pointer = nullptr;
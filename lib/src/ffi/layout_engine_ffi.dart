@@ -7,17 +7,109 @@ import 'package:rive_native/src/ffi/dynamic_library_helper.dart';
 
 DynamicLibrary get _nativeLib => DynamicLibraryHelper.nativeLib;
 
-final Pointer<Void> Function() _makeYogaStyle = _nativeLib
-    .lookup<NativeFunction<Pointer<Void> Function()>>('makeYogaStyle')
+const int _edgeCount = 9;
+const int _gutterCount = 3;
+const int _dimensionCount = 2;
+
+/// Mirrors PackedLayoutStyle in layout_engine_binding.cpp. Styles are edited
+/// in place from Dart and only cross into native code when applied to a node.
+final class _PackedLayoutStyle extends Struct {
+  @Int32()
+  external int alignContent;
+  @Int32()
+  external int direction;
+  @Int32()
+  external int flexDirection;
+  @Int32()
+  external int justifyContent;
+  @Int32()
+  external int alignItems;
+  @Int32()
+  external int alignSelf;
+  @Int32()
+  external int positionType;
+  @Int32()
+  external int flexWrap;
+  @Int32()
+  external int overflow;
+  @Int32()
+  external int display;
+  @Float()
+  external double flex;
+  @Float()
+  external double flexGrow;
+  @Float()
+  external double flexShrink;
+  external _YGValue flexBasis;
+  @Array(_edgeCount)
+  external Array<_YGValue> margin;
+  @Array(_edgeCount)
+  external Array<_YGValue> position;
+  @Array(_edgeCount)
+  external Array<_YGValue> padding;
+  @Array(_edgeCount)
+  external Array<_YGValue> border;
+  @Array(_gutterCount)
+  external Array<_YGValue> gap;
+  @Array(_dimensionCount)
+  external Array<_YGValue> dimensions;
+  @Array(_dimensionCount)
+  external Array<_YGValue> minDimensions;
+  @Array(_dimensionCount)
+  external Array<_YGValue> maxDimensions;
+}
+
+final Pointer<_PackedLayoutStyle> Function() _makePackedYogaStyle = _nativeLib
+    .lookup<NativeFunction<Pointer<_PackedLayoutStyle> Function()>>(
+        'makePackedYogaStyle')
     .asFunction();
 
-final Pointer<NativeFunction<Void Function(Pointer<Void>)>>
-    _disposeYogaStyleNative =
-    _nativeLib.lookup<NativeFunction<Void Function(Pointer<Void>)>>(
-        'disposeYogaStyle');
+final Pointer<NativeFunction<Void Function(Pointer<_PackedLayoutStyle>)>>
+    _disposePackedYogaStyleNative = _nativeLib
+        .lookup<NativeFunction<Void Function(Pointer<_PackedLayoutStyle>)>>(
+            'disposePackedYogaStyle');
 
-final void Function(Pointer<Void>) _disposeYogaStyle =
-    _disposeYogaStyleNative.asFunction();
+final void Function(Pointer<_PackedLayoutStyle>) _disposePackedYogaStyle =
+    _disposePackedYogaStyleNative.asFunction();
+
+final void Function(Pointer<Void>, Pointer<_PackedLayoutStyle>)
+    _yogaNodeSetPackedStyle = _nativeLib
+        .lookup<
+            NativeFunction<
+                Void Function(Pointer<Void>,
+                    Pointer<_PackedLayoutStyle>)>>('yogaNodeSetPackedStyle')
+        .asFunction();
+
+/// Mirrors LayoutTreeOp in layout_engine_binding.cpp.
+final class _LayoutTreeOp extends Struct {
+  @Uint32()
+  external int type;
+  @Int32()
+  external int value;
+  external Pointer<Void> node;
+  external Pointer<Void> child;
+}
+
+abstract class _LayoutTreeOpType {
+  static const int insertChild = 0;
+  static const int removeChild = 1;
+  static const int clearChildren = 2;
+  static const int setStyle = 3;
+  static const int setType = 4;
+  static const int markDirty = 5;
+}
+
+final void Function(Pointer<_LayoutTreeOp>, int,
+        Pointer<Pointer<_PackedLayoutStyle>>, int) _yogaApplyTreeOps =
+    _nativeLib
+        .lookup<
+            NativeFunction<
+                Void Function(
+                    Pointer<_LayoutTreeOp>,
+                    Uint32,
+                    Pointer<Pointer<_PackedLayoutStyle>>,
+                    Uint32)>>('yogaApplyTreeOps')
+        .asFunction();
 
 final Pointer<Void> Function() _makeYogaNode = _nativeLib
     .lookup<NativeFunction<Pointer<Void> Function()>>('makeYogaNode')
@@ -31,11 +123,6 @@ final Pointer<NativeFunction<Void Function(Pointer<Void>)>>
 final void Function(Pointer<Void>) _disposeYogaNode =
     _disposeYogaNodeNative.asFunction();
 
-final void Function(Pointer<Void>, Pointer<Void>) _yogaNodeSetStyle = _nativeLib
-    .lookup<NativeFunction<Void Function(Pointer<Void>, Pointer<Void>)>>(
-        'yogaNodeSetStyle')
-    .asFunction();
-
 final bool Function(Pointer<Void>) _yogaNodeCheckAndResetUpdated = _nativeLib
     .lookup<
         NativeFunction<
@@ -61,132 +148,6 @@ final void Function(Pointer<Void>, int) _yogaNodeSetType = _nativeLib
         'yogaNodeSetType')
     .asFunction();
 
-final int Function(Pointer<Void>) _yogaStyleGetAlignContent = _nativeLib
-    .lookup<NativeFunction<Int Function(Pointer<Void>)>>(
-        'yogaStyleGetAlignContent')
-    .asFunction();
-
-final void Function(Pointer<Void>, int) _yogaStyleSetAlignContent = _nativeLib
-    .lookup<NativeFunction<Void Function(Pointer<Void>, Int)>>(
-        'yogaStyleSetAlignContent')
-    .asFunction();
-
-final int Function(Pointer<Void>) _yogaStyleGetDirection = _nativeLib
-    .lookup<NativeFunction<Int Function(Pointer<Void>)>>(
-        'yogaStyleGetDirection')
-    .asFunction();
-
-final void Function(Pointer<Void>, int) _yogaStyleSetDirection = _nativeLib
-    .lookup<NativeFunction<Void Function(Pointer<Void>, Int)>>(
-        'yogaStyleSetDirection')
-    .asFunction();
-
-final int Function(Pointer<Void>) _yogaStyleGetFlexDirection = _nativeLib
-    .lookup<NativeFunction<Int Function(Pointer<Void>)>>(
-        'yogaStyleGetFlexDirection')
-    .asFunction();
-
-final void Function(Pointer<Void>, int) _yogaStyleSetFlexDirection = _nativeLib
-    .lookup<NativeFunction<Void Function(Pointer<Void>, Int)>>(
-        'yogaStyleSetFlexDirection')
-    .asFunction();
-
-final int Function(Pointer<Void>) _yogaStyleGetJustifyContent = _nativeLib
-    .lookup<NativeFunction<Int Function(Pointer<Void>)>>(
-        'yogaStyleGetJustifyContent')
-    .asFunction();
-
-final void Function(Pointer<Void>, int) _yogaStyleSetJustifyContent = _nativeLib
-    .lookup<NativeFunction<Void Function(Pointer<Void>, Int)>>(
-        'yogaStyleSetJustifyContent')
-    .asFunction();
-
-final int Function(Pointer<Void>) _yogaStyleGetAlignItems = _nativeLib
-    .lookup<NativeFunction<Int Function(Pointer<Void>)>>(
-        'yogaStyleGetAlignItems')
-    .asFunction();
-
-final void Function(Pointer<Void>, int) _yogaStyleSetAlignItems = _nativeLib
-    .lookup<NativeFunction<Void Function(Pointer<Void>, Int)>>(
-        'yogaStyleSetAlignItems')
-    .asFunction();
-
-final int Function(Pointer<Void>) _yogaStyleGetAlignSelf = _nativeLib
-    .lookup<NativeFunction<Int Function(Pointer<Void>)>>(
-        'yogaStyleGetAlignSelf')
-    .asFunction();
-
-final void Function(Pointer<Void>, int) _yogaStyleSetAlignSelf = _nativeLib
-    .lookup<NativeFunction<Void Function(Pointer<Void>, Int)>>(
-        'yogaStyleSetAlignSelf')
-    .asFunction();
-
-final int Function(Pointer<Void>) _yogaStyleGetPositionType = _nativeLib
-    .lookup<NativeFunction<Int Function(Pointer<Void>)>>(
-        'yogaStyleGetPositionType')
-    .asFunction();
-
-final void Function(Pointer<Void>, int) _yogaStyleSetPositionType = _nativeLib
-    .lookup<NativeFunction<Void Function(Pointer<Void>, Int)>>(
-        'yogaStyleSetPositionType')
-    .asFunction();
-
-final int Function(Pointer<Void>) _yogaStyleGetFlexWrap = _nativeLib
-    .lookup<NativeFunction<Int Function(Pointer<Void>)>>('yogaStyleGetFlexWrap')
-    .asFunction();
-
-final void Function(Pointer<Void>, int) _yogaStyleSetFlexWrap = _nativeLib
-    .lookup<NativeFunction<Void Function(Pointer<Void>, Int)>>(
-        'yogaStyleSetFlexWrap')
-    .asFunction();
-
-final int Function(Pointer<Void>) _yogaStyleGetOverflow = _nativeLib
-    .lookup<NativeFunction<Int Function(Pointer<Void>)>>('yogaStyleGetOverflow')
-    .asFunction();
-
-final void Function(Pointer<Void>, int) _yogaStyleSetOverflow = _nativeLib
-    .lookup<NativeFunction<Void Function(Pointer<Void>, Int)>>(
-        'yogaStyleSetOverflow')
-    .asFunction();
-
-final int Function(Pointer<Void>) _yogaStyleGetDisplay = _nativeLib
-    .lookup<NativeFunction<Int Function(Pointer<Void>)>>('yogaStyleGetDisplay')
-    .asFunction();
-
-final void Function(Pointer<Void>, int) _yogaStyleSetDisplay = _nativeLib
-    .lookup<NativeFunction<Void Function(Pointer<Void>, Int)>>(
-        'yogaStyleSetDisplay')
-    .asFunction();
-
-final double Function(Pointer<Void>) _yogaStyleGetFlex = _nativeLib
-    .lookup<NativeFunction<Float Function(Pointer<Void>)>>('yogaStyleGetFlex')
-    .asFunction();
-
-final void Function(Pointer<Void>, double) _yogaStyleSetFlex = _nativeLib
-    .lookup<NativeFunction<Void Function(Pointer<Void>, Float)>>(
-        'yogaStyleSetFlex')
-    .asFunction();
-
-final double Function(Pointer<Void>) _yogaStyleGetFlexGrow = _nativeLib
-    .lookup<NativeFunction<Float Function(Pointer<Void>)>>(
-        'yogaStyleGetFlexGrow')
-    .asFunction();
-
-final void Function(Pointer<Void>, double) _yogaStyleSetFlexGrow = _nativeLib
-    .lookup<NativeFunction<Void Function(Pointer<Void>, Float)>>(
-        'yogaStyleSetFlexGrow')
-    .asFunction();
-
-final double Function(Pointer<Void>) _yogaStyleGetFlexShrink = _nativeLib
-    .lookup<NativeFunction<Float Function(Pointer<Void>)>>(
-        'yogaStyleGetFlexShrink')
-    .asFunction();
-
-final void Function(Pointer<Void>, double) _yogaStyleSetFlexShrink = _nativeLib
-    .lookup<NativeFunction<Void Function(Pointer<Void>, Float)>>(
-        'yogaStyleSetFlexShrink')
-    .asFunction();
-
 final class _YGValue extends Struct {
   @Float()
   external double value;
@@ -199,109 +160,6 @@ final class _YGValue extends Struct {
       );
 }
 
-final _YGValue Function(Pointer<Void>) _yogaStyleGetFlexBasis = _nativeLib
-    .lookup<NativeFunction<_YGValue Function(Pointer<Void>)>>(
-        'yogaStyleGetFlexBasis')
-    .asFunction();
-
-final void Function(Pointer<Void>, double, int) _yogaStyleSetFlexBasis =
-    _nativeLib
-        .lookup<NativeFunction<Void Function(Pointer<Void>, Float, Int32)>>(
-            'yogaStyleSetFlexBasis')
-        .asFunction();
-
-final _YGValue Function(Pointer<Void>, int) _yogaStyleGetMargin = _nativeLib
-    .lookup<NativeFunction<_YGValue Function(Pointer<Void>, Int32)>>(
-        'yogaStyleGetMargin')
-    .asFunction();
-
-final void Function(Pointer<Void>, int, double, int) _yogaStyleSetMargin =
-    _nativeLib
-        .lookup<
-            NativeFunction<
-                Void Function(
-                    Pointer<Void>, Int32, Float, Int32)>>('yogaStyleSetMargin')
-        .asFunction();
-
-final _YGValue Function(Pointer<Void>, int) _yogaStyleGetPosition = _nativeLib
-    .lookup<NativeFunction<_YGValue Function(Pointer<Void>, Int32)>>(
-        'yogaStyleGetPosition')
-    .asFunction();
-
-final void Function(Pointer<Void>, int, double, int) _yogaStyleSetPosition =
-    _nativeLib
-        .lookup<
-            NativeFunction<
-                Void Function(Pointer<Void>, Int32, Float,
-                    Int32)>>('yogaStyleSetPosition')
-        .asFunction();
-
-final _YGValue Function(Pointer<Void>, int) _yogaStyleGetPadding = _nativeLib
-    .lookup<NativeFunction<_YGValue Function(Pointer<Void>, Int32)>>(
-        'yogaStyleGetPadding')
-    .asFunction();
-
-final void Function(Pointer<Void>, int, double, int) _yogaStyleSetPadding =
-    _nativeLib
-        .lookup<
-            NativeFunction<
-                Void Function(
-                    Pointer<Void>, Int32, Float, Int32)>>('yogaStyleSetPadding')
-        .asFunction();
-
-final _YGValue Function(Pointer<Void>, int) _yogaStyleGetBorder = _nativeLib
-    .lookup<NativeFunction<_YGValue Function(Pointer<Void>, Int32)>>(
-        'yogaStyleGetBorder')
-    .asFunction();
-
-final void Function(Pointer<Void>, int, double, int) _yogaStyleSetBorder =
-    _nativeLib
-        .lookup<
-            NativeFunction<
-                Void Function(
-                    Pointer<Void>, Int32, Float, Int32)>>('yogaStyleSetBorder')
-        .asFunction();
-
-final _YGValue Function(Pointer<Void>, int) _yogaStyleGetGap = _nativeLib
-    .lookup<NativeFunction<_YGValue Function(Pointer<Void>, Int32)>>(
-        'yogaStyleGetGap')
-    .asFunction();
-
-final void Function(Pointer<Void>, int, double, int) _yogaStyleSetGap =
-    _nativeLib
-        .lookup<
-            NativeFunction<
-                Void Function(
-                    Pointer<Void>, Int32, Float, Int32)>>('yogaStyleSetGap')
-        .asFunction();
-
-final _YGValue Function(Pointer<Void>, int) _yogaStyleGetDimension = _nativeLib
-    .lookup<NativeFunction<_YGValue Function(Pointer<Void>, Int32)>>(
-        'yogaStyleGetDimension')
-    .asFunction();
-
-final void Function(Pointer<Void>, int, double, int) _yogaStyleSetDimension =
-    _nativeLib
-        .lookup<
-            NativeFunction<
-                Void Function(Pointer<Void>, Int32, Float,
-                    Int32)>>('yogaStyleSetDimension')
-        .asFunction();
-
-final _YGValue Function(Pointer<Void>, int) _yogaStyleGetMinDimension =
-    _nativeLib
-        .lookup<NativeFunction<_YGValue Function(Pointer<Void>, Int32)>>(
-            'yogaStyleGetMinDimension')
-        .asFunction();
-
-final void Function(Pointer<Void>, int, double, int) _yogaStyleSetMinDimension =
-    _nativeLib
-        .lookup<
-            NativeFunction<
-                Void Function(Pointer<Void>, Int32, Float,
-                    Int32)>>('yogaStyleSetMinDimension')
-        .asFunction();
-
 final void Function(Pointer<Void>, Pointer<Void>, int) _yogaNodeInsertChild =
     _nativeLib
         .lookup<
@@ -321,20 +179,6 @@ final void Function(Pointer<Void>) _yogaNodeClearChildren = _nativeLib
         'yogaNodeClearChildren')
     .asFunction();
 
-final _YGValue Function(Pointer<Void>, int) _yogaStyleGetMaxDimension =
-    _nativeLib
-        .lookup<NativeFunction<_YGValue Function(Pointer<Void>, Int32)>>(
-            'yogaStyleGetMaxDimension')
-        .asFunction();
-
-final void Function(Pointer<Void>, int, double, int) _yogaStyleSetMaxDimension =
-    _nativeLib
-        .lookup<
-            NativeFunction<
-                Void Function(Pointer<Void>, Int32, Float,
-                    Int32)>>('yogaStyleSetMaxDimension')
-        .asFunction();
-
 final void Function(Pointer<Void>, double, double, int)
     _yogaNodeCalculateLayout = _nativeLib
         .lookup<
@@ -369,6 +213,14 @@ final _YGLayout Function(Pointer<Void>) _yogaNodeGetLayout = _nativeLib
         'yogaNodeGetLayout')
     .asFunction();
 
+final void Function(Pointer<Pointer<Void>>, int, Pointer<_YGLayout>)
+    _yogaNodesGetLayouts = _nativeLib
+        .lookup<
+            NativeFunction<
+                Void Function(Pointer<Pointer<Void>>, Uint32,
+                    Pointer<_YGLayout>)>>('yogaNodesGetLayouts')
+        .asFunction();
+
 final _YGLayout Function(Pointer<Void>) _yogaNodeGetPadding = _nativeLib
     .lookup<NativeFunction<_YGLayout Function(Pointer<Void>)>>(
         'yogaNodeGetPadding')
@@ -440,7 +292,7 @@ class LayoutNodeFFI extends LayoutNode implements Finalizable {
 
   @override
   void setStyle(LayoutStyle style) =>
-      _yogaNodeSetStyle(_nativePtr, (style as LayoutStyleFFI)._nativePtr);
+      _yogaNodeSetPackedStyle(_nativePtr, (style as LayoutStyleFFI)._packed);
 
   @override
   LayoutNodeType get nodeType =>
@@ -575,218 +427,286 @@ class LayoutNodeFFI extends LayoutNode implements Finalizable {
 }
 
 class LayoutStyleFFI extends LayoutStyle implements Finalizable {
-  Pointer<Void> _nativePtr;
-  static final _finalizer = NativeFinalizer(_disposeYogaStyleNative);
+  Pointer<_PackedLayoutStyle> _packed;
+  static final _finalizer = NativeFinalizer(_disposePackedYogaStyleNative);
 
-  LayoutStyleFFI(this._nativePtr) {
-    _finalizer.attach(this, _nativePtr.cast(), detach: this);
+  LayoutStyleFFI(this._packed) {
+    _finalizer.attach(this, _packed.cast(), detach: this);
+  }
+
+  _PackedLayoutStyle get _style => _packed.ref;
+
+  static void _setValue(_YGValue target, LayoutValue value) {
+    target.value = value.value;
+    target.unit = value.unit.index;
   }
 
+  static double? _optional(double value) => value.isNaN ? null : value;
+
   @override
   void dispose() {
-    if (_nativePtr == nullptr) {
+    if (_packed == nullptr) {
       return;
     }
     _finalizer.detach(this);
-    _disposeYogaStyle(_nativePtr);
-    _nativePtr = nullptr;
+    _disposePackedYogaStyle(_packed);
+    _packed = nullptr;
   }
 
   @override
-  LayoutAlign get alignContent =>
-      LayoutAlign.values[_yogaStyleGetAlignContent(_nativePtr)];
+  LayoutAlign get alignContent => LayoutAlign.values[_style.alignContent];
 
   @override
-  set alignContent(LayoutAlign value) =>
-      _yogaStyleSetAlignContent(_nativePtr, value.index);
+  set alignContent(LayoutAlign value) => _style.alignContent = value.index;
 
   @override
-  LayoutDirection get direction =>
-      LayoutDirection.values[_yogaStyleGetDirection(_nativePtr)];
+  LayoutDirection get direction => LayoutDirection.values[_style.direction];
 
   @override
-  set direction(LayoutDirection value) =>
-      _yogaStyleSetDirection(_nativePtr, value.index);
+  set direction(LayoutDirection value) => _style.direction = value.index;
 
   @override
   LayoutFlexDirection get flexDirection =>
-      LayoutFlexDirection.values[_yogaStyleGetFlexDirection(_nativePtr)];
+      LayoutFlexDirection.values[_style.flexDirection];
 
   @override
   set flexDirection(LayoutFlexDirection value) =>
-      _yogaStyleSetFlexDirection(_nativePtr, value.index);
+      _style.flexDirection = value.index;
 
   @override
   LayoutJustify get justifyContent =>
-      LayoutJustify.values[_yogaStyleGetJustifyContent(_nativePtr)];
+      LayoutJustify.values[_style.justifyContent];
 
   @override
   set justifyContent(LayoutJustify value) =>
-      _yogaStyleSetJustifyContent(_nativePtr, value.index);
+      _style.justifyContent = value.index;
 
   @override
-  LayoutAlign get alignItems =>
-      LayoutAlign.values[_yogaStyleGetAlignItems(_nativePtr)];
+  LayoutAlign get alignItems => LayoutAlign.values[_style.alignItems];
 
   @override
-  set alignItems(LayoutAlign value) =>
-      _yogaStyleSetAlignItems(_nativePtr, value.index);
+  set alignItems(LayoutAlign value) => _style.alignItems = value.index;
 
   @override
-  LayoutAlign get alignSelf =>
-      LayoutAlign.values[_yogaStyleGetAlignSelf(_nativePtr)];
+  LayoutAlign get alignSelf => LayoutAlign.values[_style.alignSelf];
 
   @override
-  set alignSelf(LayoutAlign value) =>
-      _yogaStyleSetAlignSelf(_nativePtr, value.index);
+  set alignSelf(LayoutAlign value) => _style.alignSelf = value.index;
 
   @override
   LayoutPosition get positionType =>
-      LayoutPosition.values[_yogaStyleGetPositionType(_nativePtr)];
+      LayoutPosition.values[_style.positionType];
 
   @override
-  set positionType(LayoutPosition value) =>
-      _yogaStyleSetPositionType(_nativePtr, value.index);
+  set positionType(LayoutPosition value) => _style.positionType = value.index;
 
   @override
-  LayoutWrap get flexWrap =>
-      LayoutWrap.values[_yogaStyleGetFlexWrap(_nativePtr)];
+  LayoutWrap get flexWrap => LayoutWrap.values[_style.flexWrap];
 
   @override
-  set flexWrap(LayoutWrap value) =>
-      _yogaStyleSetFlexWrap(_nativePtr, value.index);
+  set flexWrap(LayoutWrap value) => _style.flexWrap = value.index;
 
   @override
-  LayoutOverflow get overflow =>
-      LayoutOverflow.values[_yogaStyleGetOverflow(_nativePtr)];
+  LayoutOverflow get overflow => LayoutOverflow.values[_style.overflow];
 
   @override
-  set overflow(LayoutOverflow value) =>
-      _yogaStyleSetOverflow(_nativePtr, value.index);
+  set overflow(LayoutOverflow value) => _style.overflow = value.index;
 
   @override
-  LayoutDisplay get display =>
-      LayoutDisplay.values[_yogaStyleGetDisplay(_nativePtr)];
+  LayoutDisplay get display => LayoutDisplay.values[_style.display];
 
   @override
-  set display(LayoutDisplay value) =>
-      _yogaStyleSetDisplay(_nativePtr, value.index);
+  set display(LayoutDisplay value) => _style.display = value.index;
 
   @override
-  double? get flex {
-    double value = _yogaStyleGetFlex(_nativePtr);
-    if (value.isNaN) {
-      return null;
-    }
-    return value;
-  }
+  double? get flex => _optional(_style.flex);
 
   @override
-  set flex(double? value) => _yogaStyleSetFlex(_nativePtr, value ?? double.nan);
+  set flex(double? value) => _style.flex = value ?? double.nan;
 
   @override
-  double? get flexGrow {
-    double value = _yogaStyleGetFlexGrow(_nativePtr);
-    if (value.isNaN) {
-      return null;
-    }
-    return value;
-  }
+  double? get flexGrow => _optional(_style.flexGrow);
 
   @override
-  set flexGrow(double? value) =>
-      _yogaStyleSetFlexGrow(_nativePtr, value ?? double.nan);
+  set flexGrow(double? value) => _style.flexGrow = value ?? double.nan;
 
   @override
-  double? get flexShrink {
-    double value = _yogaStyleGetFlexShrink(_nativePtr);
-    if (value.isNaN) {
-      return null;
-    }
-    return value;
-  }
+  double? get flexShrink => _optional(_style.flexShrink);
 
   @override
-  set flexShrink(double? value) =>
-      _yogaStyleSetFlexShrink(_nativePtr, value ?? double.nan);
+  set flexShrink(double? value) => _style.flexShrink = value ?? double.nan;
 
   @override
-  LayoutValue get flexBasis =>
-      _yogaStyleGetFlexBasis(_nativePtr).toLayoutValue();
+  LayoutValue get flexBasis => _style.flexBasis.toLayoutValue();
 
   @override
-  set flexBasis(LayoutValue value) =>
-      _yogaStyleSetFlexBasis(_nativePtr, value.value, value.unit.index);
+  set flexBasis(LayoutValue value) => _setValue(_style.flexBasis, value);
 
   @override
   LayoutValue getMargin(LayoutEdge edge) =>
-      _yogaStyleGetMargin(_nativePtr, edge.index).toLayoutValue();
+      _style.margin[edge.index].toLayoutValue();
 
   @override
-  void setMargin(LayoutEdge edge, LayoutValue value) => _yogaStyleSetMargin(
-      _nativePtr, edge.index, value.value, value.unit.index);
+  void setMargin(LayoutEdge edge, LayoutValue value) =>
+      _setValue(_style.margin[edge.index], value);
 
   @override
   LayoutValue getPosition(LayoutEdge edge) =>
-      _yogaStyleGetPosition(_nativePtr, edge.index).toLayoutValue();
+      _style.position[edge.index].toLayoutValue();
 
   @override
-  void setPosition(LayoutEdge edge, LayoutValue value) => _yogaStyleSetPosition(
-      _nativePtr, edge.index, value.value, value.unit.index);
+  void setPosition(LayoutEdge edge, LayoutValue value) =>
+      _setValue(_style.position[edge.index], value);
 
   @override
   LayoutValue getPadding(LayoutEdge edge) =>
-      _yogaStyleGetPadding(_nativePtr, edge.index).toLayoutValue();
+      _style.padding[edge.index].toLayoutValue();
 
   @override
-  void setPadding(LayoutEdge edge, LayoutValue value) => _yogaStyleSetPadding(
-      _nativePtr, edge.index, value.value, value.unit.index);
+  void setPadding(LayoutEdge edge, LayoutValue value) =>
+      _setValue(_style.padding[edge.index], value);
 
   @override
   LayoutValue getBorder(LayoutEdge edge) =>
-      _yogaStyleGetBorder(_nativePtr, edge.index).toLayoutValue();
+      _style.border[edge.index].toLayoutValue();
 
   @override
-  void setBorder(LayoutEdge edge, LayoutValue value) => _yogaStyleSetBorder(
-      _nativePtr, edge.index, value.value, value.unit.index);
+  void setBorder(LayoutEdge edge, LayoutValue value) =>
+      _setValue(_style.border[edge.index], value);
 
   @override
   LayoutValue getGap(LayoutGutter gutter) =>
-      _yogaStyleGetGap(_nativePtr, gutter.index).toLayoutValue();
+      _style.gap[gutter.index].toLayoutValue();
 
   @override
   void setGap(LayoutGutter gutter, LayoutValue value) =>
-      _yogaStyleSetGap(_nativePtr, gutter.index, value.value, value.unit.index);
+      _setValue(_style.gap[gutter.index], value);
 
   @override
   LayoutValue getDimension(LayoutDimension dimension) =>
-      _yogaStyleGetDimension(_nativePtr, dimension.index).toLayoutValue();
+      _style.dimensions[dimension.index].toLayoutValue();
 
   @override
   void setDimension(LayoutDimension dimension, LayoutValue value) =>
-      _yogaStyleSetDimension(
-          _nativePtr, dimension.index, value.value, value.unit.index);
+      _setValue(_style.dimensions[dimension.index], value);
 
   @override
   LayoutValue getMinDimension(LayoutDimension dimension) =>
-      _yogaStyleGetMinDimension(_nativePtr, dimension.index).toLayoutValue();
+      _style.minDimensions[dimension.index].toLayoutValue();
 
   @override
   void setMinDimension(LayoutDimension dimension, LayoutValue value) =>
-      _yogaStyleSetMinDimension(
-          _nativePtr, dimension.index, value.value, value.unit.index);
+      _setValue(_style.minDimensions[dimension.index], value);
 
   @override
   LayoutValue getMaxDimension(LayoutDimension dimension) =>
-      _yogaStyleGetMaxDimension(_nativePtr, dimension.index).toLayoutValue();
+      _style.maxDimensions[dimension.index].toLayoutValue();
 
   @override
   void setMaxDimension(LayoutDimension dimension, LayoutValue value) =>
-      _yogaStyleSetMaxDimension(
-          _nativePtr, dimension.index, value.value, value.unit.index);
+      _setValue(_style.maxDimensions[dimension.index], value);
+}
+
+class _RecordedTreeOp {
+  final int type;
+  final int value;
+  final LayoutNodeFFI node;
+  final LayoutNodeFFI? child;
+  final LayoutStyleFFI? style;
+
+  _RecordedTreeOp(this.type, this.node,
+      {this.value = 0, this.child, this.style});
+}
+
+class LayoutTreeBatchFFI extends LayoutTreeBatch {
+  // Holding the nodes and styles keeps them alive until the batch is applied.
+  final List<_RecordedTreeOp> _ops = [];
+
+  @override
+  void insertChild(LayoutNode parent, LayoutNode child, int index) =>
+      _ops.add(_RecordedTreeOp(
+          _LayoutTreeOpType.insertChild, parent as LayoutNodeFFI,
+          child: child as LayoutNodeFFI, value: index));
+
+  @override
+  void removeChild(LayoutNode parent, LayoutNode child) =>
+      _ops.add(_RecordedTreeOp(
+          _LayoutTreeOpType.removeChild, parent as LayoutNodeFFI,
+          child: child as LayoutNodeFFI));
+
+  @override
+  void clearChildren(LayoutNode parent) => _ops.add(_RecordedTreeOp(
+      _LayoutTreeOpType.clearChildren, parent as LayoutNodeFFI));
+
+  @override
+  void setStyle(LayoutNode node, LayoutStyle style) =>
+      _ops.add(_RecordedTreeOp(
+          _LayoutTreeOpType.setStyle, node as LayoutNodeFFI,
+          style: style as LayoutStyleFFI));
+
+  @override
+  void setNodeType(LayoutNode node, LayoutNodeType type) =>
+      _ops.add(_RecordedTreeOp(
+          _LayoutTreeOpType.setType, node as LayoutNodeFFI,
+          value: type.index));
+
+  @override
+  void markDirty(LayoutNode node) => _ops
+      .add(_RecordedTreeOp(_LayoutTreeOpType.markDirty, node as LayoutNodeFFI));
+
+  @override
+  void apply() {
+    if (_ops.isEmpty) {
+      return;
+    }
+    final styleCount = _ops.where((op) => op.style != null).length;
+    final ops = calloc<_LayoutTreeOp>(_ops.length);
+    final styles = calloc<Pointer<_PackedLayoutStyle>>(styleCount);
+    int styleIndex = 0;
+    for (int i = 0; i < _ops.length; i++) {
+      final recorded = _ops[i];
+      final op = (ops + i).ref;
+      op.type = recorded.type;
+      op.value = recorded.value;
+      op.node = recorded.node._nativePtr;
+      op.child = recorded.child?._nativePtr ?? nullptr;
+      final style = recorded.style;
+      if (style != null) {
+        styles[styleIndex] = style._packed;
+        op.value = styleIndex++;
+      }
+    }
+    _yogaApplyTreeOps(ops, _ops.length, styles, styleCount);
+    calloc.free(ops);
+    calloc.free(styles);
+    _ops.clear();
+  }
+
+  @override
+  void dispose() => _ops.clear();
+}
+
+List<Layout> getLayouts(List<LayoutNode> nodes) {
+  if (nodes.isEmpty) {
+    return [];
+  }
+  final pointers = calloc<Pointer<Void>>(nodes.length);
+  final layouts = calloc<_YGLayout>(nodes.length);
+  for (int i = 0; i < nodes.length; i++) {
+    pointers[i] = (nodes[i] as LayoutNodeFFI)._nativePtr;
+  }
+  _yogaNodesGetLayouts(pointers, nodes.length, layouts);
+  final result = List<Layout>.generate(
+      nodes.length, (i) => (layouts + i).ref.toLayout(),
+      growable: false);
+  calloc.free(pointers);
+  calloc.free(layouts);
+  return result;
 }
 
-LayoutStyle makeLayoutStyle() => LayoutStyleFFI(_makeYogaStyle());
+LayoutStyle makeLayoutStyle() => LayoutStyleFFI(_makePackedYogaStyle());
+
+LayoutTreeBatch makeLayoutTreeBatch() => LayoutTreeBatchFFI();
 
 LayoutNode makeLayoutNode() => LayoutNodeFFI(_makeYogaNode());
 
@@ -274,6 +274,19 @@ final int Function(
             )>>('audioReaderLength')
     .asFunction();
 
+final void Function(
+  int threadCount,
+) setAudioDecodeThreadCount = _nativeLib
+    .lookup<
+        NativeFunction<
+            Void Function(
+              Uint32,
+            )>>('setAudioDecodeThreadCount')
+    .asFunction();
+
+void setDecodeThreadCount(int threadCount) =>
+    setAudioDecodeThreadCount(threadCount);
+
 AudioEngine? initAudioDevice(int channels, int sampleRate) {
   var engine = makeAudioEngine(
     channels,
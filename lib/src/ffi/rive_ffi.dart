@@ -1440,6 +1440,23 @@ abstract class _NativeVMIListRuntime {
               Void Function(
                   Pointer<Void> vmi, Uint32 a, Uint32 b)>>('vmiListRuntimeSwap')
       .asFunction();
+  static final void Function(
+          Pointer<Void> vmi, Pointer<Pointer<Void>> instances, int count)
+      replaceInstances = nativeLib
+          .lookup<
+              NativeFunction<
+                  Void Function(Pointer<Void> vmi,
+                      Pointer<Pointer<Void>> instances, Size count)>>(
+              'vmiListRuntimeReplaceInstances')
+          .asFunction();
+  static final void Function(Pointer<Void> vmi) beginBatch = nativeLib
+      .lookup<NativeFunction<Void Function(Pointer<Void> vmi)>>(
+          'vmiListRuntimeBeginBatch')
+      .asFunction();
+  static final void Function(Pointer<Void> vmi) endBatch = nativeLib
+      .lookup<NativeFunction<Void Function(Pointer<Void> vmi)>>(
+          'vmiListRuntimeEndBatch')
+      .asFunction();
 }
 
 abstract class _NativeVMIArtboardRuntime {
@@ -2287,6 +2304,29 @@ class FFIViewModelInstanceListRuntime extends FFIViewModelInstanceValueRuntime
     covariant FFIRiveViewModelInstanceRuntime value,
   ) =>
       insert(index, value);
+
+  @override
+  void replaceAll(Iterable<ViewModelInstance> instances) {
+    final count = instances.length;
+    final mem = malloc.allocate<Pointer<Void>>(
+        (count == 0 ? 1 : count) * sizeOf<Pointer<Void>>());
+    int index = 0;
+    for (final instance in instances) {
+      mem[index++] = (instance as FFIRiveViewModelInstanceRuntime).pointer;
+    }
+    _NativeVMIListRuntime.replaceInstances(pointer, mem, count);
+    malloc.free(mem);
+  }
+
+  @override
+  void batch(void Function() edits) {
+    _NativeVMIListRuntime.beginBatch(pointer);
+    try {
+      edits();
+    } finally {
+      _NativeVMIListRuntime.endBatch(pointer);
+    }
+  }
 }
 
 class FFIViewModelInstanceArtboardRuntime
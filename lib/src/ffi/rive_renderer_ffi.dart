@@ -1,4 +1,5 @@
 import 'dart:ffi';
+import 'dart:math' as math;
 import 'dart:typed_data';
 import 'dart:ui' as ui;
 
@@ -21,10 +22,13 @@ final DynamicLibrary nativeLib = DynamicLibraryHelper.open();
 final Pointer<Float> _floatQueryBuffer =
     calloc.allocate<Float>(sizeOf<Float>() * 5);
 
-final void Function(Pointer<Uint8>, int) _appendCommands = nativeLib
-    .lookup<NativeFunction<Void Function(Pointer<Uint8>, Uint32)>>(
-        'appendCommands')
-    .asFunction();
+final void Function(Pointer<Uint8>, int, Pointer<Float>, int)
+    _appendPathData = nativeLib
+        .lookup<
+            NativeFunction<
+                Void Function(Pointer<Uint8>, Uint32, Pointer<Float>,
+                    Uint32)>>('appendPathData')
+        .asFunction();
 
 final Pointer<Void> Function(Pointer<Void>) _makeRenderer = nativeLib
     .lookup<NativeFunction<Pointer<Void> Function(Pointer<Void>)>>(
@@ -1055,6 +1059,22 @@ DashPathEffect makeDashPathEffect() => FFIDashPath();
 const int _scratchSize = 1024;
 final Pointer<Uint8> _scratchBuffer = calloc.allocate<Uint8>(_scratchSize);
 
+// Staging memory for handing whole paths to native, grown as needed and reused
+// across paths.
+Pointer<Uint8> _pathDataBuffer = nullptr;
+int _pathDataCapacity = 0;
+
+Pointer<Uint8> _ensurePathDataBuffer(int size) {
+  if (size > _pathDataCapacity) {
+    if (_pathDataBuffer != nullptr) {
+      calloc.free(_pathDataBuffer);
+    }
+    _pathDataCapacity = math.max(size, _pathDataCapacity * 2);
+    _pathDataBuffer = calloc.allocate<Uint8>(_pathDataCapacity);
+  }
+  return _pathDataBuffer;
+}
+
 class FFIRenderImage extends RenderImage
     implements RiveFFIReference, Finalizable {
   static final _finalizer = NativeFinalizer(_deleteRenderImageNative);
@@ -1125,8 +1145,21 @@ class FFIRenderPath extends BufferedRenderPath
   }
 
   @override
-  void appendCommands(int commandCount) =>
-      _appendCommands(_scratchBuffer, commandCount);
+  void appendPathData(List<int> verbs, List<double> points) {
+    // Points go first to keep them float aligned.
+    final pointsSize = points.length * sizeOf<Float>();
+    final buffer = _ensurePathDataBuffer(pointsSize + verbs.length);
+    final pointsBuffer = buffer.cast<Float>();
+    final verbsBuffer = buffer + pointsSize;
+    pointsBuffer.asTypedList(points.length).setAll(0, points);
+    verbsBuffer.asTypedList(verbs.length).setAll(0, verbs);
+    _appendPathData(
+      verbsBuffer,
+      verbs.length,
+      pointsBuffer,
+      points.length ~/ 2,
+    );
+  }
 
   @override
   void updateRenderPath() {
@@ -1209,12 +1242,6 @@ class FFIRenderPath extends BufferedRenderPath
     }
   }
 
-  @override
-  ByteData get scratchBufferByteData {
-    final list = _scratchBuffer.asTypedList(_scratchSize);
-    return ByteData.view(list.buffer, list.offsetInBytes, list.lengthInBytes);
-  }
-
   @override
   void dispose() {
     if (_renderPath == nullptr) {
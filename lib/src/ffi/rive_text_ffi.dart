@@ -424,6 +424,35 @@ final Pointer<SimpleParagraphArray> Function(
                     Pointer<TextRunNative>, Uint64, Int32)>>('shapeText')
         .asFunction();
 
+final Pointer<SimpleUint8Array> Function(
+    Pointer<Uint32> text,
+    int textLength,
+    Pointer<TextRunNative> runs,
+    int runsLength,
+    int defaultLevel,
+    double width,
+    int align,
+    int wrap,
+    int flags) shapeAndBreakText = _nativeLib
+    .lookup<
+        NativeFunction<
+            Pointer<SimpleUint8Array> Function(
+                Pointer<Uint32>,
+                Uint64,
+                Pointer<TextRunNative>,
+                Uint64,
+                Int32,
+                Float,
+                Uint8,
+                Uint8,
+                Uint32)>>('shapeAndBreakText')
+    .asFunction();
+
+final void Function(Pointer<SimpleUint8Array>) deleteTextLayout = _nativeLib
+    .lookup<NativeFunction<Void Function(Pointer<SimpleUint8Array>)>>(
+        'deleteTextLayout')
+    .asFunction();
+
 final Pointer<SimpleTagArray> Function(
     Pointer<Void>
         font) fontFeatures = _nativeLib
@@ -773,13 +802,7 @@ class FontFFI extends Font {
     return RawPathFFI._(glyphPath);
   }
 
-  @override
-  TextShapeResult computeShape(
-    List<int> codeUnits,
-    List<TextRun> runs, {
-    TextDirection? direction,
-  }) {
-    // Allocate and copy to runs memory.
+  static Pointer<TextRunNative> _allocateRuns(List<TextRun> runs) {
     var runsMemory =
         calloc.allocate<TextRunNative>(runs.length * sizeOf<TextRunNative>());
     int runIndex = 0;
@@ -794,24 +817,34 @@ class FontFFI extends Font {
         ..styleId = run.styleId
         ..dir = 0;
     }
+    return runsMemory;
+  }
 
-    // Allocate and copy to text buffer.
+  static Pointer<Uint32> _allocateText(List<int> codeUnits) {
     var textBuffer =
         calloc.allocate<Uint32>(codeUnits.length * sizeOf<Uint32>());
-    for (int i = 0; i < codeUnits.length; i++) {
-      textBuffer[i] = codeUnits[i];
-    }
+    textBuffer.asTypedList(codeUnits.length).setAll(0, codeUnits);
+    return textBuffer;
+  }
 
-    var shapeResult = shapeText(
-        textBuffer,
-        codeUnits.length,
-        runsMemory,
-        runs.length,
-        direction == null
-            ? -1
-            : direction == TextDirection.ltr
-                ? 0
-                : 1);
+  static int _directionLevel(TextDirection? direction) => direction == null
+      ? -1
+      : direction == TextDirection.ltr
+          ? 0
+          : 1;
+
+  @override
+  TextShapeResult computeShape(
+    List<int> codeUnits,
+    List<TextRun> runs, {
+    TextDirection? direction,
+  }) {
+    // Allocate and copy to runs memory and text buffer.
+    var runsMemory = _allocateRuns(runs);
+    var textBuffer = _allocateText(codeUnits);
+
+    var shapeResult = shapeText(textBuffer, codeUnits.length, runsMemory,
+        runs.length, _directionLevel(direction));
 
     // Free memory for structs passed into native that we no longer need.
     calloc.free(textBuffer);
@@ -819,6 +852,69 @@ class FontFFI extends Font {
 
     return TextShapeResultFFI(shapeResult);
   }
+
+  @override
+  TextLayout? computeLayout(
+    List<int> codeUnits,
+    List<TextRun> runs, {
+    required double width,
+    required TextAlign align,
+    required TextWrap wrap,
+    required bool glyphOutlines,
+    TextDirection? direction,
+  }) {
+    var runsMemory = _allocateRuns(runs);
+    var textBuffer = _allocateText(codeUnits);
+
+    var layout = shapeAndBreakText(
+      textBuffer,
+      codeUnits.length,
+      runsMemory,
+      runs.length,
+      _directionLevel(direction),
+      width,
+      align.index,
+      wrap.index,
+      glyphOutlines ? TextLayout.glyphOutlinesFlag : 0,
+    );
+
+    calloc.free(textBuffer);
+    calloc.free(runsMemory);
+
+    if (layout == nullptr) {
+      return null;
+    }
+    return TextLayoutFFI._(layout);
+  }
+}
+
+final class SimpleUint8Array extends Struct {
+  external Pointer<Uint8> data;
+  @Size()
+  external int size;
+}
+
+/// A [TextLayout] mapped straight from the native buffer, which stays alive
+/// until [dispose].
+class TextLayoutFFI extends TextLayout {
+  Pointer<SimpleUint8Array> _native;
+
+  TextLayoutFFI._(this._native)
+      : super(ByteData.sublistView(
+            _native.ref.data.asTypedList(_native.ref.size)));
+
+  @override
+  Font fontAt(int address) =>
+      FontFFI.fromAddress(Pointer<Void>.fromAddress(address));
+
+  @override
+  void dispose() {
+    if (_native == nullptr) {
+      return;
+    }
+    deleteTextLayout(_native);
+    _native = nullptr;
+  }
 }
 
 /// A Font created and owned by Dart code. User is expected to call
@@ -803,6 +803,32 @@ abstract interface class ViewModelInstanceList
   ///
   /// Throws a [RangeError] if the [index] is out of bounds.
   void operator []=(int index, ViewModelInstance value);
+
+  /// Replaces the contents of the list with [instances] in a single edit.
+  ///
+  /// Instances that were already in the list keep their bound artboards and
+  /// state machines, so reordering or filtering a large list does not
+  /// recreate them.
+  ///
+  /// Example:
+  /// ```dart
+  /// final list = viewModelInstance.list("list");
+  /// list.replaceAll(sortedInstances);
+  /// ```
+  void replaceAll(Iterable<ViewModelInstance> instances);
+
+  /// Applies all the edits made in [edits] as one change, so bound lists are
+  /// reconciled and laid out once instead of once per edit.
+  ///
+  /// Example:
+  /// ```dart
+  /// final list = viewModelInstance.list("list");
+  /// list.batch(() {
+  ///   list.removeAt(0);
+  ///   list.add(instance);
+  /// });
+  /// ```
+  void batch(void Function() edits);
 }
 
 abstract interface class ViewModelInstanceArtboard
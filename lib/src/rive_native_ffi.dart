@@ -288,12 +288,20 @@ class _RiveNativeViewRenderObject
       markNeedsPaint();
       return;
     }
-    final shouldAdvance = painter.paint(
-      _renderTexture,
-      devicePixelRatio,
-      ui.Size(width, height),
-      elapsedSeconds,
-    );
+    final bool shouldAdvance;
+    try {
+      shouldAdvance = painter.paint(
+        _renderTexture,
+        devicePixelRatio,
+        ui.Size(width, height),
+        elapsedSeconds,
+      );
+    } catch (_) {
+      // clear() began a frame on the native side; submit it anyway so its
+      // render target is handed back.
+      _renderTexture.flush(devicePixelRatio);
+      rethrow;
+    }
     if (shouldAdvance && shouldAdvance != _shouldAdvance) {
       restartTickerIfStopped();
     }
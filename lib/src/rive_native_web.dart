@@ -347,7 +347,7 @@ class RiveWasm {
   }
 
   static late js.JSNumber scratchBufferPtr;
-  static late js.JSFunction appendCommands;
+  static late js.JSFunction appendPathData;
   static late js.JSFunction makeRenderPath;
   static late js.JSFunction renderPathSetFillRule;
   static late js.JSFunction appendRenderPath;
@@ -434,6 +434,8 @@ class RiveWasm {
   static late js.JSFunction vmiListRuntimeRemoveInstanceAt;
   static late js.JSFunction vmiListRuntimeInstanceAt;
   static late js.JSFunction vmiListRuntimeSwap;
+  static late js.JSFunction vmiListRuntimeBeginBatch;
+  static late js.JSFunction vmiListRuntimeEndBatch;
   static late js.JSFunction vmiRuntimeGetArtboardProperty;
   static late js.JSFunction setVMIArtboardRuntimeValue;
   static late js.JSFunction vmiValueRuntimeHasChanged;
@@ -697,7 +699,7 @@ class RiveWasm {
     addRawPathWithTransformClockwise =
         module['_addRawPathWithTransformClockwise'] as js.JSFunction;
     addPathBackwards = module['_addPathBackwards'] as js.JSFunction;
-    appendCommands = module['_appendCommands'] as js.JSFunction;
+    appendPathData = module['_appendPathData'] as js.JSFunction;
     makeRenderPath = module['_makeRenderPath'] as js.JSFunction;
     renderPathSetFillRule = module['_renderPathSetFillRule'] as js.JSFunction;
     appendRenderPath = module['_appendRenderPath'] as js.JSFunction;
@@ -860,6 +862,9 @@ class RiveWasm {
     vmiListRuntimeInstanceAt =
         module['_vmiListRuntimeInstanceAt'] as js.JSFunction;
     vmiListRuntimeSwap = module['_vmiListRuntimeSwap'] as js.JSFunction;
+    vmiListRuntimeBeginBatch =
+        module['_vmiListRuntimeBeginBatch'] as js.JSFunction;
+    vmiListRuntimeEndBatch = module['_vmiListRuntimeEndBatch'] as js.JSFunction;
     setVMIAssetImageRuntimeValue =
         module['_setVMIAssetImageRuntimeValue'] as js.JSFunction;
     vmiRuntimeGetArtboardProperty =
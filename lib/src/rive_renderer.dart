@@ -343,6 +343,16 @@ abstract class VertexRenderBuffer extends RenderBuffer {
 
 abstract class FlutterRenderer {
   flutter.Canvas get canvas;
+
+  /// When true, renderers made afterwards record the whole frame into a
+  /// single native command buffer that is played back onto [canvas] by
+  /// [flush] (and on dispose), instead of calling back into Dart for every
+  /// draw. Only applies to native platforms.
+  static bool recordCommands = false;
+
+  /// Plays back any recorded commands onto [canvas]. Call before drawing to
+  /// [canvas] directly while recording.
+  void flush();
 }
 
 enum Fit {
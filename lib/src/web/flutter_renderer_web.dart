@@ -31,6 +31,10 @@ class FlutterRendererWeb extends WebRiveRenderer implements FlutterRenderer {
     }
   }
 
+  // Web draws through the wasm callbacks directly, nothing is recorded.
+  @override
+  void flush() {}
+
   @override
   void dispose() {
     RiveWasm.deleteFlutterRenderer.callAsFunction(null, jsRendererPtr);
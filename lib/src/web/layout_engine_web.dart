@@ -719,3 +719,47 @@ LayoutNode makeLayoutNode() =>
     LayoutNodeWasm((_makeYogaNode.callAsFunction() as js.JSNumber).toDartInt);
 
 LayoutNode makeLayoutNodeExternal(dynamic ref) => LayoutNodeWasm(ref as int);
+
+/// Each wasm call is cheap compared to an FFI transition, so the batch simply
+/// replays the edits through the per-node API.
+class LayoutTreeBatchWasm extends LayoutTreeBatch {
+  final List<void Function()> _ops = [];
+
+  @override
+  void insertChild(LayoutNode parent, LayoutNode child, int index) =>
+      _ops.add(() => parent.insertChild(child, index));
+
+  @override
+  void removeChild(LayoutNode parent, LayoutNode child) =>
+      _ops.add(() => parent.removeChild(child));
+
+  @override
+  void clearChildren(LayoutNode parent) => _ops.add(parent.clearChildren);
+
+  @override
+  void setStyle(LayoutNode node, LayoutStyle style) =>
+      _ops.add(() => node.setStyle(style));
+
+  @override
+  void setNodeType(LayoutNode node, LayoutNodeType type) =>
+      _ops.add(() => node.nodeType = type);
+
+  @override
+  void markDirty(LayoutNode node) => _ops.add(node.markDirty);
+
+  @override
+  void apply() {
+    for (final op in _ops) {
+      op();
+    }
+    _ops.clear();
+  }
+
+  @override
+  void dispose() => _ops.clear();
+}
+
+LayoutTreeBatch makeLayoutTreeBatch() => LayoutTreeBatchWasm();
+
+List<Layout> getLayouts(List<LayoutNode> nodes) =>
+    nodes.map((node) => node.layout).toList(growable: false);
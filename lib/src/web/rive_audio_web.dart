@@ -300,6 +300,9 @@ StreamingAudioSource loadAudioSource(Uint8List bytes) {
   );
 }
 
+// The wasm decode worker's pool is created with the module.
+void setDecodeThreadCount(int threadCount) {}
+
 AudioEngine? initAudioDevice(int channels, int sampleRate) {
   var engine = (_makeAudioEngine.callAsFunction(
     null,
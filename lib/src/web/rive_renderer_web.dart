@@ -1,4 +1,5 @@
 import 'dart:js_interop' as js;
+import 'dart:math' as math;
 import 'dart:typed_data';
 import 'dart:ui' as ui;
 
@@ -352,12 +353,40 @@ class WebRenderPath extends BufferedRenderPath {
     _renderPath = null;
   }
 
-  @override
-  ByteData get scratchBufferByteData => RiveWasm.scratchBufferByteData;
+  // Staging memory for handing whole paths to wasm, grown as needed and
+  // reused across paths.
+  static int _pathDataPtr = 0;
+  static int _pathDataCapacity = 0;
+
+  static int _ensurePathDataBuffer(int size) {
+    if (size > _pathDataCapacity) {
+      if (_pathDataPtr != 0) {
+        RiveWasm.deleteBuffer.callAsFunction(null, _pathDataPtr.toJS);
+      }
+      _pathDataCapacity = math.max(size, _pathDataCapacity * 2);
+      _pathDataPtr = (RiveWasm.allocateBuffer
+              .callAsFunction(null, _pathDataCapacity.toJS) as js.JSNumber)
+          .toDartInt;
+    }
+    return _pathDataPtr;
+  }
 
   @override
-  void appendCommands(int commandCount) => RiveWasm.appendCommands
-      .callAsFunction(null, RiveWasm.scratchBufferPtr, commandCount.toJS);
+  void appendPathData(List<int> verbs, List<double> points) {
+    // Points go first to keep them float aligned.
+    final pointsSize = points.length * 4;
+    final pointsPtr = _ensurePathDataBuffer(pointsSize + verbs.length);
+    final verbsPtr = pointsPtr + pointsSize;
+    RiveWasm.heapViewF32(pointsPtr, points.length).setAll(0, points);
+    RiveWasm.heap(verbsPtr, verbs.length).setAll(0, verbs);
+    RiveWasm.appendPathData.callAsFunction(
+      null,
+      verbsPtr.toJS,
+      verbs.length.toJS,
+      pointsPtr.toJS,
+      (points.length ~/ 2).toJS,
+    );
+  }
 
   @override
   void updateRenderPath() {
@@ -24,6 +24,8 @@ late js.JSFunction _setFallbackFonts;
 late js.JSFunction _deleteShapeResult;
 late js.JSFunction _breakLines;
 late js.JSFunction _deleteLines;
+late js.JSFunction _shapeAndBreakText;
+late js.JSFunction _deleteTextLayout;
 late js.JSFunction _fontFeatures;
 late js.JSFunction _fontAscent;
 late js.JSFunction _fontDescent;
@@ -49,6 +51,8 @@ class TextEngine {
     _deleteShapeResult = module['deleteShapeResult'] as js.JSFunction;
     _breakLines = module['breakLines'] as js.JSFunction;
     _deleteLines = module['deleteLines'] as js.JSFunction;
+    _shapeAndBreakText = module['shapeAndBreakText'] as js.JSFunction;
+    _deleteTextLayout = module['deleteTextLayout'] as js.JSFunction;
     _fontFeatures = module['fontFeatures'] as js.JSFunction;
     _fontAscent = module['fontAscent'] as js.JSFunction;
     _fontDescent = module['fontDescent'] as js.JSFunction;
@@ -483,6 +487,17 @@ class GlyphRunWasm extends GlyphRun {
   }
 }
 
+/// A [TextLayout] over a copy of the native buffer, nothing to release.
+class TextLayoutWasm extends TextLayout {
+  TextLayoutWasm._(super.data);
+
+  @override
+  Font fontAt(int address) => FontWasm.fromAddress(address);
+
+  @override
+  void dispose() {}
+}
+
 /// A Font reference that should not be explicitly disposed by the user.
 /// Returned while shaping.
 class FontWasm extends Font {
@@ -529,12 +544,7 @@ class FontWasm extends Font {
 
   static const int sizeOfNativeTextRun = 28;
 
-  @override
-  TextShapeResult computeShape(
-    List<int> codeUnits,
-    List<TextRun> runs, {
-    TextDirection? direction,
-  }) {
+  static Uint8List _writeRuns(List<TextRun> runs) {
     var writer = BinaryWriter(
       alignment: runs.length * sizeOfNativeTextRun,
     );
@@ -549,17 +559,58 @@ class FontWasm extends Font {
       writer.writeUint8(0); // dir (unknown at this point)
       writer.writeUint8(0); // padding to word align struct
     }
+    return writer.uint8Buffer;
+  }
 
+  static int _directionLevel(TextDirection? direction) => direction == null
+      ? -1
+      : direction == TextDirection.ltr
+          ? 0
+          : 1;
+
+  @override
+  TextLayout? computeLayout(
+    List<int> codeUnits,
+    List<TextRun> runs, {
+    required double width,
+    required TextAlign align,
+    required TextWrap wrap,
+    required bool glyphOutlines,
+    TextDirection? direction,
+  }) {
+    var layoutPtr = (_shapeAndBreakText.callAsFunctionEx(
+      null,
+      Uint32List.fromList(codeUnits).toJS,
+      _writeRuns(runs).toJS,
+      _directionLevel(direction).toJS,
+      width.toJS,
+      align.index.toJS,
+      wrap.index.toJS,
+      (glyphOutlines ? TextLayout.glyphOutlinesFlag : 0).toJS,
+    ) as js.JSNumber)
+        .toDartInt;
+    if (layoutPtr == 0) {
+      return null;
+    }
+    // Copy the buffer out in one go so it survives the WASM heap growing,
+    // then release the native side right away.
+    var array = RiveWasm.heapDataView(layoutPtr).readDynamicArray(0);
+    var bytes = Uint8List.fromList(RiveWasm.heap(array.ptr, array.size));
+    _deleteTextLayout.callAsFunction(null, layoutPtr.toJS);
+    return TextLayoutWasm._(ByteData.sublistView(bytes));
+  }
+
+  @override
+  TextShapeResult computeShape(
+    List<int> codeUnits,
+    List<TextRun> runs, {
+    TextDirection? direction,
+  }) {
     var result = _shapeText.callAsFunction(
         null,
         Uint32List.fromList(codeUnits).toJS,
-        writer.uint8Buffer.toJS,
-        (direction == null
-                ? -1
-                : direction == TextDirection.ltr
-                    ? 0
-                    : 1)
-            .toJS) as js.JSObject;
+        _writeRuns(runs).toJS,
+        _directionLevel(direction).toJS) as js.JSObject;
     final rawResult = (result['rawResult'] as js.JSNumber).toDartInt;
     final results = (result['results'] as js.JSDataView).toDart;
 
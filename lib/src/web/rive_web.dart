@@ -1094,6 +1094,26 @@ class WebViewModelInstanceListRuntime extends WebViewModelInstanceValueRuntime
     covariant WebViewModelInstanceRuntime value,
   ) =>
       insert(index, value);
+
+  @override
+  void replaceAll(Iterable<ViewModelInstance> instances) => batch(() {
+        for (int index = length - 1; index >= 0; index--) {
+          removeAt(index);
+        }
+        for (final instance in instances) {
+          add(instance);
+        }
+      });
+
+  @override
+  void batch(void Function() edits) {
+    RiveWasm.vmiListRuntimeBeginBatch.callAsFunction(null, _pointer.toJS);
+    try {
+      edits();
+    } finally {
+      RiveWasm.vmiListRuntimeEndBatch.callAsFunction(null, _pointer.toJS);
+    }
+  }
 }
 
 class WebRiveArtboard extends Artboard {
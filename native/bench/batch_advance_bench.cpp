@@ -0,0 +1,225 @@
+/*
+ * Copyright 2025 Rive
+ */
+
+// Measures how long a frame of stateMachineInstanceBatchAdvanceAndRender takes
+// for many instances of the same state machine, against advancing and drawing
+// them one by one on the calling thread.
+//
+//   batch_advance_bench [--instances N] [--frames N] [file.riv]
+//
+// file.riv defaults to test/assets/off_road_car.riv, and its default artboard
+// needs a state machine. Draws go to a Flutter renderer whose callbacks are
+// no-ops, so only native-side work is measured. In recording mode the workers
+// record each artboard's draw and the calling thread only appends them.
+//
+// rive_binding.cpp needs the runtime built with the same options as
+// rive_native (--with_rive_tools --with_rive_text --with_rive_layout).
+
+#include "rive/factory.hpp"
+#include "rive/file.hpp"
+#include "rive/renderer.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <vector>
+
+using namespace rive;
+
+class FlutterFactory;
+class FlutterRenderer;
+class WrappedArtboard;
+class WrappedStateMachine;
+
+typedef bool (*AssetLoaderCallback)(FileAsset* asset,
+                                    const uint8_t* bytes,
+                                    const size_t size);
+
+extern "C"
+{
+FlutterFactory* makeFlutterFactory();
+void deleteFlutterFactory(FlutterFactory*);
+FlutterRenderer* makeFlutterRenderer(FlutterFactory*);
+void deleteFlutterRenderer(FlutterRenderer*);
+void flutterRendererSetRecording(FlutterRenderer*, bool);
+uint64_t flutterRendererCommandsSize(FlutterRenderer*);
+const uint8_t* flutterRendererTakeCommands(FlutterRenderer*);
+void processScheduledDeletions(FlutterFactory*);
+
+void* loadRiveFile(const uint8_t* bytes,
+                   uint64_t length,
+                   Factory* factory,
+                   AssetLoaderCallback assetLoader);
+void deleteRiveFile(File*);
+WrappedArtboard* riveFileArtboardDefault(File*, bool frameOrigin);
+void deleteArtboardInstance(WrappedArtboard*);
+WrappedStateMachine* riveArtboardStateMachineDefault(WrappedArtboard*);
+void deleteStateMachineInstance(WrappedStateMachine*);
+bool stateMachineInstanceAdvanceAndApply(WrappedStateMachine*,
+                                         float elapsedSeconds);
+void artboardDraw(WrappedArtboard*, Renderer*);
+void stateMachineInstanceBatchAdvanceAndRender(WrappedStateMachine** smi,
+                                               uint64_t count,
+                                               float elapsedSeconds,
+                                               Renderer* renderer);
+}
+Factory* flutterFactoryBase(FlutterFactory*);
+Renderer* flutterRendererBase(FlutterRenderer*);
+void initNoOpFactoryCallbacks(FlutterFactory*);
+
+static double seconds_now()
+{
+    return std::chrono::duration<double>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+enum class Mode
+{
+    serial,
+    batch,
+    batchRecording,
+};
+
+static const char* modeName(Mode mode)
+{
+    switch (mode)
+    {
+        case Mode::serial:
+            return "serial";
+        case Mode::batch:
+            return "batch, callbacks";
+        case Mode::batchRecording:
+            return "batch, recorded";
+    }
+    return "";
+}
+
+int main(int argc, const char** argv)
+{
+    int instanceCount = 1000;
+    int frames = 100;
+    const char* filename = "test/assets/off_road_car.riv";
+    for (int i = 1; i < argc; ++i)
+    {
+        if (!strcmp(argv[i], "--instances") && i + 1 < argc)
+        {
+            instanceCount = atoi(argv[++i]);
+        }
+        else if (!strcmp(argv[i], "--frames") && i + 1 < argc)
+        {
+            frames = atoi(argv[++i]);
+        }
+        else if (argv[i][0] != '-')
+        {
+            filename = argv[i];
+        }
+        else
+        {
+            fprintf(stderr,
+                    "usage: batch_advance_bench [--instances N] [--frames N] "
+                    "[file.riv]\n");
+            return 1;
+        }
+    }
+
+    std::ifstream stream(filename, std::ios::binary);
+    if (!stream)
+    {
+        fprintf(stderr, "failed to open %s\n", filename);
+        return 1;
+    }
+    std::vector<uint8_t> bytes(std::istreambuf_iterator<char>(stream), {});
+
+    FlutterFactory* flutterFactory = makeFlutterFactory();
+    initNoOpFactoryCallbacks(flutterFactory);
+    auto file = static_cast<File*>(loadRiveFile(bytes.data(),
+                                                bytes.size(),
+                                                flutterFactoryBase(
+                                                    flutterFactory),
+                                                nullptr));
+    if (file == nullptr)
+    {
+        fprintf(stderr, "failed to import %s\n", filename);
+        return 1;
+    }
+
+    std::vector<WrappedArtboard*> artboards;
+    std::vector<WrappedStateMachine*> stateMachines;
+    for (int i = 0; i < instanceCount; ++i)
+    {
+        WrappedArtboard* artboard = riveFileArtboardDefault(file, true);
+        WrappedStateMachine* stateMachine =
+            riveArtboardStateMachineDefault(artboard);
+        if (stateMachine == nullptr)
+        {
+            fprintf(stderr, "%s has no state machine\n", filename);
+            return 1;
+        }
+        artboards.push_back(artboard);
+        stateMachines.push_back(stateMachine);
+    }
+
+    printf("%d instances of %s\n", instanceCount, filename);
+    for (Mode mode : {Mode::serial, Mode::batch, Mode::batchRecording})
+    {
+        FlutterRenderer* flutterRenderer = makeFlutterRenderer(flutterFactory);
+        Renderer* renderer = flutterRendererBase(flutterRenderer);
+        flutterRendererSetRecording(flutterRenderer,
+                                    mode == Mode::batchRecording);
+        double best = std::numeric_limits<double>::max();
+        size_t recordedBytes = 0;
+        // The first frame uploads every path and paint; time the rest.
+        for (int frame = 0; frame <= frames; ++frame)
+        {
+            double start = seconds_now();
+            if (mode == Mode::serial)
+            {
+                for (int i = 0; i < instanceCount; ++i)
+                {
+                    stateMachineInstanceAdvanceAndApply(stateMachines[i],
+                                                        1.0f / 60);
+                    artboardDraw(artboards[i], renderer);
+                }
+            }
+            else
+            {
+                stateMachineInstanceBatchAdvanceAndRender(stateMachines.data(),
+                                                          instanceCount,
+                                                          1.0f / 60,
+                                                          renderer);
+            }
+            recordedBytes =
+                (size_t)flutterRendererCommandsSize(flutterRenderer);
+            flutterRendererTakeCommands(flutterRenderer);
+            if (frame > 0)
+            {
+                best = std::min(best, seconds_now() - start);
+            }
+        }
+        printf("  %-17s %8.2f ms/frame", modeName(mode), best * 1e3);
+        if (mode == Mode::batchRecording)
+        {
+            printf(" %8zu bytes/frame", recordedBytes);
+        }
+        printf("\n");
+        deleteFlutterRenderer(flutterRenderer);
+        processScheduledDeletions(flutterFactory);
+    }
+
+    for (int i = 0; i < instanceCount; ++i)
+    {
+        deleteStateMachineInstance(stateMachines[i]);
+        deleteArtboardInstance(artboards[i]);
+    }
+    deleteRiveFile(file);
+    processScheduledDeletions(flutterFactory);
+    deleteFlutterFactory(flutterFactory);
+    return 0;
+}
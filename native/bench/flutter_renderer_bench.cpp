@@ -0,0 +1,191 @@
+/*
+ * Copyright 2025 Rive
+ */
+
+// Measures the native cost of handing a frame to Flutter: either one callback
+// per draw call (the default FlutterRenderer), or encoding the frame into a
+// recorded command buffer. The callbacks are no-ops, so neither number
+// includes the Dart side; they compare what each mode costs before Dart sees
+// any of it.
+//
+//   flutter_renderer_bench [--draws N] [--segments N] [--frames N] [--static]
+//
+// Each draw is save, transform, drawPath and restore of its own path of
+// --segments cubics. Paths are rewound and rebuilt every frame, like animated
+// shapes; with --static they are rebuilt into the same geometry, so unchanged
+// paths can be skipped. Only the draw calls are timed, not rebuilding paths.
+
+#include "rive/factory.hpp"
+#include "rive/renderer.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+using namespace rive;
+
+class FlutterFactory;
+class FlutterRenderer;
+
+extern "C"
+{
+FlutterFactory* makeFlutterFactory();
+void deleteFlutterFactory(FlutterFactory*);
+FlutterRenderer* makeFlutterRenderer(FlutterFactory*);
+void deleteFlutterRenderer(FlutterRenderer*);
+void flutterRendererSetRecording(FlutterRenderer*, bool);
+uint64_t flutterRendererCommandsSize(FlutterRenderer*);
+const uint8_t* flutterRendererTakeCommands(FlutterRenderer*);
+void processScheduledDeletions(FlutterFactory*);
+}
+Factory* flutterFactoryBase(FlutterFactory*);
+Renderer* flutterRendererBase(FlutterRenderer*);
+void initNoOpFactoryCallbacks(FlutterFactory*);
+
+static double seconds_now()
+{
+    return std::chrono::duration<double>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+struct Shape
+{
+    rcp<RenderPath> path;
+    rcp<RenderPaint> paint;
+};
+
+static void build_path(RenderPath* path, int segments, float phase)
+{
+    path->rewind();
+    path->moveTo(0, 0);
+    for (int i = 0; i < segments; ++i)
+    {
+        float x = (float)(i + 1) * 10;
+        float y = std::sin(phase + (float)i) * 20;
+        path->cubicTo(x - 7, y + 5, x - 3, y - 5, x, y);
+    }
+    path->close();
+}
+
+// Rebuilds every path, then times drawing them. Returns the time in seconds
+// and sets bytes to the recorded size (0 if not recording).
+static double draw_frame(FlutterRenderer* flutterRenderer,
+                         std::vector<Shape>& shapes,
+                         int segments,
+                         int frame,
+                         bool isStatic,
+                         size_t* bytes)
+{
+    Renderer* renderer = flutterRendererBase(flutterRenderer);
+    float phase = isStatic ? 0.0f : (float)frame * 0.1f;
+    for (size_t i = 0; i < shapes.size(); ++i)
+    {
+        build_path(shapes[i].path.get(), segments, phase + (float)i);
+    }
+    double start = seconds_now();
+    for (size_t i = 0; i < shapes.size(); ++i)
+    {
+        renderer->save();
+        renderer->transform(Mat2D(1, 0, 0, 1, (float)i, (float)frame));
+        renderer->drawPath(shapes[i].path.get(), shapes[i].paint.get());
+        renderer->restore();
+    }
+    *bytes = (size_t)flutterRendererCommandsSize(flutterRenderer);
+    flutterRendererTakeCommands(flutterRenderer);
+    return seconds_now() - start;
+}
+
+int main(int argc, const char** argv)
+{
+    int drawCount = 1000;
+    int segments = 16;
+    int frames = 200;
+    bool isStatic = false;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (!strcmp(argv[i], "--draws") && i + 1 < argc)
+        {
+            drawCount = atoi(argv[++i]);
+        }
+        else if (!strcmp(argv[i], "--segments") && i + 1 < argc)
+        {
+            segments = atoi(argv[++i]);
+        }
+        else if (!strcmp(argv[i], "--frames") && i + 1 < argc)
+        {
+            frames = atoi(argv[++i]);
+        }
+        else if (!strcmp(argv[i], "--static"))
+        {
+            isStatic = true;
+        }
+        else
+        {
+            fprintf(stderr,
+                    "usage: flutter_renderer_bench [--draws N] [--segments N] "
+                    "[--frames N] [--static]\n");
+            return 1;
+        }
+    }
+
+    FlutterFactory* flutterFactory = makeFlutterFactory();
+    initNoOpFactoryCallbacks(flutterFactory);
+    Factory* factory = flutterFactoryBase(flutterFactory);
+
+    printf("%d draws of %d cubics, %s paths\n",
+           drawCount,
+           segments,
+           isStatic ? "static" : "animated");
+    for (bool recording : {false, true})
+    {
+        FlutterRenderer* renderer = makeFlutterRenderer(flutterFactory);
+        flutterRendererSetRecording(renderer, recording);
+        std::vector<Shape> shapes(drawCount);
+        for (Shape& shape : shapes)
+        {
+            shape.path = factory->makeEmptyRenderPath();
+            shape.paint = factory->makeRenderPaint();
+            shape.paint->color(0xff336699);
+        }
+
+        // The first frame uploads every path and paint; time the rest.
+        size_t bytes = 0;
+        draw_frame(renderer, shapes, segments, 0, isStatic, &bytes);
+        double best = std::numeric_limits<double>::max();
+        for (int frame = 1; frame <= frames; ++frame)
+        {
+            double time =
+                draw_frame(renderer, shapes, segments, frame, isStatic, &bytes);
+            best = std::min(best, time);
+        }
+        if (recording)
+        {
+            printf("  recorded:  %8.1f us/frame %6.1f ns/draw %8zu "
+                   "bytes/frame, 1 callback/frame\n",
+                   best * 1e6,
+                   best * 1e9 / drawCount,
+                   bytes);
+        }
+        else
+        {
+            // save, transform, drawPath, restore and, when the geometry
+            // changed, a path update.
+            printf("  callbacks: %8.1f us/frame %6.1f ns/draw %8d "
+                   "callbacks/frame\n",
+                   best * 1e6,
+                   best * 1e9 / drawCount,
+                   drawCount * (isStatic ? 4 : 5));
+        }
+        shapes.clear();
+        deleteFlutterRenderer(renderer);
+        processScheduledDeletions(flutterFactory);
+    }
+    deleteFlutterFactory(flutterFactory);
+    return 0;
+}
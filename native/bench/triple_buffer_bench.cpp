@@ -0,0 +1,180 @@
+/*
+ * Copyright 2025 Rive
+ */
+
+// Measures the cost and latency of handing frames through ReadWriteRing.
+//
+//   triple_buffer_bench [--frames N] [--gpu-us N]
+//
+// First, the cost of one nextWrite, nextRead and currentRead with no
+// contention. Then the ring is shared by three threads, like the plugins do: a
+// renderer that starts a frame as soon as it can, a "GPU" that completes each
+// one --gpu-us microseconds after it was submitted, and a reader that spins on
+// currentRead. It reports how long the renderer waited for a target and how
+// long a completed frame took to reach the reader.
+
+#include "rive_native/read_write_ring.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+static double microseconds(Clock::duration duration)
+{
+    return std::chrono::duration<double, std::micro>(duration).count();
+}
+
+static void printPercentiles(const char* label,
+                             std::vector<Clock::duration>& samples)
+{
+    if (samples.empty())
+    {
+        printf("  %-26s no samples\n", label);
+        return;
+    }
+    std::sort(samples.begin(), samples.end());
+    auto at = [&samples](double fraction) {
+        return microseconds(samples[(size_t)(fraction * (samples.size() - 1))]);
+    };
+    printf("  %-26s p50 %8.2f us  p99 %8.2f us  max %8.2f us\n",
+           label,
+           at(0.5),
+           at(0.99),
+           at(1.0));
+}
+
+static void benchUncontended(int frames)
+{
+    ReadWriteRing ring;
+    Clock::time_point start = Clock::now();
+    uint32_t sum = 0;
+    for (int i = 0; i < frames; i++)
+    {
+        sum += ring.nextWrite();
+        sum += ring.nextRead();
+        sum += ring.currentRead();
+    }
+    double elapsed = microseconds(Clock::now() - start);
+    printf("  uncontended                %8.1f ns/frame (%u)\n",
+           elapsed * 1000 / frames,
+           sum % 2);
+}
+
+static void benchContended(int frames, int gpuMicroseconds)
+{
+    ReadWriteRing ring;
+    // When each target was completed, for the reader to measure latency.
+    std::atomic<int64_t> completedAt[ReadWriteRing::ringSize];
+    for (auto& time : completedAt)
+    {
+        time = 0;
+    }
+
+    std::mutex gpuMutex;
+    std::condition_variable gpuCond;
+    // Targets submitted to the GPU, and when.
+    std::deque<std::pair<uint32_t, Clock::time_point>> submitted;
+    std::atomic<bool> done{false};
+
+    std::thread gpuThread([&] {
+        for (int i = 0; i < frames; i++)
+        {
+            std::pair<uint32_t, Clock::time_point> frame;
+            {
+                std::unique_lock<std::mutex> lock(gpuMutex);
+                gpuCond.wait(lock, [&] { return !submitted.empty(); });
+                frame = submitted.front();
+                submitted.pop_front();
+            }
+            std::this_thread::sleep_until(
+                frame.second + std::chrono::microseconds(gpuMicroseconds));
+            // The target still belongs to the renderer until nextRead
+            // publishes it, so stamping it first can't race the reader.
+            completedAt[frame.first].store(
+                Clock::now().time_since_epoch().count(),
+                std::memory_order_release);
+            ring.nextRead();
+        }
+    });
+
+    std::vector<Clock::duration> displayLatency;
+    displayLatency.reserve(frames);
+    std::thread readerThread([&] {
+        int64_t lastSeen = 0;
+        while (!done.load(std::memory_order_acquire))
+        {
+            uint32_t slot = ring.currentRead();
+            int64_t completed =
+                completedAt[slot].load(std::memory_order_acquire);
+            if (completed != 0 && completed != lastSeen)
+            {
+                lastSeen = completed;
+                displayLatency.push_back(
+                    Clock::now().time_since_epoch() -
+                    Clock::duration(completed));
+            }
+        }
+    });
+
+    std::vector<Clock::duration> renderWait;
+    renderWait.reserve(frames);
+    for (int i = 0; i < frames; i++)
+    {
+        Clock::time_point start = Clock::now();
+        uint32_t slot = ring.nextWrite();
+        Clock::time_point acquired = Clock::now();
+        renderWait.push_back(acquired - start);
+        {
+            std::unique_lock<std::mutex> lock(gpuMutex);
+            submitted.emplace_back(slot, acquired);
+        }
+        gpuCond.notify_one();
+    }
+    gpuThread.join();
+    done = true;
+    readerThread.join();
+
+    printPercentiles("renderer wait for target", renderWait);
+    printPercentiles("completed to displayed", displayLatency);
+    printf("  displayed %zu of %d frames\n", displayLatency.size(), frames);
+}
+
+int main(int argc, const char** argv)
+{
+    int frames = 20000;
+    int gpuMicroseconds = 100;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (!strcmp(argv[i], "--frames") && i + 1 < argc)
+        {
+            frames = atoi(argv[++i]);
+        }
+        else if (!strcmp(argv[i], "--gpu-us") && i + 1 < argc)
+        {
+            gpuMicroseconds = atoi(argv[++i]);
+        }
+        else
+        {
+            fprintf(stderr,
+                    "usage: triple_buffer_bench [--frames N] [--gpu-us N]\n");
+            return 1;
+        }
+    }
+    printf("ReadWriteRing, %d frames, %d us per GPU frame\n",
+           frames,
+           gpuMicroseconds);
+    benchUncontended(frames);
+    benchContended(frames, gpuMicroseconds);
+    return 0;
+}
@@ -1,23 +1,35 @@
 #ifndef _RIVE_READ_WRITE_RING_HPP
 #define _RIVE_READ_WRITE_RING_HPP
+#include "rive_native/triple_buffer.hpp"
+#include <atomic>
 #include <cstdint>
-#include <mutex>
+
+// Hands render target indices between the renderer (nextWrite), the GPU
+// completion handler (nextRead) and the texture reader (currentRead). The
+// reader never blocks or is blocked. The renderer waits for the GPU only when
+// every other target is still in flight, and never for longer than it takes to
+// presume the oldest frame abandoned (see TripleBufferFrames).
 class ReadWriteRing
 {
 public:
     static constexpr uint32_t ringSize = 3;
 
     ReadWriteRing();
+    // Picks the target to render the next frame into, waiting while every
+    // target that isn't being displayed is still in flight. Every frame it
+    // starts must be completed with nextRead, or it holds its target until it
+    // is presumed abandoned.
     uint32_t nextWrite();
     uint32_t currentWrite();
+    // Marks the oldest frame in flight as complete and makes it the latest.
     uint32_t nextRead();
+    // The target to display, switching to the latest completed frame.
     uint32_t currentRead();
 
 private:
-    std::mutex m_mutex;
-    uint32_t m_size;
-    uint32_t m_read;
-    uint32_t m_write;
+    TripleBuffer m_buffer;
+    TripleBufferFrames m_frames;
+    std::atomic<uint32_t> m_write;
 };
 
-#endif
\ No newline at end of file
+#endif
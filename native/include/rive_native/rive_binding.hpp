@@ -6,6 +6,9 @@
 #include "rive/animation/linear_animation_instance.hpp"
 #include "rive/animation/state_machine_instance.hpp"
 
+#include <memory>
+#include <vector>
+
 class WrappedArtboard;
 typedef void (*EventCallback)(WrappedArtboard* wrapper, uint32_t);
 
@@ -54,3 +57,24 @@ private:
     std::unique_ptr<rive::ArtboardInstance> m_artboard;
     std::vector<WrappedDataBind*> m_dataBinds;
 };
+
+// Records draws into a private command list, typically on a worker thread, so
+// that they can later be appended in order to the renderer it was made for.
+class DrawRecorder
+{
+public:
+    virtual ~DrawRecorder() {}
+    virtual rive::Renderer* renderer() = 0;
+    // Moves everything recorded since the last call into recording (replacing
+    // its contents) and starts a new list. The recorder never touches
+    // recording again, so another thread may append it while this one keeps
+    // recording.
+    virtual void takeRecording(std::vector<uint8_t>* recording) = 0;
+    // Appends a recording taken from any recorder for the same target to the
+    // target renderer.
+    virtual void appendTo(const std::vector<uint8_t>& recording) = 0;
+};
+
+// Returns a recorder for target, or null if target can't merge recorded draws
+// (only Flutter renderers in recording mode can).
+std::unique_ptr<DrawRecorder> makeDrawRecorder(rive::Renderer* target);
@@ -1,55 +1,59 @@
 #ifndef _RIVE_SWAPCHAIN_HPP
 #define _RIVE_SWAPCHAIN_HPP
 
-#include <deque>
-#include <mutex>
-#include <condition_variable>
+#include "rive_native/triple_buffer.hpp"
 
+#include <utility>
+#include <vector>
+
+// Rotates render textures between the renderer and the presenter. Textures
+// live in fixed slots whose ownership is handed off through a TripleBuffer,
+// so presenting a frame never waits on the presenter reading the previous one
+// and vice versa.
 template <typename T> class Swapchain
 {
 public:
     template <typename... RenderTextures>
     Swapchain(T&& presentingTexture, RenderTextures&&... renderTextures) :
-        m_presentingTexture(std::move(presentingTexture))
+        m_buffer(1 + sizeof...(RenderTextures), 0), m_frames(&m_buffer)
     {
+        m_textures.reserve(1 + sizeof...(RenderTextures));
+        m_textures.push_back(std::move(presentingTexture));
         initRenderTextures(std::forward<RenderTextures>(renderTextures)...);
     }
 
+    // Textures must be presented in the order they were acquired. Acquiring
+    // and presenting may happen on different threads. Blocks while every
+    // texture is either being presented or still in flight.
     T acquireRenderTexture()
     {
-        std::unique_lock lock(m_mutex);
-        while (m_renderTextures.empty())
-        {
-            m_cond.wait(lock);
-        }
-        T ret = std::move(m_renderTextures.front());
-        m_renderTextures.pop_front();
-        return ret;
+        uint32_t slot = m_frames.begin();
+        assert(slot != TripleBuffer::noSlot);
+        return std::move(m_textures[slot]);
     }
 
     void presentTexture(T&& texture)
     {
-        {
-            std::lock_guard lock(m_mutex);
-            m_renderTextures.push_back(std::move(m_presentingTexture));
-            m_presentingTexture = std::move(texture);
-        }
-        m_cond.notify_all();
+        uint32_t slot = m_frames.publishOldest([&](uint32_t written) {
+            m_textures[written] = std::move(texture);
+        });
+        assert(slot != TripleBuffer::noSlot);
+        (void)slot;
     }
 
-    // Used to access the presentingTexture with a lock on the mutex.
+    // Pins the latest presented texture for reading. Only one presenter may
+    // hold one at a time; it does not block the renderer.
     class PresentingTextureLock
     {
     public:
-        PresentingTextureLock(Swapchain* thisPtr) : m_this(thisPtr)
-        {
-            m_this->m_mutex.lock();
-        }
-        const T& texture() { return m_this->m_presentingTexture; }
-        ~PresentingTextureLock() { m_this->m_mutex.unlock(); }
+        PresentingTextureLock(Swapchain* thisPtr) :
+            m_this(thisPtr), m_slot(thisPtr->m_buffer.acquireRead())
+        {}
+        const T& texture() { return m_this->m_textures[m_slot]; }
 
     private:
         Swapchain* m_this;
+        uint32_t m_slot;
     };
 
 private:
@@ -57,19 +61,18 @@ private:
     void initRenderTextures(T&& renderTexture,
                             RenderTextures&&... renderTextures)
     {
-        m_renderTextures.push_back(std::move(renderTexture));
+        m_textures.push_back(std::move(renderTexture));
         initRenderTextures(std::forward<RenderTextures>(renderTextures)...);
     }
 
     void initRenderTextures(T&& renderTexture)
     {
-        m_renderTextures.push_back(std::move(renderTexture));
+        m_textures.push_back(std::move(renderTexture));
     }
 
-    std::mutex m_mutex;
-    std::condition_variable m_cond;
-    T m_presentingTexture;
-    std::deque<T> m_renderTextures;
+    std::vector<T> m_textures;
+    TripleBuffer m_buffer;
+    TripleBufferFrames m_frames;
 };
 
 #endif
@@ -0,0 +1,250 @@
+#ifndef _RIVE_TRIPLE_BUFFER_HPP
+#define _RIVE_TRIPLE_BUFFER_HPP
+
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+// Lock-free hand-off of frames from one producer to one consumer over a small
+// fixed set of slots (three, or more when several frames can be in flight).
+//
+// The producer claims free slots to render into and publishes them once they
+// are complete. The most recently published slot lives in a single atomic
+// word with a dirty bit. The consumer swaps to it whenever the bit is set,
+// which returns the slot it was reading to the free set. Neither side ever
+// waits on the other. If the producer publishes again before the consumer
+// picked up the last frame, the older frame is dropped.
+//
+// The producer calls (acquireWrite, publish, cancelWrite) must not overlap.
+// When frames are started and published on different threads, go through
+// TripleBufferFrames, which serializes them.
+class TripleBuffer
+{
+public:
+    static constexpr uint32_t maxSlots = 8;
+    static constexpr uint32_t noSlot = ~0u;
+
+    // All slots but initialReadSlot start out free.
+    TripleBuffer(uint32_t slotCount, uint32_t initialReadSlot = 0) :
+        m_free(((1u << slotCount) - 1) & ~(1u << initialReadSlot)),
+        m_latest(empty),
+        m_read(initialReadSlot)
+    {
+        assert(slotCount >= 3 && slotCount <= maxSlots);
+    }
+
+    // Producer: claims a slot nobody else is using, or returns noSlot if every
+    // slot is being written, read or waiting to be read. A producer that
+    // publishes each slot before claiming the next always gets one.
+    uint32_t acquireWrite()
+    {
+        uint32_t free = m_free.load(std::memory_order_acquire);
+        while (free != 0)
+        {
+            uint32_t slot = 0;
+            while ((free & (1u << slot)) == 0)
+            {
+                slot++;
+            }
+            if (m_free.compare_exchange_weak(free,
+                                             free & ~(1u << slot),
+                                             std::memory_order_acq_rel))
+            {
+                return slot;
+            }
+        }
+        return noSlot;
+    }
+
+    // Producer: makes slot, claimed by acquireWrite, the latest frame.
+    void publish(uint32_t slot)
+    {
+        uint32_t previous =
+            m_latest.exchange(slot | dirty, std::memory_order_acq_rel);
+        if (previous != empty && (previous & slotMask) != slot)
+        {
+            // Never picked up, recycle it.
+            release(previous & slotMask);
+        }
+    }
+
+    // Producer: gives back a slot from acquireWrite without publishing it.
+    void cancelWrite(uint32_t slot) { release(slot); }
+
+    // Consumer: switches to the latest frame if a new one was published, and
+    // returns the slot to read. The slot stays valid until the next call.
+    uint32_t acquireRead()
+    {
+        if ((m_latest.load(std::memory_order_relaxed) & dirty) == 0)
+        {
+            return m_read.load(std::memory_order_relaxed);
+        }
+        uint32_t latest = m_latest.exchange(empty, std::memory_order_acq_rel);
+        uint32_t previous = m_read.load(std::memory_order_relaxed);
+        uint32_t slot = latest & slotMask;
+        m_read.store(slot, std::memory_order_relaxed);
+        if (previous != slot)
+        {
+            release(previous);
+        }
+        return slot;
+    }
+
+    // Consumer: the slot being read, without switching to a newer frame.
+    uint32_t currentRead() const
+    {
+        return m_read.load(std::memory_order_relaxed);
+    }
+
+private:
+    static constexpr uint32_t dirty = 0x80;
+    static constexpr uint32_t slotMask = 0x7f;
+    static constexpr uint32_t empty = slotMask;
+
+    void release(uint32_t slot)
+    {
+        m_free.fetch_or(1u << slot, std::memory_order_release);
+    }
+
+    std::atomic<uint32_t> m_free;
+    std::atomic<uint32_t> m_latest;
+    std::atomic<uint32_t> m_read;
+};
+
+// The producer side of a TripleBuffer for when frames are started on one
+// thread and published on another, e.g. by a GPU completion handler. Frames in
+// flight are published in the order they were started. Both sides take a
+// mutex, so the buffer only ever sees one producer call at a time, and
+// starting a frame waits while every slot is in use. The consumer side of the
+// buffer is untouched and stays lock-free.
+//
+// A frame that is started but never published would hold its slot forever, so
+// starting a frame never waits on one for longer than abandonAfter: once the
+// oldest frame in flight is that old, it is presumed abandoned and its slot is
+// reused for the new frame. If such a frame does complete later, its
+// publishOldest() publishes the frame after it early.
+class TripleBufferFrames
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit TripleBufferFrames(
+        TripleBuffer* buffer,
+        Clock::duration abandonAfter = std::chrono::milliseconds(500)) :
+        m_buffer(buffer), m_abandonAfter(abandonAfter)
+    {}
+
+    // Claims a slot for a new frame, waiting for a frame in flight to be
+    // published if there is none, or reclaiming the oldest one if it has been
+    // in flight for abandonAfter. Returns noSlot only if the slot it got was
+    // somehow already in flight, which would mean two frames rendering into
+    // the same target.
+    uint32_t begin()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        while (true)
+        {
+            if (m_count < TripleBuffer::maxSlots)
+            {
+                uint32_t slot = m_buffer->acquireWrite();
+                if (slot != TripleBuffer::noSlot)
+                {
+                    if (inFlight(slot))
+                    {
+                        assert(false && "slot handed out twice");
+                        m_buffer->cancelWrite(slot);
+                        return TripleBuffer::noSlot;
+                    }
+                    push(slot);
+                    return slot;
+                }
+            }
+            if (m_count == 0)
+            {
+                // Nothing to wait on: the consumer is between taking the
+                // latest frame and freeing the one it was reading.
+                lock.unlock();
+                std::this_thread::yield();
+                lock.lock();
+                continue;
+            }
+            Clock::time_point abandonAt = m_began[m_head] + m_abandonAfter;
+            if (Clock::now() >= abandonAt)
+            {
+                uint32_t slot = m_slots[m_head];
+                pop();
+                push(slot);
+                return slot;
+            }
+            m_published.wait_until(lock, abandonAt);
+        }
+    }
+
+    // Publishes the oldest frame in flight and returns its slot, or noSlot if
+    // none is in flight. fill(slot) runs first, while the slot is still owned
+    // by the producer.
+    template <typename Fill> uint32_t publishOldest(Fill fill)
+    {
+        uint32_t slot;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            if (m_count == 0)
+            {
+                return TripleBuffer::noSlot;
+            }
+            slot = m_slots[m_head];
+            pop();
+            fill(slot);
+            m_buffer->publish(slot);
+        }
+        m_published.notify_all();
+        return slot;
+    }
+
+    uint32_t publishOldest()
+    {
+        return publishOldest([](uint32_t) {});
+    }
+
+private:
+    void push(uint32_t slot)
+    {
+        uint32_t index = (m_head + m_count++) % TripleBuffer::maxSlots;
+        m_slots[index] = slot;
+        m_began[index] = Clock::now();
+    }
+
+    void pop()
+    {
+        m_head = (m_head + 1) % TripleBuffer::maxSlots;
+        m_count--;
+    }
+
+    bool inFlight(uint32_t slot) const
+    {
+        for (uint32_t i = 0; i < m_count; i++)
+        {
+            if (m_slots[(m_head + i) % TripleBuffer::maxSlots] == slot)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    TripleBuffer* m_buffer;
+    const Clock::duration m_abandonAfter;
+    std::mutex m_mutex;
+    std::condition_variable m_published;
+    uint32_t m_slots[TripleBuffer::maxSlots];
+    // When each frame in flight was started.
+    Clock::time_point m_began[TripleBuffer::maxSlots];
+    uint32_t m_head = 0;
+    uint32_t m_count = 0;
+};
+
+#endif
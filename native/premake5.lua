@@ -347,6 +347,66 @@ do
     end
 end
 
+-- Native-side benchmarks and tests, desktop only since they run without
+-- Flutter:
+--   flutter_renderer_bench: FlutterRenderer's callback and recording modes.
+--   batch_advance_bench: RiveWorker advancing and recording many instances.
+--   triple_buffer_bench: ReadWriteRing cost and frame latency.
+--   triple_buffer_stress_test: ReadWriteRing and Swapchain under contention.
+if _OPTIONS['arch'] ~= 'wasm' then
+    local function nativeBench(name, sources)
+        project(name)
+        do
+            kind('ConsoleApp')
+            defines({ 'YOGA_EXPORT=', 'WITH_RIVE_WORKER' })
+            includedirs({
+                './include',
+                'src/',
+                packages .. '/runtime/include',
+                packages .. '/runtime/renderer/include',
+                packages .. '/runtime',
+                yoga,
+            })
+            files(sources)
+            links({ 'rive', 'rive_harfbuzz', 'rive_sheenbidi', 'rive_yoga' })
+            filter({ 'system:linux' })
+            do
+                links({ 'pthread' })
+            end
+            filter({ 'options:not no-yoga-renames' })
+            do
+                includedirs({ dependencies })
+                forceincludes({ 'rive_yoga_renames.h' })
+            end
+            filter({})
+        end
+    end
+
+    nativeBench('flutter_renderer_bench', {
+        'bench/flutter_renderer_bench.cpp',
+        'src/flutter_renderer.cpp',
+    })
+    nativeBench('batch_advance_bench', {
+        'bench/batch_advance_bench.cpp',
+        'src/flutter_renderer.cpp',
+        'src/rive_binding.cpp',
+    })
+
+    for _, name in ipairs({ 'bench/triple_buffer_bench', 'test/triple_buffer_stress_test' }) do
+        project(path.getname(name))
+        do
+            kind('ConsoleApp')
+            includedirs({ './include' })
+            files({ name .. '.cpp', 'src/read_write_ring.cpp' })
+            filter({ 'system:linux' })
+            do
+                links({ 'pthread' })
+            end
+            filter({})
+        end
+    end
+end
+
 newoption({
     trigger = 'shared',
     description = 'builds a shared lib',
@@ -3,10 +3,12 @@
 
 #ifdef WITH_RIVE_AUDIO
 #include "rive/audio/audio_reader.hpp"
+#include <algorithm>
+#include <atomic>
 #include <condition_variable>
+#include <deque>
 #include <mutex>
 #include <thread>
-#include <deque>
 #include <vector>
 #include <cstdlib>
 
@@ -30,24 +32,64 @@ public:
     uint64_t lengthInFrames() { return m_lengthInFrames; }
 
 private:
+    // Decodes the next block. Returns true once the source is exhausted.
+    bool decodeBlock(uint64_t blockFrames)
+    {
+        uint32_t channels = m_audioReader->channels();
+        if (m_samples.empty())
+        {
+            m_samples.reserve(m_audioReader->lengthInFrames() * channels);
+        }
+        Span<float> block = m_audioReader->read(blockFrames);
+        m_samples.insert(m_samples.end(), block.begin(), block.end());
+        return block.size() < blockFrames * channels;
+    }
+
+    void finish()
+    {
+        m_lengthInFrames = m_samples.size() / m_audioReader->channels();
+        m_frames = Span<float>(m_samples.data(), m_samples.size());
+        m_isDone.store(true);
+    }
+
     rcp<AudioReader> m_audioReader;
     std::atomic<bool> m_isDone;
+    std::vector<float> m_samples;
     Span<float> m_frames;
     uint64_t m_lengthInFrames;
 };
 
+// Decodes audio sources on a pool of worker threads, in the order they were
+// added. Each source is decoded one block (roughly a second of audio) at a
+// time, so shutting down doesn't wait for a long track to finish, but a worker
+// stays on a source until it is complete: nothing plays a source back before
+// it is fully decoded, so finishing sources one after another gets each of
+// them ready soonest.
 class AudioDecodeWorker
 {
 public:
-    AudioDecodeWorker()
+    AudioDecodeWorker(uint32_t threadCount = defaultThreadCount())
     {
         std::atexit(atExit);
-        for (int i = 0; i < threadCount; i++)
+        threadCount = std::max(threadCount, 1u);
+        for (uint32_t i = 0; i < threadCount; i++)
         {
             m_workThreads.emplace_back(std::thread(staticWorkThread, this));
         }
     }
 
+    static uint32_t defaultThreadCount()
+    {
+        unsigned hardwareThreads = std::thread::hardware_concurrency();
+        if (hardwareThreads <= 1)
+        {
+            return 1;
+        }
+        return std::min(hardwareThreads - 1, maxDefaultThreadCount);
+    }
+
+    uint32_t threadCount() const { return (uint32_t)m_workThreads.size(); }
+
 private:
     void workThread()
     {
@@ -60,10 +102,16 @@ private:
                 m_work.pop_front();
                 lock.unlock();
 
-                uint64_t length = work->m_audioReader->lengthInFrames();
-                work->m_lengthInFrames = length;
-                work->m_frames = work->m_audioReader->read(length);
-                work->m_isDone.store(true);
+                uint32_t sampleRate =
+                    std::max(work->m_audioReader->sampleRate(), 1u);
+                while (!sm_exiting)
+                {
+                    if (work->decodeBlock(sampleRate))
+                    {
+                        work->finish();
+                        break;
+                    }
+                }
             }
             else
             {
@@ -87,17 +135,17 @@ public:
             std::unique_lock<std::mutex> lock(m_mutex);
             m_work.push_back(work);
         }
-        m_haveWork.notify_all();
+        m_haveWork.notify_one();
         return work;
     }
 
 private:
-    static const int threadCount = 6;
+    static const uint32_t maxDefaultThreadCount = 6;
     std::vector<std::thread> m_workThreads;
     std::deque<rcp<DecodeWork>> m_work;
     std::condition_variable m_haveWork;
     std::mutex m_mutex;
-    static bool sm_exiting;
+    static std::atomic<bool> sm_exiting;
 
 private:
     static void atExit() { AudioDecodeWorker::sm_exiting = true; }
@@ -111,4 +159,4 @@ class AudioDecodeWorker;
 class DecodeWork;
 } // namespace rive
 #endif
-#endif
\ No newline at end of file
+#endif
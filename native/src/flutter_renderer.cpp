@@ -2,11 +2,11 @@
 #include "rive_native/external.hpp"
 #include "rive/core/vector_binary_writer.hpp"
 #include "renderer/src/rive_render_path.hpp"
+#include <atomic>
 #include <condition_variable>
 #include <mutex>
 #include <thread>
-#include <deque>
-#include <functional>
+#include <unordered_set>
 
 #ifdef __EMSCRIPTEN__
 #include <emscripten.h>
@@ -26,32 +26,49 @@ using namespace rive;
 
 #if !defined(__EMSCRIPTEN__)
 /// Helper from deleting stuff in a way that's safe for Flutter Isolate model.
+/// Destructors can run on any thread so they only queue the Flutter side id of
+/// what they owned, Dart then periodically releases everything queued with a
+/// single callback per resource type.
 class DeleteHelper
 {
 public:
-    void processDeletions()
+    enum Type
+    {
+        renderImage,
+        renderPath,
+        renderPaint,
+        vertexBuffer,
+        indexBuffer,
+        renderer,
+        typeCount
+    };
+    using Batch = std::vector<uint64_t>[typeCount];
+
+    void schedule(Type type, uint64_t id)
     {
         std::unique_lock<std::mutex> lock(m_mutex);
-        while (!m_work.empty())
-        {
-            auto work = m_work.front();
-            m_work.pop_front();
-            lock.unlock();
-            work();
-            lock.lock();
-        }
+        m_pending[type].push_back(id);
     }
 
-    void schedule(std::function<void()> callback)
+    /// Moves everything pending into batch. The vectors are swapped so their
+    /// storage keeps getting reused by both sides.
+    void take(Batch& batch)
     {
         std::unique_lock<std::mutex> lock(m_mutex);
-        m_work.push_back(callback);
+        for (int type = 0; type < typeCount; type++)
+        {
+            batch[type].clear();
+            std::swap(batch[type], m_pending[type]);
+        }
     }
 
     void clear()
     {
         std::unique_lock<std::mutex> lock(m_mutex);
-        m_work.clear();
+        for (auto& ids : m_pending)
+        {
+            ids.clear();
+        }
     }
 
     void lock() { m_mutex.lock(); }
@@ -59,7 +76,7 @@ public:
 
 private:
     std::mutex m_mutex;
-    std::deque<std::function<void()>> m_work;
+    Batch m_pending;
 };
 
 #endif
@@ -171,12 +188,14 @@ typedef void (*DecodeRenderImage)(RenderImage* image,
                                   uint64_t id,
                                   const uint8_t* bytes,
                                   size_t count);
-typedef void (*DeleteRenderImage)(uint64_t image);
-typedef void (*DeleteRenderer)(Renderer* renderer);
-typedef void (*DeleteRenderPath)(uint64_t path);
-typedef void (*DeleteRenderPaint)(uint64_t paint);
-typedef void (*DeleteVertexBuffer)(uint64_t buffer);
-typedef void (*DeleteIndexBuffer)(uint64_t buffer);
+// Deletions are batched per resource type, see DeleteHelper. Renderers are
+// passed as their addresses.
+typedef void (*DeleteRenderImage)(const uint64_t* images, size_t count);
+typedef void (*DeleteRenderer)(const uint64_t* renderers, size_t count);
+typedef void (*DeleteRenderPath)(const uint64_t* paths, size_t count);
+typedef void (*DeleteRenderPaint)(const uint64_t* paints, size_t count);
+typedef void (*DeleteVertexBuffer)(const uint64_t* buffers, size_t count);
+typedef void (*DeleteIndexBuffer)(const uint64_t* buffers, size_t count);
 
 typedef void (*FlutterDrawRenderPath)(Renderer*, uint64_t path, uint64_t paint);
 typedef void (*FlutterDrawRenderImage)(Renderer*,
@@ -237,6 +256,35 @@ typedef void (*FlutterTransform)(Renderer*,
 // DeleteRenderer g_deleteRenderer = nullptr;
 #endif
 
+// Opcodes for the command buffer a recording FlutterRenderer produces instead
+// of calling back into Flutter, decoded by FlutterRendererFFI.playback. Each
+// opcode is followed by its operands; ids are var uints.
+enum class FlutterRenderCommand : uint8_t
+{
+    save,
+    restore,
+    // 6 floats: xx, xy, yx, yy, tx, ty.
+    transform,
+    // paint id, then the same payload g_updateRenderPaint receives.
+    updatePaint,
+    // path id, uint8 fill rule, uint32 verb count, uint32 point count, verbs,
+    // then points as float pairs.
+    updatePath,
+    // path id, paint id.
+    drawPath,
+    // path id.
+    clipPath,
+    // image id, uint8 blend mode, float opacity.
+    drawImage,
+    // buffer id, uint32 vertex count, then vertices as float pairs.
+    updateVertexBuffer,
+    // buffer id, uint32 index count, then uint16 indices.
+    updateIndexBuffer,
+    // image, vertex, uv and index buffer ids, uint32 vertex count, uint32
+    // index count, uint8 blend mode, float opacity.
+    drawMesh,
+};
+
 class PaintDirt
 {
 public:
@@ -252,25 +300,25 @@ public:
 };
 
 static const uint64_t maxId = 9007199254740991; // 2^53-1;
-static uint64_t nextId(uint64_t& next)
+// Atomic since draws may be recorded on RiveWorker threads.
+static uint64_t nextId(std::atomic<uint64_t>& next)
 {
-    uint64_t id = next;
-    if (next == maxId)
+    uint64_t id = next.load(std::memory_order_relaxed);
+    uint64_t following;
+    do
     {
-        next = 1;
-    }
-    else
-    {
-        next++;
-    }
+        following = id == maxId ? 1 : id + 1;
+    } while (!next.compare_exchange_weak(id,
+                                         following,
+                                         std::memory_order_relaxed));
     return id;
 }
 
-static uint64_t nextPaintId = 1;
-static uint64_t nextPathId = 1;
-static uint64_t nextVertexBufferId = 1;
-static uint64_t nextIndexBufferId = 1;
-static uint64_t nextImageId = 1;
+static std::atomic<uint64_t> nextPaintId{1};
+static std::atomic<uint64_t> nextPathId{1};
+static std::atomic<uint64_t> nextVertexBufferId{1};
+static std::atomic<uint64_t> nextIndexBufferId{1};
+static std::atomic<uint64_t> nextImageId{1};
 
 class FlutterFactory;
 class FlutterRenderPaint
@@ -486,6 +534,8 @@ public:
     ~FlutterRenderPath();
 
     void update();
+    // Same as update(), but appends the path to a recorded command buffer.
+    void record(BinaryWriter& writer);
 
     void rewind() override
     {
@@ -544,9 +594,21 @@ public:
     FillRule getFillRule() const { return m_fillRule; }
 
 private:
+    // Animated paths are usually rewound and rebuilt every frame, often into
+    // exactly the same geometry. Returns false (and clears the dirt) if the
+    // path matches what Flutter already has, so it doesn't get re-marshalled
+    // and rebuilt on the Dart side.
+    bool contentChanged();
+
     FillRule m_fillRule = FillRule::nonZero;
     RawPath m_rawPath;
     bool m_isDirty = false;
+    bool m_wasUploaded = false;
+    // What Flutter last received. Keeping it doubles the path's geometry
+    // memory, in exchange for skipping unchanged paths without a hash.
+    FillRule m_uploadedFillRule = FillRule::nonZero;
+    std::vector<PathVerb> m_uploadedVerbs;
+    std::vector<Vec2D> m_uploadedPoints;
 };
 
 static rive::RawPath emptyPath;
@@ -609,6 +671,7 @@ public:
     void onUnmap() override { m_isDirty = true; }
 
     void update();
+    void record(BinaryWriter& writer);
 
 private:
     bool m_isDirty = false;
@@ -637,6 +700,7 @@ public:
     void onUnmap() override { m_isDirty = true; }
 
     void update();
+    void record(BinaryWriter& writer);
 
 private:
     bool m_isDirty = false;
@@ -677,7 +741,33 @@ class FlutterFactory : public RefCnt<FlutterFactory>, public Factory
 public:
 #if !defined(__EMSCRIPTEN__)
     DeleteHelper g_deleteHelper;
-    void processDeletions() { g_deleteHelper.processDeletions(); }
+    void processDeletions()
+    {
+        g_deleteHelper.take(m_deletions);
+        flushDeletions(g_deleteRenderImage, DeleteHelper::renderImage);
+        flushDeletions(g_deleteRenderPath, DeleteHelper::renderPath);
+        flushDeletions(g_deleteRenderPaint, DeleteHelper::renderPaint);
+        flushDeletions(g_deleteVertexBuffer, DeleteHelper::vertexBuffer);
+        flushDeletions(g_deleteIndexBuffer, DeleteHelper::indexBuffer);
+        flushDeletions(g_deleteRenderer, DeleteHelper::renderer);
+    }
+
+private:
+    template <typename DeleteCallback>
+    void flushDeletions(DeleteCallback callback, DeleteHelper::Type type)
+    {
+        auto& ids = m_deletions[type];
+        if (!ids.empty() && CALLBACK_VALID(callback))
+        {
+            callback(ids.data(), ids.size());
+        }
+        ids.clear();
+    }
+
+    // Only touched by processDeletions, on the Dart thread.
+    DeleteHelper::Batch m_deletions;
+
+public:
 #endif
     rcp<RenderBuffer> makeRenderBuffer(RenderBufferType type,
                                        RenderBufferFlags flags,
@@ -807,14 +897,7 @@ FlutterIndexBuffer::~FlutterIndexBuffer()
         m_factory->g_deleteIndexBuffer(m_id);
     }
 #else
-    auto obj = m_id;
-    auto factory = m_factory;
-    factory->g_deleteHelper.schedule([factory, obj]() {
-        if (CALLBACK_VALID(factory->g_deleteIndexBuffer))
-        {
-            factory->g_deleteIndexBuffer(obj);
-        }
-    });
+    m_factory->g_deleteHelper.schedule(DeleteHelper::indexBuffer, m_id);
 #endif
 }
 
@@ -827,14 +910,7 @@ FlutterRenderImage::~FlutterRenderImage()
     }
 #else
     // Let Flutter know this id is gone.
-    auto obj = m_id;
-    auto factory = m_factory;
-    factory->g_deleteHelper.schedule([factory, obj]() {
-        if (CALLBACK_VALID(factory->g_deleteRenderImage))
-        {
-            factory->g_deleteRenderImage(obj);
-        }
-    });
+    m_factory->g_deleteHelper.schedule(DeleteHelper::renderImage, m_id);
 #endif
 }
 
@@ -850,6 +926,21 @@ void FlutterIndexBuffer::update()
     m_isDirty = false;
 }
 
+void FlutterIndexBuffer::record(BinaryWriter& writer)
+{
+    if (!m_isDirty)
+    {
+        return;
+    }
+    writer.write((uint8_t)FlutterRenderCommand::updateIndexBuffer);
+    writer.writeVarUint(m_id);
+    writer.write((uint32_t)m_indices.size());
+    // Native byte order, same as the pointers handed to the callbacks.
+    writer.write(reinterpret_cast<const uint8_t*>(m_indices.data()),
+                 m_indices.size() * sizeof(uint16_t));
+    m_isDirty = false;
+}
+
 void FlutterVertexBuffer::update()
 {
     if (!m_isDirty)
@@ -862,6 +953,20 @@ void FlutterVertexBuffer::update()
     m_isDirty = false;
 }
 
+void FlutterVertexBuffer::record(BinaryWriter& writer)
+{
+    if (!m_isDirty)
+    {
+        return;
+    }
+    writer.write((uint8_t)FlutterRenderCommand::updateVertexBuffer);
+    writer.writeVarUint(m_id);
+    writer.write((uint32_t)m_vertices.size());
+    writer.write(reinterpret_cast<const uint8_t*>(m_vertices.data()),
+                 m_vertices.size() * sizeof(Vec2D));
+    m_isDirty = false;
+}
+
 FlutterVertexBuffer::~FlutterVertexBuffer()
 {
 #if defined(__EMSCRIPTEN__)
@@ -870,14 +975,7 @@ FlutterVertexBuffer::~FlutterVertexBuffer()
         m_factory->g_deleteVertexBuffer(m_id);
     }
 #else
-    auto obj = m_id;
-    auto factory = m_factory;
-    factory->g_deleteHelper.schedule([factory, obj]() {
-        if (CALLBACK_VALID(factory->g_deleteVertexBuffer))
-        {
-            factory->g_deleteVertexBuffer(obj);
-        }
-    });
+    m_factory->g_deleteHelper.schedule(DeleteHelper::vertexBuffer, m_id);
 #endif
 }
 
@@ -889,20 +987,40 @@ FlutterRenderPath::~FlutterRenderPath()
         m_factory->g_deleteRenderPath(m_id);
     }
 #else
-    auto obj = m_id;
-    auto factory = m_factory;
-    factory->g_deleteHelper.schedule([factory, obj]() {
-        if (CALLBACK_VALID(factory->g_deleteRenderPath))
-        {
-            factory->g_deleteRenderPath(obj);
-        }
-    });
+    m_factory->g_deleteHelper.schedule(DeleteHelper::renderPath, m_id);
 #endif
 }
 
+bool FlutterRenderPath::contentChanged()
+{
+    auto verbs = m_rawPath.verbs();
+    auto points = m_rawPath.points();
+    // memcmp stops at the first difference, so a path that really changed
+    // rarely pays for a full pass.
+    if (m_wasUploaded && m_fillRule == m_uploadedFillRule &&
+        verbs.size() == m_uploadedVerbs.size() &&
+        points.size() == m_uploadedPoints.size() &&
+        memcmp(verbs.data(),
+               m_uploadedVerbs.data(),
+               verbs.size() * sizeof(PathVerb)) == 0 &&
+        memcmp(points.data(),
+               m_uploadedPoints.data(),
+               points.size() * sizeof(Vec2D)) == 0)
+    {
+        m_isDirty = false;
+        return false;
+    }
+    m_wasUploaded = true;
+    m_uploadedFillRule = m_fillRule;
+    m_uploadedVerbs.assign(verbs.begin(), verbs.end());
+    m_uploadedPoints.assign(points.begin(), points.end());
+    return true;
+}
+
 void FlutterRenderPath::update()
 {
-    if (!m_isDirty || !CALLBACK_VALID(m_factory->g_updateRenderPath))
+    if (!m_isDirty || !CALLBACK_VALID(m_factory->g_updateRenderPath) ||
+        !contentChanged())
     {
         return;
     }
@@ -917,6 +1035,27 @@ void FlutterRenderPath::update()
     m_isDirty = false;
 }
 
+void FlutterRenderPath::record(BinaryWriter& writer)
+{
+    if (!m_isDirty || !contentChanged())
+    {
+        return;
+    }
+    auto verbs = m_rawPath.verbs();
+    auto points = m_rawPath.points();
+    writer.write((uint8_t)FlutterRenderCommand::updatePath);
+    writer.writeVarUint(m_id);
+    writer.write((uint8_t)m_fillRule);
+    writer.write((uint32_t)verbs.size());
+    writer.write((uint32_t)points.size());
+    writer.write(reinterpret_cast<const uint8_t*>(verbs.data()),
+                 verbs.size() * sizeof(PathVerb));
+    writer.write(reinterpret_cast<const uint8_t*>(points.data()),
+                 points.size() * sizeof(Vec2D));
+
+    m_isDirty = false;
+}
+
 FlutterRenderPaint::~FlutterRenderPaint()
 {
 #if defined(__EMSCRIPTEN__)
@@ -925,41 +1064,82 @@ FlutterRenderPaint::~FlutterRenderPaint()
         m_factory->g_deleteRenderPaint(m_id);
     }
 #else
-    auto id = m_id;
-    auto factory = m_factory;
-    factory->g_deleteHelper.schedule([factory, id]() {
-        if (CALLBACK_VALID(factory->g_deleteRenderPaint))
-        {
-            factory->g_deleteRenderPaint(id);
-        }
-    });
+    m_factory->g_deleteHelper.schedule(DeleteHelper::renderPaint, m_id);
 #endif
 }
 
+class FlutterRenderer;
+
+// Flutter renderers that Dart put into recording mode. Draws destined for
+// these can be recorded on worker threads and merged, see makeDrawRecorder.
+static std::mutex g_recordingRenderersMutex;
+static std::unordered_set<const Renderer*> g_recordingRenderers;
+
 class FlutterRenderer : public Renderer
 {
 public:
     FlutterRenderer(FlutterFactory* factory) : m_factory(safe_ref(factory)) {}
     ~FlutterRenderer()
     {
+        {
+            std::unique_lock<std::mutex> lock(g_recordingRenderersMutex);
+            g_recordingRenderers.erase(this);
+        }
 #if defined(__EMSCRIPTEN__)
         if (CALLBACK_VALID(m_factory->g_deleteRenderer))
         {
             m_factory->g_deleteRenderer(CAST_POINTER this);
         }
 #else
-        auto obj = this;
-        auto factory = m_factory;
-        factory->g_deleteHelper.schedule([factory, obj]() {
-            if (CALLBACK_VALID(factory->g_deleteRenderer))
-            {
-                factory->g_deleteRenderer(obj);
-            }
-        });
+        m_factory->g_deleteHelper.schedule(DeleteHelper::renderer,
+                                           (uint64_t)(uintptr_t)this);
 #endif
     }
+    // While recording, draw calls are appended to a command buffer that
+    // Flutter plays back in one go (see takeCommands), instead of each one
+    // calling back into Flutter.
+    void recording(bool value)
+    {
+        m_recording = value;
+        m_commandWriter.clear();
+    }
+    bool recording() const { return m_recording; }
+
+    // Size of the commands recorded since the last takeCommands.
+    size_t commandsSize() const { return m_commandWriter.size(); }
+
+    // Returns the commands recorded since the last call (commandsSize() bytes)
+    // and starts a new buffer. The returned bytes stay valid until the next
+    // command is recorded.
+    const uint8_t* takeCommands()
+    {
+        m_commandWriter.clear();
+        return m_commands.data();
+    }
+
+    // Moves the commands recorded since the last take into commands and
+    // starts a new buffer, which reuses commands' old storage.
+    void takeCommands(std::vector<uint8_t>* commands)
+    {
+        m_commands.resize(m_commandWriter.size());
+        std::swap(*commands, m_commands);
+        m_commands.clear();
+        m_commandWriter.clear();
+    }
+
+    // Appends commands recorded by another renderer.
+    void appendCommands(const uint8_t* commands, size_t size)
+    {
+        m_commandWriter.write(commands, size);
+    }
+
     void save() override
     {
+        if (m_recording)
+        {
+            m_commandWriter.write((uint8_t)FlutterRenderCommand::save);
+            return;
+        }
         if (CALLBACK_VALID(m_factory->g_save))
         {
             m_factory->g_save(CAST_POINTER this);
@@ -967,6 +1147,11 @@ public:
     }
     void restore() override
     {
+        if (m_recording)
+        {
+            m_commandWriter.write((uint8_t)FlutterRenderCommand::restore);
+            return;
+        }
         if (CALLBACK_VALID(m_factory->g_restore))
         {
             m_factory->g_restore(CAST_POINTER this);
@@ -974,6 +1159,15 @@ public:
     }
     void transform(const Mat2D& transform) override
     {
+        if (m_recording)
+        {
+            m_commandWriter.write((uint8_t)FlutterRenderCommand::transform);
+            for (int i = 0; i < 6; i++)
+            {
+                m_commandWriter.write(transform[i]);
+            }
+            return;
+        }
         if (CALLBACK_VALID(m_factory->g_transform))
         {
             m_factory->g_transform(CAST_POINTER this,
@@ -991,6 +1185,22 @@ public:
         LITE_RTTI_CAST_OR_RETURN(flutterPath, FlutterRenderPath*, path);
         LITE_RTTI_CAST_OR_RETURN(flutterPaint, FlutterRenderPaint*, paint);
 
+        if (m_recording)
+        {
+            if (flutterPaint->isDirty())
+            {
+                m_commandWriter.write(
+                    (uint8_t)FlutterRenderCommand::updatePaint);
+                m_commandWriter.writeVarUint(flutterPaint->m_id);
+                flutterPaint->update(m_commandWriter);
+            }
+            flutterPath->record(m_commandWriter);
+            m_commandWriter.write((uint8_t)FlutterRenderCommand::drawPath);
+            m_commandWriter.writeVarUint(flutterPath->m_id);
+            m_commandWriter.writeVarUint(flutterPaint->m_id);
+            return;
+        }
+
         if (flutterPaint->isDirty())
         {
             m_buffer.clear();
@@ -1014,6 +1224,14 @@ public:
     {
         LITE_RTTI_CAST_OR_RETURN(flutterPath, FlutterRenderPath*, path);
 
+        if (m_recording)
+        {
+            flutterPath->record(m_commandWriter);
+            m_commandWriter.write((uint8_t)FlutterRenderCommand::clipPath);
+            m_commandWriter.writeVarUint(flutterPath->m_id);
+            return;
+        }
+
         flutterPath->update();
         if (CALLBACK_VALID(m_factory->g_clipRenderPath))
         {
@@ -1029,6 +1247,14 @@ public:
         LITE_RTTI_CAST_OR_RETURN(flutterRenderImage,
                                  const FlutterRenderImage*,
                                  renderImage);
+        if (m_recording)
+        {
+            m_commandWriter.write((uint8_t)FlutterRenderCommand::drawImage);
+            m_commandWriter.writeVarUint(flutterRenderImage->m_id);
+            m_commandWriter.write((uint8_t)blendMode);
+            m_commandWriter.write(opacity);
+            return;
+        }
         if (CALLBACK_VALID(m_factory->g_drawRenderImage))
         {
             m_factory->g_drawRenderImage(CAST_POINTER this,
@@ -1061,6 +1287,23 @@ public:
                                  FlutterIndexBuffer*,
                                  indices_u16.get());
 
+        if (m_recording)
+        {
+            flutterVertexBuffer->record(m_commandWriter);
+            flutterUVBuffer->record(m_commandWriter);
+            flutterIndexBuffer->record(m_commandWriter);
+            m_commandWriter.write((uint8_t)FlutterRenderCommand::drawMesh);
+            m_commandWriter.writeVarUint(flutterRenderImage->m_id);
+            m_commandWriter.writeVarUint(flutterVertexBuffer->m_id);
+            m_commandWriter.writeVarUint(flutterUVBuffer->m_id);
+            m_commandWriter.writeVarUint(flutterIndexBuffer->m_id);
+            m_commandWriter.write(vertexCount);
+            m_commandWriter.write(indexCount);
+            m_commandWriter.write((uint8_t)blendMode);
+            m_commandWriter.write(opacity);
+            return;
+        }
+
         flutterVertexBuffer->update();
         flutterUVBuffer->update();
         flutterIndexBuffer->update();
@@ -1082,6 +1325,11 @@ public:
     // Buffer for marshaling data.
     std::vector<uint8_t> m_buffer;
     rcp<FlutterFactory> m_factory;
+
+private:
+    bool m_recording = false;
+    std::vector<uint8_t> m_commands;
+    VectorBinaryWriter m_commandWriter{&m_commands};
 };
 
 /// Factory callbacks to allow native to create and destroy Flutter resources.
@@ -1168,8 +1416,125 @@ EXPORT void deleteFlutterRenderer(FlutterRenderer* renderer)
     delete renderer;
 }
 
+EXPORT void flutterRendererSetRecording(FlutterRenderer* renderer,
+                                        bool recording)
+{
+    if (renderer == nullptr)
+    {
+        return;
+    }
+    renderer->recording(recording);
+    std::unique_lock<std::mutex> lock(g_recordingRenderersMutex);
+    if (recording)
+    {
+        g_recordingRenderers.insert(renderer);
+    }
+    else
+    {
+        g_recordingRenderers.erase(renderer);
+    }
+}
+
+class FlutterDrawRecorder : public DrawRecorder
+{
+public:
+    FlutterDrawRecorder(FlutterRenderer* target) :
+        m_target(target), m_recorder(target->m_factory.get())
+    {
+        m_recorder.recording(true);
+    }
+
+    Renderer* renderer() override { return &m_recorder; }
+    void takeRecording(std::vector<uint8_t>* recording) override
+    {
+        m_recorder.takeCommands(recording);
+    }
+    void appendTo(const std::vector<uint8_t>& recording) override
+    {
+        m_target->appendCommands(recording.data(), recording.size());
+    }
+
+private:
+    FlutterRenderer* m_target;
+    FlutterRenderer m_recorder;
+};
+
+std::unique_ptr<DrawRecorder> makeDrawRecorder(Renderer* target)
+{
+    {
+        std::unique_lock<std::mutex> lock(g_recordingRenderersMutex);
+        if (g_recordingRenderers.count(target) == 0)
+        {
+            return nullptr;
+        }
+    }
+    return rivestd::make_unique<FlutterDrawRecorder>(
+        static_cast<FlutterRenderer*>(target));
+}
+
+EXPORT uint64_t flutterRendererCommandsSize(FlutterRenderer* renderer)
+{
+    if (renderer == nullptr)
+    {
+        return 0;
+    }
+    return renderer->commandsSize();
+}
+
+EXPORT const uint8_t* flutterRendererTakeCommands(FlutterRenderer* renderer)
+{
+    if (renderer == nullptr)
+    {
+        return nullptr;
+    }
+    return renderer->takeCommands();
+}
+
 EXPORT FlutterFactory* makeFlutterFactory() { return new FlutterFactory(); }
 
+#if !defined(__EMSCRIPTEN__)
+// Native-only hooks for tools that drive a FlutterRenderer without a Dart
+// isolate, like bench/flutter_renderer_bench.cpp. The callbacks installed by
+// initNoOpFactoryCallbacks do nothing, so only native-side work is measured.
+rive::Factory* flutterFactoryBase(FlutterFactory* factory) { return factory; }
+rive::Renderer* flutterRendererBase(FlutterRenderer* renderer)
+{
+    return renderer;
+}
+
+void initNoOpFactoryCallbacks(FlutterFactory* factory)
+{
+    initFactoryCallbacks(
+        factory,
+        [](RenderImage*, uint64_t, const uint8_t*, size_t) {},
+        [](const uint64_t*, size_t) {},
+        [](Renderer*, uint64_t, uint64_t) {},
+        [](Renderer*, uint64_t, uint8_t, float) {},
+        [](Renderer*,
+           uint64_t,
+           uint64_t,
+           uint64_t,
+           uint64_t,
+           uint32_t,
+           uint32_t,
+           uint8_t,
+           float) {},
+        [](uint64_t, Vec2D*, uint8_t*, size_t, uint8_t) {},
+        [](Renderer*, uint64_t) {},
+        [](Renderer*) {},
+        [](Renderer*) {},
+        [](Renderer*, float, float, float, float, float, float) {},
+        [](uint64_t, uint8_t*, size_t) {},
+        [](uint64_t, uint16_t*, size_t) {},
+        [](uint64_t, Vec2D*, size_t) {},
+        [](const uint64_t*, size_t) {},
+        [](const uint64_t*, size_t) {},
+        [](const uint64_t*, size_t) {},
+        [](const uint64_t*, size_t) {},
+        [](const uint64_t*, size_t) {});
+}
+#endif
+
 EXPORT void deleteFlutterFactory(FlutterFactory* factory)
 {
     // The factory is a singleton in Flutter so it gets nuked during a hot
@@ -518,6 +518,262 @@ struct Layout
     float height;
 };
 
+// Plain-old-data mirror of every YGStyle field, so a host can fill in a whole
+// style in its own memory and hand it over with a single call instead of one
+// call per field. Enums are stored as their integer values and units as YGUnit.
+struct PackedLayoutValue
+{
+    float value;
+    int32_t unit;
+};
+
+static const int packedEdgeCount = 9;
+static const int packedGutterCount = 3;
+static const int packedDimensionCount = 2;
+
+struct PackedLayoutStyle
+{
+    int32_t alignContent;
+    int32_t direction;
+    int32_t flexDirection;
+    int32_t justifyContent;
+    int32_t alignItems;
+    int32_t alignSelf;
+    int32_t positionType;
+    int32_t flexWrap;
+    int32_t overflow;
+    int32_t display;
+    // NaN when unset.
+    float flex;
+    float flexGrow;
+    float flexShrink;
+    PackedLayoutValue flexBasis;
+    PackedLayoutValue margin[packedEdgeCount];
+    PackedLayoutValue position[packedEdgeCount];
+    PackedLayoutValue padding[packedEdgeCount];
+    PackedLayoutValue border[packedEdgeCount];
+    PackedLayoutValue gap[packedGutterCount];
+    PackedLayoutValue dimensions[packedDimensionCount];
+    PackedLayoutValue minDimensions[packedDimensionCount];
+    PackedLayoutValue maxDimensions[packedDimensionCount];
+};
+
+static PackedLayoutValue packValue(YGValue value)
+{
+    return {value.value, (int32_t)value.unit};
+}
+
+static YGValue unpackValue(const PackedLayoutValue& value)
+{
+    return (YGValue){value.value, (YGUnit)value.unit};
+}
+
+static void packStyle(YGStyle& style, PackedLayoutStyle& packed)
+{
+    packed.alignContent = (int32_t)(YGAlign)style.alignContent();
+    packed.direction = (int32_t)(YGDirection)style.direction();
+    packed.flexDirection = (int32_t)(YGFlexDirection)style.flexDirection();
+    packed.justifyContent = (int32_t)(YGJustify)style.justifyContent();
+    packed.alignItems = (int32_t)(YGAlign)style.alignItems();
+    packed.alignSelf = (int32_t)(YGAlign)style.alignSelf();
+    packed.positionType = (int32_t)(YGPositionType)style.positionType();
+    packed.flexWrap = (int32_t)(YGWrap)style.flexWrap();
+    packed.overflow = (int32_t)(YGOverflow)style.overflow();
+    packed.display = (int32_t)(YGDisplay)style.display();
+    packed.flex = YGFloatOptional(style.flex()).unwrap();
+    packed.flexGrow = YGFloatOptional(style.flexGrow()).unwrap();
+    packed.flexShrink = YGFloatOptional(style.flexShrink()).unwrap();
+    facebook::yoga::detail::CompactValue flexBasis = style.flexBasis();
+    packed.flexBasis = packValue(flexBasis);
+    for (int i = 0; i < packedEdgeCount; i++)
+    {
+        packed.margin[i] = packValue(style.margin()[(YGEdge)i]);
+        packed.position[i] = packValue(style.position()[(YGEdge)i]);
+        packed.padding[i] = packValue(style.padding()[(YGEdge)i]);
+        packed.border[i] = packValue(style.border()[(YGEdge)i]);
+    }
+    for (int i = 0; i < packedGutterCount; i++)
+    {
+        packed.gap[i] = packValue(style.gap()[(YGGutter)i]);
+    }
+    for (int i = 0; i < packedDimensionCount; i++)
+    {
+        packed.dimensions[i] = packValue(style.dimensions()[(YGDimension)i]);
+        packed.minDimensions[i] =
+            packValue(style.minDimensions()[(YGDimension)i]);
+        packed.maxDimensions[i] =
+            packValue(style.maxDimensions()[(YGDimension)i]);
+    }
+}
+
+static void unpackStyle(const PackedLayoutStyle& packed, YGStyle& style)
+{
+    style.alignContent() = (YGAlign)packed.alignContent;
+    style.direction() = (YGDirection)packed.direction;
+    style.flexDirection() = (YGFlexDirection)packed.flexDirection;
+    style.justifyContent() = (YGJustify)packed.justifyContent;
+    style.alignItems() = (YGAlign)packed.alignItems;
+    style.alignSelf() = (YGAlign)packed.alignSelf;
+    style.positionType() = (YGPositionType)packed.positionType;
+    style.flexWrap() = (YGWrap)packed.flexWrap;
+    style.overflow() = (YGOverflow)packed.overflow;
+    style.display() = (YGDisplay)packed.display;
+    style.flex() = YGFloatOptional(packed.flex);
+    style.flexGrow() = YGFloatOptional(packed.flexGrow);
+    style.flexShrink() = YGFloatOptional(packed.flexShrink);
+    style.flexBasis() = unpackValue(packed.flexBasis);
+    for (int i = 0; i < packedEdgeCount; i++)
+    {
+        style.margin()[(YGEdge)i] = unpackValue(packed.margin[i]);
+        style.position()[(YGEdge)i] = unpackValue(packed.position[i]);
+        style.padding()[(YGEdge)i] = unpackValue(packed.padding[i]);
+        style.border()[(YGEdge)i] = unpackValue(packed.border[i]);
+    }
+    for (int i = 0; i < packedGutterCount; i++)
+    {
+        style.gap()[(YGGutter)i] = unpackValue(packed.gap[i]);
+    }
+    for (int i = 0; i < packedDimensionCount; i++)
+    {
+        style.dimensions()[(YGDimension)i] = unpackValue(packed.dimensions[i]);
+        style.minDimensions()[(YGDimension)i] =
+            unpackValue(packed.minDimensions[i]);
+        style.maxDimensions()[(YGDimension)i] =
+            unpackValue(packed.maxDimensions[i]);
+    }
+}
+
+// Makes a packed style initialized to Yoga's defaults.
+EXPORT PackedLayoutStyle* makePackedYogaStyle()
+{
+    YGStyle defaults;
+    auto packed = new PackedLayoutStyle();
+    packStyle(defaults, *packed);
+    return packed;
+}
+
+EXPORT void disposePackedYogaStyle(PackedLayoutStyle* packed) { delete packed; }
+
+EXPORT void yogaStyleGetPacked(YGStyle* style, PackedLayoutStyle* packed)
+{
+    if (style == nullptr || packed == nullptr)
+    {
+        return;
+    }
+    packStyle(*style, *packed);
+}
+
+EXPORT void yogaStyleSetPacked(YGStyle* style, const PackedLayoutStyle* packed)
+{
+    if (style == nullptr || packed == nullptr)
+    {
+        return;
+    }
+    unpackStyle(*packed, *style);
+}
+
+EXPORT void yogaNodeSetPackedStyle(LayoutData* layoutData,
+                                   const PackedLayoutStyle* packed)
+{
+    if (layoutData == nullptr || packed == nullptr)
+    {
+        return;
+    }
+    YGStyle style;
+    unpackStyle(*packed, style);
+    layoutData->node.setStyle(style);
+}
+
+enum class LayoutTreeOpType : uint32_t
+{
+    insertChild,
+    removeChild,
+    clearChildren,
+    // value indexes the styles passed alongside the ops.
+    setStyle,
+    // value is the YGNodeType.
+    setType,
+    markDirty,
+};
+
+struct LayoutTreeOp
+{
+    uint32_t type;
+    // Child index for insertChild, see LayoutTreeOpType for the others.
+    int32_t value;
+    LayoutData* node;
+    LayoutData* child;
+};
+
+// Applies a list of structural and style edits in one call, so building or
+// restructuring a whole subtree doesn't cost a call per node and per field.
+EXPORT void yogaApplyTreeOps(const LayoutTreeOp* ops,
+                             uint32_t opCount,
+                             const PackedLayoutStyle* const* styles,
+                             uint32_t styleCount)
+{
+    if (ops == nullptr)
+    {
+        return;
+    }
+    for (uint32_t i = 0; i < opCount; i++)
+    {
+        const LayoutTreeOp& op = ops[i];
+        switch ((LayoutTreeOpType)op.type)
+        {
+            case LayoutTreeOpType::insertChild:
+                yogaNodeInsertChild(op.node, op.child, op.value);
+                break;
+            case LayoutTreeOpType::removeChild:
+                yogaNodeRemoveChild(op.node, op.child);
+                break;
+            case LayoutTreeOpType::clearChildren:
+                yogaNodeClearChildren(op.node);
+                break;
+            case LayoutTreeOpType::setStyle:
+                if (styles != nullptr && op.value >= 0 &&
+                    (uint32_t)op.value < styleCount &&
+                    styles[op.value] != nullptr)
+                {
+                    yogaNodeSetPackedStyle(op.node, styles[op.value]);
+                }
+                break;
+            case LayoutTreeOpType::setType:
+                yogaNodeSetType(op.node, op.value);
+                break;
+            case LayoutTreeOpType::markDirty:
+                yogaNodeMarkDirty(op.node);
+                break;
+        }
+    }
+}
+
+// Writes the computed layout of each node to layouts, four floats (left, top,
+// width, height) per node.
+EXPORT void yogaNodesGetLayouts(LayoutData* const* nodes,
+                                uint32_t count,
+                                Layout* layouts)
+{
+    if (nodes == nullptr || layouts == nullptr)
+    {
+        return;
+    }
+    for (uint32_t i = 0; i < count; i++)
+    {
+        LayoutData* layoutData = nodes[i];
+        if (layoutData == nullptr)
+        {
+            layouts[i] = {};
+            continue;
+        }
+        auto node = &layoutData->node;
+        layouts[i] = {YGNodeLayoutGetLeft(node),
+                      YGNodeLayoutGetTop(node),
+                      YGNodeLayoutGetWidth(node),
+                      YGNodeLayoutGetHeight(node)};
+    }
+}
+
 #ifdef __EMSCRIPTEN__
 Layout yogaNodeGetLayout(WasmPtr layoutDataPtr)
 {
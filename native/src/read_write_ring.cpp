@@ -1,33 +1,32 @@
 #include "rive_native/read_write_ring.hpp"
-#include <stdio.h>
 
-ReadWriteRing::ReadWriteRing() : m_size(ringSize), m_read(0), m_write(0) {}
+ReadWriteRing::ReadWriteRing() :
+    m_buffer(ringSize), m_frames(&m_buffer), m_write(0)
+{}
 
 uint32_t ReadWriteRing::nextWrite()
 {
-    m_mutex.lock();
-    m_write = (m_write + 1) % m_size;
-    m_mutex.unlock();
-    return m_write;
+    uint32_t slot = m_frames.begin();
+    if (slot == TripleBuffer::noSlot)
+    {
+        // Can't happen unless the ring is corrupt; keep the last target
+        // rather than returning an invalid index.
+        return m_write.load(std::memory_order_relaxed);
+    }
+    m_write.store(slot, std::memory_order_relaxed);
+    return slot;
 }
 uint32_t ReadWriteRing::currentWrite()
 {
-    m_mutex.lock();
-    uint32_t value = m_write;
-    m_mutex.unlock();
-    return value;
+    return m_write.load(std::memory_order_relaxed);
 }
 uint32_t ReadWriteRing::nextRead()
 {
-    m_mutex.lock();
-    m_read = (m_read + 1) % m_size;
-    m_mutex.unlock();
-    return m_read;
-}
-uint32_t ReadWriteRing::currentRead()
-{
-    m_mutex.lock();
-    uint32_t value = m_read;
-    m_mutex.unlock();
-    return value;
+    uint32_t slot = m_frames.publishOldest();
+    if (slot == TripleBuffer::noSlot)
+    {
+        return m_buffer.currentRead();
+    }
+    return slot;
 }
+uint32_t ReadWriteRing::currentRead() { return m_buffer.acquireRead(); }
@@ -16,55 +16,31 @@ const rive::FillRule renderPathFillRule(rive::Factory* factory,
 
 static rive::RawPath buildingPath;
 
-static rive::Vec2D readVec2(rive::BinaryReader& reader)
-{
-    float x = reader.readFloat32();
-    float y = reader.readFloat32();
-    return rive::Vec2D(x, y);
-}
-
 const int scratchBufferSize = 1024;
-EXPORT void appendCommands(uint8_t* memory, uint32_t commands)
+
+// Appends a whole path in one call. Verbs are PathVerb bytes and points are
+// x,y float pairs consumed in order, so callers can hand over their buffers
+// without chunking them through the scratch buffer.
+EXPORT void appendPathData(const uint8_t* verbs,
+                           uint32_t verbCount,
+                           const float* points,
+                           uint32_t pointCount)
 {
-    rive::BinaryReader reader(rive::Span<uint8_t>(memory, scratchBufferSize));
-    for (int i = 0; i < commands; i++)
+    if (verbs == nullptr)
     {
-        rive::PathVerb verb = (rive::PathVerb)reader.readByte();
-
-        switch (verb)
-        {
-            case rive::PathVerb::move:
-            {
-                auto v = readVec2(reader);
-                buildingPath.move(v);
-                break;
-            }
-            case rive::PathVerb::line:
-            {
-                auto v = readVec2(reader);
-                buildingPath.line(v);
-                break;
-            }
-            case rive::PathVerb::quad:
-            {
-                auto control = readVec2(reader);
-                auto to = readVec2(reader);
-                buildingPath.quad(control, to);
-                break;
-            }
-            case rive::PathVerb::cubic:
-            {
-                auto control1 = readVec2(reader);
-                auto control2 = readVec2(reader);
-                auto to = readVec2(reader);
-                buildingPath.cubic(control1, control2, to);
-                break;
-            }
-            case rive::PathVerb::close:
-                buildingPath.close();
-                break;
-        }
+        return;
+    }
+    if (points == nullptr)
+    {
+        pointCount = 0;
     }
+    buildingPath.addVerbsAndPoints(
+        rive::Span<const rive::PathVerb>(
+            reinterpret_cast<const rive::PathVerb*>(verbs),
+            verbCount),
+        rive::Span<const rive::Vec2D>(
+            reinterpret_cast<const rive::Vec2D*>(points),
+            pointCount));
 }
 
 class DashPathEffect : public rive::PathDasher
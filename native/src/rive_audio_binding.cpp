@@ -19,7 +19,7 @@ using namespace emscripten;
 using WasmPtr = uint32_t;
 #ifdef __EMSCRIPTEN_PTHREADS__
 rive::AudioDecodeWorker g_decodeWorker;
-bool rive::AudioDecodeWorker::sm_exiting = false;
+std::atomic<bool> rive::AudioDecodeWorker::sm_exiting{false};
 #endif
 
 WasmPtr makeAudioEngine(uint32_t numChannels, uint32_t sampleRate)
@@ -436,17 +436,30 @@ EMSCRIPTEN_BINDINGS(RiveAudio)
 
 #ifdef WITH_RIVE_AUDIO
 rive::AudioDecodeWorker* g_decodeWorker;
+static uint32_t g_decodeThreadCount = 0;
 static rive::AudioDecodeWorker* decodeWorker()
 {
     if (g_decodeWorker == nullptr)
     {
-        g_decodeWorker = new rive::AudioDecodeWorker();
+        g_decodeWorker = new rive::AudioDecodeWorker(
+            g_decodeThreadCount != 0
+                ? g_decodeThreadCount
+                : rive::AudioDecodeWorker::defaultThreadCount());
     }
     return g_decodeWorker;
 }
-bool rive::AudioDecodeWorker::sm_exiting = false;
+std::atomic<bool> rive::AudioDecodeWorker::sm_exiting{false};
 #endif
 
+// Only takes effect if called before the first source is decoded, 0 restores
+// the default.
+EXPORT void setAudioDecodeThreadCount(uint32_t threadCount)
+{
+#ifdef WITH_RIVE_AUDIO
+    g_decodeThreadCount = threadCount;
+#endif
+}
+
 EXPORT rive::AudioEngine* makeAudioEngine(uint32_t numChannels,
                                           uint32_t sampleRate)
 {
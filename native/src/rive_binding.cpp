@@ -1643,6 +1643,46 @@ EXPORT void vmiListRuntimeSwap(WrappedVMIListRuntime* wrappedListProperty,
     wrappedListProperty->instance()->swap(a, b);
 }
 
+EXPORT void vmiListRuntimeReplaceInstances(
+    WrappedVMIListRuntime* wrappedListProperty,
+    WrappedVMIRuntime** wrappedViewModelInstances,
+    size_t count)
+{
+    if (wrappedListProperty == nullptr)
+    {
+        return;
+    }
+    std::vector<ViewModelInstanceRuntime*> instances;
+    instances.reserve(count);
+    for (size_t i = 0; i < count; i++)
+    {
+        auto wrappedViewModelInstance = wrappedViewModelInstances[i];
+        if (wrappedViewModelInstance != nullptr)
+        {
+            instances.push_back(wrappedViewModelInstance->instance());
+        }
+    }
+    wrappedListProperty->instance()->replaceInstances(instances);
+}
+
+EXPORT void vmiListRuntimeBeginBatch(WrappedVMIListRuntime* wrappedListProperty)
+{
+    if (wrappedListProperty == nullptr)
+    {
+        return;
+    }
+    wrappedListProperty->instance()->beginBatch();
+}
+
+EXPORT void vmiListRuntimeEndBatch(WrappedVMIListRuntime* wrappedListProperty)
+{
+    if (wrappedListProperty == nullptr)
+    {
+        return;
+    }
+    wrappedListProperty->instance()->endBatch();
+}
+
 EXPORT bool vmiValueRuntimeHasChanged(
     WrappedVMIValueRuntime<ViewModelInstanceValueRuntime>* wrappedValue)
 {
@@ -4023,75 +4063,169 @@ EXPORT void initBindingCallbacks(
 }
 
 #ifdef WITH_RIVE_WORKER
+#include <atomic>
 #include <condition_variable>
 #include <deque>
 #include <thread>
 
-struct Work
-{
-    rcp<WrappedStateMachine> smi;
-    bool done;
-};
-
+// Advances batches of state machines on a pool of worker threads.
+//
+// Each batch is split into contiguous runs, one per lane (one lane per worker
+// plus one for the calling thread). Workers take items from the front of their
+// own lane and, once it is empty, steal from the back of the others. Idle
+// workers sleep until the next batch; nothing polls.
+//
+// When drawing, the calling thread draws finished items in order while the
+// rest are still advancing, and helps with the advancing whenever the next
+// item isn't ready. If the target renderer supports it (see DrawRecorder),
+// workers also record each artboard's draw right after advancing it into a
+// buffer owned by that item, and the calling thread only appends those buffers
+// in order.
 class RiveWorker
 {
 private:
-    static const int threadCount = 6;
+    struct Item
+    {
+        WrappedStateMachine* smi;
+        std::atomic<bool> done;
+        // This item's draw when recording. It is taken out of the lane's
+        // recorder once complete, so the calling thread can append it while
+        // that lane keeps recording. Reused from batch to batch.
+        DrawRecorder* recorder;
+        std::vector<uint8_t> recording;
+    };
+
+    struct Lane
+    {
+        std::mutex mutex;
+        std::deque<size_t> items;
+        std::unique_ptr<DrawRecorder> recorder;
+    };
+
     static RiveWorker* sm_instance;
-    static bool sm_exiting;
-    std::vector<Work> m_work;
-    std::condition_variable m_haveWork;
-    std::condition_variable m_didSomeWork;
+    static std::atomic<bool> sm_exiting;
+
     std::vector<std::thread> m_workThreads;
+    // One per worker, plus the calling thread's at the back.
+    std::vector<std::unique_ptr<Lane>> m_lanes;
+    std::unique_ptr<Item[]> m_items;
+    size_t m_itemCapacity = 0;
+    float m_elapsedSeconds = 0.0f;
+    bool m_record = false;
+
     std::mutex m_mutex;
-    float m_elapsedSeconds;
-    uint64_t m_workIndex = 0;
-    uint64_t m_completed = 0;
-    uint64_t m_toComplete = 0;
+    std::condition_variable m_haveWork;
+    std::condition_variable m_didSomeWork;
+    uint64_t m_generation = 0;
 
     RiveWorker()
     {
         std::atexit(atExit);
-        for (int i = 0; i < threadCount; i++)
+        unsigned threadCount = std::thread::hardware_concurrency();
+        threadCount = threadCount > 1 ? threadCount - 1 : 1;
+        for (unsigned i = 0; i <= threadCount; i++)
+        {
+            m_lanes.push_back(rivestd::make_unique<Lane>());
+        }
+        for (unsigned i = 0; i < threadCount; i++)
+        {
+            m_workThreads.emplace_back(std::thread(staticWorkThread, this, i));
+        }
+    }
+
+    bool takeItem(size_t laneIndex, size_t* itemIndex)
+    {
+        {
+            Lane& lane = *m_lanes[laneIndex];
+            std::unique_lock<std::mutex> lock(lane.mutex);
+            if (!lane.items.empty())
+            {
+                *itemIndex = lane.items.front();
+                lane.items.pop_front();
+                return true;
+            }
+        }
+        for (size_t i = 1; i < m_lanes.size(); i++)
+        {
+            Lane& victim = *m_lanes[(laneIndex + i) % m_lanes.size()];
+            std::unique_lock<std::mutex> lock(victim.mutex);
+            if (!victim.items.empty())
+            {
+                *itemIndex = victim.items.back();
+                victim.items.pop_back();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void runItem(size_t laneIndex, size_t itemIndex)
+    {
+        Item& item = m_items[itemIndex];
+        StateMachineInstance* stateMachine = item.smi->stateMachine();
+        stateMachine->advanceAndApply(m_elapsedSeconds);
+        if (m_record)
+        {
+            DrawRecorder* recorder = m_lanes[laneIndex]->recorder.get();
+            WrappedArtboard* wrappedArtboard = static_cast<WrappedArtboard*>(
+                stateMachine->artboard()->callbackUserData);
+            Renderer* renderer = recorder->renderer();
+            renderer->save();
+            renderer->transform(wrappedArtboard->renderTransform);
+            wrappedArtboard->artboard()->draw(renderer);
+            renderer->restore();
+            item.recorder = recorder;
+            recorder->takeRecording(&item.recording);
+        }
+        item.done.store(true, std::memory_order_release);
+        // Taking the lock orders this with the caller checking the predicate
+        // before it waits, so the wakeup can't be lost.
         {
-            m_workThreads.emplace_back(std::thread(staticWorkThread, this));
+            std::unique_lock<std::mutex> lock(m_mutex);
         }
+        m_didSomeWork.notify_one();
     }
 
-    void workThread()
+    void workThread(size_t laneIndex)
     {
-        while (!sm_exiting)
+        uint64_t generation = 0;
+        while (true)
         {
-            Work* work = nullptr;
             {
                 std::unique_lock<std::mutex> lock(m_mutex);
-                if (m_workIndex < m_work.size())
-                {
-                    work = &m_work[m_workIndex++];
-                }
-                else
+                m_haveWork.wait(lock, [&] {
+                    return m_generation != generation || sm_exiting;
+                });
+                if (sm_exiting)
                 {
-                    m_haveWork.wait_for(lock, std::chrono::milliseconds(100));
+                    return;
                 }
+                generation = m_generation;
             }
-            if (work != nullptr)
+            size_t itemIndex;
+            while (takeItem(laneIndex, &itemIndex))
             {
-                work->smi->stateMachine()->advanceAndApply(m_elapsedSeconds);
-                std::unique_lock<std::mutex> lock(m_mutex);
-                work->done = true;
-                m_completed++;
+                runItem(laneIndex, itemIndex);
             }
-            m_didSomeWork.notify_all();
         }
     }
 
-    static void staticWorkThread(void* w)
+    static void staticWorkThread(RiveWorker* worker, size_t laneIndex)
     {
-        RiveWorker* worker = static_cast<RiveWorker*>(w);
-        worker->workThread();
+        worker->workThread(laneIndex);
     }
 
-    static void atExit() { sm_exiting = true; }
+    static void atExit()
+    {
+        sm_exiting = true;
+        if (sm_instance != nullptr)
+        {
+            {
+                std::unique_lock<std::mutex> lock(sm_instance->m_mutex);
+            }
+            sm_instance->m_haveWork.notify_all();
+        }
+    }
 
 public:
     static RiveWorker* get()
@@ -4104,74 +4238,130 @@ public:
         return sm_instance;
     }
 
-    void add(float elapsedSeconds, WrappedStateMachine** smi, uint64_t count)
+    // Advances the state machines, calling draw (if any) on each one in order
+    // as soon as it and all the ones before it are done. If renderer is
+    // provided and can merge recorded draws, the draws are recorded on the
+    // workers instead and draw is not called.
+    void run(float elapsedSeconds,
+             WrappedStateMachine** smi,
+             uint64_t count,
+             Renderer* renderer,
+             const std::function<void(WrappedStateMachine*)>& draw)
     {
+        if (count == 0 || sm_exiting)
         {
-            std::unique_lock<std::mutex> lock(m_mutex);
-            m_elapsedSeconds = elapsedSeconds;
-            m_toComplete = count;
-            m_completed = 0;
-            m_workIndex = 0;
-            m_work.clear();
-            for (uint64_t i = 0; i < count; i++)
+            return;
+        }
+        if (m_itemCapacity < count)
+        {
+            m_items.reset(new Item[count]);
+            m_itemCapacity = count;
+        }
+        for (uint64_t i = 0; i < count; i++)
+        {
+            Item& item = m_items[i];
+            item.smi = smi[i];
+            item.done.store(false, std::memory_order_relaxed);
+            item.recorder = nullptr;
+        }
+
+        m_record = false;
+        if (renderer != nullptr)
+        {
+            m_record = true;
+            for (auto& lane : m_lanes)
             {
-                m_work.push_back({ref_rcp(smi[i]), false});
+                lane->recorder = makeDrawRecorder(renderer);
+                if (lane->recorder == nullptr)
+                {
+                    m_record = false;
+                    break;
+                }
             }
         }
-        m_haveWork.notify_all();
-    }
+        m_elapsedSeconds = elapsedSeconds;
 
-    void complete(
-        std::function<void(rcp<WrappedStateMachine>)> callback = nullptr)
-    {
-        int completedIndex = 0;
-        while (!sm_exiting)
+        size_t laneCount = m_lanes.size();
+        for (size_t i = 0; i < laneCount; i++)
+        {
+            Lane& lane = *m_lanes[i];
+            std::unique_lock<std::mutex> lock(lane.mutex);
+            for (size_t j = count * i / laneCount;
+                 j < count * (i + 1) / laneCount;
+                 j++)
+            {
+                lane.items.push_back(j);
+            }
+        }
         {
-            // Keep rendering artboards that are done.
             std::unique_lock<std::mutex> lock(m_mutex);
-            if (callback != nullptr)
+            m_generation++;
+        }
+        m_haveWork.notify_all();
+
+        size_t callerLane = laneCount - 1;
+        uint64_t nextToDraw = 0;
+        while (nextToDraw < count)
+        {
+            Item& next = m_items[nextToDraw];
+            if (next.done.load(std::memory_order_acquire))
             {
-                // Any artboards ready to draw?
-                if (completedIndex < m_toComplete &&
-                    m_work[completedIndex].done)
+                if (m_record)
                 {
-                    // While locked, count how many we can draw unlocked.
-                    uint64_t completedFrom = completedIndex;
-                    while (++completedIndex < m_toComplete &&
-                           m_work[completedIndex].done)
-                    {
-                        // Intentionally empty.
-                    }
-                    lock.unlock();
-                    while (completedFrom < completedIndex)
-                    {
-                        callback(m_work[completedFrom].smi);
-                        completedFrom++;
-                    }
-                    continue;
+                    next.recorder->appendTo(next.recording);
                 }
+                else if (draw)
+                {
+                    draw(next.smi);
+                }
+                nextToDraw++;
+                continue;
             }
-            if (m_toComplete == m_completed)
+            size_t itemIndex;
+            if (takeItem(callerLane, &itemIndex))
             {
-                break;
+                runItem(callerLane, itemIndex);
+                continue;
+            }
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_didSomeWork.wait(lock, [&] {
+                return next.done.load(std::memory_order_acquire) ||
+                       sm_exiting;
+            });
+            if (sm_exiting)
+            {
+                return;
             }
-            m_didSomeWork.wait_for(lock, std::chrono::milliseconds(100));
+        }
+
+        for (auto& lane : m_lanes)
+        {
+            lane->recorder = nullptr;
         }
     }
 };
 
 RiveWorker* RiveWorker::sm_instance = nullptr;
-bool RiveWorker::sm_exiting = false;
+std::atomic<bool> RiveWorker::sm_exiting{false};
 #endif
 
+static void drawStateMachineArtboard(WrappedStateMachine* smi,
+                                     Renderer* renderer)
+{
+    WrappedArtboard* wrappedArtboard = static_cast<WrappedArtboard*>(
+        smi->stateMachine()->artboard()->callbackUserData);
+    renderer->save();
+    renderer->transform(wrappedArtboard->renderTransform);
+    wrappedArtboard->artboard()->draw(renderer);
+    renderer->restore();
+}
+
 EXPORT void stateMachineInstanceBatchAdvance(WrappedStateMachine** smi,
                                              SizeType count,
                                              float elapsedSeconds)
 {
 #ifdef WITH_RIVE_WORKER
-    RiveWorker* worker = RiveWorker::get();
-    worker->add(elapsedSeconds, smi, count);
-    worker->complete();
+    RiveWorker::get()->run(elapsedSeconds, smi, count, nullptr, nullptr);
 #else
     for (int i = 0; i < count; i++)
     {
@@ -4190,28 +4380,19 @@ EXPORT void stateMachineInstanceBatchAdvanceAndRender(WrappedStateMachine** smi,
         return;
     }
 #ifdef WITH_RIVE_WORKER
-    RiveWorker* worker = RiveWorker::get();
-    worker->add(elapsedSeconds, smi, count);
-    worker->complete([&](rcp<WrappedStateMachine> smi) {
-        WrappedArtboard* wrappedArtboard = static_cast<WrappedArtboard*>(
-            smi->stateMachine()->artboard()->callbackUserData);
-        renderer->save();
-        renderer->transform(wrappedArtboard->renderTransform);
-        wrappedArtboard->artboard()->draw(renderer);
-        renderer->restore();
-    });
+    RiveWorker::get()->run(elapsedSeconds,
+                           smi,
+                           count,
+                           renderer,
+                           [renderer](WrappedStateMachine* smi) {
+                               drawStateMachineArtboard(smi, renderer);
+                           });
 #else
     for (int i = 0; i < count; i++)
     {
         smi[i]->stateMachine()->advanceAndApply(elapsedSeconds);
-        WrappedArtboard* wrappedArtboard = static_cast<WrappedArtboard*>(
-            smi[i]->stateMachine()->artboard()->callbackUserData);
-        renderer->save();
-        renderer->transform(wrappedArtboard->renderTransform);
-        wrappedArtboard->artboard()->draw(renderer);
-        renderer->restore();
-    }
-    return;
+        drawStateMachineArtboard(smi[i], renderer);
+    }
 #endif
 }
 
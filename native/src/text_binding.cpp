@@ -1,5 +1,6 @@
 #ifdef __EMSCRIPTEN__
 #include "rive/text/font_hb.hpp"
+#include "text_layout_buffer.hpp"
 
 #include <emscripten.h>
 #include <emscripten/bind.h>
@@ -60,19 +61,7 @@ struct GlyphPath
 GlyphPath makeGlyphPath(WasmPtr fontPtr, rive::GlyphID id)
 {
     auto font = reinterpret_cast<HBFont*>(fontPtr);
-    rive::RawPath* path = nullptr;
-
-    const rive::RawPath& glyphRawPath = font->getPath(id);
-    if (glyphRawPath.computeCoarseArea() >= 0)
-    {
-        path = new rive::RawPath(glyphRawPath);
-    }
-    else
-    {
-        rive::RawPath scratchPath;
-        scratchPath.addPathBackwards(glyphRawPath);
-        path = new rive::RawPath(scratchPath);
-    }
+    rive::RawPath* path = new rive::RawPath(rive::MakeGlyphOutline(font, id));
 
     return {
         .rawPath = (WasmPtr)path,
@@ -97,45 +86,13 @@ WasmPtr breakLines(WasmPtr paragraphsPtr,
                    uint8_t align,
                    uint8_t wrap)
 {
-    bool autoWidth = width == -1.0f;
     auto paragraphs =
         reinterpret_cast<rive::SimpleArray<rive::Paragraph>*>(paragraphsPtr);
-    float paragraphWidth = width;
-
-    rive::SimpleArrayBuilder<uint16_t> paragraphLines;
-
-    rive::SimpleArray<rive::SimpleArray<rive::GlyphLine>>* lines =
-        new rive::SimpleArray<rive::SimpleArray<rive::GlyphLine>>(
-            paragraphs->size());
-    rive::SimpleArray<rive::SimpleArray<rive::GlyphLine>>& linesRef = *lines;
-    size_t paragraphIndex = 0;
-    for (auto& para : *paragraphs)
-    {
-        linesRef[paragraphIndex] = rive::GlyphLine::BreakLines(
-            para.runs,
-            (autoWidth || (rive::TextWrap)wrap == rive::TextWrap::noWrap)
-                ? -1.0f
-                : width);
-        if (autoWidth)
-        {
-            paragraphWidth = std::max(
-                paragraphWidth,
-                rive::GlyphLine::ComputeMaxWidth(linesRef[paragraphIndex],
-                                                 para.runs));
-        }
-        paragraphIndex++;
-    }
-    paragraphIndex = 0;
-    for (auto& para : *paragraphs)
-    {
-        rive::GlyphLine::ComputeLineSpacing(paragraphIndex == 0,
-                                            linesRef[paragraphIndex],
-                                            para.runs,
-                                            paragraphWidth,
-                                            (rive::TextAlign)align);
-        paragraphIndex++;
-    }
-    return (WasmPtr)lines;
+    return (WasmPtr) new rive::SimpleArray<rive::SimpleArray<rive::GlyphLine>>(
+        rive::BreakParagraphLines(*paragraphs,
+                                  width,
+                                  (rive::TextAlign)align,
+                                  (rive::TextWrap)wrap));
 }
 
 void deleteLines(WasmPtr lines)
@@ -272,6 +229,52 @@ WasmPtr shapeText(emscripten::val codeUnits,
     return {};
 }
 
+// Shapes and line breaks the text in one call, returning the whole layout (and
+// optionally the glyph outlines it uses) as a single flat buffer. See
+// text_layout_buffer.hpp for the format.
+WasmPtr shapeAndBreakText(emscripten::val codeUnits,
+                          emscripten::val runsList,
+                          int defaultLevel,
+                          float width,
+                          uint8_t align,
+                          uint8_t wrap,
+                          uint32_t flags)
+{
+    std::vector<uint8_t> runsBytes(runsList["byteLength"].as<unsigned>());
+    {
+        emscripten::val memoryView{
+            emscripten::typed_memory_view(runsBytes.size(), runsBytes.data())};
+        memoryView.call<void>("set", runsList);
+    }
+    std::vector<uint32_t> codeUnitArray(codeUnits["length"].as<unsigned>());
+    {
+        emscripten::val memoryView{
+            emscripten::typed_memory_view(codeUnitArray.size(),
+                                          codeUnitArray.data())};
+        memoryView.call<void>("set", codeUnits);
+    }
+
+    auto runCount = runsBytes.size() / sizeof(rive::TextRun);
+    rive::TextRun* runs = reinterpret_cast<rive::TextRun*>(runsBytes.data());
+    if (runCount == 0 || codeUnitArray.empty())
+    {
+        return (WasmPtr) nullptr;
+    }
+    return (WasmPtr) new rive::SimpleArray<uint8_t>(rive::MakeTextLayoutBuffer(
+        codeUnitArray,
+        rive::Span<const rive::TextRun>(runs, runCount),
+        defaultLevel,
+        width,
+        (rive::TextAlign)align,
+        (rive::TextWrap)wrap,
+        flags));
+}
+
+void deleteTextLayout(WasmPtr layout)
+{
+    delete reinterpret_cast<rive::SimpleArray<uint8_t>*>(layout);
+}
+
 WasmPtr makeFontWithOptions(WasmPtr fontPtr,
                             emscripten::val coordsList,
                             emscripten::val featuresList)
@@ -398,6 +401,8 @@ EMSCRIPTEN_BINDINGS(RiveText)
 
     function("breakLines", &breakLines);
     function("deleteLines", &deleteLines);
+    function("shapeAndBreakText", &shapeAndBreakText);
+    function("deleteTextLayout", &deleteTextLayout);
     function("init", &init);
 
 #ifdef DEBUG
@@ -410,6 +415,7 @@ EMSCRIPTEN_BINDINGS(RiveText)
 
 #include "rive_native/external.hpp"
 #include "rive/text/font_hb.hpp"
+#include "text_layout_buffer.hpp"
 
 EXPORT
 rive::Font* makeFont(const uint8_t* bytes, uint64_t length)
@@ -451,19 +457,7 @@ struct GlyphPath
 EXPORT
 GlyphPath makeGlyphPath(rive::Font* font, rive::GlyphID id)
 {
-    rive::RawPath* path = nullptr;
-
-    const rive::RawPath& glyphRawPath = font->getPath(id);
-    if (glyphRawPath.computeCoarseArea() >= 0)
-    {
-        path = new rive::RawPath(glyphRawPath);
-    }
-    else
-    {
-        rive::RawPath scratchPath;
-        scratchPath.addPathBackwards(glyphRawPath);
-        path = new rive::RawPath(scratchPath);
-    }
+    rive::RawPath* path = new rive::RawPath(rive::MakeGlyphOutline(font, id));
 
     return {
         .rawPath = path,
@@ -561,41 +555,11 @@ EXPORT rive::SimpleArray<rive::SimpleArray<rive::GlyphLine>>* breakLines(
     uint8_t align,
     uint8_t wrap)
 {
-    bool autoWidth = width == -1.0f;
-    float paragraphWidth = width;
-
-    rive::SimpleArray<rive::SimpleArray<rive::GlyphLine>>* lines =
-        new rive::SimpleArray<rive::SimpleArray<rive::GlyphLine>>(
-            paragraphs->size());
-    rive::SimpleArray<rive::SimpleArray<rive::GlyphLine>>& linesRef = *lines;
-    size_t paragraphIndex = 0;
-    for (auto& para : *paragraphs)
-    {
-        linesRef[paragraphIndex] = rive::GlyphLine::BreakLines(
-            para.runs,
-            (autoWidth || (rive::TextWrap)wrap == rive::TextWrap::noWrap)
-                ? -1.0f
-                : width);
-        if (autoWidth)
-        {
-            paragraphWidth = std::max(
-                paragraphWidth,
-                rive::GlyphLine::ComputeMaxWidth(linesRef[paragraphIndex],
-                                                 para.runs));
-        }
-        paragraphIndex++;
-    }
-    paragraphIndex = 0;
-    for (auto& para : *paragraphs)
-    {
-        rive::GlyphLine::ComputeLineSpacing(paragraphIndex == 0,
-                                            linesRef[paragraphIndex],
-                                            para.runs,
-                                            paragraphWidth,
-                                            (rive::TextAlign)align);
-        paragraphIndex++;
-    }
-    return lines;
+    return new rive::SimpleArray<rive::SimpleArray<rive::GlyphLine>>(
+        rive::BreakParagraphLines(*paragraphs,
+                                  width,
+                                  (rive::TextAlign)align,
+                                  (rive::TextWrap)wrap));
 }
 
 EXPORT void deleteLines(
@@ -604,6 +568,39 @@ EXPORT void deleteLines(
     delete result;
 }
 
+// Shapes and line breaks the text in one call, returning the whole layout (and
+// optionally the glyph outlines it uses) as a single flat buffer the host can
+// map directly. See text_layout_buffer.hpp for the format.
+EXPORT
+rive::SimpleArray<uint8_t>* shapeAndBreakText(const uint32_t* text,
+                                              uint64_t length,
+                                              rive::TextRun* runs,
+                                              uint64_t runsLength,
+                                              int defaultLevel,
+                                              float width,
+                                              uint8_t align,
+                                              uint8_t wrap,
+                                              uint32_t flags)
+{
+    if (runsLength == 0 || length == 0)
+    {
+        return nullptr;
+    }
+    return new rive::SimpleArray<uint8_t>(rive::MakeTextLayoutBuffer(
+        rive::Span<const uint32_t>(text, length),
+        rive::Span<const rive::TextRun>(runs, runsLength),
+        defaultLevel,
+        width,
+        (rive::TextAlign)align,
+        (rive::TextWrap)wrap,
+        flags));
+}
+
+EXPORT void deleteTextLayout(rive::SimpleArray<uint8_t>* layout)
+{
+    delete layout;
+}
+
 std::vector<rive::Font*> fallbackFonts;
 bool useFallbackFonts = false;
 
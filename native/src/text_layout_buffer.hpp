@@ -0,0 +1,381 @@
+#ifndef _RIVE_TEXT_LAYOUT_BUFFER_HPP_
+#define _RIVE_TEXT_LAYOUT_BUFFER_HPP_
+
+#include "rive/math/raw_path.hpp"
+#include "rive/text_engine.hpp"
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <utility>
+#include <vector>
+
+namespace rive
+{
+// Line breaks every paragraph and computes line spacing. A width of -1 sizes
+// the lines to the widest paragraph, which is returned in alignedWidth.
+inline SimpleArray<SimpleArray<GlyphLine>> BreakParagraphLines(
+    const SimpleArray<Paragraph>& paragraphs,
+    float width,
+    TextAlign align,
+    TextWrap wrap,
+    float* alignedWidth = nullptr)
+{
+    bool autoWidth = width == -1.0f;
+    float paragraphWidth = width;
+
+    SimpleArray<SimpleArray<GlyphLine>> lines(paragraphs.size());
+    size_t paragraphIndex = 0;
+    for (auto& para : paragraphs)
+    {
+        lines[paragraphIndex] = GlyphLine::BreakLines(
+            para.runs,
+            (autoWidth || wrap == TextWrap::noWrap) ? -1.0f : width);
+        if (autoWidth)
+        {
+            paragraphWidth = std::max(
+                paragraphWidth,
+                GlyphLine::ComputeMaxWidth(lines[paragraphIndex], para.runs));
+        }
+        paragraphIndex++;
+    }
+    paragraphIndex = 0;
+    for (auto& para : paragraphs)
+    {
+        GlyphLine::ComputeLineSpacing(paragraphIndex == 0,
+                                      lines[paragraphIndex],
+                                      para.runs,
+                                      paragraphWidth,
+                                      align);
+        paragraphIndex++;
+    }
+    if (alignedWidth != nullptr)
+    {
+        *alignedWidth = paragraphWidth;
+    }
+    return lines;
+}
+
+// Glyph outline with the winding the renderer expects: glyphs come back from
+// the font in either direction depending on the format.
+inline RawPath MakeGlyphOutline(const Font* font, GlyphID id)
+{
+    RawPath glyphRawPath = font->getPath(id);
+    if (glyphRawPath.computeCoarseArea() >= 0)
+    {
+        return glyphRawPath;
+    }
+    RawPath reversed;
+    reversed.addPathBackwards(glyphRawPath);
+    return reversed;
+}
+
+// Shaping and line breaking results for a whole set of paragraphs, encoded in
+// one flat buffer the host can read in place instead of walking native
+// objects one call at a time.
+//
+// The buffer starts with a TextLayoutHeader. Every section it points to is a
+// tightly packed little endian array, 8 byte aligned from the start of the
+// buffer:
+//  - paragraphs: TextLayoutParagraph[paragraphCount]
+//  - runs: TextLayoutRun[runCount]
+//  - glyphIds: uint16_t[glyphCount]
+//  - textIndices: uint32_t[glyphCount]
+//  - advances: float[glyphCount]
+//  - xpos: float[glyphCount + runCount], each run has glyphCount + 1 entries
+//    starting at its firstX
+//  - offsets: float[glyphCount * 2]
+//  - lines: GlyphLine[lineCount], run indices are relative to the paragraph
+//  - glyphOutlines: uint32_t[glyphCount], index into outlines
+//  - outlines: TextLayoutOutline[outlineCount]
+//  - verbs: uint8_t[verbCount], PathVerb values
+//  - points: float[pointCount * 2]
+// The outline sections are only present (non zero offsets) when the layout
+// was made with TextLayoutFlags::glyphOutlines. Outlines are shared by every
+// glyph using the same font and glyph id.
+enum class TextLayoutFlags : uint32_t
+{
+    none = 0,
+    glyphOutlines = 1 << 0,
+};
+
+struct TextLayoutHeader
+{
+    static constexpr uint32_t currentVersion = 1;
+
+    uint32_t version;
+    uint32_t flags;
+    // Width the lines were aligned to, the widest line when laid out with
+    // auto width.
+    float width;
+    uint32_t byteLength;
+    uint32_t paragraphCount;
+    uint32_t runCount;
+    uint32_t glyphCount;
+    uint32_t lineCount;
+    uint32_t outlineCount;
+    uint32_t verbCount;
+    uint32_t pointCount;
+    // Byte offsets of each section from the start of the buffer.
+    uint32_t paragraphs;
+    uint32_t runs;
+    uint32_t glyphIds;
+    uint32_t textIndices;
+    uint32_t advances;
+    uint32_t xpos;
+    uint32_t offsets;
+    uint32_t lines;
+    uint32_t glyphOutlines;
+    uint32_t outlines;
+    uint32_t verbs;
+    uint32_t points;
+    uint32_t reserved;
+};
+
+struct TextLayoutParagraph
+{
+    uint32_t firstRun;
+    uint32_t runCount;
+    uint32_t firstLine;
+    uint32_t lineCount;
+    uint32_t level;
+    uint32_t reserved;
+};
+
+struct TextLayoutRun
+{
+    // Address of the rive::Font, matching what the host gets from makeFont.
+    uint64_t font;
+    float size;
+    float lineHeight;
+    float letterSpacing;
+    uint32_t styleId;
+    uint32_t level;
+    uint32_t firstGlyph;
+    uint32_t glyphCount;
+    uint32_t firstX;
+};
+
+struct TextLayoutOutline
+{
+    uint32_t firstVerb;
+    uint32_t verbCount;
+    uint32_t firstPoint;
+    uint32_t pointCount;
+};
+
+static_assert(sizeof(TextLayoutHeader) == 96, "host reads a fixed header");
+static_assert(sizeof(TextLayoutParagraph) == 24, "host reads fixed records");
+static_assert(sizeof(TextLayoutRun) == 40, "host reads fixed records");
+static_assert(sizeof(TextLayoutOutline) == 16, "host reads fixed records");
+static_assert(sizeof(GlyphLine) == 32, "host reads fixed records");
+
+inline SimpleArray<uint8_t> MakeTextLayoutBuffer(Span<const Unichar> text,
+                                                 Span<const TextRun> runs,
+                                                 int defaultLevel,
+                                                 float width,
+                                                 TextAlign align,
+                                                 TextWrap wrap,
+                                                 uint32_t flags)
+{
+    if (text.empty() || runs.empty())
+    {
+        return SimpleArray<uint8_t>();
+    }
+    SimpleArray<Paragraph> paragraphs =
+        runs[0].font->shapeText(text, runs, defaultLevel);
+    float alignedWidth = width;
+    SimpleArray<SimpleArray<GlyphLine>> lines =
+        BreakParagraphLines(paragraphs, width, align, wrap, &alignedWidth);
+
+    TextLayoutHeader header = {};
+    header.version = TextLayoutHeader::currentVersion;
+    header.flags = flags;
+    header.width = alignedWidth;
+    header.paragraphCount = (uint32_t)paragraphs.size();
+    for (size_t i = 0; i < paragraphs.size(); i++)
+    {
+        header.runCount += (uint32_t)paragraphs[i].runs.size();
+        header.lineCount += (uint32_t)lines[i].size();
+        for (const GlyphRun& run : paragraphs[i].runs)
+        {
+            header.glyphCount += (uint32_t)run.glyphs.size();
+        }
+    }
+
+    // Deduplicate outlines up front so the buffer can be sized exactly.
+    bool withOutlines =
+        (flags & (uint32_t)TextLayoutFlags::glyphOutlines) != 0;
+    std::vector<RawPath> outlines;
+    std::vector<uint32_t> glyphOutlines;
+    if (withOutlines)
+    {
+        std::map<std::pair<const Font*, GlyphID>, uint32_t> outlineLookup;
+        glyphOutlines.reserve(header.glyphCount);
+        for (const Paragraph& paragraph : paragraphs)
+        {
+            for (const GlyphRun& run : paragraph.runs)
+            {
+                for (GlyphID glyph : run.glyphs)
+                {
+                    auto key = std::make_pair(run.font.get(), glyph);
+                    auto itr = outlineLookup.find(key);
+                    if (itr == outlineLookup.end())
+                    {
+                        itr = outlineLookup
+                                  .emplace(key, (uint32_t)outlines.size())
+                                  .first;
+                        outlines.push_back(
+                            MakeGlyphOutline(run.font.get(), glyph));
+                        header.verbCount +=
+                            (uint32_t)outlines.back().verbs().size();
+                        header.pointCount +=
+                            (uint32_t)outlines.back().points().size();
+                    }
+                    glyphOutlines.push_back(itr->second);
+                }
+            }
+        }
+        header.outlineCount = (uint32_t)outlines.size();
+    }
+
+    uint32_t byteLength = sizeof(TextLayoutHeader);
+    auto section = [&byteLength](size_t size) {
+        byteLength = (byteLength + 7) & ~7u;
+        uint32_t offset = byteLength;
+        byteLength += (uint32_t)size;
+        return offset;
+    };
+    header.paragraphs =
+        section(header.paragraphCount * sizeof(TextLayoutParagraph));
+    header.runs = section(header.runCount * sizeof(TextLayoutRun));
+    header.glyphIds = section(header.glyphCount * sizeof(GlyphID));
+    header.textIndices = section(header.glyphCount * sizeof(uint32_t));
+    header.advances = section(header.glyphCount * sizeof(float));
+    header.xpos =
+        section((header.glyphCount + header.runCount) * sizeof(float));
+    header.offsets = section(header.glyphCount * sizeof(Vec2D));
+    header.lines = section(header.lineCount * sizeof(GlyphLine));
+    if (withOutlines)
+    {
+        header.glyphOutlines = section(header.glyphCount * sizeof(uint32_t));
+        header.outlines =
+            section(header.outlineCount * sizeof(TextLayoutOutline));
+        header.verbs = section(header.verbCount * sizeof(PathVerb));
+        header.points = section(header.pointCount * sizeof(Vec2D));
+    }
+    header.byteLength = byteLength;
+
+    SimpleArray<uint8_t> buffer((size_t)byteLength);
+    uint8_t* bytes = buffer.data();
+    memset(bytes, 0, byteLength);
+    memcpy(bytes, &header, sizeof(TextLayoutHeader));
+
+    auto write = [bytes](uint32_t& offset, const void* data, size_t size) {
+        if (size != 0)
+        {
+            memcpy(bytes + offset, data, size);
+            offset += (uint32_t)size;
+        }
+    };
+
+    uint32_t paragraphOffset = header.paragraphs;
+    uint32_t runOffset = header.runs;
+    uint32_t glyphIdOffset = header.glyphIds;
+    uint32_t textIndexOffset = header.textIndices;
+    uint32_t advanceOffset = header.advances;
+    uint32_t xOffset = header.xpos;
+    uint32_t offsetOffset = header.offsets;
+    uint32_t lineOffset = header.lines;
+    uint32_t runIndex = 0;
+    uint32_t lineIndex = 0;
+    uint32_t glyphIndex = 0;
+    uint32_t xIndex = 0;
+    for (size_t i = 0; i < paragraphs.size(); i++)
+    {
+        const Paragraph& paragraph = paragraphs[i];
+        TextLayoutParagraph flatParagraph = {};
+        flatParagraph.firstRun = runIndex;
+        flatParagraph.runCount = (uint32_t)paragraph.runs.size();
+        flatParagraph.firstLine = lineIndex;
+        flatParagraph.lineCount = (uint32_t)lines[i].size();
+        flatParagraph.level = paragraph.level;
+        write(paragraphOffset, &flatParagraph, sizeof(flatParagraph));
+
+        for (const GlyphRun& run : paragraph.runs)
+        {
+            uint32_t glyphCount = (uint32_t)run.glyphs.size();
+            TextLayoutRun flatRun = {};
+            flatRun.font = (uint64_t)(uintptr_t)run.font.get();
+            flatRun.size = run.size;
+            flatRun.lineHeight = run.lineHeight;
+            flatRun.letterSpacing = run.letterSpacing;
+            flatRun.styleId = run.styleId;
+            flatRun.level = run.level;
+            flatRun.firstGlyph = glyphIndex;
+            flatRun.glyphCount = glyphCount;
+            flatRun.firstX = xIndex;
+            write(runOffset, &flatRun, sizeof(flatRun));
+
+            write(glyphIdOffset,
+                  run.glyphs.data(),
+                  glyphCount * sizeof(GlyphID));
+            write(textIndexOffset,
+                  run.textIndices.data(),
+                  glyphCount * sizeof(uint32_t));
+            write(advanceOffset,
+                  run.advances.data(),
+                  glyphCount * sizeof(float));
+            // xpos normally has the extra right most extent, but don't trust
+            // it blindly when sizing the write.
+            size_t xCount = std::min(run.xpos.size(), (size_t)glyphCount + 1);
+            write(xOffset, run.xpos.data(), xCount * sizeof(float));
+            xOffset += (uint32_t)((glyphCount + 1 - xCount) * sizeof(float));
+            write(offsetOffset,
+                  run.offsets.data(),
+                  glyphCount * sizeof(Vec2D));
+
+            runIndex++;
+            glyphIndex += glyphCount;
+            xIndex += glyphCount + 1;
+        }
+        write(lineOffset,
+              lines[i].data(),
+              lines[i].size() * sizeof(GlyphLine));
+        lineIndex += (uint32_t)lines[i].size();
+    }
+
+    if (withOutlines)
+    {
+        uint32_t glyphOutlineOffset = header.glyphOutlines;
+        write(glyphOutlineOffset,
+              glyphOutlines.data(),
+              glyphOutlines.size() * sizeof(uint32_t));
+
+        uint32_t outlineOffset = header.outlines;
+        uint32_t verbOffset = header.verbs;
+        uint32_t pointOffset = header.points;
+        uint32_t verbIndex = 0;
+        uint32_t pointIndex = 0;
+        for (const RawPath& outline : outlines)
+        {
+            TextLayoutOutline flatOutline = {};
+            flatOutline.firstVerb = verbIndex;
+            flatOutline.verbCount = (uint32_t)outline.verbs().size();
+            flatOutline.firstPoint = pointIndex;
+            flatOutline.pointCount = (uint32_t)outline.points().size();
+            write(outlineOffset, &flatOutline, sizeof(flatOutline));
+            write(verbOffset,
+                  outline.verbs().data(),
+                  outline.verbs().size() * sizeof(PathVerb));
+            write(pointOffset,
+                  outline.points().data(),
+                  outline.points().size() * sizeof(Vec2D));
+            verbIndex += flatOutline.verbCount;
+            pointIndex += flatOutline.pointCount;
+        }
+    }
+    return buffer;
+}
+} // namespace rive
+
+#endif
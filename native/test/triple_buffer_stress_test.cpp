@@ -0,0 +1,343 @@
+/*
+ * Copyright 2025 Rive
+ */
+
+// Stress test for ReadWriteRing and Swapchain under contention, meant to be
+// run under ThreadSanitizer as well as on its own.
+//
+//   triple_buffer_stress_test [--frames N]
+//
+// Three threads share each ring, like the plugins do: a renderer that starts
+// frames, a "GPU" that completes them in order after a random delay, and a
+// reader that displays whatever is latest. Every target records who is using
+// it, so a target handed to the renderer while it is still in flight or being
+// displayed fails the test, as does a torn or out-of-order frame.
+//
+// Frames that are started and never published, e.g. when painting throws,
+// must not stall the renderer for good: their targets are reclaimed.
+
+#include "rive_native/read_write_ring.hpp"
+#include "rive_native/swapchain.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <thread>
+
+static std::atomic<int> g_failures{0};
+
+#define CHECK(condition)                                                       \
+    do                                                                         \
+    {                                                                          \
+        if (!(condition))                                                      \
+        {                                                                      \
+            fprintf(stderr,                                                    \
+                    "%s:%d: CHECK(%s) failed\n",                               \
+                    __FILE__,                                                  \
+                    __LINE__,                                                  \
+                    #condition);                                               \
+            g_failures++;                                                      \
+        }                                                                      \
+    } while (0)
+
+// A render target. Its payload is filled with the frame number, so a reader
+// can tell a complete frame from one that is still being written.
+struct Target
+{
+    static constexpr int payloadSize = 256;
+
+    std::atomic<int> writers{0};
+    std::atomic<int> readers{0};
+    uint64_t payload[payloadSize];
+
+    void write(uint64_t frame)
+    {
+        CHECK(writers.fetch_add(1) == 0);
+        CHECK(readers.load() == 0);
+        for (uint64_t& value : payload)
+        {
+            value = frame;
+        }
+    }
+
+    void finishWrite() { writers.fetch_sub(1); }
+
+    // Returns the frame number, or 0 if the target was torn.
+    uint64_t read()
+    {
+        readers.fetch_add(1);
+        CHECK(writers.load() == 0);
+        uint64_t frame = payload[0];
+        for (uint64_t value : payload)
+        {
+            if (value != frame)
+            {
+                frame = 0;
+            }
+        }
+        readers.fetch_sub(1);
+        return frame;
+    }
+};
+
+// Frames the renderer submitted, completed in order by the GPU thread.
+class GpuQueue
+{
+public:
+    void submit(uint32_t slot)
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_slots.push_back(slot);
+        }
+        m_cond.notify_one();
+    }
+
+    void finish()
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_finished = true;
+        }
+        m_cond.notify_one();
+    }
+
+    // Returns false once finished and drained.
+    bool next(uint32_t* slot)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_cond.wait(lock, [this] { return !m_slots.empty() || m_finished; });
+        if (m_slots.empty())
+        {
+            return false;
+        }
+        *slot = m_slots.front();
+        m_slots.pop_front();
+        return true;
+    }
+
+private:
+    std::mutex m_mutex;
+    std::condition_variable m_cond;
+    std::deque<uint32_t> m_slots;
+    bool m_finished = false;
+};
+
+static void randomDelay(std::minstd_rand& random)
+{
+    if (random() % 4 == 0)
+    {
+        std::this_thread::sleep_for(std::chrono::microseconds(random() % 50));
+    }
+    else
+    {
+        std::this_thread::yield();
+    }
+}
+
+// Checks that the reader only ever moves forward and never sees a torn frame.
+static void readFrames(const std::atomic<bool>& done,
+                       const std::function<uint64_t()>& readLatest)
+{
+    std::minstd_rand random(3);
+    uint64_t lastFrame = 0;
+    uint64_t distinctFrames = 0;
+    while (!done.load())
+    {
+        uint64_t frame = readLatest();
+        // Frame 0 is the initial contents, before anything was published.
+        CHECK(frame >= lastFrame);
+        if (frame != lastFrame)
+        {
+            distinctFrames++;
+        }
+        lastFrame = frame;
+        randomDelay(random);
+    }
+    CHECK(distinctFrames > 0);
+}
+
+static void testReadWriteRing(uint64_t frameCount)
+{
+    ReadWriteRing ring;
+    Target targets[ReadWriteRing::ringSize];
+    for (Target& target : targets)
+    {
+        target.write(0);
+        target.finishWrite();
+    }
+    GpuQueue gpu;
+    std::atomic<bool> done{false};
+    uint64_t lastPublished = 0;
+
+    std::thread gpuThread([&] {
+        std::minstd_rand random(2);
+        uint32_t slot;
+        while (gpu.next(&slot))
+        {
+            randomDelay(random);
+            targets[slot].finishWrite();
+            CHECK(ring.nextRead() == slot);
+        }
+    });
+    std::thread readerThread([&] {
+        readFrames(done, [&] { return targets[ring.currentRead()].read(); });
+    });
+
+    std::minstd_rand random(1);
+    for (uint64_t frame = 1; frame <= frameCount; frame++)
+    {
+        uint32_t slot = ring.nextWrite();
+        CHECK(slot < ReadWriteRing::ringSize);
+        CHECK(ring.currentWrite() == slot);
+        targets[slot].write(frame);
+        lastPublished = frame;
+        gpu.submit(slot);
+        randomDelay(random);
+    }
+    gpu.finish();
+    gpuThread.join();
+    done = true;
+    readerThread.join();
+    // Every frame has been published, so the reader must end up on the last.
+    CHECK(targets[ring.currentRead()].read() == lastPublished);
+}
+
+static void testBeginWithoutPublish()
+{
+    using Clock = TripleBufferFrames::Clock;
+    const auto abandonAfter = std::chrono::milliseconds(20);
+    TripleBuffer buffer(3);
+    TripleBufferFrames frames(&buffer, abandonAfter);
+
+    // Slot 0 is being read, so two frames can start before running out.
+    uint32_t first = frames.begin();
+    uint32_t second = frames.begin();
+    CHECK(first != 0 && second != 0 && first != second);
+
+    // Neither is ever published. The next frame reuses the oldest one's
+    // target once it has been in flight for abandonAfter.
+    Clock::time_point start = Clock::now();
+    uint32_t third = frames.begin();
+    Clock::duration waited = Clock::now() - start;
+    CHECK(third == first);
+    CHECK(waited >= abandonAfter);
+    CHECK(waited < std::chrono::seconds(5));
+    // The second frame is already old enough, so this doesn't wait again.
+    start = Clock::now();
+    uint32_t fourth = frames.begin();
+    CHECK(fourth == second);
+    CHECK(Clock::now() - start < abandonAfter);
+
+    // Publishing resumes in start order with the reclaimed frames.
+    CHECK(frames.publishOldest() == third);
+    CHECK(buffer.acquireRead() == third);
+    CHECK(frames.publishOldest() == fourth);
+    CHECK(buffer.acquireRead() == fourth);
+    CHECK(frames.publishOldest() == TripleBuffer::noSlot);
+    CHECK(frames.begin() != fourth);
+
+    // The same through ReadWriteRing, with its default timeout: leaking every
+    // target still leaves the renderer able to start frames.
+    ReadWriteRing ring;
+    for (int i = 0; i < 4; i++)
+    {
+        CHECK(ring.nextWrite() != ring.currentRead());
+    }
+}
+
+static void testSwapchain(uint64_t frameCount)
+{
+    using TargetPtr = std::unique_ptr<Target>;
+    auto makeTarget = [] {
+        TargetPtr target(new Target);
+        target->write(0);
+        target->finishWrite();
+        return target;
+    };
+    Swapchain<TargetPtr> swapchain(makeTarget(),
+                                   makeTarget(),
+                                   makeTarget(),
+                                   makeTarget());
+    std::mutex inFlightMutex;
+    std::deque<TargetPtr> inFlight;
+    GpuQueue gpu;
+    std::atomic<bool> done{false};
+
+    std::thread gpuThread([&] {
+        std::minstd_rand random(5);
+        uint32_t token;
+        while (gpu.next(&token))
+        {
+            randomDelay(random);
+            TargetPtr target;
+            {
+                std::unique_lock<std::mutex> lock(inFlightMutex);
+                target = std::move(inFlight.front());
+                inFlight.pop_front();
+            }
+            target->finishWrite();
+            swapchain.presentTexture(std::move(target));
+        }
+    });
+    std::thread readerThread([&] {
+        readFrames(done, [&] {
+            Swapchain<TargetPtr>::PresentingTextureLock lock(&swapchain);
+            return lock.texture()->read();
+        });
+    });
+
+    std::minstd_rand random(4);
+    for (uint64_t frame = 1; frame <= frameCount; frame++)
+    {
+        TargetPtr target = swapchain.acquireRenderTexture();
+        CHECK(target != nullptr);
+        if (target == nullptr)
+        {
+            break;
+        }
+        target->write(frame);
+        {
+            std::unique_lock<std::mutex> lock(inFlightMutex);
+            inFlight.push_back(std::move(target));
+        }
+        gpu.submit(0);
+        randomDelay(random);
+    }
+    gpu.finish();
+    gpuThread.join();
+    done = true;
+    readerThread.join();
+    Swapchain<TargetPtr>::PresentingTextureLock lock(&swapchain);
+    CHECK(lock.texture()->read() == frameCount);
+}
+
+int main(int argc, const char** argv)
+{
+    uint64_t frameCount = 20000;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (!strcmp(argv[i], "--frames") && i + 1 < argc)
+        {
+            frameCount = strtoull(argv[++i], nullptr, 10);
+        }
+        else
+        {
+            fprintf(stderr, "usage: triple_buffer_stress_test [--frames N]\n");
+            return 1;
+        }
+    }
+    testReadWriteRing(frameCount);
+    testBeginWithoutPublish();
+    testSwapchain(frameCount);
+    printf("%d failures\n", g_failures.load());
+    return g_failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,191 @@
+/*
+ * Copyright 2025 Rive
+ */
+
+// Measures how many commands per second make it through a CommandQueue to a
+// CommandServer running on its own thread. One thread records a burst of
+// commands while the server consumes them; the time is taken from the first
+// recorded command until the server has processed the last one.
+//
+//   command_queue_bench [--commands N] [--iterations N] [--coalesce] [file.riv]
+//
+// file.riv defaults to test/assets/databinding.riv, and needs a default view
+// model with a number property "age" and a string property "name". Every
+// command in a burst goes to the same view model, so --coalesce collapses
+// nearly all of them and measures recording only.
+
+#include "rive/animation/state_machine_instance.hpp"
+#include "rive/command_queue.hpp"
+#include "rive/command_server.hpp"
+#include "utils/no_op_factory.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <thread>
+#include <vector>
+
+using namespace rive;
+
+static double seconds_now()
+{
+    return std::chrono::duration<double>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+// Blocks until the server has run every command recorded before this call.
+static void wait_for_server(CommandQueue* queue)
+{
+    std::atomic<bool> done{false};
+    queue->runOnce([&done](CommandServer*) {
+        done.store(true, std::memory_order_release);
+    });
+    while (!done.load(std::memory_order_acquire))
+    {
+        std::this_thread::yield();
+    }
+}
+
+// Records commandCount commands with recordCommand and returns the best time,
+// in seconds, that the server took to get through all of them.
+static double time_commands(CommandQueue* queue,
+                            int commandCount,
+                            int iterations,
+                            const std::function<void(int)>& recordCommand)
+{
+    double bestSeconds = std::numeric_limits<double>::infinity();
+    for (int i = 0; i < iterations; ++i)
+    {
+        wait_for_server(queue);
+        double t0 = seconds_now();
+        for (int j = 0; j < commandCount; ++j)
+        {
+            recordCommand(j);
+        }
+        wait_for_server(queue);
+        bestSeconds = std::min(seconds_now() - t0, bestSeconds);
+    }
+    return bestSeconds;
+}
+
+static void report(const char* name, int commandCount, double seconds)
+{
+    printf("%-16s %8.3f ms  %8.2f M commands/s  %6.1f ns/command\n",
+           name,
+           seconds * 1e3,
+           commandCount / seconds * 1e-6,
+           seconds * 1e9 / commandCount);
+}
+
+int main(int argc, const char** argv)
+{
+    int commandCount = 100000;
+    int iterations = 10;
+    bool coalesce = false;
+    const char* filename = "test/assets/databinding.riv";
+    for (int i = 1; i < argc; ++i)
+    {
+        if (!strcmp(argv[i], "--commands") && i + 1 < argc)
+        {
+            commandCount = atoi(argv[++i]);
+        }
+        else if (!strcmp(argv[i], "--iterations") && i + 1 < argc)
+        {
+            iterations = atoi(argv[++i]);
+        }
+        else if (!strcmp(argv[i], "--coalesce"))
+        {
+            coalesce = true;
+        }
+        else if (argv[i][0] != '-')
+        {
+            filename = argv[i];
+        }
+        else
+        {
+            fprintf(stderr,
+                    "usage: command_queue_bench [--commands N] "
+                    "[--iterations N] [--coalesce] [file.riv]\n");
+            return 1;
+        }
+    }
+    if (commandCount <= 0 || iterations <= 0)
+    {
+        fprintf(stderr, "--commands and --iterations must be positive\n");
+        return 1;
+    }
+
+    std::ifstream stream(filename, std::ios::binary);
+    if (!stream)
+    {
+        fprintf(stderr, "failed to open %s\n", filename);
+        return 1;
+    }
+    std::vector<uint8_t> bytes{std::istreambuf_iterator<char>(stream), {}};
+
+    NoOpFactory factory;
+    auto queue = make_rcp<CommandQueue>();
+    std::thread serverThread([queue, &factory]() {
+        CommandServer server(queue, &factory);
+        server.serveUntilDisconnect();
+    });
+
+    queue->setCommandCoalescing(coalesce);
+    FileHandle file = queue->loadFile(std::move(bytes));
+    ArtboardHandle artboard = queue->instantiateDefaultArtboard(file);
+    StateMachineHandle stateMachine =
+        queue->instantiateDefaultStateMachine(artboard);
+    ViewModelInstanceHandle viewModel =
+        queue->instantiateDefaultViewModelInstance(file, artboard);
+    queue->bindViewModelInstance(stateMachine, viewModel);
+    wait_for_server(queue.get());
+
+    printf("%d commands per burst, best of %d%s\n",
+           commandCount,
+           iterations,
+           coalesce ? ", coalescing" : "");
+    report("runOnce",
+           commandCount,
+           time_commands(queue.get(), commandCount, iterations, [&](int) {
+               queue->runOnce([](CommandServer*) {});
+           }));
+    report("set number",
+           commandCount,
+           time_commands(queue.get(), commandCount, iterations, [&](int j) {
+               queue->setViewModelInstanceNumber(viewModel,
+                                                 "age",
+                                                 static_cast<float>(j));
+           }));
+    report("set string",
+           commandCount,
+           time_commands(queue.get(), commandCount, iterations, [&](int j) {
+               queue->setViewModelInstanceString(viewModel,
+                                                 "name",
+                                                 j % 2 ? "odd" : "even");
+           }));
+    report("pointer move",
+           commandCount,
+           time_commands(queue.get(), commandCount, iterations, [&](int j) {
+               CommandQueue::PointerEvent event;
+               event.screenBounds = Vec2D(100, 100);
+               event.position = Vec2D(static_cast<float>(j % 100), 50);
+               queue->pointerMove(stateMachine, event);
+           }));
+    report("advance",
+           commandCount,
+           time_commands(queue.get(), commandCount, iterations, [&](int) {
+               queue->advanceStateMachine(stateMachine, 1.0f / 60);
+           }));
+
+    queue->disconnect();
+    serverThread.join();
+    return 0;
+}
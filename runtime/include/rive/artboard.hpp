@@ -14,6 +14,7 @@
 #include "rive/generated/artboard_base.hpp"
 #include "rive/hit_info.hpp"
 #include "rive/math/aabb.hpp"
+#include "rive/picture.hpp"
 #include "rive/renderer.hpp"
 #include "rive/text/text_value_run.hpp"
 #include "rive/event.hpp"
@@ -223,6 +224,43 @@ public:
     void draw(Renderer* renderer) override;
     void addToRenderPath(RenderPath* path, const Mat2D& transform);
 
+    /// When enabled, draw() records the artboard into a Picture once its
+    /// drawing stops changing, and replays that picture instead of walking
+    /// the drawables until something is dirtied, animated or data bound
+    /// again.
+    ///
+    /// The cache covers the whole artboard: any change, including every
+    /// apply of a playing animation, throws the picture away, so only an
+    /// artboard that is entirely at rest replays. Replay saves the walk over
+    /// the drawables, not the renderer's per-draw work, since every recorded
+    /// call goes back through the target renderer as usual.
+    void usePictureCache(bool value);
+    bool usePictureCache() const { return m_usePictureCache; }
+
+    /// Signals that something affecting how the artboard draws has changed.
+    /// Dirt, animations and data binds call this automatically; call it after
+    /// changing a paint or drawable directly while the picture cache is on.
+    void markDrawingDirty() { ++m_drawGeneration; }
+
+    /// Changes whenever the drawing of this artboard, or of any artboard it
+    /// hosts, may have changed.
+    uint64_t drawGeneration();
+
+private:
+    void drawInternal(Renderer* renderer, DrawOption option);
+
+    bool m_usePictureCache = false;
+    uint64_t m_drawGeneration = 0;
+    // Generation at the previous draw(). The picture is only recorded once a
+    // draw sees the same generation twice in a row, so artboards that change
+    // every frame never pay for recording.
+    uint64_t m_lastDrawGeneration = ~0ull;
+    rcp<Picture> m_cachedPicture;
+    uint64_t m_cachedPictureGeneration = 0;
+    DrawOption m_cachedPictureOption = DrawOption::kNormal;
+
+public:
+
 #ifdef TESTING
     ShapePaintPath* clipPath() { return &m_worldPath; }
     ShapePaintPath* backgroundPath() { return &m_localPath; }
@@ -117,7 +117,10 @@ public:
 
 private:
     void updateArtboardsWorldTransform();
+    void updateItemIndicesAndSizes();
     void disposeListItem(const rcp<ViewModelInstanceListItem>& listItem);
+    void adoptArtboard(const rcp<ViewModelInstanceListItem>& from,
+                       const rcp<ViewModelInstanceListItem>& to);
     std::unique_ptr<ArtboardInstance> createArtboard(
         Component* target,
         rcp<ViewModelInstanceListItem> listItem) const;
@@ -162,6 +165,7 @@ private:
                                 rcp<ViewModelInstanceListItem>);
     void clearArtboardOverride(ArtboardInstance*);
     bool m_shouldResetInstances = false;
+    bool m_deferLayoutSync = false;
 };
 } // namespace rive
 
@@ -9,9 +9,11 @@
 #include "rive/math/vec2d.hpp"
 #include "rive/viewmodel/runtime/viewmodel_runtime.hpp"
 
+#include <algorithm>
 #include <condition_variable>
 #include <cstdint>
 #include <functional>
+#include <memory>
 #include <mutex>
 #include <string>
 #include <vector>
@@ -572,6 +574,33 @@ public:
     // will be run per pollCommands.
     void draw(DrawKey, CommandServerDrawCallback);
 
+    // When enabled, redundant commands are collapsed while they are still
+    // waiting for the server:
+    //  - Consecutive bool, number, color, enum or string writes keep only the
+    //    last value per (view model instance, path), in the slot of the first
+    //    write. Writes to different properties may be interleaved; any other
+    //    command ends the run.
+    //  - A pointerMove recorded directly after a pointerMove to the same state
+    //    machine replaces it.
+    // The surviving command carries the latest requestId. Triggers and all
+    // other commands are never coalesced. Disabled by default.
+    void setCommandCoalescing(bool enabled);
+
+    // Latency and throughput counters for the queue/server pair, see Metrics
+    // below. Collection is off by default; while it is off the only cost is a
+    // flag check per command.
+    struct Metrics;
+    using MetricsCallback = std::function<void(const Metrics&)>;
+
+    void setMetricsEnabled(bool enabled);
+    // Returns a snapshot of everything collected since the last reset.
+    Metrics metrics() const;
+    void resetMetrics();
+    // While metrics are enabled, the server posts a report at most every
+    // intervalSeconds, and processMessages hands the current snapshot to
+    // callback. Pass a null callback to stop reporting.
+    void setMetricsReporting(float intervalSeconds, MetricsCallback callback);
+
 #ifdef TESTING
     // Sends a commandLoopBreak command to the server. This will cause the
     // processCommands to return even if there are more commands to consume.
@@ -817,6 +846,8 @@ private:
         listViewModelPropertyValue,
         getViewModelListSize
     };
+    constexpr static size_t kCommandTypeCount =
+        static_cast<size_t>(Command::getViewModelListSize) + 1;
 
     enum class Message
     {
@@ -849,7 +880,8 @@ private:
         imageError,
         audioError,
         fontError,
-        stateMachineError
+        stateMachineError,
+        metricsReported
     };
 
     friend class CommandServer;
@@ -864,6 +896,95 @@ private:
     uint64_t m_currentStateMachineHandleIdx = 0;
     uint64_t m_currentDrawKeyIdx = 0;
 
+    // Records a bool/number/color write, or coalesces it into a pending one.
+    template <typename T>
+    void setViewModelInstanceValue(ViewModelInstanceHandle,
+                                   DataType,
+                                   std::string path,
+                                   T value,
+                                   uint64_t requestId);
+    // Records an enum/string write, or coalesces it into a pending one.
+    void setViewModelInstanceText(ViewModelInstanceHandle,
+                                  DataType,
+                                  std::string path,
+                                  std::string value,
+                                  uint64_t requestId);
+
+    // Where the parts of a queued value write live in the streams, so a later
+    // write to the same property can replace them in place.
+    struct CoalescedWrite
+    {
+        uint64_t commandOffset;
+        uint64_t requestIdOffset;
+        // Offset in m_commandStream for POD values, index in m_names for
+        // enums and strings.
+        uint64_t valueLocation;
+    };
+    struct CoalescedWriteKey
+    {
+        ViewModelInstanceHandle handle;
+        DataType type;
+        std::string path;
+
+        bool operator==(const CoalescedWriteKey& other) const
+        {
+            return handle == other.handle && type == other.type &&
+                   path == other.path;
+        }
+    };
+    struct CoalescedWriteKeyHash
+    {
+        size_t operator()(const CoalescedWriteKey& key) const
+        {
+            return std::hash<std::string>()(key.path) ^
+                   (std::hash<ViewModelInstanceHandle>()(key.handle) << 1) ^
+                   (static_cast<size_t>(key.type) << 2);
+        }
+    };
+    // Returns the queued write that a new write to key may replace, or null.
+    // Must be called with m_commandMutex held.
+    CoalescedWrite* findCoalescableWrite(const CoalescedWriteKey& key);
+
+    bool m_coalesceCommands = false;
+    // m_commandStream offset just past the last coalescable value write. If
+    // anything else has been written since, the run is over.
+    uint64_t m_coalescedWritesEnd = 0;
+    std::unordered_map<CoalescedWriteKey, CoalescedWrite, CoalescedWriteKeyHash>
+        m_coalescedWrites;
+    struct CoalescedPointerMove
+    {
+        StateMachineHandle handle = RIVE_NULL_HANDLE;
+        uint64_t commandOffset = 0;
+        uint64_t requestIdOffset = 0;
+        uint64_t eventIndex = 0;
+        uint64_t end = ~0ull;
+    };
+    CoalescedPointerMove m_lastPointerMove;
+
+    class AutoLockAndNotify;
+
+    // When and where a command was recorded, so the server can tell how long
+    // it waited in the queue. Only recorded while metrics are enabled.
+    struct CommandTimestamp
+    {
+        uint64_t commandOffset;
+        uint64_t enqueueTime;
+    };
+
+    // Guarded by m_commandMutex.
+    bool m_metricsEnabled = false;
+    uint64_t m_metricsReportInterval = 0;
+    ObjectStream<CommandTimestamp> m_commandTimestamps;
+
+    // Guarded by m_messageMutex. Enqueue time of the oldest command whose
+    // messages have not been processed yet, 0 if none.
+    uint64_t m_messageRoundTripStart = 0;
+
+    mutable std::mutex m_metricsMutex;
+    std::unique_ptr<Metrics> m_metrics;
+    // Guarded by m_commandMutex.
+    MetricsCallback m_metricsCallback;
+
     std::mutex m_commandMutex;
     std::condition_variable m_commandConditionVariable;
     PODStream m_commandStream;
@@ -903,4 +1024,74 @@ private:
         m_stateMachineListeners;
 };
 
+struct CommandQueue::Metrics
+{
+    // Log2 histogram of durations in nanoseconds. Bucket 0 holds samples under
+    // 1us, bucket i holds [2^(i-1), 2^i) us, and the last bucket also holds
+    // everything longer.
+    struct Histogram
+    {
+        constexpr static size_t kBucketCount = 32;
+
+        uint64_t count = 0;
+        uint64_t totalNs = 0;
+        uint64_t maxNs = 0;
+        uint64_t buckets[kBucketCount] = {};
+
+        void record(uint64_t ns)
+        {
+            ++count;
+            totalNs += ns;
+            maxNs = std::max(maxNs, ns);
+            size_t bucket = 0;
+            for (uint64_t us = ns / 1000; us != 0 && bucket + 1 < kBucketCount;
+                 us >>= 1)
+            {
+                ++bucket;
+            }
+            ++buckets[bucket];
+        }
+
+        uint64_t meanNs() const { return count ? totalNs / count : 0; }
+
+        // Upper bound of the bucket holding the given percentile (0..1),
+        // clamped to maxNs.
+        uint64_t percentileNs(float percentile) const;
+    };
+
+    // Number of distinct command types, and a stable name for each one, for
+    // indexing the per-command arrays below.
+    constexpr static size_t kCommandTypeCount = CommandQueue::kCommandTypeCount;
+    static const char* commandName(size_t commandType);
+
+    // Monotonic clock used for all timestamps, in nanoseconds.
+    static uint64_t now();
+
+    uint64_t commandsExecuted = 0;
+    uint64_t batchesExecuted = 0;
+
+    // Commands and bytes waiting in the queue when the server started a batch.
+    // Command counts only include commands recorded while metrics were on.
+    uint64_t lastQueueDepthCommands = 0;
+    uint64_t maxQueueDepthCommands = 0;
+    uint64_t lastQueueDepthBytes = 0;
+    uint64_t maxQueueDepthBytes = 0;
+
+    // Time from a command being recorded to the server starting it.
+    Histogram enqueueLatency[kCommandTypeCount];
+    // Time the server spent executing each command. With parallel advance
+    // enabled, advanceStateMachine only covers deferring the advance; the
+    // advance itself is in parallelAdvanceWallTime.
+    Histogram executionTime[kCommandTypeCount];
+    // With parallel advance enabled, the wall time of each run of deferred
+    // advances: from sharding them until the last shard finished. This is one
+    // sample for the whole set of shards, not a per state machine time.
+    Histogram parallelAdvanceWallTime;
+    // Duration of each draw callback.
+    Histogram drawCallbackTime;
+    // Time from the oldest command of a server batch being recorded to
+    // processMessages consuming the messages that batch produced.
+    Histogram messageRoundTrip;
+};
+
 }; // namespace rive
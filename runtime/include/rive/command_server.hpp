@@ -6,10 +6,12 @@
 
 #include "rive/command_queue.hpp"
 #include <iostream>
+#include <memory>
 #include <sstream>
 #include <thread>
 #include <unordered_map>
 #include <type_traits>
+#include <utility>
 
 namespace rive
 {
@@ -18,7 +20,22 @@ namespace rive
 class CommandServer
 {
 public:
-    CommandServer(rcp<CommandQueue>, Factory*);
+    // workerThreadCount > 0 enables parallel state machine advancement: runs
+    // of consecutive advanceStateMachine commands are sharded by the files
+    // their artboard and bound view model instance came from, and advanced on
+    // a pool of that many worker threads (plus the server thread). Only state
+    // machines that share no file run concurrently, since nested view models
+    // and file resources can be shared by anything created from the same
+    // file. Every other command acts as a barrier, so commands still observe
+    // the order they were recorded in. Draw callbacks always run serially on
+    // the server thread.
+    //
+    // Artboards instantiated from the same file therefore always advance on
+    // one thread, so many artboards from a single .riv get no parallelism;
+    // only state machines from different (unlinked) files do.
+    CommandServer(rcp<CommandQueue>,
+                  Factory*,
+                  uint32_t workerThreadCount = 0);
     virtual ~CommandServer();
 
     Factory* factory() const { return m_factory; }
@@ -40,6 +57,10 @@ public:
     // Blocks and runs waitMessages until disconnect is received.
     void serveUntilDisconnect();
 
+private:
+    class SubscriptionObserver;
+
+public:
     struct Subscription
     {
         // The request Id for sbuscribing to this particular property.
@@ -48,6 +69,10 @@ public:
         PropertyData data;
         // The root view model of from the perspective of the path in data.name.
         ViewModelInstanceHandle rootViewModel;
+        // Registered as a delegate on the underlying value so changes are
+        // pushed to the server instead of polled. Null once the root view
+        // model has been deleted.
+        std::unique_ptr<SubscriptionObserver> observer;
     };
 
 #ifdef TESTING
@@ -70,6 +95,12 @@ public:
     bool testing_globalImageContains(std::string name);
     bool testing_globalAudioContains(std::string name);
     bool testing_globalFontContains(std::string name);
+
+    // Number of shards the last run of parallel advances was split into.
+    size_t testing_lastAdvanceShardCount() const
+    {
+        return m_lastAdvanceShardCount;
+    }
 #endif
 
 private:
@@ -124,6 +155,15 @@ private:
 
     void checkPropertySubscriptions();
 
+    // Looks every subscription's path up again from its root view model, and
+    // moves its observer to the value now found there. Needed after a view
+    // model along a path has been replaced.
+    void resolvePropertySubscriptions();
+
+    // Runs the advances deferred while in parallel mode and reports the ones
+    // that settled, in the order they were recorded.
+    void flushPendingAdvances();
+
     Vec2D cursorPosForPointerEvent(StateMachineInstance*,
                                    const CommandQueue::PointerEvent&);
 
@@ -138,6 +178,7 @@ private:
                 auto& stateMachineVector = dependencyItr->second;
                 for (auto stateMachine : stateMachineVector)
                 {
+                    m_stateMachineAffinities.erase(stateMachine);
                     if (m_stateMachines.erase(stateMachine) > 0)
                     {
                         std::unique_lock<std::mutex> lock(
@@ -152,6 +193,7 @@ private:
                 m_artboardDependencies.erase(dependencyItr);
             }
             m_artboards.erase(itr);
+            m_artboardFiles.erase(handle);
             std::unique_lock<std::mutex> lock(m_commandQueue->m_messageMutex);
             m_commandQueue->m_messageStream
                 << CommandQueue::Message::artboardDeleted;
@@ -167,9 +209,20 @@ private:
     const std::thread::id m_threadID;
 #endif
 
-    // Vector to iterate on for subscriptions. This is a vector instead of a map
-    // because we iterate through the entire vector every frame anyway.
+    // All active subscriptions, only walked when subscribing, unsubscribing
+    // or deleting a view model.
     std::vector<Subscription> m_propertySubscriptions;
+    // Subscriptions whose value changed since the last flush, in the order
+    // they changed. Each observer appears at most once.
+    std::vector<SubscriptionObserver*> m_changedSubscriptions;
+    // Scratch storage for the values gathered before taking the message lock.
+    struct ChangedValue
+    {
+        uint64_t requestId;
+        ViewModelInstanceHandle rootViewModel;
+        CommandQueue::ViewModelInstanceData data;
+    };
+    std::vector<ChangedValue> m_changedValues;
 
     // Dependencies
     // When a file gets deleted artboards and statemachine become invalid. Here
@@ -197,6 +250,66 @@ private:
 
     std::unordered_map<DrawKey, CommandServerDrawCallback> m_uniqueDraws;
 
+    // The files a state machine's artboard and bound view model instance were
+    // created from. Anything else it may touch while advancing (nested view
+    // models, file resources) is reached through one of these, so state
+    // machines that share either file are advanced on the same shard, in
+    // order.
+    struct StateMachineAffinity
+    {
+        FileHandle artboardFile = RIVE_NULL_HANDLE;
+        FileHandle viewModelFile = RIVE_NULL_HANDLE;
+    };
+    std::unordered_map<StateMachineHandle, StateMachineAffinity>
+        m_stateMachineAffinities;
+    // The file each view model instance handle was created from. Nested and
+    // list references take their root's file.
+    std::unordered_map<ViewModelInstanceHandle, FileHandle> m_viewModelFiles;
+    // The file each artboard handle was instantiated from.
+    std::unordered_map<ArtboardHandle, FileHandle> m_artboardFiles;
+    // Files whose view model graphs were linked by setting an instance from
+    // one of them into the other. Their state machines share a shard. Links
+    // are dropped when either file is deleted.
+    std::vector<std::pair<FileHandle, FileHandle>> m_linkedFiles;
+    // Maps every linked file to one representative of its group of linked
+    // files, so sharding doesn't re-walk m_linkedFiles on every flush.
+    std::unordered_map<FileHandle, FileHandle> m_linkedFileGroups;
+    size_t m_lastAdvanceShardCount = 0;
+
+    void rebuildLinkedFileGroups();
+    // Records that value, a view model instance handle, is now reachable from
+    // root's graph.
+    void linkViewModelFiles(ViewModelInstanceHandle root,
+                            ViewModelInstanceHandle value);
+
+    struct PendingAdvance
+    {
+        StateMachineHandle handle;
+        uint64_t requestId;
+        float timeToAdvance;
+        StateMachineInstance* stateMachine;
+        bool settled;
+    };
+    std::vector<PendingAdvance> m_pendingAdvances;
+
+    class WorkerPool;
+    std::unique_ptr<WorkerPool> m_workerPool;
+    // Guards m_changedSubscriptions while advances run on worker threads.
+    std::mutex m_changedSubscriptionsMutex;
+
+    // Pops the enqueue timestamp recorded for the command at commandOffset,
+    // or returns 0 if it was recorded while metrics were off. Must be called
+    // with the command mutex held.
+    uint64_t takeCommandEnqueueTime(uint64_t commandOffset);
+    void recordCommandMetrics(CommandQueue::Command,
+                              uint64_t enqueueTime,
+                              uint64_t startTime);
+
+    // Latched from the queue at the start of each processCommands.
+    bool m_collectMetrics = false;
+    CommandQueue::CommandTimestamp m_nextCommandTimestamp = {0, 0};
+    uint64_t m_lastMetricsReport = 0;
+
     class CommandFileAssetLoader;
     rcp<CommandFileAssetLoader> m_fileAssetLoader;
 };
@@ -86,6 +86,12 @@ public:
     void addRect(const AABB&, PathDirection = PathDirection::cw);
     void addOval(const AABB&, PathDirection = PathDirection::cw);
     void addPoly(Span<const Vec2D>, bool isClosed);
+    // Appends a serialized path, where each verb consumes its points in order
+    // from the points span. Well-formed input (every contour begins with a
+    // move) is copied in bulk. Otherwise it falls back to the individual verb
+    // methods so implicit moves are still injected. Trailing verbs without
+    // enough points are dropped.
+    void addVerbsAndPoints(Span<const PathVerb>, Span<const Vec2D>);
 
     // Simple STL-style iterator. To traverse using range-for:
     //
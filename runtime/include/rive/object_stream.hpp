@@ -6,50 +6,275 @@
 
 #include "rive/refcnt.hpp"
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>
-#include <deque>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <type_traits>
 
 namespace rive
 {
+// Singly linked list of fixed-size chunks shared by the streams below. Writers
+// append to the tail chunk, readers consume from the head chunk, and chunks
+// that have been fully read are recycled instead of returned to the allocator,
+// so a stream that reaches a steady state stops allocating altogether. At most
+// kMaxFreeChunks are kept, so a one-off burst doesn't pin its memory for the
+// life of the stream.
+template <typename Chunk> class ChunkList
+{
+public:
+    constexpr static size_t kMaxFreeChunks = 4;
+
+    ChunkList() = default;
+    ChunkList(const ChunkList&) = delete;
+    ChunkList& operator=(const ChunkList&) = delete;
+
+    ~ChunkList()
+    {
+        freeChain(m_head);
+        freeChain(m_freeList);
+    }
+
+    Chunk* head() const { return m_head; }
+    Chunk* tail() const { return m_tail; }
+
+    // Appends a fresh (or recycled) chunk to the end of the list.
+    Chunk* pushChunk()
+    {
+        Chunk* chunk = m_freeList;
+        if (chunk != nullptr)
+        {
+            m_freeList = chunk->next;
+            --m_freeCount;
+            chunk->reset();
+        }
+        else
+        {
+            chunk = new Chunk();
+        }
+        if (m_tail != nullptr)
+        {
+            m_tail->next = chunk;
+        }
+        else
+        {
+            m_head = chunk;
+        }
+        m_tail = chunk;
+        return chunk;
+    }
+
+    // Moves the fully read head chunk to the free list, or frees it if the
+    // free list is full. The tail chunk is kept in place and simply rewound.
+    void popChunk()
+    {
+        assert(m_head != nullptr);
+        if (m_head == m_tail)
+        {
+            m_head->reset();
+            return;
+        }
+        Chunk* chunk = m_head;
+        m_head = chunk->next;
+        if (m_freeCount == kMaxFreeChunks)
+        {
+            delete chunk;
+            return;
+        }
+        chunk->next = m_freeList;
+        m_freeList = chunk;
+        ++m_freeCount;
+    }
+
+private:
+    static void freeChain(Chunk* chunk)
+    {
+        while (chunk != nullptr)
+        {
+            Chunk* next = chunk->next;
+            delete chunk;
+            chunk = next;
+        }
+    }
+
+    Chunk* m_head = nullptr;
+    Chunk* m_tail = nullptr;
+    Chunk* m_freeList = nullptr;
+    size_t m_freeCount = 0;
+};
+
 // Stream for recording objects of a specific type, using C++-style "<<" ">>"
 // operators.
 template <typename T> class ObjectStream
 {
 public:
-    bool empty() const { return m_stream.empty(); }
+    ObjectStream() = default;
+    ObjectStream(const ObjectStream&) = delete;
+    ObjectStream& operator=(const ObjectStream&) = delete;
+
+    ~ObjectStream()
+    {
+        for (Chunk* chunk = m_chunks.head(); chunk != nullptr;
+             chunk = chunk->next)
+        {
+            while (chunk->readIdx < chunk->writeIdx)
+            {
+                chunk->slot(chunk->readIdx++)->~T();
+            }
+        }
+    }
+
+    bool empty() const { return m_count.load(std::memory_order_acquire) == 0; }
+
+    // Total number of objects ever written to / read from this stream. An
+    // object's index is the writeCount() from just before it was written.
+    uint64_t writeCount() const { return m_writeCount; }
+    uint64_t readCount() const { return m_readCount; }
 
     ObjectStream& operator<<(T obj)
     {
-        m_stream.push_back(std::move(obj));
+        Chunk* chunk = m_chunks.tail();
+        if (chunk == nullptr || chunk->writeIdx == kChunkCapacity)
+        {
+            chunk = m_chunks.pushChunk();
+        }
+        if (chunk->writeIdx == 0)
+        {
+            chunk->baseIndex = m_writeCount;
+        }
+        new (chunk->slot(chunk->writeIdx++)) T(std::move(obj));
+        ++m_writeCount;
+        m_count.fetch_add(1, std::memory_order_release);
         return *this;
     }
 
+    // Replaces the object at the given index if it has not been read yet.
+    // Returns false if it was already consumed.
+    bool overwrite(uint64_t index, T obj)
+    {
+        if (index < m_readCount || index >= m_writeCount)
+        {
+            return false;
+        }
+        for (Chunk* chunk = m_chunks.head(); chunk != nullptr;
+             chunk = chunk->next)
+        {
+            if (index < chunk->baseIndex + chunk->writeIdx)
+            {
+                *chunk->slot(index - chunk->baseIndex) = std::move(obj);
+                return true;
+            }
+        }
+        return false;
+    }
+
     ObjectStream& operator>>(T& dst)
     {
         assert(!empty());
-        dst = std::move(m_stream.front());
-        m_stream.pop_front();
+        Chunk* chunk = m_chunks.head();
+        assert(chunk->readIdx < chunk->writeIdx);
+        T* src = chunk->slot(chunk->readIdx++);
+        dst = std::move(*src);
+        src->~T();
+        if (chunk->readIdx == kChunkCapacity ||
+            chunk->readIdx == chunk->writeIdx)
+        {
+            m_chunks.popChunk();
+        }
+        ++m_readCount;
+        m_count.fetch_sub(1, std::memory_order_release);
         return *this;
     }
 
 private:
-    std::deque<T> m_stream;
+    constexpr static size_t kChunkCapacity = 64;
+
+    struct Chunk
+    {
+        Chunk* next = nullptr;
+        size_t readIdx = 0;
+        size_t writeIdx = 0;
+        uint64_t baseIndex = 0;
+        alignas(T) unsigned char storage[sizeof(T) * kChunkCapacity];
+
+        T* slot(size_t idx)
+        {
+            return reinterpret_cast<T*>(storage) + idx;
+        }
+
+        void reset()
+        {
+            assert(readIdx == writeIdx);
+            next = nullptr;
+            readIdx = writeIdx = 0;
+        }
+    };
+
+    ChunkList<Chunk> m_chunks;
+    std::atomic<size_t> m_count{0};
+    uint64_t m_writeCount = 0;
+    uint64_t m_readCount = 0;
 };
 
 // Stream for recording objects of any trivially-copyable type, using C++-style
 // "<<" ">>" operators. Object types must be read back in the same order they
 // were writen.
+//
+// Bytes are bump-allocated into fixed-size chunks and read back in place, so
+// recording and consuming a command is a memcpy rather than a per-byte deque
+// insert/erase.
 class PODStream
 {
 public:
-    bool empty() const { return m_byteStream.empty(); }
+    PODStream() = default;
+    PODStream(const PODStream&) = delete;
+    PODStream& operator=(const PODStream&) = delete;
+
+    bool empty() const { return m_size.load(std::memory_order_acquire) == 0; }
+
+    // Total number of bytes ever written to / read from this stream. A
+    // record's offset is the bytesWritten() from just before it was written.
+    uint64_t bytesWritten() const { return m_bytesWritten; }
+    uint64_t bytesRead() const { return m_bytesRead; }
+
+    // Replaces a value previously written at the given offset if it has not
+    // been read yet. Returns false if it was already consumed.
+    template <typename T> bool overwrite(uint64_t offset, T obj)
+    {
+        static_assert(std::is_pod<T>(),
+                      "PODStream only accepts plain-old-data types");
+        if (offset < m_bytesRead || offset + sizeof(T) > m_bytesWritten)
+        {
+            return false;
+        }
+        auto data = reinterpret_cast<const char*>(&obj);
+        size_t remaining = sizeof(T);
+        for (Chunk* chunk = m_chunks.head(); chunk != nullptr && remaining > 0;
+             chunk = chunk->next)
+        {
+            uint64_t chunkEnd = chunk->baseOffset + chunk->writePos;
+            if (offset >= chunkEnd)
+            {
+                continue;
+            }
+            size_t pos = static_cast<size_t>(offset - chunk->baseOffset);
+            size_t n = std::min(remaining, chunk->writePos - pos);
+            memcpy(chunk->bytes + pos, data, n);
+            data += n;
+            offset += n;
+            remaining -= n;
+        }
+        return remaining == 0;
+    }
 
     template <typename T> PODStream& operator<<(T obj)
     {
         static_assert(std::is_pod<T>(),
                       "PODStream only accepts plain-old-data types");
-        const char* data = reinterpret_cast<const char*>(&obj);
-        m_byteStream.insert(m_byteStream.end(), data, data + sizeof(T));
+        write(&obj, sizeof(T));
         return *this;
     }
 
@@ -57,11 +282,7 @@ public:
     {
         static_assert(std::is_pod<T>(),
                       "PODStream only accepts plain-old-data types");
-        assert(m_byteStream.size() >= sizeof(T));
-        char* data = reinterpret_cast<char*>(&dst);
-        std::copy(m_byteStream.begin(), m_byteStream.begin() + sizeof(T), data);
-        m_byteStream.erase(m_byteStream.begin(),
-                           m_byteStream.begin() + sizeof(T));
+        read(&dst, sizeof(T));
         return *this;
     }
 
@@ -79,6 +300,75 @@ public:
     }
 
 private:
-    std::deque<char> m_byteStream;
+    constexpr static size_t kChunkSize = 4096;
+
+    struct Chunk
+    {
+        Chunk* next = nullptr;
+        size_t readPos = 0;
+        size_t writePos = 0;
+        uint64_t baseOffset = 0;
+        char bytes[kChunkSize];
+
+        void reset()
+        {
+            next = nullptr;
+            readPos = writePos = 0;
+        }
+    };
+
+    void write(const void* src, size_t size)
+    {
+        auto data = static_cast<const char*>(src);
+        size_t remaining = size;
+        while (remaining > 0)
+        {
+            Chunk* chunk = m_chunks.tail();
+            if (chunk == nullptr || chunk->writePos == kChunkSize)
+            {
+                chunk = m_chunks.pushChunk();
+            }
+            if (chunk->writePos == 0)
+            {
+                chunk->baseOffset = m_bytesWritten + (size - remaining);
+            }
+            size_t n = std::min(remaining, kChunkSize - chunk->writePos);
+            memcpy(chunk->bytes + chunk->writePos, data, n);
+            chunk->writePos += n;
+            data += n;
+            remaining -= n;
+        }
+        m_bytesWritten += size;
+        m_size.fetch_add(size, std::memory_order_release);
+    }
+
+    void read(void* dst, size_t size)
+    {
+        assert(m_size.load(std::memory_order_relaxed) >= size);
+        auto data = static_cast<char*>(dst);
+        size_t remaining = size;
+        while (remaining > 0)
+        {
+            Chunk* chunk = m_chunks.head();
+            assert(chunk->readPos < chunk->writePos);
+            size_t n = std::min(remaining, chunk->writePos - chunk->readPos);
+            memcpy(data, chunk->bytes + chunk->readPos, n);
+            chunk->readPos += n;
+            data += n;
+            remaining -= n;
+            if (chunk->readPos == kChunkSize ||
+                chunk->readPos == chunk->writePos)
+            {
+                m_chunks.popChunk();
+            }
+        }
+        m_bytesRead += size;
+        m_size.fetch_sub(size, std::memory_order_release);
+    }
+
+    ChunkList<Chunk> m_chunks;
+    std::atomic<size_t> m_size{0};
+    uint64_t m_bytesWritten = 0;
+    uint64_t m_bytesRead = 0;
 };
 }; // namespace rive
@@ -0,0 +1,165 @@
+/*
+ * Copyright 2025 Rive
+ */
+
+#ifndef _RIVE_PICTURE_HPP_
+#define _RIVE_PICTURE_HPP_
+
+#include "rive/renderer.hpp"
+#include <vector>
+
+namespace rive
+{
+/// Immutable stream of Renderer calls, captured by PictureRecorder.
+///
+/// A Picture references (and keeps alive) the paths, paints, images and
+/// buffers it was recorded with, rather than copying them. Playback therefore
+/// reflects any changes made to those objects after recording, with the
+/// exception of path fill rules, which are captured at record time when the
+/// path reports them.
+///
+/// The stream is simplified as it is recorded: consecutive transforms are
+/// merged, calls with invalid arguments are dropped, and save/restore blocks
+/// that never draw are removed entirely.
+class Picture : public RefCnt<Picture>
+{
+public:
+    /// Replays the recorded calls into the given renderer, relative to its
+    /// current transform and clip.
+    void playback(Renderer*) const;
+
+    /// Replays the recorded calls with an additional transform applied.
+    void playback(Renderer*, const Mat2D&) const;
+
+    /// Bounds that all of the picture's drawing is contained within, in the
+    /// picture's local space. Only valid if hasBounds() is true, in which case
+    /// renderers may skip the picture entirely when these bounds are offscreen.
+    bool hasBounds() const { return m_hasBounds; }
+    const AABB& bounds() const { return m_bounds; }
+
+    /// Number of drawPath(), drawImage() and drawImageMesh() calls recorded.
+    size_t drawCount() const { return m_drawCount; }
+
+    bool empty() const { return m_drawCount == 0; }
+
+private:
+    friend class PictureRecorder;
+
+    enum class OpType : uint8_t
+    {
+        save,
+        restore,
+        transform,
+        drawPath,
+        clipPath,
+        drawImage,
+        drawImageMesh,
+    };
+
+    enum class FillRuleState : uint8_t
+    {
+        unknown,
+        nonZero,
+        evenOdd,
+        clockwise,
+    };
+
+    struct Op
+    {
+        OpType type;
+        FillRuleState fillRule;
+        // Index into m_matrices, m_paths, m_images, or m_meshes, depending on
+        // the type.
+        uint32_t index;
+        // Index into m_paints for drawPath.
+        uint32_t paintIndex;
+    };
+
+    struct ImageOp
+    {
+        rcp<const RenderImage> image;
+        ImageSampler sampler;
+        BlendMode blendMode;
+        float opacity;
+    };
+
+    struct MeshOp
+    {
+        ImageOp image;
+        rcp<RenderBuffer> vertices;
+        rcp<RenderBuffer> uvCoords;
+        rcp<RenderBuffer> indices;
+        uint32_t vertexCount;
+        uint32_t indexCount;
+    };
+
+    std::vector<Op> m_ops;
+    std::vector<Mat2D> m_matrices;
+    std::vector<rcp<RenderPath>> m_paths;
+    std::vector<rcp<RenderPaint>> m_paints;
+    std::vector<ImageOp> m_images;
+    std::vector<MeshOp> m_meshes;
+    AABB m_bounds;
+    bool m_hasBounds = false;
+    size_t m_drawCount = 0;
+};
+
+/// Renderer that captures the calls made to it into a Picture.
+///
+///     PictureRecorder recorder;
+///     artboard->draw(&recorder);
+///     rcp<Picture> picture = recorder.finishRecording();
+///     ...
+///     renderer->drawPicture(*picture);
+class PictureRecorder : public Renderer
+{
+public:
+    PictureRecorder();
+    ~PictureRecorder() override;
+
+    /// Declares that everything drawn into the picture is contained within
+    /// 'value' (e.g., because the recorded stream clips to it).
+    void bounds(const AABB& value);
+
+    /// Returns the recorded picture and resets the recorder so it can record
+    /// another one. Any saves that have not been restored are closed.
+    rcp<Picture> finishRecording();
+
+    void save() override;
+    void restore() override;
+    void transform(const Mat2D&) override;
+    void drawPath(RenderPath*, RenderPaint*) override;
+    void clipPath(RenderPath*) override;
+    void drawImage(const RenderImage*,
+                   ImageSampler,
+                   BlendMode,
+                   float opacity) override;
+    void drawImageMesh(const RenderImage*,
+                       ImageSampler,
+                       rcp<RenderBuffer> vertices_f32,
+                       rcp<RenderBuffer> uvCoords_f32,
+                       rcp<RenderBuffer> indices_u16,
+                       uint32_t vertexCount,
+                       uint32_t indexCount,
+                       BlendMode,
+                       float opacity) override;
+
+private:
+    void pushOp(Picture::OpType, uint32_t index, uint32_t paintIndex = 0);
+    Picture::FillRuleState fillRuleOf(const RenderPath*) const;
+
+    struct SaveRecord
+    {
+        // Size of the picture's op and resource arrays when save() was called,
+        // so an empty save/restore block can be rolled back.
+        size_t opCount;
+        size_t matrixCount;
+        size_t pathCount;
+        size_t drawCount;
+    };
+
+    rcp<Picture> m_picture;
+    std::vector<SaveRecord> m_saveStack;
+};
+} // namespace rive
+#endif
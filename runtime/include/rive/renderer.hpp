@@ -24,6 +24,7 @@
 namespace rive
 {
 class Vec2D;
+class Picture;
 
 // Helper that computes a matrix to "align" content (source) to fit inside frame
 // (destination).
@@ -195,6 +196,12 @@ public:
     }
 
     virtual void addRawPath(const RawPath& path) = 0;
+
+    // Writes the fill rule most recently assigned to this path and returns
+    // true, if the implementation tracks it. PictureRecorder uses this to
+    // capture fill rules at record time, since the same path may be drawn
+    // with different fill rules within a frame.
+    virtual bool peekFillRule(FillRule*) const { return false; }
 };
 
 class Renderer
@@ -220,6 +227,10 @@ public:
                                BlendMode,
                                float opacity) = 0;
 
+    // Replays a recorded Picture relative to the current transform and clip.
+    // Renderers may override this to take advantage of the picture's bounds.
+    virtual void drawPicture(const Picture&);
+
     // helpers
 
     void translate(float x, float y);
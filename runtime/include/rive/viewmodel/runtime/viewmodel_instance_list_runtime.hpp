@@ -4,6 +4,7 @@
 #include <string>
 #include <stdint.h>
 #include <unordered_map>
+#include <vector>
 #include "rive/viewmodel/runtime/viewmodel_instance_value_runtime.hpp"
 #include "rive/viewmodel/viewmodel_instance_list.hpp"
 #include "rive/viewmodel/viewmodel_instance_list_item.hpp"
@@ -25,6 +26,11 @@ public:
     void removeInstance(ViewModelInstanceRuntime*);
     void removeInstanceAt(int);
     void swap(uint32_t, uint32_t);
+    // Replaces the whole list in one edit. List items already wrapping one of
+    // the given instances are reused so bound artboards keep their state.
+    void replaceInstances(const std::vector<ViewModelInstanceRuntime*>&);
+    void beginBatch();
+    void endBatch();
     size_t size() const;
     const DataType dataType() override { return DataType::list; }
 
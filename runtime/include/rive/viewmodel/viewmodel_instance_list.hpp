@@ -17,12 +17,21 @@ public:
     Span<rcp<ViewModelInstanceListItem>> listItems() { return m_ListItems; }
     rcp<ViewModelInstanceListItem> item(uint32_t index);
     void swap(uint32_t index1, uint32_t index2);
+    void replaceItems(std::vector<rcp<ViewModelInstanceListItem>> items);
+    // Edits made between beginBatch and endBatch are reported as a single
+    // change, so bound lists reconcile (and relayout) once. Batches nest.
+    void beginBatch();
+    void endBatch();
     Core* clone() const override;
     void advanced() override;
 
 protected:
     std::vector<rcp<ViewModelInstanceListItem>> m_ListItems;
     void propertyValueChanged();
+
+private:
+    uint32_t m_batchDepth = 0;
+    bool m_batchChanged = false;
 };
 } // namespace rive
 
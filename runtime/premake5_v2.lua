@@ -136,6 +136,33 @@ do
     end
 end
 
+project('command_queue_bench')
+do
+    dependson('rive')
+
+    kind('ConsoleApp')
+    cppdialect('C++11')
+    includedirs({ 'include' })
+    defines({ 'YOGA_EXPORT=', '_RIVE_INTERNAL_' })
+
+    fatalwarnings({ 'All' })
+
+    files({ 'command_queue_bench/**.cpp', 'utils/no_op_factory.cpp' })
+
+    links({ 'rive', 'rive_harfbuzz', 'rive_sheenbidi', 'rive_yoga' })
+
+    filter('system:windows')
+    do
+        architecture('x64')
+        defines({ '_USE_MATH_DEFINES' })
+    end
+
+    filter('system:linux')
+    do
+        links({ 'pthread' })
+    end
+end
+
 newoption({
     trigger = 'with_rive_tools',
     description = 'Enables tools usually not necessary for runtime.',
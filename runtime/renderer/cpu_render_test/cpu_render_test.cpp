@@ -0,0 +1,456 @@
+/*
+ * Copyright 2025 Rive
+ */
+
+// Renders .riv files from test/assets through the CPU backend and compares
+// them against goldens. Run it from the repository root.
+//
+//   cpu_render_test [--update] [--goldens goldens.txt] [file.riv...]
+//
+// Each file's default scene is advanced a fixed number of steps and drawn
+// into a kSize x kSize target. Every file is rendered twice, with one thread
+// and with several, which must produce identical pixels. The image is then
+// reduced to a kGrid x kGrid grid of average premultiplied RGBA values and
+// compared against the golden, allowing each channel to drift by kTolerance
+// so that small rasterization changes don't fail the test but missing or
+// miscolored content does.
+//
+// --update rewrites the goldens from the current output instead of comparing.
+//
+// It also checks that the image atlas doesn't change how image meshes look:
+// a mesh whose UVs run past the image's edges is drawn with the atlas off and
+// on, for every wrap mode, and the two must match.
+
+#include "rive/artboard.hpp"
+#include "rive/file.hpp"
+#include "rive/layout.hpp"
+#include "rive/animation/state_machine_instance.hpp"
+#include "rive/static_scene.hpp"
+#include "rive/renderer/rive_renderer.hpp"
+#include "rive/renderer/cpu/render_context_cpu_impl.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace rive;
+using namespace rive::gpu;
+
+constexpr static uint32_t kSize = 256;
+constexpr static uint32_t kGrid = 16;
+constexpr static uint32_t kCell = kSize / kGrid;
+constexpr static int kTolerance = 6;
+constexpr static int kAdvanceSteps = 30;
+constexpr static uint32_t kThreadCount = 4;
+
+static const char* kDefaultFiles[] = {
+    "test/assets/off_road_car.riv",
+    "test/assets/rating.riv",
+    "test/assets/rewards.riv",
+    "test/assets/follow_path_shapes.riv",
+    "test/assets/local_bounds.riv",
+    "test/assets/skins_demo.riv",
+    "test/assets/tree_loading_bar.riv",
+    "test/assets/electrified_button_simple.riv",
+    "test/assets/batch_rivs/circle-fui.riv",
+    "test/assets/batch_rivs/danger-quarantine.riv",
+    "test/assets/batch_rivs/fire-skull.riv",
+    "test/assets/batch_rivs/joystick-demos-fish.riv",
+    "test/assets/batch_rivs/polito.riv",
+};
+
+static std::unique_ptr<Scene> make_scene(File* file,
+                                         ArtboardInstance* artboard,
+                                         rcp<ViewModelInstance>* viewModel)
+{
+    std::unique_ptr<Scene> scene = artboard->stateMachineAt(0);
+    if (scene == nullptr)
+    {
+        scene = artboard->animationAt(0);
+    }
+    if (scene == nullptr)
+    {
+        scene = std::make_unique<StaticScene>(artboard);
+    }
+
+    int viewModelId = artboard->viewModelId();
+    *viewModel = viewModelId == -1
+                     ? file->createViewModelInstance(artboard)
+                     : file->createViewModelInstance(viewModelId, 0);
+    artboard->bindViewModelInstance(*viewModel);
+    if (*viewModel != nullptr)
+    {
+        scene->bindViewModelInstance(*viewModel);
+    }
+    return scene;
+}
+
+// Renders the file's default scene and returns its pixels, or an empty vector
+// if it couldn't be loaded.
+static std::vector<uint8_t> render_file(RenderContext* renderContext,
+                                        const char* path)
+{
+    std::ifstream rivStream(path, std::ios::binary);
+    std::vector<uint8_t> rivBytes(std::istreambuf_iterator<char>(rivStream),
+                                  {});
+    rcp<File> file = File::import(rivBytes, renderContext);
+    if (file == nullptr)
+    {
+        fprintf(stderr, "%s: failed to import\n", path);
+        return {};
+    }
+    std::unique_ptr<ArtboardInstance> artboard = file->artboardDefault();
+    if (artboard == nullptr)
+    {
+        fprintf(stderr, "%s: no artboard\n", path);
+        return {};
+    }
+    rcp<ViewModelInstance> viewModel;
+    std::unique_ptr<Scene> scene =
+        make_scene(file.get(), artboard.get(), &viewModel);
+    for (int i = 0; i < kAdvanceSteps; ++i)
+    {
+        scene->advanceAndApply(1 / 60.f);
+    }
+
+    Mat2D viewMatrix = computeAlignment(
+        Fit::contain,
+        Alignment::center,
+        AABB(0, 0, static_cast<float>(kSize), static_cast<float>(kSize)),
+        artboard->bounds());
+    rcp<RenderTargetCPU> renderTarget =
+        renderContext->static_impl_cast<RenderContextCPUImpl>()
+            ->makeRenderTarget(kSize, kSize);
+    renderContext->beginFrame({
+        .renderTargetWidth = kSize,
+        .renderTargetHeight = kSize,
+        .clearColor = 0xff303030,
+    });
+    RiveRenderer renderer(renderContext);
+    renderer.save();
+    renderer.transform(viewMatrix);
+    scene->draw(&renderer);
+    renderer.restore();
+    renderContext->flush({.renderTarget = renderTarget.get()});
+
+    const uint8_t* pixels = renderTarget->pixels();
+    return std::vector<uint8_t>(pixels, pixels + kSize * kSize * 4);
+}
+
+// Draws one image mesh per wrap mode, with UVs from -0.5 to 1.5, and returns
+// the pixels. Images that pack next to the test image are solid red, so a
+// sample that leaks out of its atlas region shows up.
+static std::vector<uint8_t> render_image_meshes(bool imageAtlas)
+{
+    constexpr static uint32_t kImageWidth = 24;
+    constexpr static uint32_t kImageHeight = 20;
+    constexpr static uint32_t kTargetSize = 192;
+    std::unique_ptr<RenderContext> renderContext =
+        RenderContextCPUImpl::MakeContext({.threadCount = 1});
+    renderContext->setImageAtlasEnabled(imageAtlas);
+
+    std::vector<uint8_t> red(kImageWidth * kImageHeight * 4);
+    for (size_t i = 0; i < red.size(); i += 4)
+    {
+        red[i] = red[i + 3] = 255;
+    }
+    std::vector<uint8_t> pixels(kImageWidth * kImageHeight * 4);
+    for (uint32_t y = 0; y < kImageHeight; ++y)
+    {
+        for (uint32_t x = 0; x < kImageWidth; ++x)
+        {
+            uint8_t* pixel = &pixels[(y * kImageWidth + x) * 4];
+            pixel[0] = 0;
+            pixel[1] = static_cast<uint8_t>(x * 255 / (kImageWidth - 1));
+            pixel[2] = static_cast<uint8_t>(y * 255 / (kImageHeight - 1));
+            pixel[3] = 255;
+        }
+    }
+    rcp<RenderImage> before =
+        renderContext->makeImage(kImageWidth, kImageHeight, red.data());
+    rcp<RenderImage> image =
+        renderContext->makeImage(kImageWidth, kImageHeight, pixels.data());
+    rcp<RenderImage> after =
+        renderContext->makeImage(kImageWidth, kImageHeight, red.data());
+
+    constexpr static float kVertices[] = {0, 0, 60, 0, 60, 60, 0, 60};
+    constexpr static float kUVs[] =
+        {-.5f, -.5f, 1.5f, -.5f, 1.5f, 1.5f, -.5f, 1.5f};
+    constexpr static uint16_t kIndices[] = {0, 1, 2, 0, 2, 3};
+    auto makeBuffer =
+        [&](RenderBufferType type, const void* data, size_t size) {
+            rcp<RenderBuffer> buffer =
+                renderContext->makeRenderBuffer(type,
+                                                RenderBufferFlags::none,
+                                                size);
+            memcpy(buffer->map(), data, size);
+            buffer->unmap();
+            return buffer;
+        };
+    rcp<RenderBuffer> vertices =
+        makeBuffer(RenderBufferType::vertex, kVertices, sizeof(kVertices));
+    rcp<RenderBuffer> uvs =
+        makeBuffer(RenderBufferType::vertex, kUVs, sizeof(kUVs));
+    rcp<RenderBuffer> indices =
+        makeBuffer(RenderBufferType::index, kIndices, sizeof(kIndices));
+
+    rcp<RenderTargetCPU> renderTarget =
+        renderContext->static_impl_cast<RenderContextCPUImpl>()
+            ->makeRenderTarget(kTargetSize, kTargetSize);
+    renderContext->beginFrame({
+        .renderTargetWidth = kTargetSize,
+        .renderTargetHeight = kTargetSize,
+        .clearColor = 0xff303030,
+    });
+    RiveRenderer renderer(renderContext.get());
+    const ImageWrap wraps[] = {ImageWrap::clamp,
+                               ImageWrap::repeat,
+                               ImageWrap::mirror};
+    for (int i = 0; i < 3; ++i)
+    {
+        for (int j = 0; j < 3; ++j)
+        {
+            ImageSampler sampler;
+            sampler.wrapX = wraps[i];
+            sampler.wrapY = wraps[j];
+            renderer.save();
+            renderer.translate(4.f + 64 * i, 4.f + 64 * j);
+            renderer.drawImageMesh(image.get(),
+                                   sampler,
+                                   vertices,
+                                   uvs,
+                                   indices,
+                                   4,
+                                   6,
+                                   BlendMode::srcOver,
+                                   1);
+            renderer.restore();
+        }
+    }
+    renderContext->flush({.renderTarget = renderTarget.get()});
+
+    const uint8_t* result = renderTarget->pixels();
+    return std::vector<uint8_t>(result,
+                                result + kTargetSize * kTargetSize * 4);
+}
+
+static bool test_image_atlas_meshes()
+{
+    std::vector<uint8_t> standalone = render_image_meshes(false);
+    std::vector<uint8_t> atlased = render_image_meshes(true);
+    int maxDiff = 0;
+    for (size_t i = 0; i < standalone.size(); ++i)
+    {
+        maxDiff = std::max(maxDiff,
+                           abs(static_cast<int>(standalone[i]) - atlased[i]));
+    }
+    // Bilinear filtering of the atlas and the standalone texture may round
+    // differently.
+    if (maxDiff > 2)
+    {
+        fprintf(stderr,
+                "image meshes: atlased draws differ from standalone by %d\n",
+                maxDiff);
+        return false;
+    }
+    printf("image meshes: ok (max difference %d)\n", maxDiff);
+    return true;
+}
+
+// Averages each kCell x kCell block of pixels, channel by channel.
+static std::vector<uint8_t> reduce_to_grid(const std::vector<uint8_t>& pixels)
+{
+    std::vector<uint8_t> grid(kGrid * kGrid * 4);
+    for (uint32_t gy = 0; gy < kGrid; ++gy)
+    {
+        for (uint32_t gx = 0; gx < kGrid; ++gx)
+        {
+            uint32_t sums[4] = {0, 0, 0, 0};
+            for (uint32_t y = gy * kCell; y < (gy + 1) * kCell; ++y)
+            {
+                for (uint32_t x = gx * kCell; x < (gx + 1) * kCell; ++x)
+                {
+                    for (uint32_t c = 0; c < 4; ++c)
+                    {
+                        sums[c] += pixels[(y * kSize + x) * 4 + c];
+                    }
+                }
+            }
+            for (uint32_t c = 0; c < 4; ++c)
+            {
+                grid[(gy * kGrid + gx) * 4 + c] = static_cast<uint8_t>(
+                    (sums[c] + kCell * kCell / 2) / (kCell * kCell));
+            }
+        }
+    }
+    return grid;
+}
+
+// Goldens are one line per file: the path, a space, and the grid in hex.
+static std::map<std::string, std::string> read_goldens(const char* path)
+{
+    std::map<std::string, std::string> goldens;
+    std::ifstream stream(path);
+    std::string name, hex;
+    while (stream >> name >> hex)
+    {
+        goldens[name] = hex;
+    }
+    return goldens;
+}
+
+static std::string to_hex(const std::vector<uint8_t>& bytes)
+{
+    static const char digits[] = "0123456789abcdef";
+    std::string hex;
+    hex.reserve(bytes.size() * 2);
+    for (uint8_t byte : bytes)
+    {
+        hex.push_back(digits[byte >> 4]);
+        hex.push_back(digits[byte & 0xf]);
+    }
+    return hex;
+}
+
+static std::vector<uint8_t> from_hex(const std::string& hex)
+{
+    std::vector<uint8_t> bytes(hex.size() / 2);
+    for (size_t i = 0; i < bytes.size(); ++i)
+    {
+        bytes[i] = static_cast<uint8_t>(
+            strtoul(hex.substr(i * 2, 2).c_str(), nullptr, 16));
+    }
+    return bytes;
+}
+
+int main(int argc, const char** argv)
+{
+    const char* goldensPath = "runtime/renderer/cpu_render_test/goldens.txt";
+    bool update = false;
+    std::vector<const char*> rivPaths;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (!strcmp(argv[i], "--update"))
+        {
+            update = true;
+        }
+        else if (!strcmp(argv[i], "--goldens") && i + 1 < argc)
+        {
+            goldensPath = argv[++i];
+        }
+        else if (argv[i][0] != '-')
+        {
+            rivPaths.push_back(argv[i]);
+        }
+        else
+        {
+            fprintf(stderr,
+                    "usage: cpu_render_test [--update] [--goldens "
+                    "goldens.txt] [file.riv...]\n");
+            return 1;
+        }
+    }
+    if (rivPaths.empty())
+    {
+        rivPaths.assign(std::begin(kDefaultFiles), std::end(kDefaultFiles));
+    }
+
+    std::unique_ptr<RenderContext> singleThreaded =
+        RenderContextCPUImpl::MakeContext({.threadCount = 1});
+    std::unique_ptr<RenderContext> multiThreaded =
+        RenderContextCPUImpl::MakeContext({.threadCount = kThreadCount});
+    std::map<std::string, std::string> goldens = read_goldens(goldensPath);
+
+    int failures = 0;
+    for (const char* path : rivPaths)
+    {
+        std::vector<uint8_t> pixels = render_file(singleThreaded.get(), path);
+        if (pixels.empty())
+        {
+            ++failures;
+            continue;
+        }
+        if (render_file(multiThreaded.get(), path) != pixels)
+        {
+            fprintf(stderr,
+                    "%s: %u threads rendered different pixels than 1\n",
+                    path,
+                    kThreadCount);
+            ++failures;
+        }
+
+        std::vector<uint8_t> grid = reduce_to_grid(pixels);
+        if (update)
+        {
+            goldens[path] = to_hex(grid);
+            continue;
+        }
+        auto golden = goldens.find(path);
+        if (golden == goldens.end())
+        {
+            fprintf(stderr, "%s: no golden, run with --update\n", path);
+            ++failures;
+            continue;
+        }
+        std::vector<uint8_t> expected = from_hex(golden->second);
+        if (expected.size() != grid.size())
+        {
+            fprintf(stderr, "%s: golden has the wrong size\n", path);
+            ++failures;
+            continue;
+        }
+        int maxDiff = 0;
+        size_t worst = 0;
+        for (size_t i = 0; i < grid.size(); ++i)
+        {
+            int diff = abs(static_cast<int>(grid[i]) - expected[i]);
+            if (diff > maxDiff)
+            {
+                maxDiff = diff;
+                worst = i;
+            }
+        }
+        if (maxDiff > kTolerance)
+        {
+            fprintf(stderr,
+                    "%s: cell (%zu, %zu) differs from the golden by %d\n",
+                    path,
+                    worst / 4 % kGrid,
+                    worst / 4 / kGrid,
+                    maxDiff);
+            ++failures;
+        }
+        else
+        {
+            printf("%s: ok (max difference %d)\n", path, maxDiff);
+        }
+    }
+
+    if (!test_image_atlas_meshes())
+    {
+        ++failures;
+    }
+
+    if (update)
+    {
+        FILE* out = fopen(goldensPath, "w");
+        if (out == nullptr)
+        {
+            fprintf(stderr, "%s: failed to open\n", goldensPath);
+            return 1;
+        }
+        for (const auto& [name, hex] : goldens)
+        {
+            fprintf(out, "%s %s\n", name.c_str(), hex.c_str());
+        }
+        fclose(out);
+        printf("wrote %zu goldens to %s\n", goldens.size(), goldensPath);
+    }
+    return failures == 0 ? 0 : 1;
+}
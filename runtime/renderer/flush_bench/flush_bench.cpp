@@ -0,0 +1,495 @@
+/*
+ * Copyright 2025 Rive
+ */
+
+// Replays .riv files through RiveRenderer on the null backend and reports the
+// CPU time spent in each stage of RenderContext::flush(), along with the bytes
+// written to the resource buffers. No GPU is required.
+//
+//   flush_bench [--frames N] [--warmup N] [--size WxH] [--threads N]
+//               [--static] [--no-tess-cache] [--no-tri-cache]
+//               [--no-grad-cache] [--picture-cache] [--image-atlas]
+//               [--trace-intersections out.txt]
+//               [--trace-triangulations out.txt]
+//               [--atomic | --clockwise | --msaa] [file.riv | dir]...
+//
+// Directories are expanded to the .riv files they contain. With no files, the
+// batch suite in test/assets/batch_rivs/ is replayed, so run it from the
+// repository root.
+//
+// --static only advances the scene once, to measure redrawing unchanged
+// content.
+//
+// --picture-cache enables Artboard::usePictureCache(), which replays a recorded
+// Picture whenever the artboard hasn't changed since the previous frame.
+//
+// --image-atlas enables RenderContext::setImageAtlasEnabled() before the files
+// are imported, so their small images get packed into shared textures.
+//
+// --trace-intersections saves every rectangle that draw reordering adds to the
+// IntersectionBoard (atomic, clockwise, and msaa modes only), for replaying
+// with intersection_board_bench.
+//
+// --trace-triangulations saves every interior polygon that gets run through
+// GrTriangulator (atomic and clockwise modes only), for replaying with
+// triangulation_bench.
+
+#include "rive/artboard.hpp"
+#include "rive/file.hpp"
+#include "rive/layout.hpp"
+#include "rive/animation/state_machine_instance.hpp"
+#include "rive/static_scene.hpp"
+#include "rive/renderer/rive_renderer.hpp"
+#include "rive/renderer/null/render_context_null_impl.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+using namespace rive;
+using namespace rive::gpu;
+
+static int frames = 100;
+static int warmupFrames = 10;
+static uint32_t width = 1600;
+static uint32_t height = 1600;
+static bool atomic = false;
+static bool clockwise = false;
+static int msaa = 0;
+static uint32_t threadCount = 1;
+static bool tessellationCache = true;
+static bool triangulationCache = true;
+static bool gradientRampCache = true;
+static bool staticScene = false;
+static bool pictureCache = false;
+static bool imageAtlas = false;
+static const char* intersectionTracePath = nullptr;
+static const char* triangulationTracePath = nullptr;
+
+// Replayed when no files are given on the command line.
+static const char* defaultRivDirectory = "test/assets/batch_rivs/";
+
+// Sums of FlushStats over every measured frame of a file.
+struct BenchTotals
+{
+    double advanceSeconds = 0;
+    double drawSeconds = 0;
+    RenderContext::FlushStats flush;
+
+    void add(const RenderContext::FlushStats& stats)
+    {
+        flush.pushDrawsSeconds += stats.pushDrawsSeconds;
+        flush.layoutResourcesSeconds += stats.layoutResourcesSeconds;
+        flush.writeResourcesSeconds += stats.writeResourcesSeconds;
+        flush.reorderDrawsSeconds += stats.reorderDrawsSeconds;
+        flush.writeDrawsSeconds += stats.writeDrawsSeconds;
+        flush.writeTessellationSeconds += stats.writeTessellationSeconds;
+        flush.backendFlushSeconds += stats.backendFlushSeconds;
+        flush.logicalFlushCount += stats.logicalFlushCount;
+        flush.drawCount += stats.drawCount;
+        flush.drawBatchCount += stats.drawBatchCount;
+        flush.tessVertexSpanCount += stats.tessVertexSpanCount;
+        flush.triangleVertexCount += stats.triangleVertexCount;
+        flush.uniformBytesWritten += stats.uniformBytesWritten;
+        flush.pathBytesWritten += stats.pathBytesWritten;
+        flush.paintBytesWritten += stats.paintBytesWritten;
+        flush.contourBytesWritten += stats.contourBytesWritten;
+        flush.gradSpanBytesWritten += stats.gradSpanBytesWritten;
+        flush.tessSpanBytesWritten += stats.tessSpanBytesWritten;
+        flush.triangleBytesWritten += stats.triangleBytesWritten;
+    }
+};
+
+static double seconds_now()
+{
+    return std::chrono::duration<double>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+static std::unique_ptr<Scene> make_scene(File* file,
+                                         ArtboardInstance* artboard,
+                                         rcp<ViewModelInstance>* viewModel)
+{
+    std::unique_ptr<Scene> scene = artboard->stateMachineAt(0);
+    if (scene == nullptr)
+    {
+        scene = artboard->animationAt(0);
+    }
+    if (scene == nullptr)
+    {
+        // This is a riv without any animations or state machines. Just draw
+        // the artboard.
+        scene = std::make_unique<StaticScene>(artboard);
+    }
+
+    int viewModelId = artboard->viewModelId();
+    *viewModel = viewModelId == -1
+                     ? file->createViewModelInstance(artboard)
+                     : file->createViewModelInstance(viewModelId, 0);
+    artboard->bindViewModelInstance(*viewModel);
+    if (*viewModel != nullptr)
+    {
+        scene->bindViewModelInstance(*viewModel);
+    }
+    return scene;
+}
+
+static bool bench_file(RenderContext* renderContext,
+                       RenderTarget* renderTarget,
+                       const char* path)
+{
+    std::ifstream rivStream(path, std::ios::binary);
+    std::vector<uint8_t> rivBytes(std::istreambuf_iterator<char>(rivStream),
+                                  {});
+    rcp<File> file = File::import(rivBytes, renderContext);
+    if (file == nullptr)
+    {
+        fprintf(stderr, "%s: failed to import\n", path);
+        return false;
+    }
+    std::unique_ptr<ArtboardInstance> artboard = file->artboardDefault();
+    if (artboard == nullptr)
+    {
+        fprintf(stderr, "%s: no artboard\n", path);
+        return false;
+    }
+    rcp<ViewModelInstance> viewModel;
+    std::unique_ptr<Scene> scene =
+        make_scene(file.get(), artboard.get(), &viewModel);
+    artboard->usePictureCache(pictureCache);
+
+    Mat2D viewMatrix = computeAlignment(Fit::contain,
+                                        Alignment::center,
+                                        AABB(0,
+                                             0,
+                                             static_cast<float>(width),
+                                             static_cast<float>(height)),
+                                        artboard->bounds());
+
+    BenchTotals totals;
+    RenderContext::FrameDescriptor frameDescriptor = {
+        .renderTargetWidth = width,
+        .renderTargetHeight = height,
+        .clearColor = 0xff303030,
+        .msaaSampleCount = msaa,
+        .disableRasterOrdering = atomic || clockwise,
+        .clockwiseFillOverride = clockwise,
+    };
+    for (int i = 0; i < warmupFrames + frames; ++i)
+    {
+        double t0 = seconds_now();
+        if (!staticScene || i == 0)
+        {
+            scene->advanceAndApply(1 / 60.f);
+        }
+        double t1 = seconds_now();
+
+        renderContext->beginFrame(frameDescriptor);
+        RiveRenderer renderer(renderContext);
+        renderer.save();
+        renderer.transform(viewMatrix);
+        scene->draw(&renderer);
+        renderer.restore();
+        double t2 = seconds_now();
+
+        renderContext->flush({
+            .renderTarget = renderTarget,
+            .currentFrameNumber = static_cast<uint64_t>(i + 1),
+            .safeFrameNumber = static_cast<uint64_t>(i),
+        });
+
+        if (i >= warmupFrames)
+        {
+            totals.advanceSeconds += t1 - t0;
+            totals.drawSeconds += t2 - t1;
+            totals.add(renderContext->lastFlushStats());
+        }
+    }
+
+    // Report per-frame averages. Times are in milliseconds.
+    const RenderContext::FlushStats& f = totals.flush;
+    double n = frames;
+    double ms = 1000 / n;
+    printf("%s\n", path);
+    printf("  advance %8.3f ms   draw %8.3f ms (pushDraws %.3f ms)\n",
+           totals.advanceSeconds * ms,
+           totals.drawSeconds * ms,
+           f.pushDrawsSeconds * ms);
+    printf("  layout  %8.3f ms   write %8.3f ms (tessellation %.3f ms, reorder "
+           "%.3f ms, draws %.3f ms)   backend %.3f ms\n",
+           f.layoutResourcesSeconds * ms,
+           f.writeResourcesSeconds * ms,
+           f.writeTessellationSeconds * ms,
+           f.reorderDrawsSeconds * ms,
+           f.writeDrawsSeconds * ms,
+           f.backendFlushSeconds * ms);
+    printf("  %.1f logical flushes, %.1f draws, %.1f batches, %.1f tess "
+           "spans, %.1f triangle vertices\n",
+           f.logicalFlushCount / n,
+           f.drawCount / n,
+           f.drawBatchCount / n,
+           f.tessVertexSpanCount / n,
+           f.triangleVertexCount / n);
+    printf("  %.0f bytes written (uniform %.0f, path %.0f, paint %.0f, contour "
+           "%.0f, gradSpan %.0f, tessSpan %.0f, triangle %.0f)\n",
+           f.totalBytesWritten() / n,
+           f.uniformBytesWritten / n,
+           f.pathBytesWritten / n,
+           f.paintBytesWritten / n,
+           f.contourBytesWritten / n,
+           f.gradSpanBytesWritten / n,
+           f.tessSpanBytesWritten / n,
+           f.triangleBytesWritten / n);
+    return true;
+}
+
+// Writes one line per logical flush ("flush width height") and one per
+// rectangle ("rect l t r b layerCount").
+static bool write_intersection_trace(
+    const std::vector<RenderContext::IntersectionTraceEntry>& trace,
+    const char* path)
+{
+    FILE* out = fopen(path, "w");
+    if (out == nullptr)
+    {
+        fprintf(stderr, "%s: failed to open\n", path);
+        return false;
+    }
+    for (const RenderContext::IntersectionTraceEntry& entry : trace)
+    {
+        if (entry.layerCount == 0)
+        {
+            fprintf(out, "flush %d %d\n", entry.ltrb[2], entry.ltrb[3]);
+        }
+        else
+        {
+            fprintf(out,
+                    "rect %d %d %d %d %d\n",
+                    entry.ltrb[0],
+                    entry.ltrb[1],
+                    entry.ltrb[2],
+                    entry.ltrb[3],
+                    entry.layerCount);
+        }
+    }
+    fclose(out);
+    return true;
+}
+
+// Writes one line per polygon ("path evenOdd horizontalAxis"), followed by
+// one line per vertex ("M x y" or "L x y").
+static bool write_triangulation_trace(
+    const std::vector<RenderContext::TriangulationTraceEntry>& trace,
+    const char* path)
+{
+    FILE* out = fopen(path, "w");
+    if (out == nullptr)
+    {
+        fprintf(stderr, "%s: failed to open\n", path);
+        return false;
+    }
+    for (const RenderContext::TriangulationTraceEntry& entry : trace)
+    {
+        fprintf(out,
+                "path %d %d\n",
+                entry.fillRule == FillRule::evenOdd,
+                entry.horizontalAxis);
+        for (const auto [verb, pts] : entry.path)
+        {
+            switch (verb)
+            {
+                case PathVerb::move:
+                    fprintf(out, "M %.9g %.9g\n", pts[0].x, pts[0].y);
+                    break;
+                case PathVerb::line:
+                    fprintf(out, "L %.9g %.9g\n", pts[1].x, pts[1].y);
+                    break;
+                default:
+                    // Interior polygons are only made of moves and lines.
+                    break;
+            }
+        }
+    }
+    fclose(out);
+    return true;
+}
+
+// Appends path, or the .riv files in it if it is a directory, in sorted order.
+static bool add_riv_paths(const char* path, std::vector<std::string>* rivPaths)
+{
+    std::error_code error;
+    if (!std::filesystem::is_directory(path, error))
+    {
+        rivPaths->push_back(path);
+        return true;
+    }
+    std::vector<std::string> files;
+    for (const auto& entry : std::filesystem::directory_iterator(path, error))
+    {
+        if (entry.path().extension() == ".riv")
+        {
+            files.push_back(entry.path().string());
+        }
+    }
+    if (files.empty())
+    {
+        fprintf(stderr, "%s: no .riv files\n", path);
+        return false;
+    }
+    std::sort(files.begin(), files.end());
+    rivPaths->insert(rivPaths->end(), files.begin(), files.end());
+    return true;
+}
+
+int main(int argc, const char** argv)
+{
+    std::vector<std::string> rivPaths;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (!strcmp(argv[i], "--frames") && i + 1 < argc)
+        {
+            frames = atoi(argv[++i]);
+        }
+        else if (!strcmp(argv[i], "--warmup") && i + 1 < argc)
+        {
+            warmupFrames = atoi(argv[++i]);
+        }
+        else if (!strcmp(argv[i], "--size") && i + 1 < argc)
+        {
+            if (sscanf(argv[++i], "%ux%u", &width, &height) != 2)
+            {
+                fprintf(stderr, "invalid size: %s\n", argv[i]);
+                return 1;
+            }
+        }
+        else if (!strcmp(argv[i], "--threads") && i + 1 < argc)
+        {
+            threadCount = static_cast<uint32_t>(atoi(argv[++i]));
+        }
+        else if (!strcmp(argv[i], "--static"))
+        {
+            staticScene = true;
+        }
+        else if (!strcmp(argv[i], "--no-tess-cache"))
+        {
+            tessellationCache = false;
+        }
+        else if (!strcmp(argv[i], "--no-tri-cache"))
+        {
+            triangulationCache = false;
+        }
+        else if (!strcmp(argv[i], "--no-grad-cache"))
+        {
+            gradientRampCache = false;
+        }
+        else if (!strcmp(argv[i], "--picture-cache"))
+        {
+            pictureCache = true;
+        }
+        else if (!strcmp(argv[i], "--image-atlas"))
+        {
+            imageAtlas = true;
+        }
+        else if (!strcmp(argv[i], "--trace-intersections") && i + 1 < argc)
+        {
+            intersectionTracePath = argv[++i];
+        }
+        else if (!strcmp(argv[i], "--trace-triangulations") && i + 1 < argc)
+        {
+            triangulationTracePath = argv[++i];
+        }
+        else if (!strcmp(argv[i], "--atomic"))
+        {
+            atomic = true;
+        }
+        else if (!strcmp(argv[i], "--clockwise"))
+        {
+            clockwise = true;
+        }
+        else if (!strcmp(argv[i], "--msaa"))
+        {
+            msaa = 4;
+        }
+        else if (!add_riv_paths(argv[i], &rivPaths))
+        {
+            return 1;
+        }
+    }
+    if (rivPaths.empty())
+    {
+        std::error_code error;
+        if (!std::filesystem::is_directory(defaultRivDirectory, error))
+        {
+            fprintf(stderr,
+                    "%s not found; run from the repository root or pass "
+                    "files\n",
+                    defaultRivDirectory);
+            return 1;
+        }
+        if (!add_riv_paths(defaultRivDirectory, &rivPaths))
+        {
+            return 1;
+        }
+    }
+    if (frames <= 0)
+    {
+        fprintf(stderr,
+                "usage: flush_bench [--frames N] [--warmup N] [--size WxH] "
+                "[--threads N] [--static] [--no-tess-cache] "
+                "[--no-tri-cache] [--no-grad-cache] [--picture-cache] "
+                "[--image-atlas] "
+                "[--trace-intersections out.txt] "
+                "[--trace-triangulations out.txt] "
+                "[--atomic | --clockwise | --msaa] [file.riv | dir]...\n");
+        return 1;
+    }
+
+    std::unique_ptr<RenderContext> renderContext =
+        RenderContextNullImpl::MakeContext();
+    renderContext->setFlushStatsEnabled(true);
+    renderContext->setFlushThreadCount(threadCount);
+    renderContext->setTessellationCacheEnabled(tessellationCache);
+    renderContext->setTriangulationCacheEnabled(triangulationCache);
+    renderContext->setGradientRampCacheEnabled(gradientRampCache);
+    renderContext->setImageAtlasEnabled(imageAtlas);
+    std::vector<RenderContext::IntersectionTraceEntry> intersectionTrace;
+    if (intersectionTracePath != nullptr)
+    {
+        renderContext->setIntersectionTrace(&intersectionTrace);
+    }
+    std::vector<RenderContext::TriangulationTraceEntry> triangulationTrace;
+    if (triangulationTracePath != nullptr)
+    {
+        renderContext->setTriangulationTrace(&triangulationTrace);
+    }
+    rcp<RenderTargetNull> renderTarget =
+        renderContext->static_impl_cast<RenderContextNullImpl>()
+            ->makeRenderTarget(width, height);
+
+    int failures = 0;
+    for (const std::string& path : rivPaths)
+    {
+        if (!bench_file(renderContext.get(), renderTarget.get(), path.c_str()))
+        {
+            ++failures;
+        }
+    }
+    if (intersectionTracePath != nullptr &&
+        !write_intersection_trace(intersectionTrace, intersectionTracePath))
+    {
+        ++failures;
+    }
+    if (triangulationTracePath != nullptr &&
+        !write_triangulation_trace(triangulationTrace, triangulationTracePath))
+    {
+        ++failures;
+    }
+    return failures == 0 ? 0 : 1;
+}
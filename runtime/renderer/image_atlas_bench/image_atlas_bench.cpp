@@ -0,0 +1,263 @@
+/*
+ * Copyright 2025 Rive
+ */
+
+// Packs randomly sized images into ImageAtlas pages, and reports the time spent
+// per image and how full the pages end up. Then checks every image's region
+// and gutter in the page pixels, and draws all the images through RiveRenderer
+// on the null backend, with and without the atlas, to compare the number of
+// draw batches.
+//
+//   image_atlas_bench [--images N] [--iterations N] [--seed N]
+//
+// Exits with an error if any region doesn't match its image.
+
+#include "rive/renderer/image_atlas.hpp"
+#include "rive/renderer/rive_renderer.hpp"
+#include "rive/renderer/null/render_context_null_impl.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+using namespace rive;
+using namespace rive::gpu;
+
+struct TestImage
+{
+    uint32_t width;
+    uint32_t height;
+    std::vector<uint32_t> texels;
+};
+
+static double seconds_now()
+{
+    return std::chrono::duration<double>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+static uint32_t next_random(uint32_t* state)
+{
+    // xorshift32.
+    uint32_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return *state = x;
+}
+
+// Fills each image with texels that depend on its index, so a region that got
+// overwritten by a neighbor can't go unnoticed.
+static std::vector<TestImage> make_images(size_t count, uint32_t seed)
+{
+    std::vector<TestImage> images(count);
+    uint32_t state = seed != 0 ? seed : 1;
+    for (size_t i = 0; i < count; ++i)
+    {
+        TestImage& image = images[i];
+        image.width = 1 + next_random(&state) % ImageAtlas::kMaxImageSize;
+        image.height = 1 + next_random(&state) % ImageAtlas::kMaxImageSize;
+        image.texels.resize(static_cast<size_t>(image.width) * image.height);
+        for (uint32_t& texel : image.texels)
+        {
+            texel = next_random(&state) ^ static_cast<uint32_t>(i);
+        }
+    }
+    return images;
+}
+
+// Checks that the image, plus a gutter of replicated edge texels, is where its
+// uvTransform says it is.
+static bool verify_region(const TestImage& image,
+                          const ImageAtlasPage& page,
+                          const Mat2D& uvTransform)
+{
+    float pageSize = static_cast<float>(page.size());
+    if (uvTransform.xx() * pageSize != static_cast<float>(image.width) ||
+        uvTransform.yy() * pageSize != static_cast<float>(image.height) ||
+        uvTransform.xy() != 0 || uvTransform.yx() != 0)
+    {
+        return false;
+    }
+    float left = uvTransform.tx() * pageSize;
+    float top = uvTransform.ty() * pageSize;
+    if (left != std::floor(left) || top != std::floor(top) ||
+        static_cast<uint32_t>(left) % ImageAtlas::kAlignment != 0 ||
+        static_cast<uint32_t>(top) % ImageAtlas::kAlignment != 0)
+    {
+        return false;
+    }
+    int gutter = static_cast<int>(ImageAtlas::kGutter);
+    int x0 = static_cast<int>(left) - gutter;
+    int y0 = static_cast<int>(top) - gutter;
+    int x1 = static_cast<int>(left + image.width) + gutter;
+    int y1 = static_cast<int>(top + image.height) + gutter;
+    if (x0 < 0 || y0 < 0 || x1 > static_cast<int>(page.size()) ||
+        y1 > static_cast<int>(page.size()))
+    {
+        return false;
+    }
+    const std::vector<uint32_t>& pixels = page.pixels();
+    for (int y = y0; y < y1; ++y)
+    {
+        int srcY =
+            std::clamp(y - static_cast<int>(top), 0, int(image.height) - 1);
+        for (int x = x0; x < x1; ++x)
+        {
+            int srcX =
+                std::clamp(x - static_cast<int>(left), 0, int(image.width) - 1);
+            uint32_t expected = image.texels[srcY * image.width + srcX];
+            if (pixels[static_cast<size_t>(y) * page.size() + x] != expected)
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// Draws every image once, in a grid, and returns the number of draw batches.
+static size_t count_batches(const std::vector<TestImage>& images,
+                            bool useAtlas,
+                            bool msaa)
+{
+    std::unique_ptr<RenderContext> renderContext =
+        RenderContextNullImpl::MakeContext();
+    renderContext->setFlushStatsEnabled(true);
+    renderContext->setImageAtlasEnabled(useAtlas);
+    std::vector<rcp<RenderImage>> renderImages;
+    for (const TestImage& image : images)
+    {
+        renderImages.push_back(renderContext->makeImage(
+            image.width,
+            image.height,
+            reinterpret_cast<const uint8_t*>(image.texels.data())));
+    }
+
+    constexpr static uint32_t kSize = 2048;
+    rcp<RenderTargetNull> renderTarget =
+        renderContext->static_impl_cast<RenderContextNullImpl>()
+            ->makeRenderTarget(kSize, kSize);
+    renderContext->beginFrame({
+        .renderTargetWidth = kSize,
+        .renderTargetHeight = kSize,
+        .msaaSampleCount = msaa ? 4 : 0,
+    });
+    RiveRenderer renderer(renderContext.get());
+    uint32_t columns = kSize / ImageAtlas::kMaxImageSize;
+    for (size_t i = 0; i < renderImages.size(); ++i)
+    {
+        renderer.save();
+        renderer.translate(
+            static_cast<float>(i % columns * ImageAtlas::kMaxImageSize),
+            static_cast<float>(i / columns % columns *
+                               ImageAtlas::kMaxImageSize));
+        renderer.drawImage(renderImages[i].get(),
+                           ImageSampler::LinearClamp(),
+                           BlendMode::srcOver,
+                           1);
+        renderer.restore();
+    }
+    renderContext->flush({.renderTarget = renderTarget.get()});
+    return renderContext->lastFlushStats().drawBatchCount;
+}
+
+int main(int argc, const char** argv)
+{
+    size_t imageCount = 1000;
+    int iterations = 20;
+    uint32_t seed = 1;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (!strcmp(argv[i], "--images") && i + 1 < argc)
+        {
+            imageCount = static_cast<size_t>(atoi(argv[++i]));
+        }
+        else if (!strcmp(argv[i], "--iterations") && i + 1 < argc)
+        {
+            iterations = atoi(argv[++i]);
+        }
+        else if (!strcmp(argv[i], "--seed") && i + 1 < argc)
+        {
+            seed = static_cast<uint32_t>(atoi(argv[++i]));
+        }
+        else
+        {
+            fprintf(stderr,
+                    "usage: image_atlas_bench [--images N] [--iterations N] "
+                    "[--seed N]\n");
+            return 1;
+        }
+    }
+    if (imageCount == 0 || iterations <= 0)
+    {
+        fprintf(stderr, "--images and --iterations must be positive\n");
+        return 1;
+    }
+
+    std::vector<TestImage> images = make_images(imageCount, seed);
+    uint64_t imageTexelCount = 0;
+    for (const TestImage& image : images)
+    {
+        imageTexelCount += image.texels.size();
+    }
+
+    std::vector<rcp<ImageAtlasPage>> pages(imageCount);
+    std::vector<Mat2D> uvTransforms(imageCount);
+    size_t pageCount = 0;
+    double bestSeconds = std::numeric_limits<double>::infinity();
+    for (int i = 0; i < iterations; ++i)
+    {
+        ImageAtlas atlas;
+        double t0 = seconds_now();
+        for (size_t j = 0; j < imageCount; ++j)
+        {
+            const TestImage& image = images[j];
+            pages[j] = atlas.add(
+                image.width,
+                image.height,
+                reinterpret_cast<const uint8_t*>(image.texels.data()),
+                &uvTransforms[j]);
+        }
+        bestSeconds = std::min(seconds_now() - t0, bestSeconds);
+        pageCount = atlas.pageCount();
+    }
+
+    double pageTexelCount = static_cast<double>(ImageAtlas::kPageSize) *
+                            ImageAtlas::kPageSize * pageCount;
+    printf("%zu images, %zu pages of %ux%u (%.1f%% image texels)\n",
+           imageCount,
+           pageCount,
+           ImageAtlas::kPageSize,
+           ImageAtlas::kPageSize,
+           imageTexelCount * 100 / pageTexelCount);
+    printf("best of %d: %.3f ms (%.1f ns per image texel)\n",
+           iterations,
+           bestSeconds * 1e3,
+           bestSeconds * 1e9 / static_cast<double>(imageTexelCount));
+
+    size_t failures = 0;
+    for (size_t j = 0; j < imageCount; ++j)
+    {
+        if (!verify_region(images[j], *pages[j], uvTransforms[j]))
+        {
+            fprintf(stderr, "image %zu: region doesn't match\n", j);
+            ++failures;
+        }
+    }
+    printf("verified %zu regions, %zu failures\n", imageCount, failures);
+
+    printf("draw batches without atlas: %zu (msaa %zu)\n",
+           count_batches(images, false, false),
+           count_batches(images, false, true));
+    printf("draw batches with atlas:    %zu (msaa %zu)\n",
+           count_batches(images, true, false),
+           count_batches(images, true, true));
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,129 @@
+/*
+ * Copyright 2025 Rive
+ */
+
+#pragma once
+
+#include "rive/renderer/render_context_helper_impl.hpp"
+#include <memory>
+#include <vector>
+
+namespace rive::gpu
+{
+class RenderContextCPUImpl;
+class WorkerPool;
+
+// CPU backend implementation of RenderTarget. Pixels are premultiplied RGBA8,
+// stored top-down with no padding between rows.
+class RenderTargetCPU : public RenderTarget
+{
+public:
+    RenderTargetCPU(uint32_t width, uint32_t height);
+    ~RenderTargetCPU() override {}
+
+    uint8_t* pixels() { return reinterpret_cast<uint8_t*>(m_pixels.get()); }
+    const uint8_t* pixels() const
+    {
+        return reinterpret_cast<const uint8_t*>(m_pixels.get());
+    }
+    size_t rowBytes() const { return width() * sizeof(uint32_t); }
+
+private:
+    friend class RenderContextCPUImpl;
+
+    // Pixel local storage planes other than color. Coverage and clip hold a
+    // value along with the ID of the path or clip that wrote it.
+    struct CoverageTexel
+    {
+        float value;
+        uint32_t id;
+    };
+
+    // Allocates the remaining planes on first use.
+    void allocatePLSPlanes();
+
+    std::unique_ptr<uint32_t[]> m_pixels;
+    std::unique_ptr<uint32_t[]> m_scratchColor;
+    std::unique_ptr<CoverageTexel[]> m_coverage;
+    std::unique_ptr<CoverageTexel[]> m_clip;
+};
+
+// CPU backend implementation of RenderContextImpl, for headless rendering
+// without a GPU. Resource buffers live in host memory and flushes are executed
+// by a tiled rasterizer that splits the render target into horizontal bands
+// and shades them in parallel.
+class RenderContextCPUImpl : public RenderContextHelperImpl
+{
+public:
+    struct ContextOptions
+    {
+        // Number of threads that rasterize a flush, including the thread that
+        // calls flush(). 0 means one per hardware thread.
+        uint32_t threadCount = 0;
+    };
+
+    static std::unique_ptr<RenderContext> MakeContext(const ContextOptions&);
+
+    ~RenderContextCPUImpl() override;
+
+    rcp<RenderTargetCPU> makeRenderTarget(uint32_t width, uint32_t height)
+    {
+        return make_rcp<RenderTargetCPU>(width, height);
+    }
+
+    rcp<RenderBuffer> makeRenderBuffer(RenderBufferType,
+                                       RenderBufferFlags,
+                                       size_t) override;
+
+    rcp<Texture> makeImageTexture(uint32_t width,
+                                  uint32_t height,
+                                  uint32_t mipLevelCount,
+                                  const uint8_t imageDataRGBAPremul[]) override;
+
+private:
+    RenderContextCPUImpl(const ContextOptions&);
+
+    std::unique_ptr<BufferRing> makeUniformBufferRing(
+        size_t capacityInBytes) override;
+    std::unique_ptr<BufferRing> makeStorageBufferRing(
+        size_t capacityInBytes,
+        gpu::StorageBufferStructure) override;
+    std::unique_ptr<BufferRing> makeVertexBufferRing(
+        size_t capacityInBytes) override;
+
+    void resizeGradientTexture(uint32_t width, uint32_t height) override;
+    void resizeTessellationTexture(uint32_t width, uint32_t height) override;
+    void resizeAtlasTexture(uint32_t width, uint32_t height) override;
+
+    void flush(const FlushDescriptor&) override;
+
+    // Per-flush state and reusable scratch memory, defined in the .cpp.
+    struct FlushState;
+
+    void renderGradientSpans(const FlushState&);
+    void renderTessellationSpans(const FlushState&);
+    void renderAtlas(FlushState&);
+    void renderDrawList(FlushState&);
+
+    std::unique_ptr<WorkerPool> m_workerPool;
+    std::unique_ptr<FlushState> m_flushState;
+
+    // RGBA8 unmultiplied, kGradTextureWidth texels per row.
+    std::vector<uint32_t> m_gradTexture;
+    uint32_t m_gradTextureHeight = 0;
+
+    // Four 32-bit words per texel: position, angle, and contour flags.
+    std::vector<uint32_t> m_tessTexture;
+    uint32_t m_tessTextureHeight = 0;
+
+    std::vector<float> m_atlasTexture;
+    uint32_t m_atlasTextureWidth = 0;
+    uint32_t m_atlasTextureHeight = 0;
+
+    PatchVertex m_patchVertices[kPatchVertexBufferCount];
+    uint16_t m_patchIndices[kPatchIndexBufferCount];
+
+    float m_featherTable[GAUSSIAN_TABLE_SIZE];
+    float m_inverseFeatherTable[GAUSSIAN_TABLE_SIZE];
+};
+} // namespace rive::gpu
@@ -253,7 +253,10 @@ public:
         return m_coverageBufferRange;
     }
 
-    GrInnerFanTriangulator* triangulator() const { return m_triangulator; }
+    const GrInnerFanTriangulator* triangulator() const
+    {
+        return m_triangulator;
+    }
 
     bool allocateResources(RenderContext::LogicalFlush*) override;
     void countSubpasses() override;
@@ -270,6 +273,11 @@ public:
                                uint32_t* tessVertexCount,
                                uint32_t* tessBaseVertex);
 
+    // Writes out the contours and TessVertexSpans reserved by
+    // pushTessellationData(). Only touches this draw and its reserved ranges,
+    // so separate draws may write their data concurrently.
+    void writeTessellationData(RenderContext::TessellationWriter*);
+
     void releaseRefs() override;
 
 protected:
@@ -281,6 +289,20 @@ protected:
     // Prepares to draw the path by tessellating a fan around its midpoint.
     void initForMidpointFan(RenderContext*, const RiveRenderPaint*);
 
+    struct MidpointFanCounts;
+    struct MidpointFanData;
+
+    // Final step of initForMidpointFan(). Fills in m_resourceCounts from the
+    // totals counted over the path.
+    void finishMidpointFanInit(size_t contourCount, const MidpointFanCounts&);
+
+    // Copies the results of a previous initForMidpointFan() into this frame's
+    // allocators, and the results of this one out of them.
+    void loadMidpointFanData(RenderContext*, const MidpointFanData&);
+    void saveMidpointFanData(size_t contourCount,
+                             const MidpointFanCounts&,
+                             MidpointFanData*) const;
+
     enum class TriangulatorAxis
     {
         horizontal,
@@ -311,8 +333,8 @@ protected:
         uint32_t tessLocation,
         gpu::ShaderMiscFlags = gpu::ShaderMiscFlags::none);
 
-    // Pushes TessVertexSpans that will tessellate this PathDraw at the given
-    // location.
+    // Reserves the TessVertexSpans that will tessellate this PathDraw at the
+    // given location, and queues the draw to write them out.
     void pushTessellationData(RenderContext::LogicalFlush*,
                               uint32_t tessVertexCount,
                               uint32_t tessLocation);
@@ -333,7 +355,8 @@ protected:
     enum class InteriorTriangulationOp : bool
     {
         // Fills in m_resourceCounts and runs a GrInnerFanTriangulator on the
-        // path's interior polygon.
+        // path's interior polygon, unless m_triangulator was already found in
+        // the TriangulationCache.
         countDataAndTriangulate,
 
         // Pushes the contours and cubics to the renderContext for an
@@ -371,7 +394,8 @@ protected:
     // clockwiseAtomic only.
     gpu::CoverageBufferRange m_coverageBufferRange;
 
-    GrInnerFanTriangulator* m_triangulator = nullptr;
+    // Allocated on the per-frame allocator, or owned by the TriangulationCache.
+    const GrInnerFanTriangulator* m_triangulator = nullptr;
 
     StrokeJoin m_strokeJoin;
     StrokeCap m_strokeCap;
@@ -395,6 +419,33 @@ protected:
         RIVE_DEBUG_CODE(uint32_t tessVertexCount;)
     };
 
+    // Totals that initForMidpointFan() counts while iterating the path.
+    struct MidpointFanCounts
+    {
+        size_t lineCount;
+        size_t unpaddedCurveCount;
+        size_t unpaddedRotationCount;
+        size_t emptyStrokeCountForCaps;
+        size_t tessVertexCount;
+    };
+
+    // Everything initForMidpointFan() computes from the path, the linear terms
+    // of the matrix, and the stroke or feather. Saved across frames by the
+    // TessellationCache.
+    struct MidpointFanData
+    {
+        std::vector<ContourInfo> contours;
+        std::vector<uint8_t> numChops;
+        std::vector<Vec2D> chopVertices;
+        std::vector<std::array<Vec2D, 2>> tangentPairs;
+        std::vector<uint32_t> polarSegmentCounts;
+        std::vector<uint32_t> parametricSegmentCounts;
+        MidpointFanCounts counts;
+
+        size_t sizeInBytes() const;
+    };
+    friend class TessellationCache;
+
     ContourInfo* m_contours;
     FixedQueue<uint8_t> m_numChops;
     FixedQueue<Vec2D> m_chopVertices;
@@ -460,6 +511,10 @@ protected:
 class ImageMeshDraw : public Draw
 {
 public:
+    // If "atlasTransform" is not null, the texture is an atlas page and the
+    // transform maps the mesh's UVs to the image's region of it. The shader
+    // clamps UVs to the image before applying it, so this is only valid with
+    // clamped samplers.
     ImageMeshDraw(IAABB pixelBounds,
                   const Mat2D&,
                   BlendMode,
@@ -469,13 +524,18 @@ public:
                   rcp<RenderBuffer> uvBuffer,
                   rcp<RenderBuffer> indexBuffer,
                   uint32_t indexCount,
-                  float opacity);
+                  float opacity,
+                  const Mat2D* atlasTransform = nullptr);
 
     RenderBuffer* vertexBuffer() const { return m_vertexBufferRef; }
     RenderBuffer* uvBuffer() const { return m_uvBufferRef; }
     RenderBuffer* indexBuffer() const { return m_indexBufferRef; }
     uint32_t indexCount() const { return m_indexCount; }
     float opacity() const { return m_opacity; }
+    const Mat2D* atlasTransform() const
+    {
+        return m_hasAtlasTransform ? &m_atlasTransform : nullptr;
+    }
 
     void pushToRenderContext(RenderContext::LogicalFlush*,
                              int subpassIndex) override;
@@ -488,6 +548,8 @@ protected:
     RenderBuffer* const m_indexBufferRef;
     const uint32_t m_indexCount;
     const float m_opacity;
+    const bool m_hasAtlasTransform;
+    const Mat2D m_atlasTransform;
 };
 
 // Resets the stencil clip by either entirely erasing the existing clip, or
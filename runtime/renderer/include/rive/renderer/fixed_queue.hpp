@@ -34,6 +34,9 @@ public:
 
     size_t pushCount() const { return m_end - m_array; }
 
+    // Every item pushed since the last reset(), including popped ones.
+    const T* data() const { return m_array; }
+
     T& push_back()
     {
         assert(m_end < m_array + m_capacity);
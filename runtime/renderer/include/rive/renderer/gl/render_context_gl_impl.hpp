@@ -226,6 +226,7 @@ private:
     glutils::VAO m_colorRampVAO;
     glutils::Framebuffer m_colorRampFBO;
     GLuint m_gradientTexture = 0;
+    uint32_t m_gradientTextureHeight = 0;
 
     // Gaussian integral table for feathering.
     glutils::Texture m_featherTexture;
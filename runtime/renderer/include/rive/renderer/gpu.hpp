@@ -189,6 +189,13 @@ struct PlatformFeatures
     // Workaround for precision issues. Determines how far apart we space unique
     // path IDs when they will be bit-casted to fp16.
     uint8_t pathIDGranularity = 1;
+    // The gradient texture keeps its contents between flushes, including when
+    // it gets resized (rows that still fit are preserved). This allows complex
+    // color ramps to be cached in the texture across frames. Set by the GL
+    // (except on PowerVR), CPU, and null backends. The Metal, Vulkan, D3D, and
+    // WebGPU color ramp passes don't load the texture's previous contents, so
+    // they leave this off and render every ramp on every flush.
+    bool preservesGradientTexture = false;
     // Maximum size (width or height) of a texture.
     uint32_t maxTextureSize = 2048;
     // Maximum length (in 32-bit uints) of the coverage buffer used for paths in
@@ -379,8 +386,10 @@ enum class PaintType : uint32_t
 
 // Specifies the location of a simple or complex horizontal color ramp within
 // the gradient texture. A simple color ramp is two texels wide, beginning at
-// the specified row and column. A complex color ramp spans the entire width of
-// the gradient texture, on the row:
+// the specified column, on the row:
+//     "GradTextureLayout::simpleOffsetY + ColorRampLocation::row".
+// A complex color ramp spans the entire width of the gradient texture, on the
+// row:
 //     "GradTextureLayout::complexOffsetY + ColorRampLocation::row".
 struct ColorRampLocation
 {
@@ -436,13 +445,16 @@ private:
     Mat2D m_inverseMatrix;
 };
 
-// Specifies the height of the gradient texture, and the row at which we
-// transition from simple color ramps to complex.
+// Specifies the height of the gradient texture, and the rows where the simple
+// and complex color ramps begin. Simple ramps normally come first, but when
+// complex ramps are cached across frames, they keep the top rows and simple
+// ramps go below them.
 //
 // This information is computed at flush time, once we know exactly how many
 // color ramps of each type will be in the gradient texture.
 struct GradTextureLayout
 {
+    uint32_t simpleOffsetY;  // Row of the first simple gradient.
     uint32_t complexOffsetY; // Row of the first complex gradient.
     float inverseHeight;     // 1 / textureHeight
 };
@@ -1470,12 +1482,15 @@ struct ImageDrawUniforms
 public:
     ImageDrawUniforms() = default;
 
+    // "atlasTransform", if not null, maps the image's normalized coordinates
+    // to its region of an atlas page (see ImageAtlas::add()).
     ImageDrawUniforms(const Mat2D&,
                       float opacity,
                       const ClipRectInverseMatrix*,
                       uint32_t clipID,
                       BlendMode,
-                      uint32_t zIndex);
+                      uint32_t zIndex,
+                      const Mat2D* atlasTransform = nullptr);
 
 private:
     WRITEONLY float m_matrix[6];
@@ -1485,14 +1500,19 @@ private:
     WRITEONLY uint32_t m_clipID;
     WRITEONLY uint32_t m_blendMode;
     WRITEONLY uint32_t m_zIndex; // gpu::InterlockMode::msaa only.
+    WRITEONLY uint32_t m_padding2[3] = {0, 0, 0};
+    // Scale (xy) and translation (zw) from the image's texture coordinates to
+    // its region of an atlas page, or all zeros if the image isn't atlased.
+    WRITEONLY float m_atlasRegion[4];
     // Uniform blocks must be multiples of 256 bytes in size.
-    WRITEONLY uint8_t m_padTo256Bytes[256 - 68];
+    WRITEONLY uint8_t m_padTo256Bytes[256 - 96];
 
     constexpr void staticChecks()
     {
         static_assert(offsetof(ImageDrawUniforms, m_matrix) % 16 == 0);
         static_assert(
             offsetof(ImageDrawUniforms, m_clipRectInverseMatrix) % 16 == 0);
+        static_assert(offsetof(ImageDrawUniforms, m_atlasRegion) == 80);
         static_assert(sizeof(ImageDrawUniforms) == 256);
     }
 };
@@ -1582,6 +1602,9 @@ public:
 
     size_t elementsWritten() const { return bytesWritten() / sizeof(T); }
 
+    // How many items fit in the buffer in total?
+    size_t capacity() const { return m_mappingEnd - m_mappedMemory; }
+
     // Is there room to push() itemCount items to the buffer?
     bool hasRoomFor(size_t itemCount)
     {
@@ -1610,6 +1633,13 @@ public:
     }
     void skip_back() { push(); }
 
+    // Claims the next "count" items and returns a separate view that writes
+    // them. The view may be filled in later, or on another thread.
+    WriteOnlyMappedMemory push_back_range(size_t count)
+    {
+        return WriteOnlyMappedMemory(push(count), count);
+    }
+
 private:
     RIVE_ALWAYS_INLINE T& push()
     {
@@ -0,0 +1,93 @@
+/*
+ * Copyright 2025 Rive
+ */
+
+#pragma once
+
+#include "rive/math/mat2d.hpp"
+#include "rive/refcnt.hpp"
+#include "rive/renderer/sk_rectanizer_skyline.hpp"
+#include "rive/renderer/texture.hpp"
+
+#include <vector>
+
+namespace rive::gpu
+{
+// One texture's worth of small images, packed side by side. The pixels are
+// kept on the CPU until the texture is needed, so a page that is still being
+// filled only gets uploaded when something draws from it.
+class ImageAtlasPage : public RefCnt<ImageAtlasPage>
+{
+public:
+    ImageAtlasPage(uint32_t size);
+
+    uint32_t size() const { return m_size; }
+
+    // Returns the page's texture, uploading the pixels first if images have
+    // been added since the last upload. Once the atlas has moved on to another
+    // page, the final upload also frees the CPU copy of the pixels.
+    //
+    // Backends can only create whole textures, so each upload replaces the
+    // previous texture with a new full-size one, even if only one image was
+    // added. Draws already recorded against the old texture keep it alive
+    // until they are flushed.
+    rcp<Texture> refTexture(RenderContextImpl*);
+
+    // RGBA premultiplied texels, row by row. Empty once the page has been
+    // sealed and uploaded.
+    const std::vector<uint32_t>& pixels() const { return m_pixels; }
+
+private:
+    friend class ImageAtlas;
+
+    const uint32_t m_size;
+    skgpu::RectanizerSkyline m_rectanizer;
+    std::vector<uint32_t> m_pixels;
+    rcp<Texture> m_texture;
+    // Set when images have been added since m_texture was created.
+    bool m_dirty = false;
+    // Set when the atlas stops adding images to this page.
+    bool m_sealed = false;
+};
+
+// Packs small images into shared ImageAtlasPages, so draws of different images
+// can sample the same texture and batch together.
+//
+// Every image gets a gutter of replicated edge texels, and its region is
+// aligned to the smallest mip level, so clamped bilinear and trilinear
+// sampling inside the region never reads a neighbor. Pages only have
+// kMipLevelCount levels, and the gutter only emulates ImageWrap::clamp.
+class ImageAtlas
+{
+public:
+    constexpr static uint32_t kPageSize = 1024;
+    // Images larger than this in either dimension get their own texture.
+    constexpr static uint32_t kMaxImageSize = 128;
+    constexpr static uint32_t kMipLevelCount = 3;
+    // Image regions start on, and are padded to, multiples of this many texels
+    // so mip levels never blend an image with its gutter.
+    constexpr static uint32_t kAlignment = 1 << (kMipLevelCount - 1);
+    constexpr static uint32_t kGutter = kAlignment;
+
+    static bool CanAdd(uint32_t width, uint32_t height)
+    {
+        return width != 0 && height != 0 && width <= kMaxImageSize &&
+               height <= kMaxImageSize;
+    }
+
+    // Copies a width x height RGBA premultiplied image into a page, and
+    // returns that page. "uvTransform" receives the matrix that maps the
+    // image's normalized [0, 1] coordinates to its region of the page.
+    rcp<ImageAtlasPage> add(uint32_t width,
+                            uint32_t height,
+                            const uint8_t imageDataRGBAPremul[],
+                            Mat2D* uvTransform);
+
+    // Number of pages that have been started.
+    size_t pageCount() const { return m_pageCount; }
+
+private:
+    rcp<ImageAtlasPage> m_currentPage;
+    size_t m_pageCount = 0;
+};
+} // namespace rive::gpu
@@ -0,0 +1,62 @@
+/*
+ * Copyright 2025 Rive
+ */
+
+#pragma once
+
+#include "rive/renderer/render_context_helper_impl.hpp"
+#include <memory>
+
+namespace rive::gpu
+{
+// RenderTarget for the null backend. It has dimensions but no pixels.
+class RenderTargetNull : public RenderTarget
+{
+public:
+    RenderTargetNull(uint32_t width, uint32_t height) :
+        RenderTarget(width, height)
+    {}
+};
+
+// RenderContextImpl that hands out host memory from the map*Buffer() calls and
+// discards every flush. Everything RenderContext does on the CPU still runs,
+// which makes this backend useful for measuring renderer CPU cost on machines
+// without a GPU.
+class RenderContextNullImpl : public RenderContextHelperImpl
+{
+public:
+    static std::unique_ptr<RenderContext> MakeContext();
+
+    rcp<RenderTargetNull> makeRenderTarget(uint32_t width, uint32_t height)
+    {
+        return make_rcp<RenderTargetNull>(width, height);
+    }
+
+    rcp<RenderBuffer> makeRenderBuffer(RenderBufferType,
+                                       RenderBufferFlags,
+                                       size_t) override;
+
+    rcp<Texture> makeImageTexture(uint32_t width,
+                                  uint32_t height,
+                                  uint32_t mipLevelCount,
+                                  const uint8_t imageDataRGBAPremul[]) override;
+
+private:
+    RenderContextNullImpl();
+
+    std::unique_ptr<BufferRing> makeUniformBufferRing(
+        size_t capacityInBytes) override;
+    std::unique_ptr<BufferRing> makeStorageBufferRing(
+        size_t capacityInBytes,
+        gpu::StorageBufferStructure) override;
+    std::unique_ptr<BufferRing> makeVertexBufferRing(
+        size_t capacityInBytes) override;
+
+    void resizeGradientTexture(uint32_t width, uint32_t height) override {}
+    void resizeTessellationTexture(uint32_t width, uint32_t height) override {}
+    void resizeAtlasTexture(uint32_t width, uint32_t height) override {}
+    void resizeCoverageBuffer(size_t sizeInBytes) override {}
+
+    void flush(const FlushDescriptor&) override {}
+};
+} // namespace rive::gpu
@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include "rive/math/raw_path.hpp"
 #include "rive/math/vec2d.hpp"
 #include "rive/renderer/gpu.hpp"
 #include "rive/renderer/rive_render_factory.hpp"
@@ -27,7 +28,12 @@ class RiveRenderPath;
 namespace rive::gpu
 {
 class GradientLibrary;
+class GradientRampCache;
+class ImageAtlas;
 class IntersectionBoard;
+class TessellationCache;
+class TriangulationCache;
+class WorkerPool;
 class ImageMeshDraw;
 class ImageRectDraw;
 class StencilClipReset;
@@ -50,8 +56,8 @@ enum class ShaderCompilationMode
 class GradientContentKey
 {
 public:
-    inline GradientContentKey(rcp<const Gradient> gradient);
-    inline GradientContentKey(GradientContentKey&& other);
+    GradientContentKey(rcp<const Gradient> gradient);
+    GradientContentKey(GradientContentKey&& other);
     bool operator==(const GradientContentKey&) const;
     const Gradient* gradient() const { return m_gradient.get(); }
 
@@ -235,6 +241,121 @@ public:
     // Submits all GPU commands that have been built up since beginFrame().
     void flush(const FlushResources&);
 
+    // CPU cost of a frame, from beginFrame() through flush(). Only collected
+    // while enabled with setFlushStatsEnabled().
+    struct FlushStats
+    {
+        // Seconds spent in each stage. pushDraws accumulates over every call
+        // during the frame.
+        double pushDrawsSeconds = 0;
+        double layoutResourcesSeconds = 0;
+        double writeResourcesSeconds = 0;
+        // Portions of writeResourcesSeconds: ordering draws with the
+        // IntersectionBoard (not done in rasterOrdering mode), writing draw
+        // data, and writing the contours and tessellation spans of paths.
+        double reorderDrawsSeconds = 0;
+        double writeDrawsSeconds = 0;
+        double writeTessellationSeconds = 0;
+        // Time in the backend's flush() calls.
+        double backendFlushSeconds = 0;
+
+        size_t logicalFlushCount = 0;
+        size_t drawCount = 0;
+        // Draw calls the backend was asked to issue, after merging.
+        size_t drawBatchCount = 0;
+        size_t tessVertexSpanCount = 0;
+        size_t triangleVertexCount = 0;
+
+        // Bytes written to the mapped resource buffers.
+        size_t uniformBytesWritten = 0;
+        size_t pathBytesWritten = 0;
+        size_t paintBytesWritten = 0;
+        size_t contourBytesWritten = 0;
+        size_t gradSpanBytesWritten = 0;
+        size_t tessSpanBytesWritten = 0;
+        size_t triangleBytesWritten = 0;
+
+        size_t totalBytesWritten() const
+        {
+            return uniformBytesWritten + pathBytesWritten + paintBytesWritten +
+                   contourBytesWritten + gradSpanBytesWritten +
+                   tessSpanBytesWritten + triangleBytesWritten;
+        }
+    };
+
+    void setFlushStatsEnabled(bool enabled) { m_flushStatsEnabled = enabled; }
+
+    // Stats from the most recent flush() while enabled.
+    const FlushStats& lastFlushStats() const { return m_lastFlushStats; }
+
+    // A rectangle that draw reordering added to the IntersectionBoard. Entries
+    // with a layerCount of 0 mark the beginning of a logical flush, and hold
+    // the render target size in ltrb[2..3].
+    struct IntersectionTraceEntry
+    {
+        int32_t ltrb[4];
+        int32_t layerCount;
+    };
+
+    // Records every rectangle that draw reordering adds to the
+    // IntersectionBoard, so the sequence can be replayed offline. Null disables
+    // recording.
+    void setIntersectionTrace(std::vector<IntersectionTraceEntry>* trace)
+    {
+        m_intersectionTrace = trace;
+    }
+
+    // An interior polygon, in local coordinates, that a PathDraw ran through
+    // GrTriangulator.
+    struct TriangulationTraceEntry
+    {
+        RawPath path;
+        FillRule fillRule; // nonZero or evenOdd.
+        bool horizontalAxis;
+    };
+
+    // Records every polygon that gets triangulated (i.e., misses the
+    // TriangulationCache), so they can be replayed offline. Null disables
+    // recording.
+    void setTriangulationTrace(std::vector<TriangulationTraceEntry>* trace)
+    {
+        m_triangulationTrace = trace;
+    }
+
+    // Sets the number of threads, including the one that calls flush(), that
+    // write the contours and tessellation spans of paths during flush(). The
+    // default of 1 does all the work on the calling thread. 0 means one per
+    // hardware thread.
+    void setFlushThreadCount(uint32_t threadCount);
+
+    // Enables or disables saving path tessellation work across frames, for
+    // paths that don't change. Enabled by default.
+    void setTessellationCacheEnabled(bool);
+
+    // Enables or disables saving the interior triangulations of large fills
+    // across frames, for paths that don't change. Enabled by default.
+    void setTriangulationCacheEnabled(bool);
+
+    // Enables or disables keeping complex gradient color ramps in the gradient
+    // texture across frames, so only new ramps get rendered. Enabled by
+    // default. Has no effect unless the backend preserves its gradient texture
+    // between flushes.
+    void setGradientRampCacheEnabled(bool);
+
+    // Enables or disables packing small decoded images into shared atlas
+    // textures, so draws of different images can batch together. Disabled by
+    // default. Only affects images created after the call.
+    //
+    // Only draws with clamped samplers use the atlas. Others, and every
+    // ImageRectDraw, keep sampling the image's own texture.
+    //
+    // The atlas costs memory rather than saving it: every atlased image also
+    // keeps its own texture, each page is a 1024x1024 texture with 3 mip levels
+    // (about 5.3 MB), and the page still being filled keeps a 4 MB CPU copy.
+    // Adding an image to a page that has already been drawn re-uploads the
+    // whole page, so it's cheapest to create images before drawing them.
+    void setImageAtlasEnabled(bool);
+
     // Called when the client will stop rendering. Releases all CPU and GPU
     // resources associated with this render context.
     void releaseResources();
@@ -286,6 +407,12 @@ public:
                                        size_t) override;
     rcp<RenderImage> decodeImage(Span<const uint8_t>) override;
 
+    // Creates an image from width x height RGBA premultiplied pixels, packing
+    // it into the image atlas if enabled and the image is small enough.
+    rcp<RenderImage> makeImage(uint32_t width,
+                               uint32_t height,
+                               const uint8_t imageDataRGBAPremul[]);
+
 private:
     friend class Draw;
     friend class PathDraw;
@@ -298,6 +425,10 @@ private:
     // Resets the CPU-side STL containers so they don't have unbounded growth.
     void resetContainers();
 
+    // Adds the time until it goes out of scope to a field of m_flushStats, if
+    // stats are enabled.
+    class FlushStatsTimer;
+
     // Throttled width/height of the atlas texture. If drawing to a render
     // target larger than this, we may create a larger atlas anyway.
     uint32_t atlasMaxSize() const
@@ -369,6 +500,12 @@ private:
     ResourceAllocationCounts m_maxRecentResourceRequirements;
     double m_lastResourceTrimTimeInSeconds;
 
+    bool m_flushStatsEnabled = false;
+    FlushStats m_flushStats;
+    FlushStats m_lastFlushStats;
+    std::vector<IntersectionTraceEntry>* m_intersectionTrace = nullptr;
+    std::vector<TriangulationTraceEntry>* m_triangulationTrace = nullptr;
+
     // Per-frame state.
     FrameDescriptor m_frameDescriptor;
     gpu::InterlockMode m_frameInterlockMode;
@@ -391,6 +528,25 @@ private:
     // Used by LogicalFlushes for re-ordering high level draws.
     std::vector<int64_t> m_indirectDrawList;
     std::unique_ptr<IntersectionBoard> m_intersectionBoard;
+    // Null unless setFlushThreadCount() asked for more than one thread.
+    std::unique_ptr<WorkerPool> m_workerPool;
+    // Used by PathDraws to skip tessellation work on paths that haven't
+    // changed since a previous frame. Null if disabled.
+    std::unique_ptr<TessellationCache> m_tessellationCache;
+    // Used by PathDraws to skip GrTriangulator on large fills that haven't
+    // changed since a previous frame. Null if disabled.
+    std::unique_ptr<TriangulationCache> m_triangulationCache;
+    // Owns the top rows of the gradient texture, where complex color ramps
+    // persist across frames. Null if disabled or unsupported by the backend.
+    std::unique_ptr<GradientRampCache> m_gradientRampCache;
+    // Packs small images from makeImage() into shared textures. Null if
+    // disabled.
+    std::unique_ptr<ImageAtlas> m_imageAtlas;
+    // Unique ID for each LogicalFlush, so the GradientRampCache knows which
+    // rows the current one references.
+    uint64_t m_lastLogicalFlushSerial = 0;
+    // Used by LogicalFlushes for splitting tessellation work across threads.
+    std::vector<size_t> m_tessellationChunkEnds;
 
     WriteOnlyMappedMemory<gpu::FlushUniforms> m_flushUniformData;
     WriteOnlyMappedMemory<gpu::PathData> m_pathData;
@@ -403,8 +559,8 @@ private:
     WriteOnlyMappedMemory<gpu::ImageDrawUniforms> m_imageDrawUniformData;
 
     // Simple allocator for trivially-destructible data that needs to persist
-    // until the current frame has completed. All memory in this allocator is
-    // dropped at the end of the every frame.
+    // until the current frame has completed. All allocations are dropped at
+    // the end of the every frame, but the blocks are kept for the next one.
     constexpr static size_t kPerFlushAllocatorInitialBlockSize =
         1024 * 1024; // 1 MiB.
     TrivialBlockAllocator m_perFrameAllocator{
@@ -430,6 +586,27 @@ private:
 
     class TessellationWriter;
 
+    // Output ranges reserved for the contours and tessellation spans of one
+    // path. A TessellationWriter fills them in later, potentially on another
+    // thread. (See LogicalFlush::pushTessellationJob().)
+    struct TessellationJob
+    {
+        PathDraw* draw;
+        uint32_t pathID;
+        gpu::ContourDirections contourDirections;
+        uint32_t forwardTessVertexCount;
+        uint32_t forwardTessLocation;
+        uint32_t mirroredTessVertexCount;
+        uint32_t mirroredTessLocation;
+        // Contour records for the path, the first of which has ID
+        // "firstContourID".
+        WriteOnlyMappedMemory<gpu::ContourData> contourData;
+        uint32_t firstContourID;
+        // Enough spans for the path's worst-case line wrapping in the
+        // tessellation texture. Spans the path doesn't use are left empty.
+        WriteOnlyMappedMemory<gpu::TessVertexSpan> tessSpanData;
+    };
+
     // Manages a list of high-level Draws and their required resources.
     //
     // Since textures have hard size limits, we can't always fit an entire frame
@@ -470,6 +647,9 @@ private:
             return m_flushDesc;
         }
 
+        size_t drawCount() const { return m_draws.size(); }
+        size_t drawBatchCount() const { return m_drawList.count(); }
+
         // Generates a unique clip ID that is guaranteed to not exist in the
         // current clip buffer.
         //
@@ -647,19 +827,19 @@ private:
         // pushMidpointFanDraw() or pushOuterCubicsDraw().
         [[nodiscard]] uint32_t pushPath(const PathDraw* draw);
 
-        // Pushes a contour record to the GPU that references the given path.
+        // Reserves the contour records and tessellation spans that the given
+        // path will write, and queues the path to write them at the end of
+        // writeResources(). Each path only writes to its own reserved ranges,
+        // so the queue can be spread across threads.
         //
-        // "vertexIndex0" is the index within the tessellation where the first
-        // vertex of the contour resides. Shaders need this when the contour is
-        // closed.
-        //
-        // Returns a unique 16-bit "contourID" handle for this specific record.
-        // This ID may be or-ed with '*_CONTOUR_FLAG' bits from constants.glsl.
-        [[nodiscard]] uint32_t pushContour(uint32_t pathID,
-                                           Vec2D midpoint,
-                                           bool isStroke,
-                                           bool closed,
-                                           uint32_t vertexIndex0);
+        // The tessellation locations and counts are as described in
+        // TessellationWriter.
+        void pushTessellationJob(PathDraw*,
+                                 uint32_t pathID,
+                                 uint32_t forwardTessVertexCount,
+                                 uint32_t forwardTessLocation,
+                                 uint32_t mirroredTessVertexCount,
+                                 uint32_t mirroredTessLocation);
 
         // Writes padding vertices to the tessellation texture, with an invalid
         // contour ID that is guaranteed to not be the same ID as any neighbors.
@@ -719,6 +899,22 @@ private:
 
         ClipInfo& getWritableClipInfo(uint32_t clipID);
 
+        // Reserves the output ranges for a TessellationWriter that will push
+        // "contourCount" contours and "cubicCount" cubics.
+        TessellationJob reserveTessellation(PathDraw*,
+                                            uint32_t pathID,
+                                            gpu::ContourDirections,
+                                            uint32_t contourCount,
+                                            uint32_t cubicCount,
+                                            uint32_t forwardTessVertexCount,
+                                            uint32_t forwardTessLocation,
+                                            uint32_t mirroredTessVertexCount,
+                                            uint32_t mirroredTessLocation);
+
+        // Writes out every job in m_tessellationJobs, on the context's
+        // WorkerPool if it has one.
+        void writeTessellationJobs();
+
         // Either appends a new drawBatch to m_drawList or merges into
         // m_drawList.tail(). Updates the batch's ShaderFeatures according to
         // the passed parameters.
@@ -737,6 +933,9 @@ private:
         // Instance pointer to the outer parent class.
         RenderContext* const m_ctx;
 
+        // Reassigned every time the flush rewinds.
+        uint64_t m_serial;
+
         // Running counts of GPU data records that need to be allocated for
         // draws.
         ResourceCounters m_resourceCounts;
@@ -755,9 +954,17 @@ private:
         // should be scaled to a ramp where every stop lands exactly on a pixel
         // center, but for now we just always scale them to the entire gradient
         // texture width.
+        //
+        // If the context has a GradientRampCache, complex gradients get their
+        // rows from it instead, and m_complexGradients stays empty.
         std::unordered_map<GradientContentKey, uint16_t, DeepHashGradient>
             m_complexGradients; // [colors[0..n], stops[0..n]] -> rowIdx
-        std::vector<const Gradient*> m_pendingComplexGradDraws;
+        struct ComplexGradDraw
+        {
+            const Gradient* gradient;
+            uint16_t row;
+        };
+        std::vector<ComplexGradDraw> m_pendingComplexGradDraws;
 
         // Simple and complex gradients both get uploaded to the GPU as sets of
         // "GradientSpan" instances.
@@ -792,6 +999,10 @@ private:
         uint32_t m_currentPathID;
         uint32_t m_currentContourID;
 
+        // Paths whose contours and tessellation spans have been reserved, but
+        // not yet written.
+        std::vector<TessellationJob> m_tessellationJobs;
+
         // Atlas for offscreen feathering.
         std::unique_ptr<skgpu::RectanizerSkyline> m_atlasRectanizer;
         uint32_t m_atlasMaxX = 0;
@@ -821,8 +1032,8 @@ private:
     class TessellationWriter
     {
     public:
-        // forwardTessLocation & mirroredTessLocation are allocated by
-        // allocate*TessVertices().
+        // The job's forwardTessLocation & mirroredTessLocation are allocated
+        // by allocate*TessVertices().
         //
         // forwardTessLocation starts at the beginning of the vertex span
         // and advances forward.
@@ -834,13 +1045,10 @@ private:
         // & mirroredTessVertexCount must both be equal, and
         // forwardTessLocation & mirroredTessLocation must both be valid.
         // Otherwise, one span or the other may be empty.
-        TessellationWriter(LogicalFlush* flush,
-                           uint32_t pathID,
-                           gpu::ContourDirections,
-                           uint32_t forwardTessVertexCount,
-                           uint32_t forwardTessLocation,
-                           uint32_t mirroredTessVertexCount = 0,
-                           uint32_t mirroredTessLocation = 0);
+        //
+        // Only writes to the ranges reserved in the job, so writers for
+        // different jobs may run concurrently.
+        TessellationWriter(LogicalFlush* flush, const TessellationJob&);
 
         ~TessellationWriter();
 
@@ -856,8 +1064,10 @@ private:
                        : m_pathMirroredTessLocation - 1;
         }
 
-        // Wrapper around LogicalFlush::pushContour(), with an additional
-        // padding option.
+        // Writes the path's next reserved contour record.
+        //
+        // Returns a unique 16-bit "contourID" handle for this specific record.
+        // This ID may be or-ed with '*_CONTOUR_FLAG' bits from constants.glsl.
         //
         // The first curve of the contour will be pre-padded with
         // 'paddingVertexCount' tessellation vertices, colocated at T=0. The
@@ -929,9 +1139,12 @@ private:
 
     private:
         LogicalFlush* const m_flush;
-        WriteOnlyMappedMemory<gpu::TessVertexSpan>& m_tessSpanData;
+        WriteOnlyMappedMemory<gpu::TessVertexSpan> m_tessSpanData;
+        WriteOnlyMappedMemory<gpu::ContourData> m_contourData;
         const uint32_t m_pathID;
         const gpu::ContourDirections m_contourDirections;
+        // Most recent contourID returned by pushContour().
+        uint32_t m_currentContourID;
         uint32_t m_pathTessLocation;
         uint32_t m_pathMirroredTessLocation;
         // Padding to add to the next curve.
@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include "rive/renderer/image_atlas.hpp"
 #include "rive/renderer/texture.hpp"
 
 namespace rive
@@ -17,9 +18,24 @@ public:
         resetTexture(std::move(texture));
     }
 
+    // Small images may also be packed into an atlas page that they share with
+    // other images. "atlasTransform" maps the image's normalized coordinates
+    // to its region of the page, and "atlasRegionPath" is that region, in the
+    // same coordinates. The renderer applies the transform itself, so
+    // uvTransform() stays the identity and callers' UVs remain in [0, 1].
+    RiveRenderImage(rcp<gpu::Texture> texture,
+                    rcp<gpu::ImageAtlasPage> atlasPage,
+                    const Mat2D& atlasTransform,
+                    rcp<RenderPath> atlasRegionPath);
+
     rcp<gpu::Texture> refTexture() const { return m_texture; }
     gpu::Texture* getTexture() { return m_texture.get(); }
 
+    // Null if the image isn't in an atlas.
+    gpu::ImageAtlasPage* atlasPage() const { return m_atlasPage.get(); }
+    const Mat2D& atlasTransform() const { return m_atlasTransform; }
+    RenderPath* atlasRegionPath() const { return m_atlasRegionPath.get(); }
+
 protected:
     RiveRenderImage(int width, int height)
     {
@@ -40,5 +56,8 @@ protected:
 
 private:
     rcp<gpu::Texture> m_texture;
+    rcp<gpu::ImageAtlasPage> m_atlasPage;
+    Mat2D m_atlasTransform;
+    rcp<RenderPath> m_atlasRegionPath;
 };
 } // namespace rive
@@ -47,6 +47,7 @@ public:
                        uint32_t indexCount,
                        BlendMode,
                        float opacity) override;
+    void drawPicture(const Picture&) override;
 
     // Determines if a path is an axis-aligned rectangle that can be represented
     // by rive::AABB.
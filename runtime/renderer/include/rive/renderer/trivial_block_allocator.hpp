@@ -5,6 +5,7 @@
 #pragma once
 
 #include "rive/math/math_types.hpp"
+#include <algorithm>
 #include <cassert>
 #include <memory>
 #include <vector>
@@ -19,28 +20,64 @@ public:
         m_initialBlockSize(initialBlockSize)
     {
         m_blocks.push_back(
-            std::unique_ptr<char[]>(new char[m_initialBlockSize]));
+            {std::unique_ptr<char[]>(new char[m_initialBlockSize]),
+             m_initialBlockSize});
         reset();
     }
 
+    // Rewinds to the first block. The other blocks are kept and refilled in
+    // the same order, so once the allocator has grown to fit a frame, later
+    // frames of a similar size don't have to go back to the heap.
     void reset()
     {
+        m_maxRecentBlockCount =
+            std::max(m_maxRecentBlockCount, m_currentBlockIdx + 1);
         m_fibMinus2 = 0;
         m_fibMinus1 = 1;
-        m_blocks.resize(1);
-        m_currentBlockSize = m_initialBlockSize;
+        m_currentBlockIdx = 0;
+        m_currentBlock = m_blocks[0].data.get();
+        m_currentBlockSize = m_blocks[0].sizeInBytes;
         m_currentBlockUsage = 0;
     }
 
+    // Rewinds to the first block and frees all the others.
+    void resetAndReleaseMemory()
+    {
+        m_blocks.resize(1);
+        reset();
+        m_maxRecentBlockCount = 0;
+    }
+
+    // Rewinds to the first block and frees the blocks that haven't been used
+    // since the last trim, so a single large frame doesn't pin its memory
+    // forever.
+    void resetAndTrimToRecentUsage()
+    {
+        reset();
+        m_blocks.resize(std::max<size_t>(m_maxRecentBlockCount, 1));
+        m_maxRecentBlockCount = 0;
+    }
+
+    // Total size of every block this allocator is holding onto.
+    size_t reservedSizeInBytes() const
+    {
+        size_t sizeInBytes = 0;
+        for (const Block& block : m_blocks)
+        {
+            sizeInBytes += block.sizeInBytes;
+        }
+        return sizeInBytes;
+    }
+
     template <size_t AlignmentInBytes = 8> void* alloc(size_t sizeInBytes)
     {
-        uintptr_t start = reinterpret_cast<uintptr_t>(m_blocks.back().get()) +
-                          m_currentBlockUsage;
+        uintptr_t start =
+            reinterpret_cast<uintptr_t>(m_currentBlock) + m_currentBlockUsage;
         size_t alignmentPad =
             math::round_up_to_multiple_of<AlignmentInBytes>(start) - start;
 
-        // Ensure there is room for this allocation in our newest block, pushing
-        // a new one if needed.
+        // Ensure there is room for this allocation in our current block,
+        // moving on to the next one if needed.
         if (m_currentBlockUsage + alignmentPad + sizeInBytes >
             m_currentBlockSize)
         {
@@ -51,19 +88,32 @@ public:
 
             size_t blockSize = std::max(fib * m_initialBlockSize,
                                         sizeInBytes + AlignmentInBytes - 1);
-            m_blocks.push_back(std::unique_ptr<char[]>(new char[blockSize]));
-            m_currentBlockSize = blockSize;
+            ++m_currentBlockIdx;
+            if (m_currentBlockIdx == m_blocks.size())
+            {
+                m_blocks.push_back(
+                    {std::unique_ptr<char[]>(new char[blockSize]), blockSize});
+            }
+            else if (m_blocks[m_currentBlockIdx].sizeInBytes < blockSize)
+            {
+                // The block we kept from a previous reset is too small.
+                m_blocks[m_currentBlockIdx] = {
+                    std::unique_ptr<char[]>(new char[blockSize]),
+                    blockSize};
+            }
+            m_currentBlock = m_blocks[m_currentBlockIdx].data.get();
+            m_currentBlockSize = m_blocks[m_currentBlockIdx].sizeInBytes;
             m_currentBlockUsage = 0;
 
-            start = reinterpret_cast<uintptr_t>(m_blocks.back().get());
+            start = reinterpret_cast<uintptr_t>(m_currentBlock);
             alignmentPad =
                 math::round_up_to_multiple_of<AlignmentInBytes>(start) - start;
         }
 
-        char* ret = &m_blocks.back()[m_currentBlockUsage + alignmentPad];
+        char* ret = m_currentBlock + m_currentBlockUsage + alignmentPad;
         m_currentBlockUsage += alignmentPad + sizeInBytes;
         assert((reinterpret_cast<uintptr_t>(ret) % AlignmentInBytes) == 0);
-        assert(ret + sizeInBytes <= m_blocks.back().get() + m_currentBlockSize);
+        assert(ret + sizeInBytes <= m_currentBlock + m_currentBlockSize);
         return ret;
     }
 
@@ -96,7 +146,16 @@ private:
     size_t m_fibMinus2;
     size_t m_fibMinus1;
 
-    std::vector<std::unique_ptr<char[]>> m_blocks;
+    struct Block
+    {
+        std::unique_ptr<char[]> data;
+        size_t sizeInBytes;
+    };
+    std::vector<Block> m_blocks;
+    size_t m_currentBlockIdx = 0;
+    // Most blocks used by any frame since the last trim.
+    size_t m_maxRecentBlockCount = 0;
+    char* m_currentBlock;
     size_t m_currentBlockSize;
     size_t m_currentBlockUsage;
 };
@@ -124,6 +183,8 @@ public:
     }
 
     using TrivialBlockAllocator::reset;
+    using TrivialBlockAllocator::resetAndReleaseMemory;
+    using TrivialBlockAllocator::resetAndTrimToRecentUsage;
 };
 
 // Simple linked list whose nodes are allocated on a TrivialBlockAllocator.
@@ -0,0 +1,141 @@
+/*
+ * Copyright 2025 Rive
+ */
+
+// Replays rectangle traces recorded by "flush_bench --trace-intersections"
+// through IntersectionBoard, and reports the time spent per rectangle.
+//
+//   intersection_board_bench [--iterations N] trace.txt...
+//
+// Also prints a checksum of the group indices that were assigned, which must
+// not change when optimizing IntersectionBoard.
+
+#include "intersection_board.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+using namespace rive;
+using namespace rive::gpu;
+
+struct TraceFlush
+{
+    uint32_t width;
+    uint32_t height;
+    std::vector<int4> rects;
+    std::vector<int16_t> layerCounts;
+};
+
+static bool load_trace(const char* path, std::vector<TraceFlush>* flushes)
+{
+    FILE* in = fopen(path, "r");
+    if (in == nullptr)
+    {
+        fprintf(stderr, "%s: failed to open\n", path);
+        return false;
+    }
+    char type[8];
+    while (fscanf(in, "%7s", type) == 1)
+    {
+        if (!strcmp(type, "flush"))
+        {
+            TraceFlush flush;
+            if (fscanf(in, "%u %u", &flush.width, &flush.height) != 2)
+            {
+                break;
+            }
+            flushes->push_back(std::move(flush));
+        }
+        else if (!strcmp(type, "rect") && !flushes->empty())
+        {
+            int l, t, r, b, layerCount;
+            if (fscanf(in, "%d %d %d %d %d", &l, &t, &r, &b, &layerCount) != 5)
+            {
+                break;
+            }
+            flushes->back().rects.push_back({l, t, r, b});
+            flushes->back().layerCounts.push_back(
+                static_cast<int16_t>(layerCount));
+        }
+        else
+        {
+            break;
+        }
+    }
+    bool success = feof(in);
+    fclose(in);
+    if (!success)
+    {
+        fprintf(stderr, "%s: malformed trace\n", path);
+    }
+    return success;
+}
+
+static double seconds_now()
+{
+    return std::chrono::duration<double>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+int main(int argc, const char** argv)
+{
+    int iterations = 20;
+    std::vector<TraceFlush> flushes;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (!strcmp(argv[i], "--iterations") && i + 1 < argc)
+        {
+            iterations = atoi(argv[++i]);
+        }
+        else if (!load_trace(argv[i], &flushes))
+        {
+            return 1;
+        }
+    }
+    if (flushes.empty() || iterations <= 0)
+    {
+        fprintf(stderr,
+                "usage: intersection_board_bench [--iterations N] "
+                "trace.txt...\n");
+        return 1;
+    }
+
+    size_t rectCount = 0;
+    for (const TraceFlush& flush : flushes)
+    {
+        rectCount += flush.rects.size();
+    }
+
+    IntersectionBoard board;
+    uint64_t checksum = 0;
+    double bestSeconds = std::numeric_limits<double>::infinity();
+    for (int i = 0; i < iterations; ++i)
+    {
+        checksum = 0;
+        double t0 = seconds_now();
+        for (const TraceFlush& flush : flushes)
+        {
+            board.resizeAndReset(flush.width, flush.height);
+            for (size_t j = 0; j < flush.rects.size(); ++j)
+            {
+                int16_t groupIndex =
+                    board.addRectangle(flush.rects[j], flush.layerCounts[j]);
+                checksum = checksum * 31 + static_cast<uint16_t>(groupIndex);
+            }
+        }
+        bestSeconds = std::min(seconds_now() - t0, bestSeconds);
+    }
+
+    printf("%zu flushes, %zu rectangles\n", flushes.size(), rectCount);
+    printf("best of %d: %.3f ms (%.1f ns per rectangle)\n",
+           iterations,
+           bestSeconds * 1e3,
+           bestSeconds * 1e9 / static_cast<double>(rectCount));
+    printf("checksum %016llx\n", static_cast<unsigned long long>(checksum));
+    return 0;
+}
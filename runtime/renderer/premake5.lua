@@ -183,6 +183,206 @@ if not _OPTIONS['with-webgpu'] then
     end
 end
 
+project('flush_bench')
+do
+    dependson('rive')
+
+    kind('ConsoleApp')
+    includedirs({
+        'include',
+        RIVE_RUNTIME_DIR .. '/include',
+    })
+
+    fatalwarnings({ 'All' })
+
+    files({ 'flush_bench/**.cpp' })
+
+    links({
+        'rive',
+        'rive_pls_renderer',
+        'rive_decoders',
+        'libwebp',
+        'rive_harfbuzz',
+        'rive_sheenbidi',
+        'rive_yoga',
+    })
+    filter({ 'options:not no_rive_png' })
+    do
+        links({ 'zlib', 'libpng' })
+    end
+    filter({ 'options:not no_rive_jpeg' })
+    do
+        links({ 'libjpeg' })
+    end
+    filter({})
+
+    filter({ 'toolset:not msc' })
+    do
+        buildoptions({ '-Wshorten-64-to-32' })
+    end
+
+    filter('system:windows')
+    do
+        architecture('x64')
+        defines({ 'RIVE_WINDOWS', '_CRT_SECURE_NO_WARNINGS' })
+    end
+
+    filter('system:linux')
+    do
+        links({ 'pthread' })
+    end
+end
+
+project('cpu_render_test')
+do
+    dependson('rive')
+
+    kind('ConsoleApp')
+    includedirs({
+        'include',
+        RIVE_RUNTIME_DIR .. '/include',
+    })
+
+    fatalwarnings({ 'All' })
+
+    files({ 'cpu_render_test/**.cpp' })
+
+    links({
+        'rive',
+        'rive_pls_renderer',
+        'rive_decoders',
+        'libwebp',
+        'rive_harfbuzz',
+        'rive_sheenbidi',
+        'rive_yoga',
+    })
+    filter({ 'options:not no_rive_png' })
+    do
+        links({ 'zlib', 'libpng' })
+    end
+    filter({ 'options:not no_rive_jpeg' })
+    do
+        links({ 'libjpeg' })
+    end
+    filter({})
+
+    filter({ 'toolset:not msc' })
+    do
+        buildoptions({ '-Wshorten-64-to-32' })
+    end
+
+    filter('system:windows')
+    do
+        architecture('x64')
+        defines({ 'RIVE_WINDOWS', '_CRT_SECURE_NO_WARNINGS' })
+    end
+
+    filter('system:linux')
+    do
+        links({ 'pthread' })
+    end
+end
+
+project('intersection_board_bench')
+do
+    dependson('rive_pls_renderer')
+
+    kind('ConsoleApp')
+    includedirs({
+        'include',
+        'src',
+        RIVE_RUNTIME_DIR .. '/include',
+    })
+
+    fatalwarnings({ 'All' })
+
+    files({ 'intersection_board_bench/**.cpp' })
+
+    links({ 'rive_pls_renderer' })
+
+    filter({ 'toolset:not msc' })
+    do
+        buildoptions({ '-Wshorten-64-to-32' })
+    end
+
+    filter('system:windows')
+    do
+        architecture('x64')
+        defines({ 'RIVE_WINDOWS', '_CRT_SECURE_NO_WARNINGS' })
+    end
+end
+
+project('triangulation_bench')
+do
+    dependson({ 'rive', 'rive_pls_renderer' })
+
+    kind('ConsoleApp')
+    includedirs({
+        'include',
+        'src',
+        RIVE_RUNTIME_DIR .. '/include',
+    })
+
+    fatalwarnings({ 'All' })
+
+    files({ 'triangulation_bench/**.cpp' })
+
+    links({ 'rive_pls_renderer', 'rive' })
+
+    filter({ 'toolset:not msc' })
+    do
+        buildoptions({ '-Wshorten-64-to-32' })
+    end
+
+    filter('system:windows')
+    do
+        architecture('x64')
+        defines({ 'RIVE_WINDOWS', '_CRT_SECURE_NO_WARNINGS' })
+    end
+end
+
+project('image_atlas_bench')
+do
+    dependson('rive')
+
+    kind('ConsoleApp')
+    includedirs({
+        'include',
+        RIVE_RUNTIME_DIR .. '/include',
+    })
+
+    fatalwarnings({ 'All' })
+
+    files({ 'image_atlas_bench/**.cpp' })
+
+    links({ 'rive_pls_renderer', 'rive_decoders', 'libwebp', 'rive' })
+    filter({ 'options:not no_rive_png' })
+    do
+        links({ 'zlib', 'libpng' })
+    end
+    filter({ 'options:not no_rive_jpeg' })
+    do
+        links({ 'libjpeg' })
+    end
+    filter({})
+
+    filter({ 'toolset:not msc' })
+    do
+        buildoptions({ '-Wshorten-64-to-32' })
+    end
+
+    filter('system:windows')
+    do
+        architecture('x64')
+        defines({ 'RIVE_WINDOWS', '_CRT_SECURE_NO_WARNINGS' })
+    end
+
+    filter('system:linux')
+    do
+        links({ 'pthread' })
+    end
+end
+
 if _OPTIONS['with-webgpu'] or _OPTIONS['with-dawn'] then
     project('webgpu_player')
     do
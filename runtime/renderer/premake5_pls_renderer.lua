@@ -196,6 +196,8 @@ do
     fatalwarnings({ 'All' })
 
     files({ 'src/*.cpp', 'src/shaders/*.glsl', 'include/**.hpp', 'include/**.h' })
+    files({ 'src/cpu/*.cpp' })
+    files({ 'src/null/*.cpp' })
 
 
     if _OPTIONS['with_optick'] then
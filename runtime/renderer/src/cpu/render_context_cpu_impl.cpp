@@ -0,0 +1,2850 @@
+/*
+ * Copyright 2025 Rive
+ */
+
+#include "rive/renderer/cpu/render_context_cpu_impl.hpp"
+
+#include "rive/math/math_types.hpp"
+#include "rive/math/simd.hpp"
+#include "rive/renderer/render_context.hpp"
+#include "rive/renderer/texture.hpp"
+#include "utils/lite_rtti.hpp"
+#include "worker_pool.hpp"
+#include "shaders/constants.glsl"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <thread>
+
+// The CPU backend executes the same flush as the GPU backends, but runs ports
+// of the shaders in rive::simd instead of dispatching them. Only
+// InterlockMode::rasterOrdering is supported: every pixel is owned by exactly
+// one thread at a time, so fragment ordering falls out of the traversal order
+// for free.
+//
+// A flush is executed in passes, each of which is spread across the worker
+// pool:
+//
+//   1. Gradient spans and tessellation spans are rendered into host textures.
+//   2. Draw batches are split into jobs that run the vertex shader port and
+//      set up triangles.
+//   3. The target is split into horizontal bands. Each band walks every batch
+//      in draw order and scan converts the triangles that overlap it.
+//
+// The feather atlas (if any) is rendered the same way, before the main pass.
+
+namespace rive::gpu
+{
+namespace
+{
+constexpr float kPi = 3.14159265359f;
+constexpr float k2Pi = 6.28318530718f;
+constexpr float kPiOver2 = 1.57079632679f;
+
+constexpr float kFeatherCoverageBias = -2.f;
+constexpr float kFeatherCoverageThreshold = -1.5f;
+constexpr float kFeatherXCoordBias = .25f;
+constexpr float kHorizontalCotangentThreshold = 1e3f;
+constexpr float kHorizontalCotangentValue =
+    kHorizontalCotangentThreshold * kHorizontalCotangentThreshold;
+constexpr float kAARadius = .5f;
+constexpr int kMaxParametricSegmentsLog2 = 10;
+
+// Rows of the render target shaded by a single task.
+constexpr int kBandHeight = 32;
+// Patch instances, or triangles, processed by a single vertex task.
+constexpr uint32_t kPatchesPerVertexJob = 64;
+constexpr uint32_t kTrianglesPerVertexJob = 1024;
+// Spans per task when rendering gradients and tessellation.
+constexpr uint32_t kSpansPerJob = 256;
+
+// Vertices are snapped to 8 bits of subpixel precision.
+constexpr int kSubpixelBits = 8;
+constexpr int kSubpixelOne = 1 << kSubpixelBits;
+constexpr int kSubpixelHalf = kSubpixelOne / 2;
+// Triangles reaching this far outside any render target get discarded.
+constexpr float kMaxVertexCoord = 1 << 20;
+
+RIVE_ALWAYS_INLINE float as_float(uint32_t bits)
+{
+    return math::bit_cast<float>(bits);
+}
+
+RIVE_ALWAYS_INLINE float2 load_float2(const uint32_t* bits)
+{
+    return float2{as_float(bits[0]), as_float(bits[1])};
+}
+
+// GLSL mod(), which always has the sign of y.
+RIVE_ALWAYS_INLINE float glsl_mod(float x, float y)
+{
+    return x - y * floorf(x / y);
+}
+
+RIVE_ALWAYS_INLINE float glsl_sign(float x)
+{
+    return x > 0 ? 1.f : x < 0 ? -1.f : 0.f;
+}
+
+RIVE_ALWAYS_INLINE float glsl_atan2(float2 v)
+{
+    return atan2f(v.y, v.x);
+}
+
+RIVE_ALWAYS_INLINE float clamp01(float x)
+{
+    // Also maps NaN to 0.
+    return x > 0 ? std::min(x, 1.f) : 0.f;
+}
+
+// 2x2 matrix in the column-major layout used by the shaders:
+//
+//   | m[0] m[2] |
+//   | m[1] m[3] |
+//
+struct Mat2x2
+{
+    explicit Mat2x2(const float* m) : a(m[0]), b(m[1]), c(m[2]), d(m[3]) {}
+    Mat2x2(float2 col0, float2 col1) :
+        a(col0.x), b(col0.y), c(col1.x), d(col1.y)
+    {}
+
+    float2 operator*(float2 v) const
+    {
+        return float2{a * v.x + c * v.y, b * v.x + d * v.y};
+    }
+    float determinant() const { return a * d - b * c; }
+
+    // Row vector times the inverse, i.e., GLSL "MUL(v, inverse(M))".
+    float2 rowTimesInverse(float2 v) const
+    {
+        float invDet = 1.f / determinant();
+        return float2{(v.x * d - v.y * b) * invDet,
+                      (v.y * a - v.x * c) * invDet};
+    }
+
+    float a, b, c, d;
+};
+
+RIVE_ALWAYS_INLINE float determinant(float2 col0, float2 col1)
+{
+    return col0.x * col1.y - col0.y * col1.x;
+}
+
+RIVE_ALWAYS_INLINE float length(float2 v) { return sqrtf(simd::dot(v, v)); }
+
+RIVE_ALWAYS_INLINE float2 normalize(float2 v)
+{
+    return v * (1.f / length(v));
+}
+
+RIVE_ALWAYS_INLINE float2 lerp(float2 a, float2 b, float t)
+{
+    return a + (b - a) * t;
+}
+
+RIVE_ALWAYS_INLINE float4 unpack_rgba8(uint32_t rgba)
+{
+    uint4 channels = uint4{rgba, rgba >> 8, rgba >> 16, rgba >> 24} & 0xffu;
+    return simd::cast<float>(channels) * (1.f / 255);
+}
+
+RIVE_ALWAYS_INLINE uint32_t pack_rgba8(float4 color)
+{
+    color = simd::clamp(color, float4(0), float4(1));
+    uint4 channels = simd::cast<uint32_t>(color * 255.f + .5f);
+    return channels.x | (channels.y << 8) | (channels.z << 16) |
+           (channels.w << 24);
+}
+
+// GradientSpan colors are ColorInt (ARGB).
+RIVE_ALWAYS_INLINE uint32_t color_int_to_rgba8(uint32_t argb)
+{
+    return SwizzleRiveColorToRGBA(argb);
+}
+
+RIVE_ALWAYS_INLINE float4 unmultiply(float4 premul)
+{
+    float4 color = premul * (premul.w != 0 ? 1.f / premul.w : 0.f);
+    color.w = premul.w;
+    return color;
+}
+
+float cosine_between_vectors(float2 a, float2 b)
+{
+    float ab_cosTheta = simd::dot(a, b);
+    float ab_pow2 = simd::dot(a, a) * simd::dot(b, b);
+    return (ab_pow2 == 0) ? 1.f
+                          : std::clamp(ab_cosTheta / sqrtf(ab_pow2), -1.f, 1.f);
+}
+
+struct CubicCoeffs
+{
+    CubicCoeffs(float2 p0, float2 p1, float2 p2, float2 p3)
+    {
+        C = p1 - p0;
+        float2 D = p2 - p1;
+        float2 E = p3 - p0;
+        B = D - C;
+        A = -3.f * D + E;
+    }
+    float2 A, B, C;
+};
+
+void find_cubic_tangents(float2 p0,
+                         float2 p1,
+                         float2 p2,
+                         float2 p3,
+                         float2 tangents[2])
+{
+    tangents[0] = (simd::any(p0 != p1)   ? p1
+                   : simd::any(p1 != p2) ? p2
+                                         : p3) -
+                  p0;
+    tangents[1] = p3 - (simd::any(p3 != p2)   ? p2
+                        : simd::any(p2 != p1) ? p1
+                                              : p0);
+}
+
+// Returns clamp(a/b, 0, 1), with the edge cases documented in
+// bezier_utils.glsl.
+float clamped_divide(float a, float b)
+{
+    a = b < 0 ? -a : a;
+    b = fabsf(b);
+    return a > 0 ? (a < b ? a / b : 1.f) : 0.f;
+}
+
+float measure_cubic_local_curvature(float2 p0,
+                                    float2 p1,
+                                    float2 p2,
+                                    float2 p3,
+                                    float T,
+                                    float desiredSpread)
+{
+    CubicCoeffs coeffs(p0, p1, p2, p3);
+    float2 A = coeffs.A, B = coeffs.B, C = coeffs.C;
+    float2 tangent = 3.f * (((A * T) + 2.f * B) * T + C);
+    float lengthTan = length(tangent);
+    if (lengthTan == 0)
+    {
+        return 0;
+    }
+    tangent *= 1.f / lengthTan;
+    float A_ = 2.f * simd::dot(A, tangent);
+    float C_ = 3.f * (A_ * T + 4.f * simd::dot(B, tangent)) * T +
+               6.f * simd::dot(C, tangent);
+    float maxDT = std::min(T, 1.f - T);
+    float maxSpread = (A_ * maxDT * maxDT + C_) * maxDT;
+    float targetSpread = std::min(desiredSpread, maxSpread * .9999f);
+    float dt;
+    if (A_ == 0)
+    {
+        dt = targetSpread / C_;
+    }
+    else
+    {
+        float r = 1.f / A_;
+        float b = C_ * r, c = -targetSpread * r;
+        float Q = (-1.f / 3.f) * b, R = .5f * c;
+        float discr = R * R - Q * Q * Q;
+        if (discr < 0)
+        {
+            float sqrtQ = sqrtf(Q);
+            float theta = acosf(R / (sqrtQ * sqrtQ * sqrtQ));
+            dt = -2.f * sqrtQ * cosf(theta * (1.f / 3.f) + (-kPi * 2.f / 3.f));
+        }
+        else
+        {
+            float A__ = powf(fabsf(R) + sqrtf(discr), 1.f / 3.f);
+            if (R < 0)
+                A__ = -A__;
+            dt = A__ != 0 ? A__ + Q / A__ : 0;
+        }
+    }
+    dt = fabsf(dt);
+    float4 t0011 = T + float4{-dt, -dt, dt, dt};
+    float4 tanDirs = (A.xyxy * t0011 + 2.f * B.xyxy) * t0011 + C.xyxy;
+    float2 tangents[2];
+    find_cubic_tangents(p0, p1, p2, p3, tangents);
+    float2 tan0 = t0011.x < 1e-3f ? tangents[0] : tanDirs.xy;
+    float2 tan1 = t0011.z > 1.f - 1e-3f ? tangents[1] : tanDirs.zw;
+    return acosf(cosine_between_vectors(tan0, tan1));
+}
+
+float find_cubic_max_height(float2 p0,
+                            float2 p1,
+                            float2 p2,
+                            float2 p3,
+                            float* outT)
+{
+    float2 base = p3 - p0;
+    float lengthBase = length(base);
+    if (lengthBase == 0)
+    {
+        *outT = .5f;
+        return 0;
+    }
+    float2 norm = float2{-base.y, base.x} / lengthBase;
+    float h2 = simd::dot(norm, p2 - p0);
+    float h1 = simd::dot(norm, p1 - p0);
+    float dh = h1 - h2;
+    float _3A = 3.f * dh;
+    float B = -h1 - dh;
+    float C = h1;
+    float t = .5f;
+    for (int i = 0; i < 3; ++i)
+    {
+        float _3At = _3A * t;
+        t = clamped_divide(_3At * t - C, 2.f * (_3At + B));
+    }
+    *outT = t;
+    return fabsf(t * (t * (t * _3A + 3.f * B) + 3.f * C));
+}
+
+// Evaluates a clip rect the same way as find_clip_rect_coverage_distances(),
+// already reduced to a single coverage value.
+float clip_rect_coverage(const float* clipRectInverseMatrix,
+                         const float* clipRectInverseTranslate,
+                         float2 fragCoord)
+{
+    Mat2x2 M(clipRectInverseMatrix);
+    float2 aaWidth = float2{fabsf(M.a) + fabsf(M.c), fabsf(M.b) + fabsf(M.d)};
+    if (aaWidth.x != 0 && aaWidth.y != 0)
+    {
+        float2 r = 1.f / aaWidth;
+        float2 coord = M * fragCoord + load_float2(reinterpret_cast<
+                                           const uint32_t*>(
+                                           clipRectInverseTranslate));
+        float4 distances =
+            simd::join(coord, -coord) * r.xyxy + r.xyxy + .5f;
+        return simd::reduce_min(distances);
+    }
+    return std::min(clipRectInverseTranslate[0], clipRectInverseTranslate[1]);
+}
+
+// HSL helpers from advanced_blend.glsl. Only the rgb lanes are meaningful.
+float minv3(float4 c) { return std::min(std::min(c.x, c.y), c.z); }
+float maxv3(float4 c) { return std::max(std::max(c.x, c.y), c.z); }
+float lumv3(float4 c) { return c.x * .30f + c.y * .59f + c.z * .11f; }
+float satv3(float4 c) { return maxv3(c) - minv3(c); }
+
+float4 clip_color(float4 color)
+{
+    float lum = lumv3(color);
+    float mincol = minv3(color);
+    float maxcol = maxv3(color);
+    if (mincol < 0)
+        color = lum + ((color - lum) * lum) / (lum - mincol);
+    if (maxcol > 1)
+        color = lum + ((color - lum) * (1.f - lum)) / (maxcol - lum);
+    return color;
+}
+
+float4 set_lum(float4 cbase, float4 clum)
+{
+    float ldiff = lumv3(clum) - lumv3(cbase);
+    return clip_color(cbase + ldiff);
+}
+
+float4 set_lum_sat(float4 cbase, float4 csat, float4 clum)
+{
+    float minbase = minv3(cbase);
+    float sbase = satv3(cbase);
+    float ssat = satv3(csat);
+    float4 color = sbase > 0 ? (cbase - minbase) * ssat / sbase : float4(0);
+    return set_lum(color, clum);
+}
+
+float4 advanced_blend_coeffs(float4 src, float4 dstPremul, uint32_t mode)
+{
+    float4 dst = unmultiply(dstPremul);
+    float4 coeffs = src;
+    switch (mode)
+    {
+        case BLEND_MODE_MULTIPLY:
+            coeffs = src * dst;
+            break;
+        case BLEND_MODE_SCREEN:
+            coeffs = src + dst - src * dst;
+            break;
+        case BLEND_MODE_OVERLAY:
+            for (int i = 0; i < 3; ++i)
+            {
+                coeffs[i] = dst[i] <= .5f
+                                ? 2.f * src[i] * dst[i]
+                                : 1.f - 2.f * (1.f - src[i]) * (1.f - dst[i]);
+            }
+            break;
+        case BLEND_MODE_DARKEN:
+            coeffs = simd::min(src, dst);
+            break;
+        case BLEND_MODE_LIGHTEN:
+            coeffs = simd::max(src, dst);
+            break;
+        case BLEND_MODE_COLORDODGE:
+            for (int i = 0; i < 3; ++i)
+            {
+                float d = std::clamp(dstPremul[i], 0.f, dstPremul.w);
+                float denom = clamp01(1.f - src[i]) * dstPremul.w;
+                coeffs[i] =
+                    denom == 0 ? glsl_sign(d) : std::min(1.f, d / denom);
+            }
+            break;
+        case BLEND_MODE_COLORBURN:
+        {
+            float a = dstPremul.w == 0 ? 1.f : dstPremul.w;
+            for (int i = 0; i < 3; ++i)
+            {
+                float s = clamp01(src[i]);
+                float d = std::clamp(dstPremul[i], 0.f, dstPremul.w);
+                float numer = a - d;
+                coeffs[i] = 1.f - (s == 0 ? glsl_sign(numer)
+                                          : std::min(1.f, numer / (s * a)));
+            }
+            break;
+        }
+        case BLEND_MODE_HARDLIGHT:
+            for (int i = 0; i < 3; ++i)
+            {
+                coeffs[i] = src[i] <= .5f
+                                ? 2.f * src[i] * dst[i]
+                                : 1.f - 2.f * (1.f - src[i]) * (1.f - dst[i]);
+            }
+            break;
+        case BLEND_MODE_SOFTLIGHT:
+            for (int i = 0; i < 3; ++i)
+            {
+                float s = src[i], d = dst[i];
+                if (s <= .5f)
+                    coeffs[i] = d - (1.f - 2.f * s) * d * (1.f - d);
+                else if (d <= .25f)
+                    coeffs[i] =
+                        d + (2.f * s - 1.f) * d * ((16.f * d - 12.f) * d + 3.f);
+                else
+                    coeffs[i] = d + (2.f * s - 1.f) * (sqrtf(d) - d);
+            }
+            break;
+        case BLEND_MODE_DIFFERENCE:
+            coeffs = simd::abs(dst - src);
+            break;
+        case BLEND_MODE_EXCLUSION:
+            coeffs = src + dst - 2.f * src * dst;
+            break;
+        case BLEND_MODE_HUE:
+            src = simd::clamp(src, float4(0), float4(1));
+            coeffs = set_lum_sat(src, dst, dst);
+            break;
+        case BLEND_MODE_SATURATION:
+            src = simd::clamp(src, float4(0), float4(1));
+            coeffs = set_lum_sat(dst, src, dst);
+            break;
+        case BLEND_MODE_COLOR:
+            src = simd::clamp(src, float4(0), float4(1));
+            coeffs = set_lum(src, dst);
+            break;
+        case BLEND_MODE_LUMINOSITY:
+            src = simd::clamp(src, float4(0), float4(1));
+            coeffs = set_lum(dst, src);
+            break;
+    }
+    return coeffs;
+}
+
+// Returns the blended rgb of an unmultiplied source with alpha=1. Alpha is
+// left untouched.
+RIVE_ALWAYS_INLINE float4 advanced_color_blend(float4 src,
+                                               float4 dstPremul,
+                                               uint32_t mode)
+{
+    float4 coeffs = advanced_blend_coeffs(src, dstPremul, mode);
+    float4 color = coeffs * dstPremul.w + src * (1.f - dstPremul.w);
+    color.w = src.w;
+    return color;
+}
+
+int wrap_texel(int i, int n, ImageWrap wrap)
+{
+    switch (wrap)
+    {
+        case ImageWrap::repeat:
+            i %= n;
+            return i < 0 ? i + n : i;
+        case ImageWrap::mirror:
+        {
+            int period = n * 2;
+            i %= period;
+            i = i < 0 ? i + period : i;
+            return i < n ? i : period - 1 - i;
+        }
+        case ImageWrap::clamp:
+        default:
+            return std::clamp(i, 0, n - 1);
+    }
+}
+
+// floor() to an int, keeping absurd or NaN coordinates in a sane range.
+RIVE_ALWAYS_INLINE int floor_to_int(float x)
+{
+    x = x > -1e8f ? std::min(x, 1e8f) : -1e8f;
+    return static_cast<int>(floorf(x));
+}
+
+// Floor and ceiling of integer division by a positive divisor.
+RIVE_ALWAYS_INLINE int64_t floor_div(int64_t n, int64_t d)
+{
+    int64_t q = n / d;
+    return (n % d != 0 && n < 0) ? q - 1 : q;
+}
+
+RIVE_ALWAYS_INLINE int64_t ceil_div(int64_t n, int64_t d)
+{
+    return -floor_div(-n, d);
+}
+} // namespace
+
+RenderTargetCPU::RenderTargetCPU(uint32_t width, uint32_t height) :
+    RenderTarget(width, height),
+    m_pixels(new uint32_t[static_cast<size_t>(width) * height]())
+{}
+
+void RenderTargetCPU::allocatePLSPlanes()
+{
+    if (m_coverage == nullptr)
+    {
+        size_t pixelCount = static_cast<size_t>(width()) * height();
+        m_scratchColor.reset(new uint32_t[pixelCount]);
+        m_coverage.reset(new CoverageTexel[pixelCount]);
+        m_clip.reset(new CoverageTexel[pixelCount]);
+    }
+}
+
+namespace
+{
+class RenderBufferCPUImpl
+    : public LITE_RTTI_OVERRIDE(RenderBuffer, RenderBufferCPUImpl)
+{
+public:
+    RenderBufferCPUImpl(RenderBufferType renderBufferType,
+                        RenderBufferFlags renderBufferFlags,
+                        size_t sizeInBytes) :
+        lite_rtti_override(renderBufferType, renderBufferFlags, sizeInBytes),
+        m_contents(new uint8_t[sizeInBytes])
+    {}
+
+    const uint8_t* contents() const { return m_contents.get(); }
+
+protected:
+    // Flushes are executed synchronously, so the buffer can be written in
+    // place.
+    void* onMap() override { return m_contents.get(); }
+    void onUnmap() override {}
+
+private:
+    std::unique_ptr<uint8_t[]> m_contents;
+};
+
+// Premultiplied RGBA8 image with a full chain of box-filtered mipmaps.
+class TextureCPUImpl : public Texture
+{
+public:
+    TextureCPUImpl(uint32_t width,
+                   uint32_t height,
+                   uint32_t mipLevelCount,
+                   const uint8_t imageDataRGBAPremul[]) :
+        Texture(width, height)
+    {
+        mipLevelCount = std::max(mipLevelCount, 1u);
+        m_levels.reserve(mipLevelCount);
+        MipLevel& base = m_levels.emplace_back();
+        base.width = width;
+        base.height = height;
+        base.texels.resize(static_cast<size_t>(width) * height);
+        memcpy(base.texels.data(),
+               imageDataRGBAPremul,
+               base.texels.size() * sizeof(uint32_t));
+        while (m_levels.size() < mipLevelCount &&
+               (m_levels.back().width > 1 || m_levels.back().height > 1))
+        {
+            const MipLevel& src = m_levels.back();
+            MipLevel dst;
+            dst.width = std::max(src.width >> 1, 1u);
+            dst.height = std::max(src.height >> 1, 1u);
+            dst.texels.resize(static_cast<size_t>(dst.width) * dst.height);
+            for (uint32_t y = 0; y < dst.height; ++y)
+            {
+                uint32_t y0 = std::min(y * 2, src.height - 1);
+                uint32_t y1 = std::min(y * 2 + 1, src.height - 1);
+                for (uint32_t x = 0; x < dst.width; ++x)
+                {
+                    uint32_t x0 = std::min(x * 2, src.width - 1);
+                    uint32_t x1 = std::min(x * 2 + 1, src.width - 1);
+                    float4 sum = unpack_rgba8(src.texel(x0, y0)) +
+                                 unpack_rgba8(src.texel(x1, y0)) +
+                                 unpack_rgba8(src.texel(x0, y1)) +
+                                 unpack_rgba8(src.texel(x1, y1));
+                    dst.texels[static_cast<size_t>(y) * dst.width + x] =
+                        pack_rgba8(sum * .25f);
+                }
+            }
+            m_levels.push_back(std::move(dst));
+        }
+    }
+
+    // Samples premultiplied color at normalized coordinate "uv".
+    float4 sample(float2 uv, float lod, ImageSampler sampler) const
+    {
+        float maxLOD = static_cast<float>(m_levels.size() - 1);
+        lod = lod > 0 ? std::min(lod, maxLOD) : 0.f;
+        if (sampler.filter == ImageFilter::nearest)
+        {
+            const MipLevel& level = m_levels[static_cast<size_t>(lod + .5f)];
+            int x = wrap_texel(floor_to_int(uv.x * level.width),
+                               level.width,
+                               sampler.wrapX);
+            int y = wrap_texel(floor_to_int(uv.y * level.height),
+                               level.height,
+                               sampler.wrapY);
+            return unpack_rgba8(level.texel(x, y));
+        }
+        size_t levelIdx = static_cast<size_t>(lod);
+        float4 color = m_levels[levelIdx].sampleBilinear(uv, sampler);
+        float t = lod - static_cast<float>(levelIdx);
+        if (t > 0 && levelIdx + 1 < m_levels.size())
+        {
+            float4 next = m_levels[levelIdx + 1].sampleBilinear(uv, sampler);
+            color += (next - color) * t;
+        }
+        return color;
+    }
+
+private:
+    struct MipLevel
+    {
+        uint32_t texel(int x, int y) const
+        {
+            return texels[static_cast<size_t>(y) * width + x];
+        }
+
+        float4 sampleBilinear(float2 uv, ImageSampler sampler) const
+        {
+            float fx = uv.x * width - .5f;
+            float fy = uv.y * height - .5f;
+            int x0 = floor_to_int(fx), y0 = floor_to_int(fy);
+            float tx = fx - floorf(fx), ty = fy - floorf(fy);
+            int w = static_cast<int>(width), h = static_cast<int>(height);
+            int xa = wrap_texel(x0, w, sampler.wrapX);
+            int xb = wrap_texel(x0 + 1, w, sampler.wrapX);
+            int ya = wrap_texel(y0, h, sampler.wrapY);
+            int yb = wrap_texel(y0 + 1, h, sampler.wrapY);
+            float4 top = unpack_rgba8(texel(xa, ya));
+            float4 topRight = unpack_rgba8(texel(xb, ya));
+            float4 bottom = unpack_rgba8(texel(xa, yb));
+            float4 bottomRight = unpack_rgba8(texel(xb, yb));
+            top += (topRight - top) * tx;
+            bottom += (bottomRight - bottom) * tx;
+            return top + (bottom - top) * ty;
+        }
+
+        uint32_t width;
+        uint32_t height;
+        std::vector<uint32_t> texels;
+    };
+
+    std::vector<MipLevel> m_levels;
+};
+
+// Paint state of one path, decoded from the paint buffers once per flush.
+struct PathPaint
+{
+    uint32_t paintType;
+    uint32_t blendMode;
+    // Clip to test against, or to write if this is a clip update.
+    uint32_t clipID;
+    // Clip to intersect with when updating a nested clip.
+    uint32_t outerClipID;
+    bool evenOdd;
+    bool hasClipRect;
+    // Solid colors only. Premultiplied unless blendMode != BLEND_SRC_OVER.
+    float4 color;
+    // Gradient texture row (normalized), or image opacity.
+    float paintValue;
+    // Maps fragCoord to paint coordinates, followed by the gradient span or
+    // image LOD, and the inverse clip rect matrix.
+    const float* aux;
+};
+
+// Output of the draw_path vertex shader for a single patch vertex.
+struct PathVertex
+{
+    float2 position;
+    float4 coverages;
+    uint32_t pathID;
+};
+
+// A triangle set up for scan conversion. Varyings are stored as plane
+// equations in pixel space, relative to the first vertex.
+struct RasterTriangle
+{
+    // Vertices in fixed point with kSubpixelBits of precision, wound
+    // clockwise.
+    int32_t x[3];
+    int32_t y[3];
+    // Rows whose pixel centers the triangle might cover: [top, bottom).
+    int32_t top;
+    int32_t bottom;
+    uint32_t pathID;
+    float originX;
+    float originY;
+    float4 varyings;
+    float4 ddx;
+    float4 ddy;
+};
+
+// Triangles emitted by one vertex job, along with the rows they touch.
+struct TriangleBin
+{
+    std::vector<RasterTriangle> triangles;
+    int32_t top;
+    int32_t bottom;
+};
+
+enum class RasterKind : uint8_t
+{
+    pathPatches,
+    interiorTriangles,
+    atlasBlit,
+    imageMesh,
+    atlasFill,
+    atlasStroke,
+};
+
+struct RasterBatch
+{
+    RasterKind kind;
+    bool clockwiseFill;
+    uint32_t firstBin;
+    uint32_t binCount;
+    // Patches only.
+    uint32_t patchBaseIndex;
+    uint32_t patchIndexCount;
+    // Atlas draws only.
+    int32_t scissorLeft, scissorTop, scissorRight, scissorBottom;
+    // Images only.
+    const TextureCPUImpl* texture;
+    ImageSampler sampler;
+    // Image meshes only.
+    const float* imageDrawUniforms;
+    const float* meshVertices;
+    const float* meshUVs;
+    const uint16_t* meshIndices;
+};
+
+struct VertexJob
+{
+    uint32_t batchIdx;
+    uint32_t firstElement;
+    uint32_t elementCount;
+};
+
+template <typename Fn>
+void scan_convert(const RasterTriangle& tri,
+                  int32_t rowBegin,
+                  int32_t rowEnd,
+                  int32_t colBegin,
+                  int32_t colEnd,
+                  Fn&& shadeSpan)
+{
+    rowBegin = std::max(rowBegin, tri.top);
+    rowEnd = std::min(rowEnd, tri.bottom);
+    if (rowBegin >= rowEnd || colBegin >= colEnd)
+    {
+        return;
+    }
+    // Edge i runs from vertex i to vertex i + 1. A pixel center is inside when
+    // every edge function is >= 0, or > 0 for edges that aren't top-left.
+    int64_t ax[3], ay[3], dx[3], dy[3], bias[3];
+    for (int i = 0; i < 3; ++i)
+    {
+        int j = i == 2 ? 0 : i + 1;
+        ax[i] = tri.x[i];
+        ay[i] = tri.y[i];
+        dx[i] = static_cast<int64_t>(tri.x[j]) - tri.x[i];
+        dy[i] = static_cast<int64_t>(tri.y[j]) - tri.y[i];
+        bool isTopLeft = dy[i] < 0 || (dy[i] == 0 && dx[i] > 0);
+        bias[i] = isTopLeft ? 0 : 1;
+    }
+    for (int32_t py = rowBegin; py < rowEnd; ++py)
+    {
+        int64_t Y =
+            static_cast<int64_t>(py) * kSubpixelOne + kSubpixelHalf;
+        int64_t lo = colBegin, hi = static_cast<int64_t>(colEnd) - 1;
+        bool empty = false;
+        for (int i = 0; i < 3; ++i)
+        {
+            // E(px) = dx*(Y - ay) - dy*(px*one + half - ax) = k*px + c.
+            int64_t k = -dy[i] * kSubpixelOne;
+            int64_t c = dx[i] * (Y - ay[i]) - dy[i] * (kSubpixelHalf - ax[i]);
+            if (k > 0)
+            {
+                lo = std::max(lo, ceil_div(bias[i] - c, k));
+            }
+            else if (k < 0)
+            {
+                hi = std::min(hi, floor_div(c - bias[i], -k));
+            }
+            else if (c < bias[i])
+            {
+                empty = true;
+                break;
+            }
+        }
+        if (!empty && lo <= hi)
+        {
+            shadeSpan(py,
+                      static_cast<int32_t>(lo),
+                      static_cast<int32_t>(hi) + 1);
+        }
+    }
+}
+
+// Sets up a triangle for scan_convert(). Returns false if it is culled or
+// doesn't touch any rows in [0, rowLimit).
+bool setup_triangle(float2 p0,
+                    float2 p1,
+                    float2 p2,
+                    float4 v0,
+                    float4 v1,
+                    float4 v2,
+                    bool doubleSided,
+                    int32_t rowLimit,
+                    RasterTriangle* tri)
+{
+    float2 pts[3] = {p0, p1, p2};
+    for (const float2& p : pts)
+    {
+        // Also rejects NaN.
+        if (!(fabsf(p.x) < kMaxVertexCoord && fabsf(p.y) < kMaxVertexCoord))
+        {
+            return false;
+        }
+    }
+    for (int i = 0; i < 3; ++i)
+    {
+        tri->x[i] = static_cast<int32_t>(lrintf(pts[i].x * kSubpixelOne));
+        tri->y[i] = static_cast<int32_t>(lrintf(pts[i].y * kSubpixelOne));
+    }
+    int64_t e1x = static_cast<int64_t>(tri->x[1]) - tri->x[0];
+    int64_t e1y = static_cast<int64_t>(tri->y[1]) - tri->y[0];
+    int64_t e2x = static_cast<int64_t>(tri->x[2]) - tri->x[0];
+    int64_t e2y = static_cast<int64_t>(tri->y[2]) - tri->y[0];
+    int64_t area = e1x * e2y - e1y * e2x;
+    if (area == 0)
+    {
+        return false;
+    }
+    if (area < 0)
+    {
+        // Counterclockwise in (y-down) pixel space.
+        if (!doubleSided)
+        {
+            return false;
+        }
+        std::swap(tri->x[1], tri->x[2]);
+        std::swap(tri->y[1], tri->y[2]);
+        std::swap(v1, v2);
+        std::swap(e1x, e2x);
+        std::swap(e1y, e2y);
+        area = -area;
+    }
+    int32_t minY = std::min({tri->y[0], tri->y[1], tri->y[2]});
+    int32_t maxY = std::max({tri->y[0], tri->y[1], tri->y[2]});
+    int64_t top = ceil_div(static_cast<int64_t>(minY) - kSubpixelHalf,
+                           kSubpixelOne);
+    int64_t bottom = floor_div(static_cast<int64_t>(maxY) - kSubpixelHalf,
+                               kSubpixelOne) +
+                     1;
+    tri->top = static_cast<int32_t>(std::max<int64_t>(top, 0));
+    tri->bottom = static_cast<int32_t>(std::min<int64_t>(bottom, rowLimit));
+    if (tri->top >= tri->bottom)
+    {
+        return false;
+    }
+    // Solve the plane equations in double, since the edge vectors can be much
+    // larger than the differences in varyings.
+    double invArea =
+        static_cast<double>(kSubpixelOne) / static_cast<double>(area);
+    float ddx1 = static_cast<float>(e2y * invArea);
+    float ddx2 = static_cast<float>(-e1y * invArea);
+    float ddy1 = static_cast<float>(-e2x * invArea);
+    float ddy2 = static_cast<float>(e1x * invArea);
+    float4 d1 = v1 - v0, d2 = v2 - v0;
+    tri->ddx = d1 * ddx1 + d2 * ddx2;
+    tri->ddy = d1 * ddy1 + d2 * ddy2;
+    tri->varyings = v0;
+    tri->originX = static_cast<float>(tri->x[0]) * (1.f / kSubpixelOne);
+    tri->originY = static_cast<float>(tri->y[0]) * (1.f / kSubpixelOne);
+    return true;
+}
+
+// Varyings of "tri" at the center of pixel (px, py).
+RIVE_ALWAYS_INLINE float4 varyings_at(const RasterTriangle& tri,
+                                      int32_t px,
+                                      int32_t py)
+{
+    return tri.varyings +
+           tri.ddx * (static_cast<float>(px) + .5f - tri.originX) +
+           tri.ddy * (static_cast<float>(py) + .5f - tri.originY);
+}
+
+// Port of the tessellate fragment shader. Writes the four words of one
+// tessellation texel to "out".
+void tessellateVertex(float2 p0,
+                      float2 p1,
+                      float2 p2,
+                      float2 p3,
+                      const float2 curveTangents[2],
+                      float vertexIdx,
+                      float totalVertexCount,
+                      float parametricSegmentCount,
+                      float joinSegmentCount,
+                      float radsPerPolarSegment,
+                      float2 joinTangent,
+                      float radsPerJoinSegment,
+                      uint32_t contourIDWithFlags,
+                      uint32_t* out)
+{
+    float2 tangents[2] = {curveTangents[0], curveTangents[1]};
+    float mergedSegmentCount = totalVertexCount - joinSegmentCount;
+    float mergedVertexID = vertexIdx;
+    if (mergedVertexID <= mergedSegmentCount)
+    {
+        // We belong to the curve section. Clear out any stroke join flags.
+        contourIDWithFlags &= ~JOIN_TYPE_MASK;
+    }
+    else
+    {
+        // We belong to the join section following the curve. Construct a
+        // point-cubic with rotation.
+        p0 = p1 = p2 = p3;
+        tangents[0] = tangents[1];
+        tangents[1] = joinTangent;
+        parametricSegmentCount = 1;
+        mergedVertexID -= mergedSegmentCount;
+        mergedSegmentCount = joinSegmentCount;
+        radsPerPolarSegment = radsPerJoinSegment;
+        if ((contourIDWithFlags & JOIN_TYPE_MASK) > ROUND_JOIN_CONTOUR_FLAG)
+        {
+            // Miter or bevel join vertices snap to either tangents[0] or
+            // tangents[1], and get adjusted by the path vertex shader.
+            if (mergedVertexID < 2.5f)
+                contourIDWithFlags |= JOIN_TANGENT_0_CONTOUR_FLAG;
+            if (mergedVertexID > 1.5f && mergedVertexID < 3.5f)
+                contourIDWithFlags |= JOIN_TANGENT_INNER_CONTOUR_FLAG;
+        }
+        else if ((contourIDWithFlags & EMULATED_STROKE_CAP_CONTOUR_FLAG) != 0 ||
+                 (contourIDWithFlags & JOIN_TYPE_MASK) ==
+                     FEATHER_JOIN_CONTOUR_FLAG)
+        {
+            // Emulated round caps and feather joins emit vertices at T=0 and
+            // T=1, unlike normal round joins.
+            mergedSegmentCount -= 2;
+            --mergedVertexID;
+        }
+        contourIDWithFlags |= radsPerPolarSegment < 0
+                                  ? LEFT_JOIN_CONTOUR_FLAG
+                                  : RIGHT_JOIN_CONTOUR_FLAG;
+    }
+
+    float2 tessCoord;
+    float theta = 0;
+    if (mergedVertexID == 0 || mergedVertexID == mergedSegmentCount ||
+        (contourIDWithFlags & JOIN_TYPE_MASK) > ROUND_JOIN_CONTOUR_FLAG)
+    {
+        // Vertices at the beginning and end of the strip use exact endpoints
+        // and tangents, for crack-free seaming between instances.
+        bool isTan0 = mergedVertexID < mergedSegmentCount * .5f;
+        tessCoord = isTan0 ? p0 : p3;
+        theta = glsl_atan2(isTan0 ? tangents[0] : tangents[1]);
+    }
+    else if ((contourIDWithFlags & RETROFITTED_TRIANGLE_CONTOUR_FLAG) != 0)
+    {
+        // This cubic is actually the single, non-AA triangle [p0, p1, p3].
+        tessCoord = p1;
+    }
+    else
+    {
+        float T, polarT;
+        if (parametricSegmentCount == mergedSegmentCount)
+        {
+            // There are no polar vertices. Vertices are spaced evenly in
+            // parametric space.
+            T = mergedVertexID / parametricSegmentCount;
+            polarT = 0;
+        }
+        else
+        {
+            float2 C = p1 - p0;
+            float2 D = p3 - p0;
+            float2 E = p2 - p1;
+            float2 B = E - C;
+            float2 A = -3.f * E + D;
+            float2 B_ = B * (parametricSegmentCount * 2.f);
+            float2 C_ = C * (parametricSegmentCount * parametricSegmentCount);
+
+            // Binary search for the highest parametric vertex located on or
+            // before mergedVertexID.
+            float lastParametricVertexID = 0;
+            float maxParametricVertexID =
+                std::min(parametricSegmentCount - 1.f, mergedVertexID);
+            float2 tan0norm = normalize(tangents[0]);
+            float negAbsRadsPerSegment = -fabsf(radsPerPolarSegment);
+            float maxRotation0 =
+                (1.f + mergedVertexID) * fabsf(radsPerPolarSegment);
+            for (int p = kMaxParametricSegmentsLog2 - 1; p >= 0; --p)
+            {
+                float testParametricID =
+                    lastParametricVertexID + static_cast<float>(1 << p);
+                if (testParametricID <= maxParametricVertexID)
+                {
+                    float2 testTan = testParametricID * A + B_;
+                    testTan = testParametricID * testTan + C_;
+                    float cosRotation =
+                        simd::dot(normalize(testTan), tan0norm);
+                    float maxRotation =
+                        testParametricID * negAbsRadsPerSegment + maxRotation0;
+                    maxRotation = std::min(maxRotation, kPi);
+                    if (cosRotation >= cosf(maxRotation))
+                        lastParametricVertexID = testParametricID;
+                }
+            }
+            float parametricT = lastParametricVertexID / parametricSegmentCount;
+            float lastPolarVertexID = mergedVertexID - lastParametricVertexID;
+
+            float theta0 = acosf(std::clamp(tan0norm.x, -1.f, 1.f));
+            theta0 = tan0norm.y >= 0 ? theta0 : -theta0;
+            theta = lastPolarVertexID * radsPerPolarSegment + theta0;
+            float2 norm = float2{sinf(theta), -cosf(theta)};
+
+            // Find the T value where the tangent is orthogonal to norm.
+            float a = simd::dot(norm, A), b_over_2 = simd::dot(norm, B),
+                  c = simd::dot(norm, C);
+            float discr_over_4 = std::max(b_over_2 * b_over_2 - a * c, 0.f);
+            float q = sqrtf(discr_over_4);
+            if (b_over_2 > 0)
+                q = -q;
+            q -= b_over_2;
+            float _5qa = -.5f * q * a;
+            float2 root = (fabsf(q * q + _5qa) < fabsf(a * c + _5qa))
+                              ? float2{q, a}
+                              : float2{c, q};
+            polarT = (root.y != 0) ? root.x / root.y : 0.f;
+            polarT = std::clamp(polarT, 0.f, 1.f);
+            if (lastPolarVertexID == 0)
+                polarT = 0;
+            T = std::max(parametricT, polarT);
+        }
+
+        // Evaluate the cubic at T with De Casteljau's.
+        float2 ab = lerp(p0, p1, T);
+        float2 bc = lerp(p1, p2, T);
+        float2 cd = lerp(p2, p3, T);
+        float2 abc = lerp(ab, bc, T);
+        float2 bcd = lerp(bc, cd, T);
+        tessCoord = lerp(abc, bcd, T);
+        if (T != polarT)
+            theta = glsl_atan2(bcd - abc);
+    }
+
+    out[0] = math::bit_cast<uint32_t>(tessCoord.x);
+    out[1] = math::bit_cast<uint32_t>(tessCoord.y);
+    if ((contourIDWithFlags & JOIN_TYPE_MASK) == FEATHER_JOIN_CONTOUR_FLAG)
+    {
+        // Feather joins work out their stepping in the path vertex shader.
+        out[2] = (static_cast<uint32_t>(mergedSegmentCount) << 16) |
+                 static_cast<uint32_t>(mergedVertexID);
+    }
+    else
+    {
+        out[2] = math::bit_cast<uint32_t>(glsl_mod(theta, k2Pi));
+    }
+    out[3] = contourIDWithFlags;
+}
+} // namespace
+
+struct RenderContextCPUImpl::FlushState
+{
+    const RenderContextCPUImpl* impl;
+    const FlushDescriptor* desc;
+    RenderTargetCPU* renderTarget;
+
+    // Resource buffers, offset to the first element of this flush.
+    const uint32_t* pathData;
+    const uint32_t* paintData;
+    const float* paintAuxData;
+    const uint32_t* contourData;
+    const GradientSpan* gradSpans;
+    const TessVertexSpan* tessSpans;
+    const uint32_t* triangleVertices;
+    const uint8_t* imageDrawUniforms;
+
+    // Scratch that persists across flushes to avoid reallocating.
+    std::vector<PathPaint> paints;
+    std::vector<RasterBatch> batches;
+    std::vector<VertexJob> vertexJobs;
+    std::vector<TriangleBin> bins;
+
+    const float* pathFloats(uint32_t pathID) const
+    {
+        return reinterpret_cast<const float*>(pathData + pathID * 16);
+    }
+
+    float feather(float x) const
+    {
+        return sampleTable(impl->m_featherTable, x);
+    }
+
+    float inverseFeather(float x) const
+    {
+        return sampleTable(impl->m_inverseFeatherTable, x);
+    }
+
+    // Linear filtered, clamp-to-edge lookup of a 1D feather table.
+    static float sampleTable(const float* table, float x)
+    {
+        float u = x * GAUSSIAN_TABLE_SIZE - .5f;
+        u = u > 0 ? std::min(u, GAUSSIAN_TABLE_SIZE - 1.f) : 0.f;
+        uint32_t i = static_cast<uint32_t>(u);
+        uint32_t j = std::min(i + 1, GAUSSIAN_TABLE_SIZE - 1);
+        return table[i] + (table[j] - table[i]) * (u - static_cast<float>(i));
+    }
+
+    const uint32_t* tessTexel(int64_t idx) const
+    {
+        int64_t texelCount = static_cast<int64_t>(impl->m_tessTexture.size() / 4);
+        idx = std::clamp<int64_t>(idx, 0, std::max<int64_t>(texelCount - 1, 0));
+        return impl->m_tessTexture.data() + idx * 4;
+    }
+
+    float evalFeatheredFill(float4 coverages) const
+    {
+        float cotTheta = coverages.z;
+        float y0 = std::max(coverages.w, 0.f);
+        float featherCoverage = cotTheta >= 0 ? feather(y0) : 0.f;
+        if (fabsf(cotTheta) < kHorizontalCotangentThreshold)
+        {
+            float x = fabsf(coverages.x) - kFeatherXCoordBias;
+            float y = -coverages.y + kFeatherCoverageBias;
+            float dt = (y - y0) * 0.5984134206f;
+            float4 t = y0 + dt * float4{0.20888568955f,
+                                        0.62665706865f,
+                                        1.04442844776f,
+                                        1.46219982687f};
+            float4 u = t * -cotTheta + (y * cotTheta + x);
+            float4 feathers =
+                float4{feather(u.x), feather(u.y), feather(u.z), feather(u.w)};
+            float4 t_ = t * 5.09593080173f + -2.54796540086f;
+            float4 ddtFeather = -t_ * t_;
+            for (int i = 0; i < 4; ++i)
+            {
+                ddtFeather[i] = exp2f(ddtFeather[i]);
+            }
+            featherCoverage += simd::dot(feathers, ddtFeather) * dt;
+        }
+        return featherCoverage * glsl_sign(coverages.x);
+    }
+
+    float evalFeatheredStroke(float4 coverages) const
+    {
+        float featherCoverage = 1.f;
+        featherCoverage -= feather((1.f - kFeatherCoverageBias) + coverages.x);
+        featherCoverage -= feather(1.f - coverages.y);
+        return featherCoverage;
+    }
+
+    // Upscales a pre-rendered feather from the atlas, bilerping in linear
+    // space like filter_feather_atlas(). renderAtlas() already converted the
+    // atlas to linear space.
+    float filterFeatherAtlas(float2 atlasCoord) const
+    {
+        int w = static_cast<int>(impl->m_atlasTextureWidth);
+        int h = static_cast<int>(impl->m_atlasTextureHeight);
+        if (w == 0 || h == 0)
+        {
+            return 0;
+        }
+        int cx = floor_to_int(atlasCoord.x + .5f);
+        int cy = floor_to_int(atlasCoord.y + .5f);
+        auto fetch = [&](int x, int y) {
+            x = std::clamp(x, 0, w - 1);
+            y = std::clamp(y, 0, h - 1);
+            return impl->m_atlasTexture[static_cast<size_t>(y) * w + x];
+        };
+        float fx = atlasCoord.x + .5f - static_cast<float>(cx);
+        float fy = atlasCoord.y + .5f - static_cast<float>(cy);
+        float upper = fetch(cx - 1, cy - 1) +
+                      (fetch(cx, cy - 1) - fetch(cx - 1, cy - 1)) * fx;
+        float lower =
+            fetch(cx - 1, cy) + (fetch(cx, cy) - fetch(cx - 1, cy)) * fx;
+        return feather(upper + (lower - upper) * fy);
+    }
+
+    // Port of unpack_tessellated_path_vertex(). Returns false if the vertex is
+    // discarded.
+    bool unpackPathVertex(const PatchVertex& patchVertex,
+                          int64_t instanceID,
+                          PathVertex* out) const
+    {
+        int localVertexID = static_cast<int>(patchVertex.localVertexID);
+        float outset = patchVertex.outset;
+        float fillCoverage = patchVertex.fillCoverage;
+        int32_t params = math::bit_cast<int32_t>(patchVertex.params);
+        int patchSegmentSpan = params >> 2;
+        int vertexType = params & 3;
+
+        int vertexIDOnContour = std::min(localVertexID, patchSegmentSpan - 1);
+        int64_t tessVertexIdx = instanceID * patchSegmentSpan + vertexIDOnContour;
+        const uint32_t* tessVertexData = tessTexel(tessVertexIdx);
+        uint32_t contourIDWithFlags = tessVertexData[3];
+
+        uint32_t contourID = std::max(contourIDWithFlags & CONTOUR_ID_MASK, 1u);
+        if (contourID > desc->contourCount)
+        {
+            return false;
+        }
+        const uint32_t* contour = contourData + (contourID - 1) * 4;
+        float2 midpoint = load_float2(contour);
+        uint32_t pathID = contour[2] & 0xffffu;
+        uint32_t vertexIndex0 = contour[3];
+        if (pathID >= desc->pathCount)
+        {
+            return false;
+        }
+        const float* path = pathFloats(pathID);
+        Mat2x2 M(path);
+        float2 translate = float2{path[4], path[5]};
+        float strokeRadius = path[6];
+        float featherRadius = path[7];
+
+        uint32_t mirroredContourFlag =
+            contourIDWithFlags & MIRRORED_CONTOUR_CONTOUR_FLAG;
+        if (mirroredContourFlag != 0)
+        {
+            localVertexID = static_cast<int>(patchVertex.mirroredVertexID);
+            outset = patchVertex.mirroredOutset;
+            fillCoverage = patchVertex.mirroredFillCoverage;
+        }
+        if (localVertexID != vertexIDOnContour)
+        {
+            int64_t replacementTessVertexIdx =
+                tessVertexIdx + localVertexID - vertexIDOnContour;
+            const uint32_t* replacementTessVertexData =
+                tessTexel(replacementTessVertexIdx);
+            if ((replacementTessVertexData[3] &
+                 (MIRRORED_CONTOUR_CONTOUR_FLAG | 0xffffu)) !=
+                (contourIDWithFlags &
+                 (MIRRORED_CONTOUR_CONTOUR_FLAG | 0xffffu)))
+            {
+                bool isClosed = strokeRadius == 0 || midpoint.x != 0;
+                if (isClosed)
+                {
+                    tessVertexIdx = vertexIndex0;
+                    tessVertexData = tessTexel(tessVertexIdx);
+                }
+            }
+            else
+            {
+                tessVertexIdx = replacementTessVertexIdx;
+                tessVertexData = replacementTessVertexData;
+            }
+            contourIDWithFlags =
+                (tessVertexData[3] & ~MIRRORED_CONTOUR_CONTOUR_FLAG) |
+                mirroredContourFlag;
+        }
+
+        float theta;
+        float featherJoinEdge0Theta = 0;
+        float featherJoinCornerTheta = 0;
+        bool isFeatherJoin =
+            (contourIDWithFlags & JOIN_TYPE_MASK) == FEATHER_JOIN_CONTOUR_FLAG &&
+            vertexType == STROKE_VERTEX;
+        if (isFeatherJoin)
+        {
+            uint32_t joinDataPacked = tessVertexData[2];
+            float joinVertexID = static_cast<float>(joinDataPacked & 0xffffu);
+            float joinSegmentCount = static_cast<float>(joinDataPacked >> 16);
+
+            int64_t edgeVertexOffsets[2] = {
+                static_cast<int64_t>(-joinVertexID - 1.f),
+                static_cast<int64_t>(joinSegmentCount - joinVertexID + 1.f)};
+            if ((contourIDWithFlags & MIRRORED_CONTOUR_CONTOUR_FLAG) != 0)
+            {
+                edgeVertexOffsets[0] = -edgeVertexOffsets[0];
+                edgeVertexOffsets[1] = -edgeVertexOffsets[1];
+            }
+            const uint32_t* tessDataBeforeJoin =
+                tessTexel(tessVertexIdx + edgeVertexOffsets[0]);
+            const uint32_t* tessDataAfterJoin =
+                tessTexel(tessVertexIdx + edgeVertexOffsets[1]);
+            if ((tessDataAfterJoin[3] &
+                 (MIRRORED_CONTOUR_CONTOUR_FLAG | 0xffffu)) !=
+                (tessDataBeforeJoin[3] &
+                 (MIRRORED_CONTOUR_CONTOUR_FLAG | 0xffffu)))
+            {
+                tessDataAfterJoin = tessTexel(vertexIndex0);
+            }
+
+            featherJoinEdge0Theta = as_float(tessDataBeforeJoin[2]);
+            float featherJoinEdge1Theta = as_float(tessDataAfterJoin[2]);
+            featherJoinCornerTheta =
+                featherJoinEdge1Theta - featherJoinEdge0Theta;
+            if (fabsf(featherJoinCornerTheta) > kPi)
+                featherJoinCornerTheta -=
+                    k2Pi * glsl_sign(featherJoinCornerTheta);
+
+            float nonHelperSegmentCount =
+                joinSegmentCount + 1.f -
+                static_cast<float>(FEATHER_JOIN_HELPER_VERTEX_COUNT);
+            float forwardSegmentCount =
+                std::clamp(roundf(fabsf(featherJoinCornerTheta) / kPi *
+                                  nonHelperSegmentCount),
+                           1.f,
+                           nonHelperSegmentCount - 1.f);
+            float backwardSegmentCount =
+                nonHelperSegmentCount - forwardSegmentCount;
+            if (joinVertexID <= backwardSegmentCount)
+            {
+                featherJoinCornerTheta =
+                    -(kPi * glsl_sign(featherJoinCornerTheta) -
+                      featherJoinCornerTheta);
+                joinSegmentCount = backwardSegmentCount;
+                if (joinVertexID == backwardSegmentCount)
+                    outset = -outset;
+            }
+            else if (joinVertexID == backwardSegmentCount + 1.f)
+            {
+                joinVertexID = 0;
+                joinSegmentCount = 0;
+                outset = 0;
+            }
+            else
+            {
+                joinVertexID -= backwardSegmentCount + 2.f;
+                joinSegmentCount = forwardSegmentCount;
+            }
+
+            if (joinVertexID == joinSegmentCount)
+            {
+                theta = featherJoinEdge1Theta;
+            }
+            else
+            {
+                theta = featherJoinEdge0Theta +
+                        featherJoinCornerTheta *
+                            (joinVertexID / joinSegmentCount);
+            }
+        }
+        else
+        {
+            theta = as_float(tessVertexData[2]);
+        }
+        float2 norm = float2{sinf(theta), -cosf(theta)};
+        float2 origin = load_float2(tessVertexData);
+        float2 postTransformVertexOffset = float2{0, 0};
+        float4 coverages;
+
+        if (featherRadius != 0)
+        {
+            featherRadius = std::max(featherRadius,
+                                     (FEATHER_TEXTURE_STDDEVS / 3.f) /
+                                         length(M * norm));
+        }
+
+        if (strokeRadius != 0)
+        {
+            outset *= glsl_sign(M.determinant());
+
+            if ((contourIDWithFlags & LEFT_JOIN_CONTOUR_FLAG) != 0)
+                outset = std::min(outset, 0.f);
+            if ((contourIDWithFlags & RIGHT_JOIN_CONTOUR_FLAG) != 0)
+                outset = std::max(outset, 0.f);
+
+            float aaRadius = featherRadius != 0
+                                 ? featherRadius
+                                 : manhattanPixelWidth(M, norm) * kAARadius;
+            float globalCoverage = 1;
+            if (aaRadius > strokeRadius && featherRadius == 0)
+            {
+                globalCoverage = strokeRadius / aaRadius;
+                strokeRadius = aaRadius;
+            }
+
+            float2 vertexOffset = norm * (strokeRadius + aaRadius);
+
+            float x = outset * (strokeRadius + aaRadius);
+            float2 xy =
+                (1.f / (aaRadius * 2.f)) * (float2{x, -x} + strokeRadius) + .5f;
+            coverages = float4{xy.x, xy.y, 0, 0};
+
+            uint32_t joinType = contourIDWithFlags & JOIN_TYPE_MASK;
+            if (joinType > ROUND_JOIN_CONTOUR_FLAG)
+            {
+                int peekDir = 2;
+                if ((contourIDWithFlags & JOIN_TANGENT_0_CONTOUR_FLAG) == 0)
+                    peekDir = -peekDir;
+                if ((contourIDWithFlags & MIRRORED_CONTOUR_CONTOUR_FLAG) != 0)
+                    peekDir = -peekDir;
+                const uint32_t* otherJoinData =
+                    tessTexel(tessVertexIdx + peekDir);
+                float otherJoinTheta = as_float(otherJoinData[2]);
+                float joinAngle = fabsf(otherJoinTheta - theta);
+                if (joinAngle > kPi)
+                    joinAngle = k2Pi - joinAngle;
+                bool isTan0 =
+                    (contourIDWithFlags & JOIN_TANGENT_0_CONTOUR_FLAG) != 0;
+                bool isLeftJoin =
+                    (contourIDWithFlags & LEFT_JOIN_CONTOUR_FLAG) != 0;
+                float bisectTheta =
+                    joinAngle * (isTan0 == isLeftJoin ? -.5f : .5f) + theta;
+                float2 bisector =
+                    float2{sinf(bisectTheta), -cosf(bisectTheta)};
+                float bisectPixelWidth = manhattanPixelWidth(M, bisector);
+
+                float miterRatio = cosf(joinAngle * .5f);
+                float clipRadius;
+                if ((joinType == MITER_CLIP_JOIN_CONTOUR_FLAG) ||
+                    (joinType == MITER_REVERT_JOIN_CONTOUR_FLAG &&
+                     miterRatio >= .25f))
+                {
+                    float miterInverseLimit =
+                        (contourIDWithFlags &
+                         EMULATED_STROKE_CAP_CONTOUR_FLAG) != 0
+                            ? 1.f
+                            : .25f;
+                    clipRadius = strokeRadius *
+                                 (1.f / std::max(miterRatio, miterInverseLimit));
+                }
+                else
+                {
+                    clipRadius =
+                        strokeRadius * miterRatio + bisectPixelWidth * .5f;
+                }
+                float clipAARadius = clipRadius + bisectPixelWidth * kAARadius;
+                if ((contourIDWithFlags & JOIN_TANGENT_INNER_CONTOUR_FLAG) != 0)
+                {
+                    float strokeAARaidus = strokeRadius + aaRadius;
+                    float slop = aaRadius * .125f;
+                    if (strokeAARaidus <= clipAARadius * miterRatio + slop)
+                    {
+                        float miterAARadius =
+                            strokeAARaidus * (1.f / miterRatio);
+                        vertexOffset = bisector * miterAARadius;
+                    }
+                    else
+                    {
+                        float2 bisectAAOffset = bisector * clipAARadius;
+                        float2 k =
+                            float2{simd::dot(vertexOffset, vertexOffset),
+                                   simd::dot(bisectAAOffset, bisectAAOffset)};
+                        vertexOffset = Mat2x2(vertexOffset, bisectAAOffset)
+                                           .rowTimesInverse(k);
+                    }
+                }
+                float2 pt = fabsf(outset) * vertexOffset;
+                float clipDistance =
+                    (clipAARadius - simd::dot(pt, bisector)) /
+                    (bisectPixelWidth * (kAARadius * 2.f));
+                if ((contourIDWithFlags & LEFT_JOIN_CONTOUR_FLAG) != 0)
+                    coverages.y = clipDistance;
+                else
+                    coverages.x = clipDistance;
+            }
+
+            coverages.x *= globalCoverage;
+            coverages.y *= globalCoverage;
+            coverages.y = std::max(coverages.y, 1e-4f);
+            if (featherRadius != 0)
+            {
+                coverages.x = kFeatherCoverageBias - coverages.x;
+            }
+
+            postTransformVertexOffset = M * (outset * vertexOffset);
+
+            if (vertexType != STROKE_VERTEX)
+                return false;
+        }
+        else
+        {
+            coverages = float4{fillCoverage, -1, 0, 0};
+            if (featherRadius != 0)
+            {
+                coverages.y = kFeatherCoverageBias;
+                coverages.z = kHorizontalCotangentValue;
+                coverages.w = fillCoverage;
+                if (isFeatherJoin)
+                {
+                    if (featherJoinCornerTheta < 0)
+                    {
+                        featherJoinEdge0Theta += featherJoinCornerTheta;
+                        featherJoinCornerTheta = -featherJoinCornerTheta;
+                    }
+                    float spokeTheta = theta - featherJoinEdge0Theta;
+                    spokeTheta =
+                        glsl_mod(spokeTheta + kPiOver2, k2Pi) - kPiOver2;
+                    spokeTheta =
+                        std::clamp(spokeTheta, 0.f, featherJoinCornerTheta);
+                    if (spokeTheta > featherJoinCornerTheta * .5f)
+                    {
+                        spokeTheta = featherJoinCornerTheta - spokeTheta;
+                    }
+                    float2 spokeNorm =
+                        float2{sinf(spokeTheta), cosf(spokeTheta)};
+                    coverages = packFeatheredFillCoverages(featherJoinCornerTheta,
+                                                           spokeNorm,
+                                                           outset);
+                }
+                postTransformVertexOffset = M * ((outset * featherRadius) * norm);
+            }
+            else
+            {
+                float2 v = M.rowTimesInverse(outset * norm);
+                postTransformVertexOffset =
+                    float2{glsl_sign(v.x), glsl_sign(v.y)} * kAARadius;
+            }
+
+            if (((contourIDWithFlags & MIRRORED_CONTOUR_CONTOUR_FLAG) != 0) !=
+                ((contourIDWithFlags & NEGATE_PATH_FILL_COVERAGE_FLAG) != 0))
+            {
+                coverages.x = -coverages.x;
+            }
+
+            if (vertexType == FAN_MIDPOINT_VERTEX)
+                origin = midpoint;
+
+            if ((contourIDWithFlags & RETROFITTED_TRIANGLE_CONTOUR_FLAG) != 0 &&
+                vertexType != FAN_VERTEX)
+            {
+                return false;
+            }
+        }
+
+        out->position = M * origin + postTransformVertexOffset + translate;
+        out->coverages = coverages;
+        out->pathID = pathID;
+        return true;
+    }
+
+    static float manhattanPixelWidth(const Mat2x2& M, float2 normalized)
+    {
+        float2 v = M * normalized;
+        return (fabsf(v.x) + fabsf(v.y)) * (1.f / simd::dot(v, v));
+    }
+
+    static float4 packFeatheredFillCoverages(float cornerTheta,
+                                             float2 spokeNorm,
+                                             float outset)
+    {
+        float2 cornerLocalCoord = (1.f - spokeNorm * fabsf(outset)) * .5f;
+        float cotTheta, y0;
+        if (fabsf(cornerTheta - kPiOver2) < 1.f / kHorizontalCotangentThreshold)
+        {
+            cotTheta = 0;
+            y0 = 0;
+        }
+        else
+        {
+            float tanTheta = tanf(cornerTheta);
+            cotTheta = glsl_sign(kPiOver2 - cornerTheta) /
+                       std::max(fabsf(tanTheta), 1.f / kHorizontalCotangentValue);
+            y0 = cotTheta >= 0
+                     ? cornerLocalCoord.y - (1.f - cornerLocalCoord.x) * tanTheta
+                     : cornerLocalCoord.y + cornerLocalCoord.x * tanTheta;
+        }
+        return float4{std::max(cornerLocalCoord.x, 0.f) + kFeatherXCoordBias,
+                      -cornerLocalCoord.y + kFeatherCoverageBias,
+                      cotTheta,
+                      y0};
+    }
+
+    // Runs the vertex stage for one job and appends its triangles to "bin".
+    void runVertexJob(const VertexJob& job, TriangleBin* bin) const
+    {
+        const RasterBatch& batch = batches[job.batchIdx];
+        bin->triangles.clear();
+        bin->top = std::numeric_limits<int32_t>::max();
+        bin->bottom = std::numeric_limits<int32_t>::min();
+        int32_t rowLimit;
+        switch (batch.kind)
+        {
+            case RasterKind::atlasFill:
+            case RasterKind::atlasStroke:
+                rowLimit = batch.scissorBottom;
+                break;
+            default:
+                rowLimit = static_cast<int32_t>(renderTarget->height());
+                break;
+        }
+        auto emit = [&](float2 p0,
+                        float2 p1,
+                        float2 p2,
+                        float4 v0,
+                        float4 v1,
+                        float4 v2,
+                        uint32_t pathID,
+                        bool doubleSided) {
+            RasterTriangle tri;
+            if (setup_triangle(p0, p1, p2, v0, v1, v2, doubleSided, rowLimit, &tri))
+            {
+                tri.pathID = pathID;
+                bin->top = std::min(bin->top, tri.top);
+                bin->bottom = std::max(bin->bottom, tri.bottom);
+                bin->triangles.push_back(tri);
+            }
+        };
+
+        switch (batch.kind)
+        {
+            case RasterKind::pathPatches:
+            case RasterKind::atlasFill:
+            case RasterKind::atlasStroke:
+            {
+                const uint16_t* indices =
+                    impl->m_patchIndices + batch.patchBaseIndex;
+                uint32_t minVertex = ~0u, maxVertex = 0;
+                for (uint32_t i = 0; i < batch.patchIndexCount; ++i)
+                {
+                    minVertex = std::min<uint32_t>(minVertex, indices[i]);
+                    maxVertex = std::max<uint32_t>(maxVertex, indices[i]);
+                }
+                if (batch.patchIndexCount == 0)
+                {
+                    return;
+                }
+                bool isAtlas = batch.kind != RasterKind::pathPatches;
+                PathVertex vertices[kPatchVertexBufferCount];
+                bool valid[kPatchVertexBufferCount];
+                for (uint32_t instance = job.firstElement;
+                     instance < job.firstElement + job.elementCount;
+                     ++instance)
+                {
+                    for (uint32_t v = minVertex; v <= maxVertex; ++v)
+                    {
+                        valid[v] = unpackPathVertex(impl->m_patchVertices[v],
+                                                    instance,
+                                                    &vertices[v]);
+                        if (valid[v] && isAtlas)
+                        {
+                            // Transform into the atlas, like render_atlas.glsl.
+                            const float* path = pathFloats(vertices[v].pathID);
+                            vertices[v].position =
+                                vertices[v].position * path[9] +
+                                float2{path[10], path[11]};
+                        }
+                    }
+                    for (uint32_t i = 0; i + 2 < batch.patchIndexCount; i += 3)
+                    {
+                        uint16_t a = indices[i], b = indices[i + 1],
+                                 c = indices[i + 2];
+                        if (!valid[a] || !valid[b] || !valid[c])
+                        {
+                            continue;
+                        }
+                        emit(vertices[a].position,
+                             vertices[b].position,
+                             vertices[c].position,
+                             vertices[a].coverages,
+                             vertices[b].coverages,
+                             vertices[c].coverages,
+                             vertices[a].pathID,
+                             false);
+                    }
+                }
+                break;
+            }
+            case RasterKind::interiorTriangles:
+            case RasterKind::atlasBlit:
+            {
+                bool isAtlasBlit = batch.kind == RasterKind::atlasBlit;
+                for (uint32_t i = 0; i < job.elementCount; i += 3)
+                {
+                    const uint32_t* v =
+                        triangleVertices + (job.firstElement + i) * 3;
+                    uint32_t pathID = v[2] & 0xffffu;
+                    if (pathID >= desc->pathCount)
+                    {
+                        continue;
+                    }
+                    float weight =
+                        static_cast<float>(static_cast<int32_t>(v[2]) >> 16);
+                    float2 p[3];
+                    for (int j = 0; j < 3; ++j)
+                    {
+                        p[j] = load_float2(v + j * 3);
+                    }
+                    if (!isAtlasBlit)
+                    {
+                        const float* path = pathFloats(pathID);
+                        Mat2x2 M(path);
+                        float2 translate = float2{path[4], path[5]};
+                        for (float2& pt : p)
+                        {
+                            pt = M * pt + translate;
+                        }
+                    }
+                    float4 varyings = float4{weight, 0, 0, 0};
+                    emit(p[0],
+                         p[1],
+                         p[2],
+                         varyings,
+                         varyings,
+                         varyings,
+                         pathID,
+                         false);
+                }
+                break;
+            }
+            case RasterKind::imageMesh:
+            {
+                const float* uniforms = batch.imageDrawUniforms;
+                Mat2x2 M(uniforms);
+                float2 translate = float2{uniforms[4], uniforms[5]};
+                float2 textureSize =
+                    float2{static_cast<float>(batch.texture->width()),
+                           static_cast<float>(batch.texture->height())};
+                if (uniforms[20] != 0)
+                {
+                    // UVs get mapped into an atlas region before sampling.
+                    textureSize *= float2{uniforms[20], uniforms[21]};
+                }
+                for (uint32_t i = 0; i + 2 < job.elementCount; i += 3)
+                {
+                    float2 p[3], uv[3];
+                    for (int j = 0; j < 3; ++j)
+                    {
+                        uint16_t idx =
+                            batch.meshIndices[job.firstElement + i + j];
+                        p[j] = M * float2{batch.meshVertices[idx * 2],
+                                          batch.meshVertices[idx * 2 + 1]} +
+                               translate;
+                        uv[j] = float2{batch.meshUVs[idx * 2],
+                                       batch.meshUVs[idx * 2 + 1]};
+                    }
+                    // Pick a mip level from the UV derivatives, which are
+                    // constant across the triangle.
+                    float2 e1 = p[1] - p[0], e2 = p[2] - p[0];
+                    float area = determinant(e1, e2);
+                    float lod = 0;
+                    if (area != 0)
+                    {
+                        float2 d1 = (uv[1] - uv[0]) * textureSize;
+                        float2 d2 = (uv[2] - uv[0]) * textureSize;
+                        float2 dUVdx = (d1 * e2.y - d2 * e1.y) / area;
+                        float2 dUVdy = (d2 * e1.x - d1 * e2.x) / area;
+                        float rho = std::max(length(dUVdx), length(dUVdy));
+                        lod = rho > 0 ? log2f(rho) : 0;
+                    }
+                    emit(p[0],
+                         p[1],
+                         p[2],
+                         float4{uv[0].x, uv[0].y, lod, 0},
+                         float4{uv[1].x, uv[1].y, lod, 0},
+                         float4{uv[2].x, uv[2].y, lod, 0},
+                         0,
+                         true);
+                }
+                break;
+            }
+        }
+    }
+
+    float4 sampleGradient(float x, float row) const
+    {
+        uint32_t height = impl->m_gradTextureHeight;
+        if (height == 0)
+        {
+            return float4(0);
+        }
+        uint32_t y = static_cast<uint32_t>(
+            std::clamp(floor_to_int(row * static_cast<float>(height)),
+                       0,
+                       static_cast<int>(height) - 1));
+        const uint32_t* texels =
+            impl->m_gradTexture.data() + static_cast<size_t>(y) * kGradTextureWidth;
+        float u = x * kGradTextureWidth - .5f;
+        u = u > 0 ? std::min(u, kGradTextureWidth - 1.f) : 0.f;
+        uint32_t i = static_cast<uint32_t>(u);
+        uint32_t j = std::min(i + 1, kGradTextureWidth - 1);
+        float4 c0 = unpack_rgba8(texels[i]);
+        float4 c1 = unpack_rgba8(texels[j]);
+        return c0 + (c1 - c0) * (u - static_cast<float>(i));
+    }
+
+    // Port of find_paint_color(). Colors are premultiplied, unless the paint
+    // has an advanced blend mode, in which case rgb is unmultiplied.
+    float4 findPaintColor(const PathPaint& paint,
+                          const RasterBatch& batch,
+                          float coverage,
+                          float2 fragCoord) const
+    {
+        bool premultiplied = paint.blendMode == BLEND_SRC_OVER;
+        if (paint.paintType == SOLID_COLOR_PAINT_TYPE)
+        {
+            float4 color = paint.color;
+            if (premultiplied)
+                color *= coverage;
+            else
+                color.w *= coverage;
+            return color;
+        }
+        const float* aux = paint.aux;
+        float2 paintCoord = Mat2x2(aux) * fragCoord + float2{aux[4], aux[5]};
+        if (paint.paintType == LINEAR_GRADIENT_PAINT_TYPE ||
+            paint.paintType == RADIAL_GRADIENT_PAINT_TYPE)
+        {
+            float t = paint.paintType == LINEAR_GRADIENT_PAINT_TYPE
+                          ? paintCoord.x
+                          : length(paintCoord);
+            t = clamp01(t);
+            float x = aux[6] > .9f ? (1.f - 1.f / kGradTextureWidth) * t +
+                                         (.5f / kGradTextureWidth)
+                                   : (1.f / kGradTextureWidth) * t + aux[7];
+            float4 color = sampleGradient(x, paint.paintValue);
+            color.w *= coverage;
+            if (premultiplied)
+            {
+                color.x *= color.w;
+                color.y *= color.w;
+                color.z *= color.w;
+            }
+            return color;
+        }
+        // IMAGE_PAINT_TYPE.
+        if (batch.texture == nullptr)
+        {
+            return float4(0);
+        }
+        float4 color = batch.texture->sample(paintCoord, aux[6], batch.sampler);
+        float opacity = paint.paintValue * coverage;
+        if (premultiplied)
+            return color * opacity;
+        color = unmultiply(color);
+        color.w *= opacity;
+        return color;
+    }
+
+    // Runs the draw_path fragment shader (rasterOrdering) across one span.
+    template <RasterKind Kind>
+    void shadePathSpan(const RasterBatch& batch,
+                       const RasterTriangle& tri,
+                       int32_t py,
+                       int32_t x0,
+                       int32_t x1) const
+    {
+        const PathPaint& paint = paints[tri.pathID];
+        const float* path = pathFloats(tri.pathID);
+        uint32_t width = renderTarget->width();
+        size_t rowIdx = static_cast<size_t>(py) * width;
+        uint32_t* colorPlane = renderTarget->m_pixels.get() + rowIdx;
+        uint32_t* scratchPlane = renderTarget->m_scratchColor.get() + rowIdx;
+        RenderTargetCPU::CoverageTexel* coveragePlane =
+            renderTarget->m_coverage.get() + rowIdx;
+        RenderTargetCPU::CoverageTexel* clipPlane =
+            renderTarget->m_clip.get() + rowIdx;
+        uint32_t pathID = tri.pathID;
+        bool isClipUpdate = paint.paintType == CLIP_UPDATE_PAINT_TYPE;
+        float4 coverages = varyings_at(tri, x0, py);
+        float2 fragCoord = float2{static_cast<float>(x0) + .5f,
+                                  static_cast<float>(py) + .5f};
+        for (int32_t px = x0; px < x1;
+             ++px, coverages += tri.ddx, fragCoord.x += 1)
+        {
+            float coverage;
+            bool firstHit = true;
+            if constexpr (Kind == RasterKind::atlasBlit)
+            {
+                float2 atlasCoord =
+                    fragCoord * path[9] + float2{path[10], path[11]};
+                coverage = filterFeatherAtlas(atlasCoord);
+            }
+            else
+            {
+                RenderTargetCPU::CoverageTexel& coverageTexel =
+                    coveragePlane[px];
+                firstHit = coverageTexel.id != pathID;
+                float coverageCount = firstHit ? 0.f : coverageTexel.value;
+                if constexpr (Kind == RasterKind::interiorTriangles)
+                {
+                    coverageCount += tri.varyings.x;
+                }
+                else
+                {
+                    if (coverages.y >= 0) // Stroke.
+                    {
+                        float fragCoverage =
+                            coverages.x < kFeatherCoverageThreshold
+                                ? evalFeatheredStroke(coverages)
+                                : std::min(coverages.x, coverages.y);
+                        coverageCount = std::max(fragCoverage, coverageCount);
+                    }
+                    else // Fill.
+                    {
+                        float fragCoverage =
+                            coverages.y < kFeatherCoverageThreshold
+                                ? evalFeatheredFill(coverages)
+                                : coverages.x;
+                        coverageCount += fragCoverage;
+                    }
+                    coverageTexel = {coverageCount, pathID};
+                }
+                if (batch.clockwiseFill)
+                {
+                    coverage = clamp01(coverageCount);
+                }
+                else
+                {
+                    coverage = fabsf(coverageCount);
+                    if (paint.evenOdd)
+                    {
+                        float f = coverage * .5f;
+                        coverage = 1.f - fabsf((f - floorf(f)) * 2.f - 1.f);
+                    }
+                    coverage = std::min(coverage, 1.f);
+                }
+            }
+
+            if (isClipUpdate)
+            {
+                if (paint.outerClipID != 0)
+                {
+                    RenderTargetCPU::CoverageTexel clipData = clipPlane[px];
+                    float outerClipCoverage;
+                    if (clipData.id != paint.clipID)
+                    {
+                        outerClipCoverage = clipData.id == paint.outerClipID
+                                                ? clipData.value
+                                                : 0.f;
+                        if constexpr (Kind == RasterKind::pathPatches)
+                        {
+                            scratchPlane[px] =
+                                pack_rgba8(float4{outerClipCoverage, 0, 0, 0});
+                        }
+                    }
+                    else
+                    {
+                        outerClipCoverage = unpack_rgba8(scratchPlane[px]).x;
+                    }
+                    coverage = std::min(coverage, outerClipCoverage);
+                }
+                clipPlane[px] = {coverage, paint.clipID};
+                continue;
+            }
+
+            if (paint.clipID != 0)
+            {
+                RenderTargetCPU::CoverageTexel clipData = clipPlane[px];
+                coverage = clipData.id == paint.clipID
+                               ? std::min(clipData.value, coverage)
+                               : 0.f;
+            }
+            if (paint.hasClipRect)
+            {
+                float clipRectCoverage =
+                    clip_rect_coverage(paint.aux + 8, paint.aux + 12, fragCoord);
+                coverage = std::clamp(clipRectCoverage, 0.f, coverage);
+            }
+
+            float4 color = findPaintColor(paint, batch, coverage, fragCoord);
+
+            uint32_t dstPacked;
+            if (firstHit)
+            {
+                dstPacked = colorPlane[px];
+                if constexpr (Kind == RasterKind::pathPatches)
+                {
+                    scratchPlane[px] = dstPacked;
+                }
+            }
+            else
+            {
+                dstPacked = scratchPlane[px];
+            }
+            float4 dstColorPremul = unpack_rgba8(dstPacked);
+
+            if (paint.blendMode != BLEND_SRC_OVER)
+            {
+                color = advanced_color_blend(color, dstColorPremul, paint.blendMode);
+                color.x *= color.w;
+                color.y *= color.w;
+                color.z *= color.w;
+            }
+            color += dstColorPremul * (1.f - color.w);
+            colorPlane[px] = pack_rgba8(color);
+        }
+    }
+
+    // Runs the draw_image_mesh fragment shader (rasterOrdering) across one
+    // span.
+    void shadeImageMeshSpan(const RasterBatch& batch,
+                            const RasterTriangle& tri,
+                            int32_t py,
+                            int32_t x0,
+                            int32_t x1) const
+    {
+        const float* uniforms = batch.imageDrawUniforms;
+        float opacity = uniforms[6];
+        uint32_t clipID = math::bit_cast<uint32_t>(uniforms[14]);
+        uint32_t blendMode = math::bit_cast<uint32_t>(uniforms[15]);
+        bool hasClipRect = uniforms[8] != 0 || uniforms[9] != 0 ||
+                           uniforms[10] != 0 || uniforms[11] != 0 ||
+                           uniforms[12] != 0 || uniforms[13] != 0;
+        bool isAtlased = uniforms[20] != 0;
+        float2 atlasScale = float2{uniforms[20], uniforms[21]};
+        float2 atlasTranslate = float2{uniforms[22], uniforms[23]};
+        size_t rowIdx = static_cast<size_t>(py) * renderTarget->width();
+        uint32_t* colorPlane = renderTarget->m_pixels.get() + rowIdx;
+        const RenderTargetCPU::CoverageTexel* clipPlane =
+            renderTarget->m_clip.get() + rowIdx;
+        float4 varyings = varyings_at(tri, x0, py);
+        float2 fragCoord = float2{static_cast<float>(x0) + .5f,
+                                  static_cast<float>(py) + .5f};
+        for (int32_t px = x0; px < x1;
+             ++px, varyings += tri.ddx, fragCoord.x += 1)
+        {
+            float2 texCoord = varyings.xy;
+            if (isAtlased)
+            {
+                texCoord = simd::clamp(texCoord, float2(0), float2(1)) *
+                               atlasScale +
+                           atlasTranslate;
+            }
+            float4 color =
+                batch.texture->sample(texCoord, tri.varyings.z, batch.sampler);
+            float coverage = 1;
+            if (hasClipRect)
+            {
+                coverage = std::clamp(
+                    clip_rect_coverage(uniforms + 8, uniforms + 12, fragCoord),
+                    0.f,
+                    coverage);
+            }
+            if (clipID != 0)
+            {
+                RenderTargetCPU::CoverageTexel clipData = clipPlane[px];
+                coverage = std::min(
+                    coverage,
+                    clipData.id == clipID ? clipData.value : 0.f);
+            }
+            float4 dstColorPremul = unpack_rgba8(colorPlane[px]);
+            if (blendMode != BLEND_SRC_OVER)
+            {
+                float4 blended = advanced_color_blend(unmultiply(color),
+                                                      dstColorPremul,
+                                                      blendMode);
+                color.x = blended.x * color.w;
+                color.y = blended.y * color.w;
+                color.z = blended.z * color.w;
+            }
+            color *= opacity * coverage;
+            color += dstColorPremul * (1.f - color.w);
+            colorPlane[px] = pack_rgba8(color);
+        }
+    }
+
+    // Runs the render_atlas fragment shaders across one span.
+    template <RasterKind Kind>
+    void shadeAtlasSpan(const RasterTriangle& tri,
+                        int32_t py,
+                        int32_t x0,
+                        int32_t x1) const
+    {
+        float* row = const_cast<float*>(impl->m_atlasTexture.data()) +
+                     static_cast<size_t>(py) * impl->m_atlasTextureWidth;
+        float4 coverages = varyings_at(tri, x0, py);
+        for (int32_t px = x0; px < x1; ++px, coverages += tri.ddx)
+        {
+            if constexpr (Kind == RasterKind::atlasFill)
+            {
+                row[px] += evalFeatheredFill(coverages);
+            }
+            else
+            {
+                row[px] = std::max(row[px], evalFeatheredStroke(coverages));
+            }
+        }
+    }
+
+    // Shades every triangle of "batch" that touches rows [rowBegin, rowEnd).
+    void rasterizeBatch(const RasterBatch& batch,
+                        int32_t rowBegin,
+                        int32_t rowEnd) const
+    {
+        int32_t colBegin = 0;
+        int32_t colEnd = static_cast<int32_t>(renderTarget->width());
+        if (batch.kind == RasterKind::atlasFill ||
+            batch.kind == RasterKind::atlasStroke)
+        {
+            colBegin = batch.scissorLeft;
+            colEnd = batch.scissorRight;
+            rowBegin = std::max(rowBegin, batch.scissorTop);
+            rowEnd = std::min(rowEnd, batch.scissorBottom);
+        }
+        for (uint32_t b = batch.firstBin; b < batch.firstBin + batch.binCount;
+             ++b)
+        {
+            const TriangleBin& bin = bins[b];
+            if (bin.bottom <= rowBegin || bin.top >= rowEnd)
+            {
+                continue;
+            }
+            for (const RasterTriangle& tri : bin.triangles)
+            {
+                switch (batch.kind)
+                {
+                    case RasterKind::pathPatches:
+                        scan_convert(tri,
+                                     rowBegin,
+                                     rowEnd,
+                                     colBegin,
+                                     colEnd,
+                                     [&](int32_t py, int32_t x0, int32_t x1) {
+                                         shadePathSpan<RasterKind::pathPatches>(
+                                             batch,
+                                             tri,
+                                             py,
+                                             x0,
+                                             x1);
+                                     });
+                        break;
+                    case RasterKind::interiorTriangles:
+                        scan_convert(
+                            tri,
+                            rowBegin,
+                            rowEnd,
+                            colBegin,
+                            colEnd,
+                            [&](int32_t py, int32_t x0, int32_t x1) {
+                                shadePathSpan<RasterKind::interiorTriangles>(
+                                    batch,
+                                    tri,
+                                    py,
+                                    x0,
+                                    x1);
+                            });
+                        break;
+                    case RasterKind::atlasBlit:
+                        scan_convert(tri,
+                                     rowBegin,
+                                     rowEnd,
+                                     colBegin,
+                                     colEnd,
+                                     [&](int32_t py, int32_t x0, int32_t x1) {
+                                         shadePathSpan<RasterKind::atlasBlit>(
+                                             batch,
+                                             tri,
+                                             py,
+                                             x0,
+                                             x1);
+                                     });
+                        break;
+                    case RasterKind::imageMesh:
+                        scan_convert(tri,
+                                     rowBegin,
+                                     rowEnd,
+                                     colBegin,
+                                     colEnd,
+                                     [&](int32_t py, int32_t x0, int32_t x1) {
+                                         shadeImageMeshSpan(batch,
+                                                            tri,
+                                                            py,
+                                                            x0,
+                                                            x1);
+                                     });
+                        break;
+                    case RasterKind::atlasFill:
+                        scan_convert(tri,
+                                     rowBegin,
+                                     rowEnd,
+                                     colBegin,
+                                     colEnd,
+                                     [&](int32_t py, int32_t x0, int32_t x1) {
+                                         shadeAtlasSpan<RasterKind::atlasFill>(
+                                             tri,
+                                             py,
+                                             x0,
+                                             x1);
+                                     });
+                        break;
+                    case RasterKind::atlasStroke:
+                        scan_convert(
+                            tri,
+                            rowBegin,
+                            rowEnd,
+                            colBegin,
+                            colEnd,
+                            [&](int32_t py, int32_t x0, int32_t x1) {
+                                shadeAtlasSpan<RasterKind::atlasStroke>(tri,
+                                                                        py,
+                                                                        x0,
+                                                                        x1);
+                            });
+                        break;
+                }
+            }
+        }
+    }
+
+    // Splits "batch" into vertex jobs and records it.
+    void pushBatch(RasterBatch batch, uint32_t baseElement, uint32_t elementCount)
+    {
+        uint32_t elementsPerJob;
+        switch (batch.kind)
+        {
+            case RasterKind::pathPatches:
+            case RasterKind::atlasFill:
+            case RasterKind::atlasStroke:
+                elementsPerJob = kPatchesPerVertexJob;
+                break;
+            default:
+                elementsPerJob = kTrianglesPerVertexJob * 3;
+                break;
+        }
+        batch.firstBin = static_cast<uint32_t>(vertexJobs.size());
+        uint32_t batchIdx = static_cast<uint32_t>(batches.size());
+        for (uint32_t i = 0; i < elementCount; i += elementsPerJob)
+        {
+            vertexJobs.push_back(
+                {batchIdx, baseElement + i, std::min(elementsPerJob, elementCount - i)});
+        }
+        batch.binCount =
+            static_cast<uint32_t>(vertexJobs.size()) - batch.firstBin;
+        batches.push_back(batch);
+    }
+
+    // Runs the vertex jobs for every recorded batch, then rasterizes them in
+    // bands of rows [0, height). prepareBand and finishBand (if any) run on
+    // each band before and after its batches.
+    void execute(WorkerPool* pool,
+                 uint32_t height,
+                 const std::function<void(int32_t, int32_t)>& prepareBand,
+                 const std::function<void(int32_t, int32_t)>& finishBand)
+    {
+        if (bins.size() < vertexJobs.size())
+        {
+            bins.resize(vertexJobs.size());
+        }
+        pool->run(vertexJobs.size(),
+                  [&](size_t i) { runVertexJob(vertexJobs[i], &bins[i]); });
+        size_t bandCount = (height + kBandHeight - 1) / kBandHeight;
+        pool->run(bandCount, [&](size_t band) {
+            int32_t rowBegin = static_cast<int32_t>(band) * kBandHeight;
+            int32_t rowEnd =
+                std::min(rowBegin + kBandHeight, static_cast<int32_t>(height));
+            if (prepareBand)
+            {
+                prepareBand(rowBegin, rowEnd);
+            }
+            for (const RasterBatch& batch : batches)
+            {
+                rasterizeBatch(batch, rowBegin, rowEnd);
+            }
+            if (finishBand)
+            {
+                finishBand(rowBegin, rowEnd);
+            }
+        });
+        batches.clear();
+        vertexJobs.clear();
+    }
+};
+
+std::unique_ptr<RenderContext> RenderContextCPUImpl::MakeContext(
+    const ContextOptions& contextOptions)
+{
+    return std::make_unique<RenderContext>(std::unique_ptr<RenderContextCPUImpl>(
+        new RenderContextCPUImpl(contextOptions)));
+}
+
+RenderContextCPUImpl::RenderContextCPUImpl(
+    const ContextOptions& contextOptions) :
+    m_flushState(std::make_unique<FlushState>())
+{
+    m_platformFeatures.supportsRasterOrdering = true;
+    m_platformFeatures.clipSpaceBottomUp = false;
+    m_platformFeatures.framebufferBottomUp = false;
+    m_platformFeatures.preservesGradientTexture = true;
+    m_platformFeatures.maxTextureSize = 16384;
+
+    uint32_t threadCount = contextOptions.threadCount;
+    if (threadCount == 0)
+    {
+        threadCount = std::max(std::thread::hardware_concurrency(), 1u);
+    }
+    m_workerPool = std::make_unique<WorkerPool>(threadCount - 1);
+
+    GeneratePatchBufferData(m_patchVertices, m_patchIndices);
+
+    for (uint32_t i = 0; i < GAUSSIAN_TABLE_SIZE; i += 4)
+    {
+        simd::store(m_featherTable + i,
+                    cast_f16_to_f32(simd::load<uint16_t, 4>(
+                        g_gaussianIntegralTableF16 + i)));
+        simd::store(m_inverseFeatherTable + i,
+                    cast_f16_to_f32(simd::load<uint16_t, 4>(
+                        g_inverseGaussianIntegralTableF16 + i)));
+    }
+}
+
+RenderContextCPUImpl::~RenderContextCPUImpl() {}
+
+rcp<RenderBuffer> RenderContextCPUImpl::makeRenderBuffer(
+    RenderBufferType type,
+    RenderBufferFlags flags,
+    size_t sizeInBytes)
+{
+    return make_rcp<RenderBufferCPUImpl>(type, flags, sizeInBytes);
+}
+
+rcp<Texture> RenderContextCPUImpl::makeImageTexture(
+    uint32_t width,
+    uint32_t height,
+    uint32_t mipLevelCount,
+    const uint8_t imageDataRGBAPremul[])
+{
+    return make_rcp<TextureCPUImpl>(width,
+                                    height,
+                                    mipLevelCount,
+                                    imageDataRGBAPremul);
+}
+
+std::unique_ptr<BufferRing> RenderContextCPUImpl::makeUniformBufferRing(
+    size_t capacityInBytes)
+{
+    return std::make_unique<HeapBufferRing>(capacityInBytes);
+}
+
+std::unique_ptr<BufferRing> RenderContextCPUImpl::makeStorageBufferRing(
+    size_t capacityInBytes,
+    gpu::StorageBufferStructure)
+{
+    return std::make_unique<HeapBufferRing>(capacityInBytes);
+}
+
+std::unique_ptr<BufferRing> RenderContextCPUImpl::makeVertexBufferRing(
+    size_t capacityInBytes)
+{
+    return std::make_unique<HeapBufferRing>(capacityInBytes);
+}
+
+void RenderContextCPUImpl::resizeGradientTexture(uint32_t width,
+                                                 uint32_t height)
+{
+    assert(width == 0 || width == kGradTextureWidth);
+    m_gradTextureHeight = width == 0 ? 0 : height;
+    // Rows are contiguous, so resizing keeps every row that still fits. (We
+    // advertise PlatformFeatures::preservesGradientTexture.)
+    m_gradTexture.resize(static_cast<size_t>(kGradTextureWidth) *
+                         m_gradTextureHeight);
+}
+
+void RenderContextCPUImpl::resizeTessellationTexture(uint32_t width,
+                                                     uint32_t height)
+{
+    assert(width == 0 || width == kTessTextureWidth);
+    m_tessTextureHeight = width == 0 ? 0 : height;
+    m_tessTexture.assign(kTessTextureWidth * m_tessTextureHeight * 4, 0);
+}
+
+void RenderContextCPUImpl::resizeAtlasTexture(uint32_t width, uint32_t height)
+{
+    m_atlasTextureWidth = width;
+    m_atlasTextureHeight = height;
+    m_atlasTexture.assign(static_cast<size_t>(width) * height, 0);
+}
+
+static const uint8_t* heap_buffer_contents(const BufferRing* bufferRing)
+{
+    return bufferRing != nullptr
+               ? static_cast<const HeapBufferRing*>(bufferRing)->contents()
+               : nullptr;
+}
+
+// Port of color_ramp.glsl. Each span is three horizontal rectangles: an
+// optional solid border on the left, the ramp itself, and an optional solid
+// border on the right.
+void RenderContextCPUImpl::renderGradientSpans(const FlushState& state)
+{
+    const FlushDescriptor& desc = *state.desc;
+    size_t jobCount = (desc.gradSpanCount + kSpansPerJob - 1) / kSpansPerJob;
+    m_workerPool->run(jobCount, [&](size_t job) {
+        uint32_t first = static_cast<uint32_t>(job) * kSpansPerJob;
+        uint32_t end = std::min(first + kSpansPerJob, desc.gradSpanCount);
+        for (uint32_t i = first; i < end; ++i)
+        {
+            const GradientSpan& span = state.gradSpans[i];
+            uint32_t row = span.yWithFlags & ~GRAD_SPAN_FLAGS_MASK;
+            if (row >= m_gradTextureHeight)
+            {
+                continue;
+            }
+            float x0 = static_cast<float>(span.horizontalSpan & 0xffffu) /
+                       65536.f * kGradTextureWidth;
+            float x1 = static_cast<float>(span.horizontalSpan >> 16) /
+                       65536.f * kGradTextureWidth;
+            float left = x0, right = x1;
+            if (span.yWithFlags & GRAD_SPAN_FLAG_LEFT_BORDER)
+            {
+                left = (span.yWithFlags & GRAD_SPAN_FLAG_COMPLEX_BORDER)
+                           ? 0.f
+                           : x0 - 1.f;
+            }
+            if (span.yWithFlags & GRAD_SPAN_FLAG_RIGHT_BORDER)
+            {
+                right = (span.yWithFlags & GRAD_SPAN_FLAG_COMPLEX_BORDER)
+                            ? static_cast<float>(kGradTextureWidth)
+                            : x1 + 1.f;
+            }
+            float4 color0 = unpack_rgba8(color_int_to_rgba8(span.color0));
+            float4 color1 = unpack_rgba8(color_int_to_rgba8(span.color1));
+            uint32_t* texels =
+                m_gradTexture.data() + static_cast<size_t>(row) * kGradTextureWidth;
+            // Cover pixel centers in [left, right).
+            int begin = std::max(static_cast<int>(ceilf(left - .5f)), 0);
+            int endX = std::min(static_cast<int>(ceilf(right - .5f)),
+                                static_cast<int>(kGradTextureWidth));
+            for (int px = begin; px < endX; ++px)
+            {
+                float center = static_cast<float>(px) + .5f;
+                float4 color;
+                if (center < x0)
+                {
+                    color = color0;
+                }
+                else if (center >= x1)
+                {
+                    color = color1;
+                }
+                else
+                {
+                    color = color0 + (color1 - color0) * ((center - x0) / (x1 - x0));
+                }
+                texels[px] = pack_rgba8(color);
+            }
+        }
+    });
+}
+
+// Port of tessellate.glsl. Each span covers the texels of one row, and its
+// optional reflection covers another row right to left.
+void RenderContextCPUImpl::renderTessellationSpans(const FlushState& state)
+{
+    const FlushDescriptor& desc = *state.desc;
+    size_t jobCount =
+        (desc.tessVertexSpanCount + kSpansPerJob - 1) / kSpansPerJob;
+    m_workerPool->run(jobCount, [&](size_t job) {
+        uint32_t first = static_cast<uint32_t>(job) * kSpansPerJob;
+        uint32_t end = std::min(first + kSpansPerJob, desc.tessVertexSpanCount);
+        for (uint32_t i = first; i < end; ++i)
+        {
+            const TessVertexSpan& span = state.tessSpans[i];
+            float2 p0 = float2{span.pts[0].x, span.pts[0].y};
+            float2 p1 = float2{span.pts[1].x, span.pts[1].y};
+            float2 p2 = float2{span.pts[2].x, span.pts[2].y};
+            float2 p3 = float2{span.pts[3].x, span.pts[3].y};
+
+            uint32_t parametricSegmentCount = span.segmentCounts & 0x3ffu;
+            uint32_t polarSegmentCount = (span.segmentCounts >> 10) & 0x3ffu;
+            uint32_t joinSegmentCount = span.segmentCounts >> 20;
+            uint32_t contourIDWithFlags = span.contourIDWithFlags;
+            uint32_t contourID = contourIDWithFlags & CONTOUR_ID_MASK;
+            uint32_t pathID = 0;
+            if (contourID > 0 && contourID <= desc.contourCount)
+            {
+                pathID = state.contourData[(contourID - 1) * 4 + 2];
+            }
+            float strokeRadius = 0, featherRadius = 0;
+            if (pathID != 0 && pathID < desc.pathCount)
+            {
+                strokeRadius = state.pathFloats(pathID)[6];
+                featherRadius = state.pathFloats(pathID)[7];
+            }
+
+            if (featherRadius != 0 && strokeRadius == 0)
+            {
+                // Soften the curvature of feathered fills.
+                float maxHeightT;
+                float height =
+                    find_cubic_max_height(p0, p1, p2, p3, &maxHeightT);
+                float oneStddev = featherRadius * (1.f / FEATHER_TEXTURE_STDDEVS);
+                float curvature = measure_cubic_local_curvature(p0,
+                                                                p1,
+                                                                p2,
+                                                                p3,
+                                                                maxHeightT,
+                                                                oneStddev);
+                float dimming = 1.f - curvature * (1.f / kPi);
+                float stddevsPow2 =
+                    simd::dot(p3 - p0, p3 - p0) / (oneStddev * oneStddev);
+                float dimmingByStddevs = (stddevsPow2 - 1.f) * .5f;
+                dimming = std::min(dimming, dimmingByStddevs);
+                dimming = std::min(dimming, .99f);
+                float desiredOpacityOnCenter = .5f * dimming;
+                float x =
+                    state.inverseFeather(desiredOpacityOnCenter) * -2.f + 1.f;
+                float softness = clamped_divide(x * featherRadius, height);
+                p1 = lerp(p1, lerp(p0, p3, 1.f / 3.f), softness);
+                p2 = lerp(p2, lerp(p0, p3, 2.f / 3.f), softness);
+            }
+
+            if (contourIDWithFlags &
+                CULL_EXCESS_TESSELLATION_SEGMENTS_CONTOUR_FLAG)
+            {
+                Mat2x2 M(state.pathFloats(pathID < desc.pathCount ? pathID : 0));
+                float2 d0 = M * (-2.f * p1 + p2 + p0);
+                float2 d1 = M * (-2.f * p2 + p3 + p1);
+                float m = std::max(simd::dot(d0, d0), simd::dot(d1, d1));
+                float n = std::max(ceilf(sqrtf(.75f * 4.f * sqrtf(m))), 1.f);
+                parametricSegmentCount = std::min(
+                    static_cast<uint32_t>(n),
+                    parametricSegmentCount);
+            }
+
+            uint32_t totalVertexCount =
+                parametricSegmentCount + polarSegmentCount + joinSegmentCount - 1;
+
+            float2 tangents[2];
+            find_cubic_tangents(p0, p1, p2, p3, tangents);
+            float theta = acosf(cosine_between_vectors(tangents[0], tangents[1]));
+            float radsPerPolarSegment =
+                theta / static_cast<float>(polarSegmentCount);
+            float turn = determinant(p2 - p0, p3 - p1);
+            if (turn == 0)
+                turn = determinant(tangents[0], tangents[1]);
+            if (turn < 0)
+                radsPerPolarSegment = -radsPerPolarSegment;
+
+            float2 joinTangent = float2{span.joinTangent.x, span.joinTangent.y};
+            float radsPerJoinSegment = 0;
+            if (joinSegmentCount > 1)
+            {
+                float joinTheta =
+                    acosf(cosine_between_vectors(tangents[1], joinTangent));
+                float joinSpan = static_cast<float>(joinSegmentCount);
+                if ((contourIDWithFlags &
+                     (JOIN_TYPE_MASK | EMULATED_STROKE_CAP_CONTOUR_FLAG)) ==
+                    (ROUND_JOIN_CONTOUR_FLAG | EMULATED_STROKE_CAP_CONTOUR_FLAG))
+                {
+                    joinSpan -= 2.f;
+                }
+                radsPerJoinSegment = joinTheta / joinSpan;
+                if (determinant(tangents[1], joinTangent) < 0)
+                    radsPerJoinSegment = -radsPerJoinSegment;
+            }
+
+            for (int reflection = 0; reflection < 2; ++reflection)
+            {
+                float y = reflection == 0 ? span.y : span.reflectionY;
+                int32_t x0x1 = reflection == 0 ? span.x0x1 : span.reflectionX0X1;
+                if (!(y >= 0 && y < static_cast<float>(m_tessTextureHeight)))
+                {
+                    // Discarded (NaN), or offscreen.
+                    continue;
+                }
+                int32_t x0 = static_cast<int32_t>(
+                    static_cast<uint32_t>(x0x1) << 16) >> 16;
+                int32_t x1 = x0x1 >> 16;
+                uint32_t flags = contourIDWithFlags;
+                if (x1 < x0)
+                {
+                    flags |= MIRRORED_CONTOUR_CONTOUR_FLAG;
+                }
+                uint32_t* rowTexels = m_tessTexture.data() +
+                                      static_cast<size_t>(y) * kTessTextureWidth * 4;
+                int32_t begin = std::max(std::min(x0, x1), 0);
+                int32_t endX = std::min(std::max(x0, x1),
+                                        static_cast<int32_t>(kTessTextureWidth));
+                for (int32_t px = begin; px < endX; ++px)
+                {
+                    float vertexIdx =
+                        static_cast<float>(totalVertexCount) -
+                        fabsf(static_cast<float>(x1) - (static_cast<float>(px) + .5f));
+                    tessellateVertex(p0,
+                                     p1,
+                                     p2,
+                                     p3,
+                                     tangents,
+                                     std::max(floorf(vertexIdx), 0.f),
+                                     static_cast<float>(totalVertexCount),
+                                     static_cast<float>(parametricSegmentCount),
+                                     static_cast<float>(joinSegmentCount),
+                                     radsPerPolarSegment,
+                                     joinTangent,
+                                     radsPerJoinSegment,
+                                     flags,
+                                     rowTexels + px * 4);
+                }
+            }
+        }
+    });
+}
+
+void RenderContextCPUImpl::renderAtlas(FlushState& state)
+{
+    const FlushDescriptor& desc = *state.desc;
+    if (desc.atlasFillBatchCount == 0 && desc.atlasStrokeBatchCount == 0)
+    {
+        return;
+    }
+    auto pushAtlasBatches = [&](const AtlasDrawBatch* atlasBatches,
+                                size_t count,
+                                RasterKind kind) {
+        for (size_t i = 0; i < count; ++i)
+        {
+            const AtlasDrawBatch& atlasBatch = atlasBatches[i];
+            RasterBatch batch{};
+            batch.kind = kind;
+            if (kind == RasterKind::atlasFill)
+            {
+                batch.patchBaseIndex = kMidpointFanCenterAAPatchBaseIndex;
+                batch.patchIndexCount = kMidpointFanCenterAAPatchIndexCount;
+            }
+            else
+            {
+                batch.patchBaseIndex = kMidpointFanPatchBaseIndex;
+                batch.patchIndexCount = kMidpointFanPatchBorderIndexCount;
+            }
+            batch.scissorLeft = atlasBatch.scissor.left;
+            batch.scissorTop = atlasBatch.scissor.top;
+            batch.scissorRight = std::min<int32_t>(atlasBatch.scissor.right,
+                                                   m_atlasTextureWidth);
+            batch.scissorBottom = std::min<int32_t>(atlasBatch.scissor.bottom,
+                                                    m_atlasTextureHeight);
+            state.pushBatch(batch, atlasBatch.basePatch, atlasBatch.patchCount);
+        }
+    };
+    pushAtlasBatches(desc.atlasFillBatches,
+                     desc.atlasFillBatchCount,
+                     RasterKind::atlasFill);
+    pushAtlasBatches(desc.atlasStrokeBatches,
+                     desc.atlasStrokeBatchCount,
+                     RasterKind::atlasStroke);
+
+    uint32_t contentWidth =
+        std::min<uint32_t>(desc.atlasContentWidth, m_atlasTextureWidth);
+    uint32_t contentHeight =
+        std::min<uint32_t>(desc.atlasContentHeight, m_atlasTextureHeight);
+    auto atlasRow = [&](int32_t y) {
+        return m_atlasTexture.data() +
+               static_cast<size_t>(y) * m_atlasTextureWidth;
+    };
+    state.execute(
+        m_workerPool.get(),
+        contentHeight,
+        [&](int32_t rowBegin, int32_t rowEnd) {
+            for (int32_t y = rowBegin; y < rowEnd; ++y)
+            {
+                std::fill(atlasRow(y), atlasRow(y) + contentWidth, 0.f);
+            }
+        },
+        [&](int32_t rowBegin, int32_t rowEnd) {
+            // Blits bilerp in linear space. Convert each texel once here
+            // instead of four times per blitted pixel.
+            for (int32_t y = rowBegin; y < rowEnd; ++y)
+            {
+                float* row = atlasRow(y);
+                for (uint32_t x = 0; x < contentWidth; ++x)
+                {
+                    row[x] = state.inverseFeather(row[x]);
+                }
+            }
+        });
+}
+
+void RenderContextCPUImpl::renderDrawList(FlushState& state)
+{
+    const FlushDescriptor& desc = *state.desc;
+    RenderTargetCPU* renderTarget = state.renderTarget;
+
+    for (const DrawBatch& drawBatch : *desc.drawList)
+    {
+        RasterBatch batch{};
+        batch.clockwiseFill =
+            desc.clockwiseFillOverride ||
+            (drawBatch.drawContents & DrawContents::clockwiseFill);
+        batch.texture = static_cast<const TextureCPUImpl*>(drawBatch.imageTexture);
+        batch.sampler = drawBatch.imageSampler;
+        switch (drawBatch.drawType)
+        {
+            case DrawType::midpointFanPatches:
+            case DrawType::midpointFanCenterAAPatches:
+            case DrawType::outerCurvePatches:
+                batch.kind = RasterKind::pathPatches;
+                batch.patchBaseIndex = PatchBaseIndex(drawBatch.drawType);
+                batch.patchIndexCount = PatchIndexCount(drawBatch.drawType);
+                break;
+            case DrawType::interiorTriangulation:
+                batch.kind = RasterKind::interiorTriangles;
+                break;
+            case DrawType::atlasBlit:
+                batch.kind = RasterKind::atlasBlit;
+                break;
+            case DrawType::imageMesh:
+            {
+                if (batch.texture == nullptr)
+                {
+                    continue;
+                }
+                batch.kind = RasterKind::imageMesh;
+                batch.imageDrawUniforms = reinterpret_cast<const float*>(
+                    state.imageDrawUniforms + drawBatch.imageDrawDataOffset);
+                LITE_RTTI_CAST_OR_BREAK(vertexBuffer,
+                                        RenderBufferCPUImpl*,
+                                        drawBatch.vertexBuffer);
+                LITE_RTTI_CAST_OR_BREAK(uvBuffer,
+                                        RenderBufferCPUImpl*,
+                                        drawBatch.uvBuffer);
+                LITE_RTTI_CAST_OR_BREAK(indexBuffer,
+                                        RenderBufferCPUImpl*,
+                                        drawBatch.indexBuffer);
+                batch.meshVertices =
+                    reinterpret_cast<const float*>(vertexBuffer->contents());
+                batch.meshUVs =
+                    reinterpret_cast<const float*>(uvBuffer->contents());
+                batch.meshIndices =
+                    reinterpret_cast<const uint16_t*>(indexBuffer->contents());
+                state.pushBatch(batch,
+                                drawBatch.baseElement,
+                                drawBatch.elementCount);
+                continue;
+            }
+            case DrawType::imageRect:
+            case DrawType::msaaStrokes:
+            case DrawType::msaaMidpointFanBorrowedCoverage:
+            case DrawType::msaaMidpointFans:
+            case DrawType::msaaMidpointFanStencilReset:
+            case DrawType::msaaMidpointFanPathsStencil:
+            case DrawType::msaaMidpointFanPathsCover:
+            case DrawType::msaaOuterCubics:
+            case DrawType::msaaStencilClipReset:
+            case DrawType::atomicInitialize:
+            case DrawType::atomicResolve:
+                // The CPU backend only implements rasterOrdering.
+                assert(false);
+                continue;
+        }
+        state.pushBatch(batch, drawBatch.baseElement, drawBatch.elementCount);
+    }
+
+    uint32_t clearColor = desc.colorLoadAction == LoadAction::clear
+                              ? SwizzleRiveColorToRGBAPremul(desc.colorClearValue)
+                              : 0;
+    IAABB updateBounds = desc.renderTargetUpdateBounds;
+    int32_t width = static_cast<int32_t>(renderTarget->width());
+    int32_t clearLeft = std::clamp(updateBounds.left, 0, width);
+    int32_t clearRight = std::clamp(updateBounds.right, clearLeft, width);
+    state.execute(
+        m_workerPool.get(),
+        renderTarget->height(),
+        [&](int32_t rowBegin, int32_t rowEnd) {
+            for (int32_t y = rowBegin; y < rowEnd; ++y)
+            {
+                size_t rowIdx = static_cast<size_t>(y) * width;
+                if (desc.colorLoadAction == LoadAction::clear)
+                {
+                    std::fill(renderTarget->m_pixels.get() + rowIdx,
+                              renderTarget->m_pixels.get() + rowIdx + width,
+                              clearColor);
+                }
+                if (y >= updateBounds.top && y < updateBounds.bottom)
+                {
+                    // Path and clip IDs restart every flush.
+                    std::fill(renderTarget->m_coverage.get() + rowIdx + clearLeft,
+                              renderTarget->m_coverage.get() + rowIdx + clearRight,
+                              RenderTargetCPU::CoverageTexel{0, 0});
+                    std::fill(renderTarget->m_clip.get() + rowIdx + clearLeft,
+                              renderTarget->m_clip.get() + rowIdx + clearRight,
+                              RenderTargetCPU::CoverageTexel{0, 0});
+                }
+            }
+        },
+        nullptr);
+}
+
+void RenderContextCPUImpl::flush(const FlushDescriptor& desc)
+{
+    assert(desc.interlockMode == InterlockMode::rasterOrdering);
+    auto renderTarget = static_cast<RenderTargetCPU*>(desc.renderTarget);
+    renderTarget->allocatePLSPlanes();
+
+    FlushState& state = *m_flushState;
+    state.impl = this;
+    state.desc = &desc;
+    state.renderTarget = renderTarget;
+    state.pathData = reinterpret_cast<const uint32_t*>(
+                         heap_buffer_contents(pathBufferRing())) +
+                     desc.firstPath * 16;
+    state.paintData = reinterpret_cast<const uint32_t*>(
+                          heap_buffer_contents(paintBufferRing())) +
+                      desc.firstPaint * 2;
+    state.paintAuxData = reinterpret_cast<const float*>(
+                             heap_buffer_contents(paintAuxBufferRing())) +
+                         desc.firstPaintAux * 16;
+    state.contourData = reinterpret_cast<const uint32_t*>(
+                            heap_buffer_contents(contourBufferRing())) +
+                        desc.firstContour * 4;
+    state.gradSpans = reinterpret_cast<const GradientSpan*>(
+                          heap_buffer_contents(gradSpanBufferRing())) +
+                      desc.firstGradSpan;
+    state.tessSpans = reinterpret_cast<const TessVertexSpan*>(
+                          heap_buffer_contents(tessSpanBufferRing())) +
+                      desc.firstTessVertexSpan;
+    state.triangleVertices = reinterpret_cast<const uint32_t*>(
+        heap_buffer_contents(triangleBufferRing()));
+    state.imageDrawUniforms =
+        heap_buffer_contents(imageDrawUniformBufferRing());
+
+    // Decode paints once per path, the way the vertex shader would.
+    state.paints.resize(desc.pathCount);
+    for (uint32_t pathID = 0; pathID < desc.pathCount; ++pathID)
+    {
+        PathPaint& paint = state.paints[pathID];
+        uint32_t params = state.paintData[pathID * 2];
+        uint32_t value = state.paintData[pathID * 2 + 1];
+        paint.paintType = params & 0xfu;
+        paint.blendMode = (params >> 4) & 0xfu;
+        paint.evenOdd = (params & PAINT_FLAG_EVEN_ODD_FILL) != 0;
+        paint.hasClipRect = (params & PAINT_FLAG_HAS_CLIP_RECT) != 0;
+        paint.aux = state.paintAuxData + pathID * 16;
+        if (paint.paintType == CLIP_UPDATE_PAINT_TYPE)
+        {
+            paint.clipID = value >> 16;
+            paint.outerClipID = params >> 16;
+        }
+        else
+        {
+            paint.clipID = params >> 16;
+            paint.outerClipID = 0;
+        }
+        paint.color = unpack_rgba8(value);
+        if (paint.blendMode == BLEND_SRC_OVER)
+        {
+            paint.color.x *= paint.color.w;
+            paint.color.y *= paint.color.w;
+            paint.color.z *= paint.color.w;
+        }
+        paint.paintValue = as_float(value);
+    }
+
+    if (desc.gradSpanCount > 0)
+    {
+        renderGradientSpans(state);
+    }
+    if (desc.tessVertexSpanCount > 0)
+    {
+        renderTessellationSpans(state);
+    }
+    renderAtlas(state);
+    renderDrawList(state);
+}
+} // namespace rive::gpu
@@ -11,6 +11,8 @@
 #include "rive/math/wangs_formula.hpp"
 #include "rive/renderer/texture.hpp"
 #include "gradient.hpp"
+#include "tessellation_cache.hpp"
+#include "triangulation_cache.hpp"
 #include "shaders/constants.glsl"
 #include "rive/profiler/profiler_macros.h"
 
@@ -39,6 +41,20 @@ static uint32_t find_outer_cubic_subdivision_count(
         math::clamp(numSubdivisions, 1, kMaxCurveSubdivisions));
 }
 
+// Paths with fewer verbs than this are faster to process again than to look up
+// in the TessellationCache or TriangulationCache.
+constexpr static size_t kMinCachedPathVerbCount = 8;
+
+// GrInnerFanTriangulator emits triangles with the winding of its path. Negate
+// them if the matrix flips the path, or if the draw negates its coverage.
+static bool should_negate_interior_winding(const Mat2D& matrix,
+                                           uint32_t contourFlags)
+{
+    float matrixDeterminant = matrix[0] * matrix[3] - matrix[2] * matrix[1];
+    return (matrixDeterminant < 0) !=
+           static_cast<bool>(contourFlags & NEGATE_PATH_FILL_COVERAGE_FLAG);
+}
+
 constexpr static int NUM_SEGMENTS_IN_MITER_OR_BEVEL_JOIN = 5;
 constexpr static int STROKE_OR_FEATHER_STYLE_FLAG = 8;
 constexpr static int ROUND_JOIN_STYLE_FLAG = STROKE_OR_FEATHER_STYLE_FLAG << 1;
@@ -751,6 +767,30 @@ void PathDraw::initForMidpointFan(RenderContext* context,
         m_strokeCap = paint->getCap();
     }
 
+    // Reuse the results from a previous frame if this exact path has been
+    // drawn with the same matrix scale/skew and stroke. Small paths are faster
+    // to process again than to look up.
+    TessellationCache* tessellationCache = context->m_tessellationCache.get();
+    TessellationCache::Key cacheKey;
+    bool shouldCache = false;
+    if (tessellationCache != nullptr &&
+        m_pathRef->getRawPath().verbs().size() >= kMinCachedPathVerbCount)
+    {
+        cacheKey = TessellationCache::Key(
+            m_pathRef->getRawPathMutationID(),
+            m_matrix,
+            m_strokeRadius,
+            m_featherRadius,
+            isStrokeOrFeather() ? m_strokeJoin : StrokeJoin::miter,
+            isStrokeOrFeather() ? m_strokeCap : StrokeCap::butt);
+        if (const MidpointFanData* cachedData =
+                tessellationCache->find(cacheKey, &shouldCache))
+        {
+            loadMidpointFanData(context, *cachedData);
+            return;
+        }
+    }
+
     // Count up how much temporary storage this function will need to reserve in
     // CPU buffers.
     const RawPath& rawPath = m_pathRef->getRawPath();
@@ -1309,12 +1349,31 @@ void PathDraw::initForMidpointFan(RenderContext* context,
     }
 
     assert(contourFirstLineIdx == lineCount);
-    RIVE_DEBUG_CODE(m_pendingLineCount = lineCount);
-    RIVE_DEBUG_CODE(m_pendingCurveCount = unpaddedCurveCount);
-    RIVE_DEBUG_CODE(m_pendingRotationCount = unpaddedRotationCount);
-    RIVE_DEBUG_CODE(m_pendingEmptyStrokeCountForCaps = emptyStrokeCountForCaps);
+    MidpointFanCounts counts = {lineCount,
+                                unpaddedCurveCount,
+                                unpaddedRotationCount,
+                                emptyStrokeCountForCaps,
+                                tessVertexCount};
+    finishMidpointFanInit(contourCount, counts);
+
+    if (shouldCache)
+    {
+        MidpointFanData data;
+        saveMidpointFanData(contourCount, counts, &data);
+        tessellationCache->insert(cacheKey, std::move(data));
+    }
+}
 
-    if (tessVertexCount > 0)
+void PathDraw::finishMidpointFanInit(size_t contourCount,
+                                     const MidpointFanCounts& counts)
+{
+    RIVE_DEBUG_CODE(m_pendingLineCount = counts.lineCount);
+    RIVE_DEBUG_CODE(m_pendingCurveCount = counts.unpaddedCurveCount);
+    RIVE_DEBUG_CODE(m_pendingRotationCount = counts.unpaddedRotationCount);
+    RIVE_DEBUG_CODE(m_pendingEmptyStrokeCountForCaps =
+                        counts.emptyStrokeCountForCaps);
+
+    if (counts.tessVertexCount > 0)
     {
         m_resourceCounts.pathCount = 1;
         m_resourceCounts.contourCount = contourCount;
@@ -1322,14 +1381,102 @@ void PathDraw::initForMidpointFan(RenderContext* context,
         // forward and mirrored contours because the forward and mirrored pair
         // both get packed into a single gpu::TessVertexSpan.
         m_resourceCounts.maxTessellatedSegmentCount =
-            lineCount + unpaddedCurveCount + emptyStrokeCountForCaps;
+            counts.lineCount + counts.unpaddedCurveCount +
+            counts.emptyStrokeCountForCaps;
         m_resourceCounts.midpointFanTessVertexCount =
             gpu::ContourDirectionsAreDoubleSided(m_contourDirections)
-                ? tessVertexCount * 2
-                : tessVertexCount;
+                ? counts.tessVertexCount * 2
+                : counts.tessVertexCount;
     }
 }
 
+size_t PathDraw::MidpointFanData::sizeInBytes() const
+{
+    return sizeof(MidpointFanData) + contours.size() * sizeof(ContourInfo) +
+           numChops.size() * sizeof(uint8_t) +
+           chopVertices.size() * sizeof(Vec2D) +
+           tangentPairs.size() * sizeof(std::array<Vec2D, 2>) +
+           polarSegmentCounts.size() * sizeof(uint32_t) +
+           parametricSegmentCounts.size() * sizeof(uint32_t);
+}
+
+// Copies the contents of "src" into a new allocation from "allocator".
+template <typename T, size_t Align>
+static T* alloc_copy(TrivialArrayAllocator<T, Align>& allocator,
+                     const std::vector<T>& src)
+{
+    T* dst = allocator.alloc(src.size());
+    if (!src.empty())
+    {
+        memcpy(dst, src.data(), src.size() * sizeof(T));
+    }
+    return dst;
+}
+
+void PathDraw::loadMidpointFanData(RenderContext* context,
+                                   const MidpointFanData& data)
+{
+    RIVE_PROF_SCOPE()
+    size_t contourCount = data.contours.size();
+    m_contours = reinterpret_cast<ContourInfo*>(
+        context->perFrameAllocator().alloc(sizeof(ContourInfo) * contourCount));
+    std::copy(data.contours.begin(), data.contours.end(), m_contours);
+
+    if (isStrokeOrFeather())
+    {
+        m_numChops.reset(context->numChopsAllocator(), data.numChops.size());
+        std::copy(data.numChops.begin(),
+                  data.numChops.end(),
+                  m_numChops.push_back_n(data.numChops.size()));
+        m_chopVertices.reset(context->chopVerticesAllocator(),
+                             data.chopVertices.size());
+        std::copy(data.chopVertices.begin(),
+                  data.chopVertices.end(),
+                  m_chopVertices.push_back_n(data.chopVertices.size()));
+        m_tangentPairs =
+            alloc_copy(context->tangentPairsAllocator(), data.tangentPairs);
+        m_polarSegmentCounts = alloc_copy(context->polarSegmentCountsAllocator(),
+                                          data.polarSegmentCounts);
+    }
+    m_parametricSegmentCounts =
+        alloc_copy(context->parametricSegmentCountsAllocator(),
+                   data.parametricSegmentCounts);
+
+    finishMidpointFanInit(contourCount, data.counts);
+}
+
+void PathDraw::saveMidpointFanData(size_t contourCount,
+                                   const MidpointFanCounts& counts,
+                                   MidpointFanData* data) const
+{
+    RIVE_PROF_SCOPE()
+    assert(contourCount > 0);
+    data->contours.assign(m_contours, m_contours + contourCount);
+    // The curve and rotation arrays are padded out to multiples of 4 at the
+    // end of each contour, so they end at the final contour's padding.
+    const ContourInfo& lastContour = m_contours[contourCount - 1];
+    size_t curveCount =
+        math::round_up_to_multiple_of<4>(lastContour.endCurveIdx);
+    data->parametricSegmentCounts.assign(m_parametricSegmentCounts,
+                                         m_parametricSegmentCounts +
+                                             curveCount);
+    if (isStrokeOrFeather())
+    {
+        data->numChops.assign(m_numChops.data(),
+                              m_numChops.data() + m_numChops.pushCount());
+        data->chopVertices.assign(m_chopVertices.data(),
+                                  m_chopVertices.data() +
+                                      m_chopVertices.pushCount());
+        size_t rotationCount =
+            math::round_up_to_multiple_of<4>(lastContour.endRotationIdx);
+        data->tangentPairs.assign(m_tangentPairs,
+                                  m_tangentPairs + rotationCount);
+        data->polarSegmentCounts.assign(m_polarSegmentCounts,
+                                        m_polarSegmentCounts + rotationCount);
+    }
+    data->counts = counts;
+}
+
 void PathDraw::initForInteriorTriangulation(RenderContext* context,
                                             RawPath* scratchPath,
                                             TriangulatorAxis triangulatorAxis)
@@ -1339,16 +1486,58 @@ void PathDraw::initForInteriorTriangulation(RenderContext* context,
     assert(!isStrokeOrFeather());
     assert(m_strokeRadius == 0);
 
+    // Reuse the triangulation from a previous frame if this exact path has
+    // been drawn with the same matrix scale/skew. Otherwise the triangulator
+    // goes in the per-frame allocator, or in an arena of its own if it will be
+    // cached.
+    TriangulationCache* triangulationCache =
+        context->m_triangulationCache.get();
+    TriangulationCache::Key cacheKey;
+    bool shouldCache = false;
+    if (triangulationCache != nullptr &&
+        m_pathRef->getRawPath().verbs().size() >= kMinCachedPathVerbCount)
+    {
+        cacheKey = TriangulationCache::Key(
+            m_pathRef->getRawPathMutationID(),
+            m_matrix,
+            m_pathFillRule,
+            triangulatorAxis == TriangulatorAxis::horizontal,
+            should_negate_interior_winding(m_matrix, m_contourFlags));
+        m_triangulator = triangulationCache->find(cacheKey, &shouldCache);
+    }
+    std::unique_ptr<TrivialBlockAllocator> cacheArena;
+    if (shouldCache)
+    {
+        cacheArena = std::make_unique<TrivialBlockAllocator>(
+            GrTriangulator::kArenaDefaultChunkSize);
+    }
+
+    bool didHitCache = m_triangulator != nullptr;
+
     // Every path has at least 1 (non-cubic) move.
     size_t originalNumChopsSize = m_pathRef->getRawPath().verbs().size() - 1;
     m_numChops.reset(context->numChopsAllocator(), originalNumChopsSize);
     iterateInteriorTriangulation(
         InteriorTriangulationOp::countDataAndTriangulate,
-        &context->perFrameAllocator(),
+        shouldCache ? cacheArena.get() : &context->perFrameAllocator(),
         scratchPath,
         triangulatorAxis,
         nullptr);
     m_numChops.shrinkToFit(context->numChopsAllocator(), originalNumChopsSize);
+
+    if (shouldCache)
+    {
+        triangulationCache->insert(cacheKey,
+                                   std::move(cacheArena),
+                                   m_triangulator);
+    }
+    if (context->m_triangulationTrace != nullptr && !didHitCache)
+    {
+        context->m_triangulationTrace->push_back(
+            {*scratchPath,
+             m_triangulator->fillRule(),
+             triangulatorAxis == TriangulatorAxis::horizontal});
+    }
 }
 
 bool PathDraw::allocateResources(RenderContext::LogicalFlush* flush)
@@ -1781,15 +1970,20 @@ void PathDraw::pushTessellationData(RenderContext::LogicalFlush* flush,
             break;
     }
 
-    // Write out the TessVertexSpans and path contours.
-    RenderContext::TessellationWriter tessWriter(flush,
-                                                 m_pathID,
-                                                 m_contourDirections,
-                                                 forwardTessVertexCount,
-                                                 forwardTessLocation,
-                                                 mirroredTessVertexCount,
-                                                 mirroredTessLocation);
+    // Reserve the TessVertexSpans and path contours. They get written out
+    // later by writeTessellationData().
+    flush->pushTessellationJob(this,
+                               m_pathID,
+                               forwardTessVertexCount,
+                               forwardTessLocation,
+                               mirroredTessVertexCount,
+                               mirroredTessLocation);
+}
 
+void PathDraw::writeTessellationData(
+    RenderContext::TessellationWriter* tessWriter)
+{
+    RIVE_PROF_SCOPE()
     if (m_triangulator != nullptr)
     {
         iterateInteriorTriangulation(
@@ -1797,11 +1991,11 @@ void PathDraw::pushTessellationData(RenderContext::LogicalFlush* flush,
             nullptr,
             nullptr,
             TriangulatorAxis::dontCare,
-            &tessWriter);
+            tessWriter);
     }
     else
     {
-        pushMidpointFanTessellationData(&tessWriter);
+        pushMidpointFanTessellationData(tessWriter);
     }
 }
 
@@ -2384,26 +2578,26 @@ void PathDraw::iterateInteriorTriangulation(
 
     if (op == InteriorTriangulationOp::countDataAndTriangulate)
     {
-        assert(m_triangulator == nullptr);
-        assert(triangulatorAxis != TriangulatorAxis::dontCare);
-        m_triangulator = allocator->make<GrInnerFanTriangulator>(
-            *scratchPath,
-            m_matrix,
-            triangulatorAxis == TriangulatorAxis::horizontal
-                ? GrTriangulator::Comparator::Direction::kHorizontal
-                : GrTriangulator::Comparator::Direction::kVertical,
-            // clockwise and nonZero paths both get triangulated as nonZero,
-            // because clockwise fill still needs the backwards triangles for
-            // borrowed coverage.
-            m_pathFillRule == FillRule::evenOdd ? FillRule::evenOdd
-                                                : FillRule::nonZero,
-            allocator);
-        float matrixDeterminant =
-            m_matrix[0] * m_matrix[3] - m_matrix[2] * m_matrix[1];
-        if ((matrixDeterminant < 0) !=
-            static_cast<bool>(m_contourFlags & NEGATE_PATH_FILL_COVERAGE_FLAG))
+        if (m_triangulator == nullptr) // Not found in the TriangulationCache.
         {
-            m_triangulator->negateWinding();
+            assert(triangulatorAxis != TriangulatorAxis::dontCare);
+            auto* triangulator = allocator->make<GrInnerFanTriangulator>(
+                *scratchPath,
+                m_matrix,
+                triangulatorAxis == TriangulatorAxis::horizontal
+                    ? GrTriangulator::Comparator::Direction::kHorizontal
+                    : GrTriangulator::Comparator::Direction::kVertical,
+                // clockwise and nonZero paths both get triangulated as nonZero,
+                // because clockwise fill still needs the backwards triangles
+                // for borrowed coverage.
+                m_pathFillRule == FillRule::evenOdd ? FillRule::evenOdd
+                                                    : FillRule::nonZero,
+                allocator);
+            if (should_negate_interior_winding(m_matrix, m_contourFlags))
+            {
+                triangulator->negateWinding();
+            }
+            m_triangulator = triangulator;
         }
         // We also draw each "grout" triangle using an outerCubic patch.
         patchCount += m_triangulator->groutList().count();
@@ -2493,7 +2687,8 @@ ImageMeshDraw::ImageMeshDraw(IAABB pixelBounds,
                              rcp<RenderBuffer> uvBuffer,
                              rcp<RenderBuffer> indexBuffer,
                              uint32_t indexCount,
-                             float opacity) :
+                             float opacity,
+                             const Mat2D* atlasTransform) :
     Draw(pixelBounds,
          matrix,
          blendMode,
@@ -2505,11 +2700,16 @@ ImageMeshDraw::ImageMeshDraw(IAABB pixelBounds,
     m_uvBufferRef(uvBuffer.release()),
     m_indexBufferRef(indexBuffer.release()),
     m_indexCount(indexCount),
-    m_opacity(opacity)
+    m_opacity(opacity),
+    m_hasAtlasTransform(atlasTransform != nullptr),
+    m_atlasTransform(atlasTransform != nullptr ? *atlasTransform : Mat2D())
 {
     assert(m_vertexBufferRef != nullptr);
     assert(m_uvBufferRef != nullptr);
     assert(m_indexBufferRef != nullptr);
+    assert(atlasTransform == nullptr ||
+           (imageSampler.wrapX == ImageWrap::clamp &&
+            imageSampler.wrapY == ImageWrap::clamp));
     m_resourceCounts.imageDrawCount = 1;
 }
 
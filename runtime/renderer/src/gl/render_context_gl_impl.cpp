@@ -191,6 +191,11 @@ RenderContextGLImpl::RenderContextGLImpl(
         // to the screen on PowerVR; always go offscreen.
         m_platformFeatures.alwaysFeatherToAtlas = true;
     }
+    // The color ramp pass only draws the rows it renders, and resizes copy
+    // over the rows that still fit, so cached ramps survive between flushes.
+    // PowerVR is left out because its synchronization workaround writes the
+    // first texel of the gradient texture on every flush.
+    m_platformFeatures.preservesGradientTexture = !m_capabilities.isPowerVR;
     m_platformFeatures.clipSpaceBottomUp = true;
     m_platformFeatures.framebufferBottomUp = true;
 
@@ -842,10 +847,12 @@ std::unique_ptr<BufferRing> RenderContextGLImpl::makeVertexBufferRing(
 
 void RenderContextGLImpl::resizeGradientTexture(uint32_t width, uint32_t height)
 {
-    glDeleteTextures(1, &m_gradientTexture);
+    GLuint oldTexture = m_gradientTexture;
+    uint32_t oldHeight = m_gradientTextureHeight;
     if (width == 0 || height == 0)
     {
         m_gradientTexture = 0;
+        m_gradientTextureHeight = 0;
     }
     else
     {
@@ -854,14 +861,30 @@ void RenderContextGLImpl::resizeGradientTexture(uint32_t width, uint32_t height)
         glBindTexture(GL_TEXTURE_2D, m_gradientTexture);
         glTexStorage2D(GL_TEXTURE_2D, 1, GL_RGBA8, width, height);
         glutils::SetTexture2DSamplingParams(GL_LINEAR, GL_LINEAR);
+        m_gradientTextureHeight = height;
     }
 
     glBindFramebuffer(GL_FRAMEBUFFER, m_colorRampFBO);
+    if (m_platformFeatures.preservesGradientTexture && oldTexture != 0 &&
+        m_gradientTexture != 0)
+    {
+        // m_colorRampFBO still reads from the old texture. Copy the rows that
+        // still fit, since they may hold cached color ramps.
+        glCopyTexSubImage2D(GL_TEXTURE_2D,
+                            0,
+                            0,
+                            0,
+                            0,
+                            0,
+                            width,
+                            std::min(oldHeight, height));
+    }
     glFramebufferTexture2D(GL_FRAMEBUFFER,
                            GL_COLOR_ATTACHMENT0,
                            GL_TEXTURE_2D,
                            m_gradientTexture,
                            0);
+    glDeleteTextures(1, &oldTexture);
 }
 
 void RenderContextGLImpl::resizeTessellationTexture(uint32_t width,
@@ -1634,8 +1657,13 @@ void RenderContextGLImpl::flush(const FlushDescriptor& desc)
         m_state->bindBuffer(GL_ARRAY_BUFFER,
                             gl_buffer_id(gradSpanBufferRing()));
         m_state->bindVAO(m_colorRampVAO);
-        GLenum colorAttachment0 = GL_COLOR_ATTACHMENT0;
-        glInvalidateFramebuffer(GL_FRAMEBUFFER, 1, &colorAttachment0);
+        if (!m_platformFeatures.preservesGradientTexture)
+        {
+            GLenum colorAttachment0 = GL_COLOR_ATTACHMENT0;
+            glInvalidateFramebuffer(GL_FRAMEBUFFER, 1, &colorAttachment0);
+        }
+        // Otherwise, rows this flush doesn't render may hold color ramps that
+        // the GradientRampCache kept from earlier flushes.
         for (auto [instanceCount, baseInstance] : InstanceChunker(
                  desc.gradSpanCount,
                  math::lossless_numeric_cast<uint32_t>(desc.firstGradSpan),
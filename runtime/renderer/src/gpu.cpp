@@ -544,11 +544,9 @@ void PaintData::set(DrawContents singleDrawContents,
         case PaintType::radialGradient:
         {
             uint32_t row = simplePaintValue.colorRampLocation.row;
-            if (simplePaintValue.colorRampLocation.isComplex())
-            {
-                // Complex gradients rows are offset after the simple gradients.
-                row += gradTextureLayout.complexOffsetY;
-            }
+            row += simplePaintValue.colorRampLocation.isComplex()
+                       ? gradTextureLayout.complexOffsetY
+                       : gradTextureLayout.simpleOffsetY;
             m_gradTextureY = (static_cast<float>(row) + .5f) *
                              gradTextureLayout.inverseHeight;
             localParams |= shiftedClipID | shiftedBlendMode;
@@ -615,8 +613,8 @@ void PaintAuxData::set(const Mat2D& viewMatrix,
                 // mipmap level-of-detail is constant throughout the entire
                 // path. Compute it ahead of time here.
                 float dudx = paintMatrix.xx() * imageTexture->width();
-                float dudy = paintMatrix.yx() * imageTexture->height();
-                float dvdx = paintMatrix.xy() * imageTexture->width();
+                float dudy = paintMatrix.yx() * imageTexture->width();
+                float dvdx = paintMatrix.xy() * imageTexture->height();
                 float dvdy = paintMatrix.yy() * imageTexture->height();
                 float maxScaleFactorPow2 = std::max(dudx * dudx + dvdx * dvdx,
                                                     dudy * dudy + dvdy * dvdy);
@@ -703,7 +701,8 @@ ImageDrawUniforms::ImageDrawUniforms(
     const ClipRectInverseMatrix* clipRectInverseMatrix,
     uint32_t clipID,
     BlendMode blendMode,
-    uint32_t zIndex)
+    uint32_t zIndex,
+    const Mat2D* atlasTransform)
 {
     write_matrix(m_matrix, matrix);
     m_opacity = opacity;
@@ -714,6 +713,21 @@ ImageDrawUniforms::ImageDrawUniforms(
     m_clipID = clipID;
     m_blendMode = ConvertBlendModeToPLSBlendMode(blendMode);
     m_zIndex = zIndex;
+    if (atlasTransform != nullptr)
+    {
+        // Atlas regions are axis-aligned, so this is only a scale and a
+        // translate.
+        assert(atlasTransform->xy() == 0 && atlasTransform->yx() == 0);
+        m_atlasRegion[0] = atlasTransform->xx();
+        m_atlasRegion[1] = atlasTransform->yy();
+        m_atlasRegion[2] = atlasTransform->tx();
+        m_atlasRegion[3] = atlasTransform->ty();
+    }
+    else
+    {
+        m_atlasRegion[0] = m_atlasRegion[1] = 0;
+        m_atlasRegion[2] = m_atlasRegion[3] = 0;
+    }
 }
 
 std::tuple<uint32_t, uint32_t> StorageTextureSize(
@@ -0,0 +1,61 @@
+/*
+ * Copyright 2025 Rive
+ */
+
+#include "gradient_ramp_cache.hpp"
+
+#include "gradient.hpp"
+
+namespace rive::gpu
+{
+int32_t GradientRampCache::findOrAllocateRow(GradientContentKey&& key,
+                                             uint64_t flushSerial,
+                                             bool* needsRender)
+{
+    auto iter = m_rowIndices.find(key);
+    if (iter != m_rowIndices.end())
+    {
+        uint16_t rowIdx = iter->second;
+        Row& row = m_rows[rowIdx];
+        row.lastFlushSerial = flushSerial;
+        m_lru.splice(m_lru.begin(), m_lru, row.lruIter);
+        *needsRender = false;
+        return rowIdx;
+    }
+
+    uint16_t rowIdx;
+    if (m_rows.size() < kMaxRowCount)
+    {
+        rowIdx = static_cast<uint16_t>(m_rows.size());
+        m_lru.push_front(rowIdx);
+        m_rows.push_back({nullptr, 0, m_lru.begin()});
+    }
+    else
+    {
+        // Recycle the least recently used row, as long as the current logical
+        // flush doesn't reference it.
+        rowIdx = m_lru.back();
+        Row& row = m_rows[rowIdx];
+        if (row.lastFlushSerial == flushSerial)
+        {
+            return -1;
+        }
+        m_rowIndices.erase(GradientContentKey(ref_rcp(row.gradient)));
+        m_lru.splice(m_lru.begin(), m_lru, row.lruIter);
+    }
+
+    Row& row = m_rows[rowIdx];
+    row.gradient = key.gradient();
+    row.lastFlushSerial = flushSerial;
+    m_rowIndices.emplace(std::move(key), rowIdx);
+    *needsRender = true;
+    return rowIdx;
+}
+
+void GradientRampCache::clear()
+{
+    m_rowIndices.clear();
+    m_rows.clear();
+    m_lru.clear();
+}
+} // namespace rive::gpu
@@ -0,0 +1,60 @@
+/*
+ * Copyright 2025 Rive
+ */
+
+#pragma once
+
+#include "rive/renderer/render_context.hpp"
+
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+namespace rive::gpu
+{
+// LRU cache of complex color ramps that have already been rendered to the
+// gradient texture, for backends whose gradient texture keeps its contents
+// between flushes (PlatformFeatures::preservesGradientTexture).
+//
+// Every cached ramp owns one row at the top of the gradient texture, which it
+// keeps until it gets evicted, so gradients that appear frame after frame only
+// get rendered once.
+class GradientRampCache
+{
+public:
+    // Upper bound on the number of rows the cache reserves at the top of the
+    // gradient texture.
+    constexpr static uint32_t kMaxRowCount = 512;
+
+    // Returns the gradient texture row holding the color ramp for "key", and
+    // marks it as used by the logical flush "flushSerial". Sets "needsRender"
+    // if the row was just assigned and the caller has to render the ramp into
+    // it.
+    //
+    // Returns -1 if the cache is full and every row is used by "flushSerial".
+    // (Rows used by a logical flush can't be reassigned until a later one.)
+    int32_t findOrAllocateRow(GradientContentKey&&,
+                              uint64_t flushSerial,
+                              bool* needsRender);
+
+    // Number of rows at the top of the gradient texture that are reserved for
+    // cached ramps.
+    uint32_t rowCount() const { return static_cast<uint32_t>(m_rows.size()); }
+
+    void clear();
+
+private:
+    struct Row
+    {
+        const Gradient* gradient;
+        uint64_t lastFlushSerial;
+        std::list<uint16_t>::iterator lruIter;
+    };
+
+    std::unordered_map<GradientContentKey, uint16_t, DeepHashGradient>
+        m_rowIndices; // [colors[0..n], stops[0..n]] -> rowIdx
+    std::vector<Row> m_rows;
+    // Most recently used rows are at the front.
+    std::list<uint16_t> m_lru;
+};
+} // namespace rive::gpu
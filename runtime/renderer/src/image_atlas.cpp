@@ -0,0 +1,109 @@
+/*
+ * Copyright 2025 Rive
+ */
+
+#include "rive/renderer/image_atlas.hpp"
+
+#include "rive/math/math_types.hpp"
+#include "rive/renderer/render_context_impl.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace rive::gpu
+{
+ImageAtlasPage::ImageAtlasPage(uint32_t size) :
+    m_size(size),
+    // The rectanizer works in kAlignment x kAlignment cells, which keeps every
+    // region aligned for free.
+    m_rectanizer(size / ImageAtlas::kAlignment, size / ImageAtlas::kAlignment),
+    m_pixels(static_cast<size_t>(size) * size, 0)
+{}
+
+rcp<Texture> ImageAtlasPage::refTexture(RenderContextImpl* impl)
+{
+    if (m_dirty)
+    {
+        m_texture =
+            impl->makeImageTexture(m_size,
+                                   m_size,
+                                   ImageAtlas::kMipLevelCount,
+                                   reinterpret_cast<const uint8_t*>(
+                                       m_pixels.data()));
+        m_dirty = false;
+        if (m_sealed)
+        {
+            m_pixels = std::vector<uint32_t>();
+        }
+    }
+    return m_texture;
+}
+
+rcp<ImageAtlasPage> ImageAtlas::add(uint32_t width,
+                                    uint32_t height,
+                                    const uint8_t imageDataRGBAPremul[],
+                                    Mat2D* uvTransform)
+{
+    assert(CanAdd(width, height));
+    uint32_t slotWidth = math::round_up_to_multiple_of<kAlignment>(width) +
+                         kGutter * 2;
+    uint32_t slotHeight = math::round_up_to_multiple_of<kAlignment>(height) +
+                          kGutter * 2;
+    int16_t cellX, cellY;
+    if (m_currentPage == nullptr ||
+        !m_currentPage->m_rectanizer.addRect(slotWidth / kAlignment,
+                                             slotHeight / kAlignment,
+                                             &cellX,
+                                             &cellY))
+    {
+        if (m_currentPage != nullptr)
+        {
+            // Release the full page's pixels after its next upload.
+            m_currentPage->m_sealed = true;
+            if (!m_currentPage->m_dirty)
+            {
+                m_currentPage->m_pixels = std::vector<uint32_t>();
+            }
+        }
+        m_currentPage = make_rcp<ImageAtlasPage>(kPageSize);
+        ++m_pageCount;
+        bool fits = m_currentPage->m_rectanizer.addRect(slotWidth / kAlignment,
+                                                        slotHeight / kAlignment,
+                                                        &cellX,
+                                                        &cellY);
+        assert(fits);
+        (void)fits;
+    }
+
+    ImageAtlasPage* page = m_currentPage.get();
+    uint32_t slotX = static_cast<uint32_t>(cellX) * kAlignment;
+    uint32_t slotY = static_cast<uint32_t>(cellY) * kAlignment;
+    const uint32_t* src =
+        reinterpret_cast<const uint32_t*>(imageDataRGBAPremul);
+    // Fill the entire slot, clamping to the image's edges so the gutter and
+    // alignment padding replicate its border texels.
+    for (uint32_t y = 0; y < slotHeight; ++y)
+    {
+        uint32_t srcY = y < kGutter ? 0 : std::min(y - kGutter, height - 1);
+        const uint32_t* srcRow = src + static_cast<size_t>(srcY) * width;
+        uint32_t* dstRow = page->m_pixels.data() +
+                           static_cast<size_t>(slotY + y) * page->m_size +
+                           slotX;
+        std::fill(dstRow, dstRow + kGutter, srcRow[0]);
+        memcpy(dstRow + kGutter, srcRow, width * sizeof(uint32_t));
+        std::fill(dstRow + kGutter + width,
+                  dstRow + slotWidth,
+                  srcRow[width - 1]);
+    }
+    page->m_dirty = true;
+
+    float pageSize = static_cast<float>(page->m_size);
+    *uvTransform = Mat2D(width / pageSize,
+                         0,
+                         0,
+                         height / pageSize,
+                         (slotX + kGutter) / pageSize,
+                         (slotY + kGutter) / pageSize);
+    return m_currentPage;
+}
+} // namespace rive::gpu
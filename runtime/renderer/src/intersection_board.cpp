@@ -11,6 +11,11 @@
 // MSVC doesn't get codegen for the inner loop. Provide direct SSE intrinsics.
 #include <emmintrin.h>
 #define FALLBACK_ON_SSE2_INTRINSICS
+#if defined(__AVX2__)
+// Test 16 rectangles at a time when the build targets AVX2.
+#include <immintrin.h>
+#define FALLBACK_ON_AVX2_INTRINSICS
+#endif
 #else
 #endif
 
@@ -27,6 +32,7 @@ void IntersectionTile::reset(int left, int top, int16_t baselineGroupIndex)
     m_maxGroupIndex = baselineGroupIndex;
     m_edges.clear();
     m_groupIndices.clear();
+    m_chunkPrefixMaxGroupIndices.clear();
     m_rectangleCount = 0;
 }
 
@@ -34,8 +40,7 @@ void IntersectionTile::addRectangle(int4 ltrb, int16_t groupIndex)
 {
     assert(simd::all(ltrb.xy < ltrb.zw)); // Ensure ltrb isn't zero or negative.
     // Ensure this rectangle preserves the integrity of our list.
-    assert(groupIndex >
-           simd::reduce_max(findMaxIntersectingGroupIndex(ltrb, 0)));
+    assert(groupIndex > findMaxIntersectingGroupIndex(ltrb, 0));
     assert(groupIndex > m_baselineGroupIndex);
     assert(groupIndex >= 0);
 
@@ -67,6 +72,8 @@ void IntersectionTile::addRectangle(int4 ltrb, int16_t groupIndex)
         // intersection test.
         assert(m_groupIndices.size() * kChunkSize == m_rectangleCount);
         m_groupIndices.emplace_back();
+
+        m_chunkPrefixMaxGroupIndices.push_back(m_maxGroupIndex);
     }
 
     // m_edges is a list of 8 rectangles encoded as [L, T, 255 - R, 255 - B],
@@ -84,21 +91,31 @@ void IntersectionTile::addRectangle(int4 ltrb, int16_t groupIndex)
     m_groupIndices.back()[subIdx] = groupIndex;
 
     m_maxGroupIndex = std::max(groupIndex, m_maxGroupIndex);
+    m_chunkPrefixMaxGroupIndices.back() = m_maxGroupIndex;
     ++m_rectangleCount;
 }
 
-int16x8 IntersectionTile::findMaxIntersectingGroupIndex(
+int16_t IntersectionTile::findMaxIntersectingGroupIndex(
     int4 ltrb,
-    int16x8 runningMaxGroupIndices) const
+    int16_t runningMaxGroupIndex) const
 {
     assert(simd::all(ltrb.xy < ltrb.zw)); // Ensure ltrb isn't zero or negative.
 
     // Since we mask non-intersecting groupIndices to zero, the "mask and max"
-    // algorithm is only correct for positive values. (runningMaxGroupIndices is
+    // algorithm is only correct for positive values. (runningMaxGroupIndex is
     // only signed because SSE doesn't have an unsigned max instruction.)
-    assert(simd::all(runningMaxGroupIndices >= 0));
+    assert(runningMaxGroupIndex >= 0);
     assert(m_baselineGroupIndex >= 0);
     assert(m_maxGroupIndex >= m_baselineGroupIndex);
+    assert(m_chunkPrefixMaxGroupIndices.size() == m_groupIndices.size());
+
+    // Ensure we never drop below our baseline index.
+    runningMaxGroupIndex = std::max(runningMaxGroupIndex, m_baselineGroupIndex);
+    if (m_maxGroupIndex <= runningMaxGroupIndex)
+    {
+        // Nothing in this tile can raise the running max.
+        return runningMaxGroupIndex;
+    }
 
     // Translate ltrb to our tile and negate the left and top sides.
     ltrb -= m_topLeft;
@@ -110,9 +127,7 @@ int16x8 IntersectionTile::findMaxIntersectingGroupIndex(
     if (simd::all(ltrb == 255))
     {
         // ltrb covers the entire -- we know it intersects with every rectangle.
-        runningMaxGroupIndices[0] =
-            std::max(runningMaxGroupIndices[0], m_maxGroupIndex);
-        return runningMaxGroupIndices;
+        return m_maxGroupIndex;
     }
 
     // Intersection test: l0 < r1 &&
@@ -136,15 +151,16 @@ int16x8 IntersectionTile::findMaxIntersectingGroupIndex(
     int8x8 _l = biased.x; // Already converted to "255 - left" above.
     int8x8 _t = biased.y; // Already converted to "255 - top" above.
 
+    // Test chunks two at a time (16 rectangles), newest first, since newer
+    // rectangles have higher groupIndices. Stop once the remaining chunks can't
+    // beat the running max. An odd chunk count leaves chunk 0 for last, which
+    // gets tested against itself as a pair.
+    size_t chunkCount = m_groupIndices.size();
 #if !defined(FALLBACK_ON_SSE2_INTRINSICS)
-    auto edges = m_edges.begin();
-    auto groupIndices = m_groupIndices.begin();
-    assert(m_edges.size() == m_groupIndices.size());
     int8x32 complement = simd::join(r, b, _l, _t);
-    for (; edges != m_edges.end(); ++edges, ++groupIndices)
-    {
+    auto intersectingGroupIndices = [&](size_t i) {
         // Test 32 edges!
-        auto edgeMasks = *edges < complement;
+        auto edgeMasks = m_edges[i] < complement;
         // Since the transposed L,T,R,B rows are a each 64-bit vectors,
         // "and-reducing" them returns the intersection test (l0 < r1 && t0 < b1
         // && r0 > l1 && b0 > t1) in each byte.
@@ -160,9 +176,23 @@ int16x8 IntersectionTile::findMaxIntersectingGroupIndex(
             math::bit_cast<int16x8>(simd::zip(isectMasks8, isectMasks8));
         // Mask out any groupIndices we don't intersect with so they don't
         // participate in the test for maximum groupIndex.
-        int16x8 maskedGroupIndices = isectMasks16 & *groupIndices;
-        runningMaxGroupIndices =
-            simd::max(maskedGroupIndices, runningMaxGroupIndices);
+        return isectMasks16 & m_groupIndices[i];
+    };
+    for (size_t i = chunkCount; i > 0; i = i >= 2 ? i - 2 : 0)
+    {
+        if (m_chunkPrefixMaxGroupIndices[i - 1] <= runningMaxGroupIndex)
+        {
+            break;
+        }
+        int16x8 maskedGroupIndices =
+            simd::max(intersectingGroupIndices(i - 1),
+                      intersectingGroupIndices(i >= 2 ? i - 2 : 0));
+        if (simd::any(maskedGroupIndices != 0))
+        {
+            runningMaxGroupIndex =
+                std::max(simd::reduce_max(maskedGroupIndices),
+                         runningMaxGroupIndex);
+        }
     }
 #else
     // MSVC doesn't get good codegen for the above loop. Provide direct SSE
@@ -172,12 +202,15 @@ int16x8 IntersectionTile::findMaxIntersectingGroupIndex(
         reinterpret_cast<const __m128i*>(m_groupIndices.data());
     __m128i complementLO = math::bit_cast<__m128i>(simd::join(r, b));
     __m128i complementHI = math::bit_cast<__m128i>(simd::join(_l, _t));
-    __m128i localMaxGroupIndices =
-        math::bit_cast<__m128i>(runningMaxGroupIndices);
-    for (size_t i = 0; i < m_groupIndices.size(); ++i)
-    {
-        __m128i edgesLO = edgeData[i * 2];
-        __m128i edgesHI = edgeData[i * 2 + 1];
+#if defined(FALLBACK_ON_AVX2_INTRINSICS)
+    __m256i complement =
+        _mm256_inserti128_si256(_mm256_castsi128_si256(complementLO),
+                                complementHI,
+                                1);
+#endif
+    auto intersectingGroupIndices = [&](size_t i) {
+        __m128i edgesLO = _mm_loadu_si128(edgeData + i * 2);
+        __m128i edgesHI = _mm_loadu_si128(edgeData + i * 2 + 1);
         // Test 32 edges!
         __m128i edgeMasksLO = _mm_cmpgt_epi8(complementLO, edgesLO);
         __m128i edgeMasksHI = _mm_cmpgt_epi8(complementHI, edgesHI);
@@ -192,19 +225,66 @@ int16x8 IntersectionTile::findMaxIntersectingGroupIndex(
         __m128i isectMasks16 =
             _mm_and_si128(partialIsectMasksLR16, partialIsectMasksTB16);
         // Mask out the groupIndices that don't intersect.
-        __m128i intersectingGroupIndices =
-            _mm_and_si128(isectMasks16, groupIndices[i]);
-        // Accumulate max intersecting groupIndices.
-        localMaxGroupIndices =
-            _mm_max_epi16(intersectingGroupIndices, localMaxGroupIndices);
+        return _mm_and_si128(isectMasks16, _mm_loadu_si128(groupIndices + i));
+    };
+    for (size_t i = chunkCount; i > 0; i = i >= 2 ? i - 2 : 0)
+    {
+        if (m_chunkPrefixMaxGroupIndices[i - 1] <= runningMaxGroupIndex)
+        {
+            break;
+        }
+        __m128i maskedGroupIndices;
+#if defined(FALLBACK_ON_AVX2_INTRINSICS)
+        if (i >= 2)
+        {
+            // Test 64 edges! Chunk i - 2 lands in the low 128-bit lane and
+            // chunk i - 1 in the high lane.
+            const __m256i* edges256 =
+                reinterpret_cast<const __m256i*>(edgeData + (i - 2) * 2);
+            __m256i edgeMasks0 =
+                _mm256_cmpgt_epi8(complement, _mm256_loadu_si256(edges256));
+            __m256i edgeMasks1 =
+                _mm256_cmpgt_epi8(complement, _mm256_loadu_si256(edges256 + 1));
+            // Gather the [L, T] masks of both chunks, then the [-R, -B] masks.
+            __m256i edgeMasksLO =
+                _mm256_permute2x128_si256(edgeMasks0, edgeMasks1, 0x20);
+            __m256i edgeMasksHI =
+                _mm256_permute2x128_si256(edgeMasks0, edgeMasks1, 0x31);
+            __m256i partialIsectMasks =
+                _mm256_and_si256(edgeMasksLO, edgeMasksHI);
+            // Widen partial edge masks from 8 bits to 16 (within each lane).
+            __m256i isectMasks16 = _mm256_and_si256(
+                _mm256_unpacklo_epi8(partialIsectMasks, partialIsectMasks),
+                _mm256_unpackhi_epi8(partialIsectMasks, partialIsectMasks));
+            // The groupIndices of chunks i - 2 and i - 1 are contiguous.
+            __m256i intersectingGroupIndices = _mm256_and_si256(
+                isectMasks16,
+                _mm256_loadu_si256(
+                    reinterpret_cast<const __m256i*>(groupIndices + i - 2)));
+            maskedGroupIndices = _mm_max_epi16(
+                _mm256_castsi256_si128(intersectingGroupIndices),
+                _mm256_extracti128_si256(intersectingGroupIndices, 1));
+        }
+        else
+        {
+            maskedGroupIndices = intersectingGroupIndices(0);
+        }
+#else
+        maskedGroupIndices =
+            _mm_max_epi16(intersectingGroupIndices(i - 1),
+                          intersectingGroupIndices(i >= 2 ? i - 2 : 0));
+#endif
+        if (_mm_movemask_epi8(_mm_cmpeq_epi16(maskedGroupIndices,
+                                              _mm_setzero_si128())) != 0xffff)
+        {
+            runningMaxGroupIndex = std::max(
+                simd::reduce_max(math::bit_cast<int16x8>(maskedGroupIndices)),
+                runningMaxGroupIndex);
+        }
     }
-    runningMaxGroupIndices = math::bit_cast<int16x8>(localMaxGroupIndices);
 #endif // !FALLBACK_ON_SSE2_INTRINSICS
 
-    // Ensure we never drop below our baseline index.
-    runningMaxGroupIndices[0] =
-        std::max(runningMaxGroupIndices[0], m_baselineGroupIndex);
-    return runningMaxGroupIndices;
+    return runningMaxGroupIndex;
 }
 
 void IntersectionBoard::resizeAndReset(uint32_t viewportWidth,
@@ -250,21 +330,25 @@ int16_t IntersectionBoard::addRectangle(int4 ltrb, int16_t layerCount)
     span = simd::clamp(span, int4(0), int4{m_cols, m_rows, m_cols, m_rows} - 1);
     assert(simd::all(span.xy <= span.zw));
 
-    // Accumulate the max groupIndex from each tile the rectangle touches.
-    int16x8 maxGroupIndices = 0;
+    // Find the absolute max group index this rectangle intersects with, from
+    // each tile the rectangle touches. Tiles whose contents can't beat the
+    // running max are skipped without testing any of their rectangles.
+    int16_t maxIntersectingGroupIndex = 0;
     for (int y = span.y; y <= span.w; ++y)
     {
         auto tileIter = m_tiles.begin() + y * m_cols + span.x;
         for (int x = span.x; x <= span.z; ++x)
         {
-            maxGroupIndices =
-                tileIter->findMaxIntersectingGroupIndex(ltrb, maxGroupIndices);
+            if (tileIter->maxGroupIndex() > maxIntersectingGroupIndex)
+            {
+                maxIntersectingGroupIndex =
+                    tileIter->findMaxIntersectingGroupIndex(
+                        ltrb,
+                        maxIntersectingGroupIndex);
+            }
             ++tileIter;
         }
     }
-
-    // Find the absolute max group index this rectangle intersects with.
-    int16_t maxIntersectingGroupIndex = simd::reduce_max(maxGroupIndices);
     // It is the caller's responsibility to not insert more rectangles than can
     // fit in a signed 16-bit integer.
     assert(maxIntersectingGroupIndex <=
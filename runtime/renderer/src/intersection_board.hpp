@@ -20,14 +20,16 @@ public:
 
     void addRectangle(int4 ltrb, int16_t groupIndex);
 
-    // Accumulate local maximum intersecting group indices for the given
-    // rectangle in each channel of a int16x8. "runningMaxGroupIndices" is a
-    // running set of local maximums if the IntersectionBoard also ran this same
-    // test on other tile(s) that the rectangle touched. The absolute maximum
-    // group index that this rectangle intersects with will be
-    // simd::reduce_max(returnValue).
-    int16x8 findMaxIntersectingGroupIndex(int4 ltrb,
-                                          int16x8 runningMaxGroupIndices) const;
+    // Max groupIndex of any rectangle in the tile, or the baseline.
+    int16_t maxGroupIndex() const { return m_maxGroupIndex; }
+
+    // Returns the max groupIndex of the internal rectangles that the given
+    // rectangle intersects, or "runningMaxGroupIndex" if it's larger.
+    // "runningMaxGroupIndex" is the running maximum if the IntersectionBoard
+    // also ran this same test on other tile(s) that the rectangle touched.
+    // Rectangles that can't beat it don't need to be tested.
+    int16_t findMaxIntersectingGroupIndex(int4 ltrb,
+                                          int16_t runningMaxGroupIndex) const;
 
 private:
     int4 m_topLeft;
@@ -47,6 +49,11 @@ private:
     // Chunk of 8 groupIndices corresponding to the above edges.
     std::vector<int16x8> m_groupIndices;
     static_assert(sizeof(m_groupIndices[0]) == kChunkSize * 2);
+
+    // Max groupIndex in each chunk and every chunk before it. Chunks are
+    // tested newest first, so we can stop as soon as none of the remaining
+    // chunks can beat the max intersecting groupIndex found so far.
+    std::vector<int16_t> m_chunkPrefixMaxGroupIndices;
 };
 
 // Manages a set of rectangles and their groupIndex across a variable-sized
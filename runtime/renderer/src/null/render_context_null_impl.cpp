@@ -0,0 +1,78 @@
+/*
+ * Copyright 2025 Rive
+ */
+
+#include "rive/renderer/null/render_context_null_impl.hpp"
+
+#include "rive/renderer/render_context.hpp"
+#include "rive/renderer/texture.hpp"
+#include "utils/factory_utils.hpp"
+
+namespace rive::gpu
+{
+namespace
+{
+// Image textures are never sampled, so only their dimensions are kept.
+class TextureNullImpl : public Texture
+{
+public:
+    TextureNullImpl(uint32_t width, uint32_t height) : Texture(width, height)
+    {}
+};
+} // namespace
+
+std::unique_ptr<RenderContext> RenderContextNullImpl::MakeContext()
+{
+    return std::make_unique<RenderContext>(
+        std::unique_ptr<RenderContextNullImpl>(new RenderContextNullImpl()));
+}
+
+RenderContextNullImpl::RenderContextNullImpl()
+{
+    // Advertise every interlock mode so the caller can choose which one to
+    // exercise via FrameDescriptor.
+    m_platformFeatures.supportsRasterOrdering = true;
+    m_platformFeatures.supportsFragmentShaderAtomics = true;
+    m_platformFeatures.supportsClockwiseAtomicRendering = true;
+    // There is no gradient texture to lose, so let the context cache color
+    // ramps the same way it would on a real backend that preserves one.
+    m_platformFeatures.preservesGradientTexture = true;
+    m_platformFeatures.maxTextureSize = 16384;
+}
+
+rcp<RenderBuffer> RenderContextNullImpl::makeRenderBuffer(
+    RenderBufferType type,
+    RenderBufferFlags flags,
+    size_t sizeInBytes)
+{
+    return make_rcp<DataRenderBuffer>(type, flags, sizeInBytes);
+}
+
+rcp<Texture> RenderContextNullImpl::makeImageTexture(
+    uint32_t width,
+    uint32_t height,
+    uint32_t mipLevelCount,
+    const uint8_t imageDataRGBAPremul[])
+{
+    return make_rcp<TextureNullImpl>(width, height);
+}
+
+std::unique_ptr<BufferRing> RenderContextNullImpl::makeUniformBufferRing(
+    size_t capacityInBytes)
+{
+    return std::make_unique<HeapBufferRing>(capacityInBytes);
+}
+
+std::unique_ptr<BufferRing> RenderContextNullImpl::makeStorageBufferRing(
+    size_t capacityInBytes,
+    gpu::StorageBufferStructure)
+{
+    return std::make_unique<HeapBufferRing>(capacityInBytes);
+}
+
+std::unique_ptr<BufferRing> RenderContextNullImpl::makeVertexBufferRing(
+    size_t capacityInBytes)
+{
+    return std::make_unique<HeapBufferRing>(capacityInBytes);
+}
+} // namespace rive::gpu
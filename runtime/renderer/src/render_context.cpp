@@ -6,8 +6,13 @@
 
 #include "gr_inner_fan_triangulator.hpp"
 #include "intersection_board.hpp"
+#include "gradient_ramp_cache.hpp"
+#include "tessellation_cache.hpp"
+#include "triangulation_cache.hpp"
+#include "worker_pool.hpp"
 #include "gradient.hpp"
 #include "rive_render_paint.hpp"
+#include "rive_render_path.hpp"
 #include "rive/renderer/draw.hpp"
 #include "rive/renderer/rive_render_image.hpp"
 #include "rive/renderer/render_context_impl.hpp"
@@ -16,6 +21,7 @@
 #include "shaders/constants.glsl"
 
 #include <string_view>
+#include <thread>
 
 #ifdef RIVE_DECODERS
 #include "rive/decoders/bitmap_decoder.hpp"
@@ -49,6 +55,10 @@ constexpr size_t kMaxTessellationAlignmentVertices =
 constexpr size_t kMaxReorderedDrawPassCount =
     std::numeric_limits<int16_t>::max();
 
+// Below this many tessellation spans in a flush, waking up the WorkerPool costs
+// more than writing the spans on one thread.
+constexpr size_t kMinParallelTessVertexSpanCount = 4096;
+
 // How tall to make a resource texture in order to support the given number of
 // items.
 template <size_t WidthInItems>
@@ -65,11 +75,11 @@ constexpr static size_t gradient_data_height(size_t simpleRampCount,
            complexRampCount;
 }
 
-inline GradientContentKey::GradientContentKey(rcp<const Gradient> gradient) :
+GradientContentKey::GradientContentKey(rcp<const Gradient> gradient) :
     m_gradient(std::move(gradient))
 {}
 
-inline GradientContentKey::GradientContentKey(GradientContentKey&& other) :
+GradientContentKey::GradientContentKey(GradientContentKey&& other) :
     m_gradient(std::move(other.m_gradient))
 {}
 
@@ -113,6 +123,9 @@ RenderContext::RenderContext(std::unique_ptr<RenderContextImpl> impl) :
 {
     setResourceSizes(ResourceAllocationCounts(), /*forceRealloc =*/true);
     releaseResources();
+    setTessellationCacheEnabled(true);
+    setTriangulationCacheEnabled(true);
+    setGradientRampCacheEnabled(true);
 }
 
 RenderContext::~RenderContext()
@@ -151,13 +164,9 @@ rcp<RenderImage> RenderContext::decodeImage(Span<const uint8_t> encodedBytes)
             {
                 bitmap->pixelFormat(Bitmap::PixelFormat::RGBAPremul);
             }
-            uint32_t width = bitmap->width();
-            uint32_t height = bitmap->height();
-            uint32_t mipLevelCount = math::msb(height | width);
-            texture = m_impl->makeImageTexture(width,
-                                               height,
-                                               mipLevelCount,
-                                               bitmap->bytes());
+            return makeImage(bitmap->width(),
+                             bitmap->height(),
+                             bitmap->bytes());
         }
     }
 #endif
@@ -165,6 +174,41 @@ rcp<RenderImage> RenderContext::decodeImage(Span<const uint8_t> encodedBytes)
                               : nullptr;
 }
 
+rcp<RenderImage> RenderContext::makeImage(uint32_t width,
+                                          uint32_t height,
+                                          const uint8_t imageDataRGBAPremul[])
+{
+    uint32_t mipLevelCount = math::msb(height | width);
+    rcp<Texture> texture = m_impl->makeImageTexture(width,
+                                                    height,
+                                                    mipLevelCount,
+                                                    imageDataRGBAPremul);
+    if (texture == nullptr)
+    {
+        return nullptr;
+    }
+    if (m_imageAtlas != nullptr && ImageAtlas::CanAdd(width, height))
+    {
+        // Keep the standalone texture too, for draws the atlas can't serve
+        // (wrapped samplers and ImageRectDraws).
+        Mat2D atlasTransform;
+        rcp<ImageAtlasPage> page = m_imageAtlas->add(width,
+                                                     height,
+                                                     imageDataRGBAPremul,
+                                                     &atlasTransform);
+        auto regionPath = make_rcp<RiveRenderPath>();
+        regionPath->addRect(atlasTransform.tx(),
+                            atlasTransform.ty(),
+                            atlasTransform.xx(),
+                            atlasTransform.yy());
+        return make_rcp<RiveRenderImage>(std::move(texture),
+                                         std::move(page),
+                                         atlasTransform,
+                                         std::move(regionPath));
+    }
+    return make_rcp<RiveRenderImage>(std::move(texture));
+}
+
 void RenderContext::releaseResources()
 {
     assert(!m_didBeginFrame);
@@ -172,6 +216,94 @@ void RenderContext::releaseResources()
     setResourceSizes(ResourceAllocationCounts());
     m_maxRecentResourceRequirements = ResourceAllocationCounts();
     m_lastResourceTrimTimeInSeconds = m_impl->secondsNow();
+    if (m_tessellationCache != nullptr)
+    {
+        m_tessellationCache->clear();
+    }
+    if (m_triangulationCache != nullptr)
+    {
+        m_triangulationCache->clear();
+    }
+    m_perFrameAllocator.resetAndReleaseMemory();
+    m_numChopsAllocator.resetAndReleaseMemory();
+    m_chopVerticesAllocator.resetAndReleaseMemory();
+    m_tangentPairsAllocator.resetAndReleaseMemory();
+    m_polarSegmentCountsAllocator.resetAndReleaseMemory();
+    m_parametricSegmentCountsAllocator.resetAndReleaseMemory();
+    if (m_gradientRampCache != nullptr)
+    {
+        m_gradientRampCache->clear();
+    }
+}
+
+void RenderContext::setFlushThreadCount(uint32_t threadCount)
+{
+    assert(!m_didBeginFrame);
+    if (threadCount == 0)
+    {
+        threadCount = std::max(std::thread::hardware_concurrency(), 1u);
+    }
+    if (threadCount <= 1)
+    {
+        m_workerPool = nullptr;
+    }
+    else if (m_workerPool == nullptr ||
+             m_workerPool->concurrency() != threadCount)
+    {
+        m_workerPool = std::make_unique<WorkerPool>(threadCount - 1);
+    }
+}
+
+void RenderContext::setTessellationCacheEnabled(bool enabled)
+{
+    assert(!m_didBeginFrame);
+    if (!enabled)
+    {
+        m_tessellationCache = nullptr;
+    }
+    else if (m_tessellationCache == nullptr)
+    {
+        m_tessellationCache = std::make_unique<TessellationCache>();
+    }
+}
+
+void RenderContext::setTriangulationCacheEnabled(bool enabled)
+{
+    assert(!m_didBeginFrame);
+    if (!enabled)
+    {
+        m_triangulationCache = nullptr;
+    }
+    else if (m_triangulationCache == nullptr)
+    {
+        m_triangulationCache = std::make_unique<TriangulationCache>();
+    }
+}
+
+void RenderContext::setGradientRampCacheEnabled(bool enabled)
+{
+    assert(!m_didBeginFrame);
+    if (!enabled || !platformFeatures().preservesGradientTexture)
+    {
+        m_gradientRampCache = nullptr;
+    }
+    else if (m_gradientRampCache == nullptr)
+    {
+        m_gradientRampCache = std::make_unique<GradientRampCache>();
+    }
+}
+
+void RenderContext::setImageAtlasEnabled(bool enabled)
+{
+    if (!enabled)
+    {
+        // Images that were already packed keep their pages alive.
+        m_imageAtlas = nullptr;
+    }
+    else if (m_imageAtlas == nullptr)
+    {
+        m_imageAtlas = std::make_unique<ImageAtlas>();
+    }
 }
 
 void RenderContext::resetContainers()
@@ -189,6 +321,9 @@ void RenderContext::resetContainers()
     m_indirectDrawList.clear();
     m_indirectDrawList.shrink_to_fit();
 
+    m_tessellationChunkEnds.clear();
+    m_tessellationChunkEnds.shrink_to_fit();
+
     m_intersectionBoard = nullptr;
 }
 
@@ -200,6 +335,7 @@ RenderContext::LogicalFlush::LogicalFlush(RenderContext* parent) : m_ctx(parent)
 void RenderContext::LogicalFlush::rewind()
 {
     RIVE_PROF_SCOPE()
+    m_serial = ++m_ctx->m_lastLogicalFlushSerial;
     m_resourceCounts = Draw::ResourceCounters();
     m_drawPassCount = 0;
     m_simpleGradients.clear();
@@ -231,6 +367,7 @@ void RenderContext::LogicalFlush::rewind()
 
     m_currentPathID = 0;
     m_currentContourID = 0;
+    m_tessellationJobs.clear();
 
     if (m_atlasRectanizer != nullptr)
     {
@@ -275,6 +412,9 @@ void RenderContext::LogicalFlush::resetContainers()
     m_pendingAtlasDraws.shrink_to_fit();
     // Don't reserve any space in m_pendingAtlasDraws since there are many
     // usecases where it isn't used at all.
+
+    m_tessellationJobs.clear();
+    m_tessellationJobs.shrink_to_fit();
 }
 
 void RenderContext::beginFrame(const FrameDescriptor& frameDescriptor)
@@ -386,10 +526,38 @@ void RenderContext::LogicalFlush::addClipReadBounds(uint32_t clipID,
     clipInfo.readBounds = clipInfo.readBounds.join(bounds);
 }
 
+class RenderContext::FlushStatsTimer
+{
+public:
+    FlushStatsTimer(RenderContext* ctx, double FlushStats::*field) :
+        m_ctx(ctx->m_flushStatsEnabled ? ctx : nullptr),
+        m_field(field),
+        m_startTime(m_ctx != nullptr ? m_ctx->m_impl->secondsNow() : 0)
+    {}
+
+    ~FlushStatsTimer() { stop(); }
+
+    void stop()
+    {
+        if (m_ctx != nullptr)
+        {
+            m_ctx->m_flushStats.*m_field +=
+                m_ctx->m_impl->secondsNow() - m_startTime;
+            m_ctx = nullptr;
+        }
+    }
+
+private:
+    RenderContext* m_ctx;
+    double FlushStats::*m_field;
+    double m_startTime;
+};
+
 bool RenderContext::pushDraws(DrawUniquePtr draws[], size_t drawCount)
 {
     assert(m_didBeginFrame);
     assert(!m_logicalFlushes.empty());
+    FlushStatsTimer timer(this, &FlushStats::pushDrawsSeconds);
     return m_logicalFlushes.back()->pushDraws(draws, drawCount);
 }
 
@@ -499,9 +667,14 @@ bool RenderContext::LogicalFlush::allocateGradient(
         }
         else
         {
+            // When complex gradients are cached, simple gradients go below the
+            // cached rows, which can keep growing until the end of the frame.
+            size_t complexRowCount =
+                m_ctx->m_gradientRampCache != nullptr
+                    ? GradientRampCache::kMaxRowCount
+                    : m_complexGradients.size();
             if (gradient_data_height(m_simpleGradients.size() + 1,
-                                     m_complexGradients.size()) >
-                kMaxTextureHeight)
+                                     complexRowCount) > kMaxTextureHeight)
             {
                 // We ran out of rows in the gradient texture. Caller has to
                 // flush and try again.
@@ -523,9 +696,27 @@ bool RenderContext::LogicalFlush::allocateGradient(
         // This is a complex gradient. Render it to an entire row of the
         // gradient texture.
         GradientContentKey key(ref_rcp(gradient));
-        auto iter = m_complexGradients.find(key);
         uint16_t row;
-        if (iter != m_complexGradients.end())
+        if (GradientRampCache* cache = m_ctx->m_gradientRampCache.get())
+        {
+            bool needsRender;
+            int32_t cachedRow =
+                cache->findOrAllocateRow(std::move(key), m_serial, &needsRender);
+            if (cachedRow < 0)
+            {
+                // Every cached row is in use by this flush. Caller has to flush
+                // and try again.
+                return false;
+            }
+            row = static_cast<uint16_t>(cachedRow);
+            if (needsRender)
+            {
+                m_pendingComplexGradDraws.push_back({gradient, row});
+                m_pendingGradSpanCount += stopCount - 1;
+            }
+        }
+        else if (auto iter = m_complexGradients.find(key);
+                 iter != m_complexGradients.end())
         {
             row = iter->second; // This gradient is already in the texture.
         }
@@ -540,9 +731,9 @@ bool RenderContext::LogicalFlush::allocateGradient(
                 return false;
             }
 
-            row = static_cast<uint32_t>(m_complexGradients.size());
+            row = static_cast<uint16_t>(m_complexGradients.size());
             m_complexGradients.emplace(std::move(key), row);
-            m_pendingComplexGradDraws.push_back(gradient);
+            m_pendingComplexGradDraws.push_back({gradient, row});
 
             size_t spanCount = stopCount - 1;
             m_pendingGradSpanCount += spanCount;
@@ -657,6 +848,7 @@ void RenderContext::flush(const FlushResources& flushResources)
     // Layout this frame's resource buffers and textures.
     LogicalFlush::ResourceCounters totalFrameResourceCounts;
     LogicalFlush::LayoutCounters layoutCounts;
+    FlushStatsTimer layoutTimer(this, &FlushStats::layoutResourcesSeconds);
     for (size_t i = 0; i < m_logicalFlushes.size(); ++i)
     {
         m_logicalFlushes[i]->layoutResources(flushResources,
@@ -664,6 +856,7 @@ void RenderContext::flush(const FlushResources& flushResources)
                                              &totalFrameResourceCounts,
                                              &layoutCounts);
     }
+    layoutTimer.stop();
 
     // Determine the minimum required resource allocation sizes to service this
     // flush.
@@ -773,10 +966,12 @@ void RenderContext::flush(const FlushResources& flushResources)
 
     mapResourceBuffers(resourceRequirements);
 
+    FlushStatsTimer writeTimer(this, &FlushStats::writeResourcesSeconds);
     for (const auto& flush : m_logicalFlushes)
     {
         flush->writeResources();
     }
+    writeTimer.stop();
 
     assert(m_flushUniformData.elementsWritten() == m_logicalFlushes.size());
     assert(m_imageDrawUniformData.elementsWritten() ==
@@ -798,13 +993,39 @@ void RenderContext::flush(const FlushResources& flushResources)
     assert(m_triangleVertexData.elementsWritten() <=
            totalFrameResourceCounts.maxTriangleVertexCount);
 
+    if (m_flushStatsEnabled)
+    {
+        m_flushStats.logicalFlushCount = m_logicalFlushes.size();
+        for (const auto& flush : m_logicalFlushes)
+        {
+            m_flushStats.drawCount += flush->drawCount();
+            m_flushStats.drawBatchCount += flush->drawBatchCount();
+        }
+        m_flushStats.tessVertexSpanCount = m_tessSpanData.elementsWritten();
+        m_flushStats.triangleVertexCount =
+            m_triangleVertexData.elementsWritten();
+        m_flushStats.uniformBytesWritten =
+            m_flushUniformData.bytesWritten() +
+            m_imageDrawUniformData.bytesWritten();
+        m_flushStats.pathBytesWritten = m_pathData.bytesWritten();
+        m_flushStats.paintBytesWritten =
+            m_paintData.bytesWritten() + m_paintAuxData.bytesWritten();
+        m_flushStats.contourBytesWritten = m_contourData.bytesWritten();
+        m_flushStats.gradSpanBytesWritten = m_gradSpanData.bytesWritten();
+        m_flushStats.tessSpanBytesWritten = m_tessSpanData.bytesWritten();
+        m_flushStats.triangleBytesWritten =
+            m_triangleVertexData.bytesWritten();
+    }
+
     unmapResourceBuffers(resourceRequirements);
 
     // Issue logical flushes to the backend.
+    FlushStatsTimer backendTimer(this, &FlushStats::backendFlushSeconds);
     for (const auto& flush : m_logicalFlushes)
     {
         m_impl->flush(flush->desc());
     }
+    backendTimer.stop();
 
     m_impl->postFlush(flushResources);
 
@@ -814,17 +1035,42 @@ void RenderContext::flush(const FlushResources& flushResources)
         m_logicalFlushes.front()->rewind();
     }
 
-    // Drop all memory that was allocated for this frame using
-    // TrivialBlockAllocator.
-    m_perFrameAllocator.reset();
-    m_numChopsAllocator.reset();
-    m_chopVerticesAllocator.reset();
-    m_tangentPairsAllocator.reset();
-    m_polarSegmentCountsAllocator.reset();
-    m_parametricSegmentCountsAllocator.reset();
+    // Drop everything that was allocated for this frame using
+    // TrivialBlockAllocator. (The blocks are kept for the next frame, except
+    // on a resource trim, which frees the ones no recent frame has needed.)
+    if (needsResourceTrim)
+    {
+        m_perFrameAllocator.resetAndTrimToRecentUsage();
+        m_numChopsAllocator.resetAndTrimToRecentUsage();
+        m_chopVerticesAllocator.resetAndTrimToRecentUsage();
+        m_tangentPairsAllocator.resetAndTrimToRecentUsage();
+        m_polarSegmentCountsAllocator.resetAndTrimToRecentUsage();
+        m_parametricSegmentCountsAllocator.resetAndTrimToRecentUsage();
+    }
+    else
+    {
+        m_perFrameAllocator.reset();
+        m_numChopsAllocator.reset();
+        m_chopVerticesAllocator.reset();
+        m_tangentPairsAllocator.reset();
+        m_polarSegmentCountsAllocator.reset();
+        m_parametricSegmentCountsAllocator.reset();
+    }
+
+    // No draws reference evicted triangulations anymore.
+    if (m_triangulationCache != nullptr)
+    {
+        m_triangulationCache->releaseEvictedEntries();
+    }
 
     m_frameDescriptor = FrameDescriptor();
 
+    if (m_flushStatsEnabled)
+    {
+        m_lastFlushStats = m_flushStats;
+    }
+    m_flushStats = FlushStats();
+
     RIVE_DEBUG_CODE(m_didBeginFrame = false;)
 
     // Wait to reset CPU-side containers until after the flush has finished.
@@ -922,11 +1168,33 @@ void RenderContext::LogicalFlush::layoutResources(
             kMaxTessellationAlignmentVertices;
     }
 
-    // Complex gradients begin on the first row immediately after the simple
-    // gradients.
-    m_gradTextureLayout.complexOffsetY = math::lossless_numeric_cast<uint32_t>(
+    uint32_t simpleGradDataHeight = math::lossless_numeric_cast<uint32_t>(
         resource_texture_height<gpu::kGradTextureWidthInSimpleRamps>(
             m_simpleGradients.size()));
+    uint32_t gradDataHeight;
+    if (m_ctx->m_gradientRampCache != nullptr)
+    {
+        // Cached complex gradients own the top rows of the gradient texture.
+        // Simple gradients go immediately after them. (Rows may still be
+        // reserved for cached gradients even if this flush doesn't use any,
+        // in which case we keep them in the texture for future frames.)
+        m_gradTextureLayout.complexOffsetY = 0;
+        m_gradTextureLayout.simpleOffsetY =
+            m_ctx->m_gradientRampCache->rowCount();
+        gradDataHeight =
+            m_gradTextureLayout.simpleOffsetY + simpleGradDataHeight;
+    }
+    else
+    {
+        // Complex gradients begin on the first row immediately after the
+        // simple gradients.
+        m_gradTextureLayout.simpleOffsetY = 0;
+        m_gradTextureLayout.complexOffsetY = simpleGradDataHeight;
+        gradDataHeight = m_gradTextureLayout.complexOffsetY +
+                         math::lossless_numeric_cast<uint32_t>(
+                             m_complexGradients.size());
+    }
+    assert(gradDataHeight <= kMaxTextureHeight);
 
     m_flushDesc.renderTarget = flushResources.renderTarget;
     m_flushDesc.interlockMode = m_ctx->frameInterlockMode();
@@ -1028,8 +1296,7 @@ void RenderContext::LogicalFlush::layoutResources(
         math::lossless_numeric_cast<uint32_t>(m_pendingGradSpanCount);
     m_flushDesc.firstGradSpan = runningFrameLayoutCounts->gradSpanCount +
                                 runningFrameLayoutCounts->gradSpanPaddingCount;
-    m_flushDesc.gradDataHeight = math::lossless_numeric_cast<uint32_t>(
-        m_gradTextureLayout.complexOffsetY + m_complexGradients.size());
+    m_flushDesc.gradDataHeight = gradDataHeight;
     m_flushDesc.tessDataHeight = tessDataHeight;
     m_flushDesc.clockwiseFillOverride = frameDescriptor.clockwiseFillOverride;
     m_flushDesc.wireframe = frameDescriptor.wireframe;
@@ -1120,8 +1387,9 @@ void RenderContext::LogicalFlush::writeResources()
             // Render each simple gradient as a single, empty GradientSpan with
             // 1px borders to the left and right.
             auto [color0, color1] = m_pendingSimpleGradDraws[i];
-            uint32_t y = math::lossless_numeric_cast<uint32_t>(
-                i / gpu::kGradTextureWidthInSimpleRamps);
+            uint32_t y = m_gradTextureLayout.simpleOffsetY +
+                         math::lossless_numeric_cast<uint32_t>(
+                             i / gpu::kGradTextureWidthInSimpleRamps);
             size_t centerX = (i % gpu::kGradTextureWidthInSimpleRamps) * 2 + 1;
             uint32_t centerXFixed = math::lossless_numeric_cast<uint32_t>(
                 centerX * ONE_TEXEL_FIXED);
@@ -1136,20 +1404,18 @@ void RenderContext::LogicalFlush::writeResources()
     }
 
     // Write out the vertex data for rendering complex gradients.
-    assert(m_complexGradients.size() == m_pendingComplexGradDraws.size());
+    assert(m_ctx->m_gradientRampCache != nullptr ||
+           m_complexGradients.size() == m_pendingComplexGradDraws.size());
     if (!m_pendingComplexGradDraws.empty())
     {
-        // The viewport will start at simpleGradDataHeight when rendering color
-        // ramps.
-        for (uint32_t i = 0; i < m_pendingComplexGradDraws.size(); ++i)
+        for (const auto& [gradient, row] : m_pendingComplexGradDraws)
         {
             // Push "GradientSpan" instances that will render each section of
             // this color ramp's gradient.
-            const Gradient* gradient = m_pendingComplexGradDraws[i];
             const float* stops = gradient->stops();
             const ColorInt* colors = gradient->colors();
             size_t stopCount = gradient->count();
-            uint32_t y = i + m_gradTextureLayout.complexOffsetY;
+            uint32_t y = row + m_gradTextureLayout.complexOffsetY;
 
             // "stop * m + a" converts a stop position to a fixed-point x
             // coordinate in the gradient texture. (In an ideal world, stops
@@ -1221,6 +1487,7 @@ void RenderContext::LogicalFlush::writeResources()
     // draw list.
     if (m_ctx->frameInterlockMode() == gpu::InterlockMode::rasterOrdering)
     {
+        FlushStatsTimer writeDrawsTimer(m_ctx, &FlushStats::writeDrawsSeconds);
         for (const DrawUniquePtr& draw : m_draws)
         {
             // TODO: We don't currently support a front-to-back prepass in
@@ -1239,6 +1506,8 @@ void RenderContext::LogicalFlush::writeResources()
     {
         assert(m_drawPassCount <= kMaxReorderedDrawPassCount);
 
+        FlushStatsTimer reorderTimer(m_ctx, &FlushStats::reorderDrawsSeconds);
+
         // Sort the draw list to optimize batching, since we can only batch
         // non-overlapping draws.
         std::vector<int64_t>& indirectDrawList = m_ctx->m_indirectDrawList;
@@ -1252,6 +1521,16 @@ void RenderContext::LogicalFlush::writeResources()
         IntersectionBoard* intersectionBoard = m_ctx->m_intersectionBoard.get();
         intersectionBoard->resizeAndReset(m_flushDesc.renderTarget->width(),
                                           m_flushDesc.renderTarget->height());
+        std::vector<IntersectionTraceEntry>* trace = m_ctx->m_intersectionTrace;
+        if (trace != nullptr)
+        {
+            trace->push_back(
+                {{0,
+                  0,
+                  static_cast<int32_t>(m_flushDesc.renderTarget->width()),
+                  static_cast<int32_t>(m_flushDesc.renderTarget->height())},
+                 0});
+        }
 
         // Build a list of sort keys that determine the final draw order.
         constexpr static int kDrawGroupShift =
@@ -1292,6 +1571,14 @@ void RenderContext::LogicalFlush::writeResources()
             // correctness.
             int maxPasses =
                 std::max(draw->prepassCount(), draw->subpassCount());
+            if (trace != nullptr)
+            {
+                trace->push_back({{drawBounds.x,
+                                   drawBounds.y,
+                                   drawBounds.z,
+                                   drawBounds.w},
+                                  maxPasses});
+            }
             int16_t drawGroupIdx =
                 intersectionBoard->addRectangle(drawBounds, maxPasses);
             assert(drawGroupIdx > 0);
@@ -1379,6 +1666,7 @@ void RenderContext::LogicalFlush::writeResources()
 
         // Re-order the draws!!
         std::sort(indirectDrawList.begin(), indirectDrawList.end());
+        reorderTimer.stop();
 
         // Atomic mode sometimes needs to initialize PLS with a draw when the
         // backend can't do it with typical clear/load APIs.
@@ -1450,6 +1738,7 @@ void RenderContext::LogicalFlush::writeResources()
 
         // Write out the draw data from the sorted draw list, and build up a
         // condensed/batched list of low-level draws.
+        FlushStatsTimer writeDrawsTimer(m_ctx, &FlushStats::writeDrawsSeconds);
         int64_t priorSignedKey =
             !indirectDrawList.empty() ? indirectDrawList[0] : 0;
         for (const int64_t signedKey : indirectDrawList)
@@ -1587,6 +1876,10 @@ void RenderContext::LogicalFlush::writeResources()
                m_pendingAtlasDraws.size());
     }
 
+    // Every TessVertexSpan and contour has been reserved. Write them out now,
+    // in parallel if the context has a worker pool.
+    writeTessellationJobs();
+
     // Pad our buffers to 256-byte alignment.
     m_ctx->m_pathData.push_back_n(nullptr, m_pathPaddingCount);
     m_ctx->m_paintData.push_back_n(nullptr, m_paintPaddingCount);
@@ -1842,6 +2135,12 @@ void RenderContext::setResourceSizes(ResourceAllocationCounts allocs,
         m_impl->resizeGradientTexture(
             gpu::kGradTextureWidth,
             math::lossless_numeric_cast<uint32_t>(allocs.gradTextureHeight));
+        if (m_gradientRampCache != nullptr &&
+            allocs.gradTextureHeight < m_gradientRampCache->rowCount())
+        {
+            // The cached color ramps didn't survive the resize.
+            m_gradientRampCache->clear();
+        }
     }
 
     assert(allocs.tessTextureHeight <= kMaxTextureHeight);
@@ -2114,32 +2413,156 @@ uint32_t RenderContext::LogicalFlush::pushPath(const PathDraw* draw)
     return m_currentPathID;
 }
 
-RenderContext::TessellationWriter::TessellationWriter(
-    LogicalFlush* flush,
+void RenderContext::LogicalFlush::pushTessellationJob(
+    PathDraw* draw,
     uint32_t pathID,
-    gpu::ContourDirections contourDirections,
     uint32_t forwardTessVertexCount,
     uint32_t forwardTessLocation,
     uint32_t mirroredTessVertexCount,
-    uint32_t mirroredTessLocation) :
+    uint32_t mirroredTessLocation)
+{
+    const Draw::ResourceCounters& counts = draw->resourceCounts();
+    m_tessellationJobs.push_back(reserveTessellation(
+        draw,
+        pathID,
+        draw->contourDirections(),
+        math::lossless_numeric_cast<uint32_t>(counts.contourCount),
+        math::lossless_numeric_cast<uint32_t>(
+            counts.maxTessellatedSegmentCount),
+        forwardTessVertexCount,
+        forwardTessLocation,
+        mirroredTessVertexCount,
+        mirroredTessLocation));
+}
+
+// Returns the number of times a run of "count" vertices, starting at
+// "location", wraps to the next line in the tessellation texture.
+constexpr static uint32_t tess_line_break_count(uint32_t location,
+                                                uint32_t count)
+{
+    return count != 0 ? (location + count - 1) / kTessTextureWidth -
+                            location / kTessTextureWidth
+                      : 0;
+}
+
+RenderContext::TessellationJob RenderContext::LogicalFlush::
+    reserveTessellation(PathDraw* draw,
+                        uint32_t pathID,
+                        gpu::ContourDirections contourDirections,
+                        uint32_t contourCount,
+                        uint32_t cubicCount,
+                        uint32_t forwardTessVertexCount,
+                        uint32_t forwardTessLocation,
+                        uint32_t mirroredTessVertexCount,
+                        uint32_t mirroredTessLocation)
+{
+    RIVE_PROF_SCOPE()
+    assert(m_hasDoneLayout);
+    assert(pathID != 0 || contourCount == 0);
+
+    TessellationJob job;
+    job.draw = draw;
+    job.pathID = pathID;
+    job.contourDirections = contourDirections;
+    job.forwardTessVertexCount = forwardTessVertexCount;
+    job.forwardTessLocation = forwardTessLocation;
+    job.mirroredTessVertexCount = mirroredTessVertexCount;
+    job.mirroredTessLocation = mirroredTessLocation;
+
+    job.contourData = m_ctx->m_contourData.push_back_range(contourCount);
+    job.firstContourID = m_currentContourID + 1;
+    m_currentContourID += contourCount;
+    assert(m_currentContourID <= gpu::kMaxContourID);
+    assert(m_flushDesc.firstContour + m_currentContourID ==
+           m_ctx->m_contourData.elementsWritten());
+
+    // Every cubic writes one span, plus another each time it wraps to a new
+    // line. A cubic and its reflection wrap within a single loop, so the
+    // number of wraps is at most the number of line breaks in the forward and
+    // mirrored vertex ranges combined.
+    uint32_t maxSpanCount =
+        cubicCount +
+        tess_line_break_count(forwardTessLocation, forwardTessVertexCount) +
+        tess_line_break_count(mirroredTessLocation - mirroredTessVertexCount,
+                              mirroredTessVertexCount);
+    job.tessSpanData = m_ctx->m_tessSpanData.push_back_range(maxSpanCount);
+    return job;
+}
+
+void RenderContext::LogicalFlush::writeTessellationJobs()
+{
+    RIVE_PROF_SCOPE()
+    FlushStatsTimer timer(m_ctx, &FlushStats::writeTessellationSeconds);
+
+    auto writeJobs = [this](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+        {
+            const TessellationJob& job = m_tessellationJobs[i];
+            TessellationWriter tessWriter(this, job);
+            job.draw->writeTessellationData(&tessWriter);
+        }
+    };
+
+    WorkerPool* workerPool = m_ctx->m_workerPool.get();
+    size_t spanCount = m_ctx->m_tessSpanData.elementsWritten() -
+                       m_flushDesc.firstTessVertexSpan;
+    if (workerPool == nullptr || spanCount < kMinParallelTessVertexSpanCount)
+    {
+        writeJobs(0, m_tessellationJobs.size());
+    }
+    else
+    {
+        // Split the jobs into chunks with similar numbers of spans, a few per
+        // thread so the faster threads can pick up the slack.
+        std::vector<size_t>& chunkEnds = m_ctx->m_tessellationChunkEnds;
+        chunkEnds.clear();
+        size_t spansPerChunk = spanCount / (workerPool->concurrency() * 4);
+        size_t chunkSpanCount = 0;
+        for (size_t i = 0; i < m_tessellationJobs.size(); ++i)
+        {
+            chunkSpanCount += m_tessellationJobs[i].tessSpanData.capacity();
+            if (chunkSpanCount >= spansPerChunk)
+            {
+                chunkEnds.push_back(i + 1);
+                chunkSpanCount = 0;
+            }
+        }
+        if (chunkEnds.empty() || chunkEnds.back() != m_tessellationJobs.size())
+        {
+            chunkEnds.push_back(m_tessellationJobs.size());
+        }
+        workerPool->run(chunkEnds.size(), [&](size_t chunk) {
+            writeJobs(chunk == 0 ? 0 : chunkEnds[chunk - 1], chunkEnds[chunk]);
+        });
+    }
+
+    m_tessellationJobs.clear();
+}
+
+RenderContext::TessellationWriter::TessellationWriter(
+    LogicalFlush* flush,
+    const TessellationJob& job) :
     m_flush(flush),
-    m_tessSpanData(m_flush->m_ctx->m_tessSpanData),
-    m_pathID(pathID),
-    m_contourDirections(contourDirections),
-    m_pathTessLocation(forwardTessLocation),
-    m_pathMirroredTessLocation(mirroredTessLocation)
+    m_tessSpanData(job.tessSpanData),
+    m_contourData(job.contourData),
+    m_pathID(job.pathID),
+    m_contourDirections(job.contourDirections),
+    m_currentContourID(job.firstContourID - 1),
+    m_pathTessLocation(job.forwardTessLocation),
+    m_pathMirroredTessLocation(job.mirroredTessLocation)
 {
     RIVE_PROF_SCOPE()
     RIVE_DEBUG_CODE(m_expectedPathTessEndLocation =
-                        m_pathTessLocation + forwardTessVertexCount;)
+                        m_pathTessLocation + job.forwardTessVertexCount;)
     RIVE_DEBUG_CODE(m_expectedPathMirroredTessEndLocation =
-                        m_pathMirroredTessLocation - mirroredTessVertexCount;)
+                        m_pathMirroredTessLocation -
+                        job.mirroredTessVertexCount;)
     assert(m_flush->m_hasDoneLayout);
-    assert(m_flush->m_ctx->m_pathData.elementsWritten() > 0);
-    assert(forwardTessVertexCount == 0 || mirroredTessVertexCount == 0 ||
-           forwardTessVertexCount == mirroredTessVertexCount);
+    assert(job.forwardTessVertexCount == 0 ||
+           job.mirroredTessVertexCount == 0 ||
+           job.forwardTessVertexCount == job.mirroredTessVertexCount);
     assert(!gpu::ContourDirectionsAreDoubleSided(m_contourDirections) ||
-           forwardTessVertexCount == mirroredTessVertexCount);
+           job.forwardTessVertexCount == job.mirroredTessVertexCount);
     assert(m_pathTessLocation >= 0);
     assert(m_pathMirroredTessLocation <= kMaxTessellationVertexCount);
     assert(m_expectedPathTessEndLocation <= kMaxTessellationVertexCount);
@@ -2150,29 +2573,24 @@ RenderContext::TessellationWriter::~TessellationWriter()
 {
     assert(m_pathTessLocation == m_expectedPathTessEndLocation);
     assert(m_pathMirroredTessLocation == m_expectedPathMirroredTessEndLocation);
-}
-
-uint32_t RenderContext::LogicalFlush::pushContour(uint32_t pathID,
-                                                  Vec2D midpoint,
-                                                  bool isStroke,
-                                                  bool closed,
-                                                  uint32_t vertexIndex0)
-{
-    RIVE_PROF_SCOPE()
-    assert(pathID != 0);
-    assert(isStroke || closed);
+    // Every reserved contour gets written.
+    assert(!m_contourData.hasRoomFor(1));
 
-    if (isStroke)
-    {
-        midpoint.x = closed ? 1 : 0;
+    // Fill the spans we didn't wrap into with empty ones. They have zero width,
+    // so they don't touch the tessellation texture.
+    constexpr static Vec2D kEmptyCubic[4]{};
+    while (m_tessSpanData.hasRoomFor(1))
+    {
+        m_tessSpanData.set_back(kEmptyCubic,
+                                Vec2D{},
+                                0.f,
+                                0,
+                                0,
+                                0,
+                                0,
+                                1,
+                                INVALID_CONTOUR_ID_WITH_FLAGS);
     }
-    m_ctx->m_contourData.emplace_back(midpoint, pathID, vertexIndex0);
-
-    ++m_currentContourID;
-    assert(0 < m_currentContourID && m_currentContourID <= gpu::kMaxContourID);
-    assert(m_flushDesc.firstContour + m_currentContourID ==
-           m_ctx->m_contourData.elementsWritten());
-    return m_currentContourID;
 }
 
 uint32_t RenderContext::TessellationWriter::pushContour(
@@ -2182,17 +2600,27 @@ uint32_t RenderContext::TessellationWriter::pushContour(
     uint32_t paddingVertexCount)
 {
     RIVE_PROF_SCOPE()
+    assert(m_pathID != 0);
+    assert(isStroke || closed);
+
     // The first curve of the contour will be pre-padded with
     // 'paddingVertexCount' tessellation vertices, colocated at T=0. The caller
     // must use this argument align the end of the contour on a boundary of the
     // patch size. (See math::padding_to_align_up().)
     m_nextCubicPaddingVertexCount = paddingVertexCount;
 
-    return m_flush->pushContour(m_pathID,
-                                midpoint,
-                                isStroke,
-                                closed,
-                                nextVertexIndex());
+    if (isStroke)
+    {
+        midpoint.x = closed ? 1 : 0;
+    }
+    // "vertexIndex0" is the index within the tessellation where the first
+    // vertex of the contour resides. Shaders need this when the contour is
+    // closed.
+    m_contourData.emplace_back(midpoint, m_pathID, nextVertexIndex());
+
+    ++m_currentContourID;
+    assert(0 < m_currentContourID && m_currentContourID <= gpu::kMaxContourID);
+    return m_currentContourID;
 }
 
 void RenderContext::TessellationWriter::pushCubic(
@@ -2210,7 +2638,7 @@ void RenderContext::TessellationWriter::pushCubic(
     assert(0 <= polarSegmentCount && polarSegmentCount <= kMaxPolarSegments);
     assert(joinSegmentCount > 0);
     assert((contourIDWithFlags & CONTOUR_ID_MASK) ==
-           (m_flush->m_currentContourID & CONTOUR_ID_MASK));
+           (m_currentContourID & CONTOUR_ID_MASK));
     // contourID can't be zero.
     assert((contourIDWithFlags & CONTOUR_ID_MASK) != 0);
     // contourID can't be out of range in the contour buffer. (Contour buffer
@@ -2420,10 +2848,15 @@ void RenderContext::LogicalFlush::pushPaddingVertices(uint32_t count,
 
     constexpr static Vec2D kEmptyCubic[4]{};
     TessellationWriter(this,
-                       /*pathID=*/0,
-                       gpu::ContourDirections::forward,
-                       count,
-                       tessLocation)
+                       reserveTessellation(nullptr,
+                                           /*pathID=*/0,
+                                           gpu::ContourDirections::forward,
+                                           /*contourCount=*/0,
+                                           /*cubicCount=*/1,
+                                           count,
+                                           tessLocation,
+                                           0,
+                                           0))
         .pushTessellationSpans(kEmptyCubic,
                                {0, 0},
                                count,
@@ -2563,7 +2996,8 @@ void RenderContext::LogicalFlush::pushImageMeshDraw(ImageMeshDraw* draw)
                                                draw->clipRectInverseMatrix(),
                                                draw->clipID(),
                                                draw->blendMode(),
-                                               m_currentZIndex);
+                                               m_currentZIndex,
+                                               draw->atlasTransform());
 
     DrawBatch& batch = pushDraw(draw,
                                 DrawType::imageMesh,
@@ -4,6 +4,20 @@
 
 #include "rive/renderer/rive_render_image.hpp"
 
+namespace rive
+{
+RiveRenderImage::RiveRenderImage(rcp<gpu::Texture> texture,
+                                 rcp<gpu::ImageAtlasPage> atlasPage,
+                                 const Mat2D& atlasTransform,
+                                 rcp<RenderPath> atlasRegionPath) :
+    RiveRenderImage(std::move(texture))
+{
+    m_atlasPage = std::move(atlasPage);
+    m_atlasTransform = atlasTransform;
+    m_atlasRegionPath = std::move(atlasRegionPath);
+}
+} // namespace rive
+
 namespace rive::gpu
 {
 Texture::Texture(uint32_t width, uint32_t height) :
@@ -10,6 +10,9 @@
 #include "rive/profiler/profiler_macros.h"
 #include "shaders/constants.glsl"
 
+#include <algorithm>
+#include <cmath>
+
 namespace rive
 {
 RiveRenderPath::RiveRenderPath(FillRule fillRule, RawPath& rawPath)
@@ -247,15 +250,59 @@ static void chop_cubic_at_uniform_rotation(RawPath* path,
     path->cubic(remainingCubic[1], remainingCubic[2], remainingCubic[3]);
 }
 
-rcp<RiveRenderPath> RiveRenderPath::makeSoftenedCopyForFeathering(
+// Softened copies are shared by every feather whose size in pixels rounds to
+// the same 1/16th of an octave (within about 2%).
+constexpr static float kPixelFeatherBucketsPerOctave = 16;
+
+rcp<RiveRenderPath> RiveRenderPath::getSoftenedCopyForFeathering(
     float feather,
     float matrixMaxScale)
+{
+    float bucket =
+        roundf(log2f(feather * matrixMaxScale) * kPixelFeatherBucketsPerOctave);
+    if (!(fabsf(bucket) < 1e6f))
+    {
+        // Degenerate feather or scale. Don't cache.
+        return makeSoftenedCopyForFeathering(feather * matrixMaxScale);
+    }
+    int32_t pixelFeatherBucket = static_cast<int32_t>(bucket);
+    uint64_t rawPathMutationID = getRawPathMutationID();
+    for (size_t i = 0; i < m_softenedCopies.size(); ++i)
+    {
+        SoftenedCopy& copy = m_softenedCopies[i];
+        if (copy.path != nullptr &&
+            copy.rawPathMutationID == rawPathMutationID &&
+            copy.pixelFeatherBucket == pixelFeatherBucket)
+        {
+            std::rotate(m_softenedCopies.begin(),
+                        m_softenedCopies.begin() + i,
+                        m_softenedCopies.begin() + i + 1);
+            return m_softenedCopies[0].path;
+        }
+    }
+
+    // Build the copy for the center of the bucket, so the result doesn't
+    // depend on which feather happened to create it. Replace the least
+    // recently used copy.
+    std::rotate(m_softenedCopies.begin(),
+                m_softenedCopies.end() - 1,
+                m_softenedCopies.end());
+    m_softenedCopies[0] = {
+        makeSoftenedCopyForFeathering(
+            exp2f(pixelFeatherBucket / kPixelFeatherBucketsPerOctave)),
+        rawPathMutationID,
+        pixelFeatherBucket};
+    return m_softenedCopies[0].path;
+}
+
+rcp<RiveRenderPath> RiveRenderPath::makeSoftenedCopyForFeathering(
+    float pixelFeather) const
 {
     RIVE_PROF_SCOPE()
     // Since curvature is what breaks 1-dimensional feathering along the normal
     // vector, chop into segments that rotate no more than a certain threshold.
     constexpr static int POLAR_JOIN_PRECISION = 2;
-    float r_ = feather * (FEATHER_TEXTURE_STDDEVS / 2) * matrixMaxScale * .25f;
+    float r_ = pixelFeather * (FEATHER_TEXTURE_STDDEVS / 2) * .25f;
     float polarSegmentsPerRadian =
         math::calc_polar_segments_per_radian<POLAR_JOIN_PRECISION>(r_);
     float rotationBetweenJoins = 1 / polarSegmentsPerRadian;
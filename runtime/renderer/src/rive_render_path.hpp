@@ -7,6 +7,8 @@
 #include "rive/math/raw_path.hpp"
 #include "rive/renderer.hpp"
 
+#include <array>
+
 namespace rive
 {
 // RenderPath implementation for Rive's pixel local storage renderer.
@@ -33,6 +35,11 @@ public:
     void addRenderPathBackwards(RenderPath* path,
                                 const Mat2D& transform) override;
     void addRawPath(const RawPath& path) override;
+    bool peekFillRule(FillRule* rule) const override
+    {
+        *rule = m_fillRule;
+        return true;
+    }
     const RawPath& getRawPath() const { return m_rawPath; }
     FillRule getFillRule() const { return m_fillRule; }
 
@@ -50,9 +57,11 @@ public:
     // path with shorter, flatter curves that will more accurately depict a
     // gaussian blur when drawn with the given feather.
     //
-    // TODO: Move this work to the GPU.
-    rcp<RiveRenderPath> makeSoftenedCopyForFeathering(float feather,
-                                                      float matrixMaxScale);
+    // The copy is saved on this path and reused until the path mutates. The
+    // softening only depends on feather * matrixMaxScale, which is snapped to
+    // a bucket so the copy also survives small changes in feather or scale.
+    rcp<RiveRenderPath> getSoftenedCopyForFeathering(float feather,
+                                                     float matrixMaxScale);
 
 #ifdef DEBUG
     // Allows ref holders to guarantee the rawPath doesn't mutate during a
@@ -66,6 +75,12 @@ public:
 #endif
 
 private:
+    // Builds the softened copy for a feather that is "pixelFeather" wide after
+    // the matrix is applied.
+    //
+    // TODO: Move this work to the GPU.
+    rcp<RiveRenderPath> makeSoftenedCopyForFeathering(float pixelFeather) const;
+
     FillRule m_fillRule = FillRule::nonZero;
     RawPath m_rawPath;
     mutable AABB m_bounds;
@@ -81,6 +96,16 @@ private:
     };
 
     mutable uint32_t m_dirt = kAllDirt;
+
+    // Softened copies from getSoftenedCopyForFeathering(), most recently used
+    // first. There are two so a path can have, e.g., both a shadow and a glow.
+    struct SoftenedCopy
+    {
+        rcp<RiveRenderPath> path;
+        uint64_t rawPathMutationID = 0;
+        int32_t pixelFeatherBucket = 0;
+    };
+    std::array<SoftenedCopy, 2> m_softenedCopies;
     RIVE_DEBUG_CODE(mutable int m_rawPathMutationLockCount = 0;)
 };
 } // namespace rive
@@ -8,6 +8,7 @@
 #include "rive_render_path.hpp"
 #include "rive/math/math_types.hpp"
 #include "rive/math/simd.hpp"
+#include "rive/picture.hpp"
 #include "rive/renderer/rive_render_image.hpp"
 #include "rive/profiler/profiler_macros.h"
 
@@ -157,8 +158,8 @@ void RiveRenderer::drawPath(RenderPath* renderPath, RenderPaint* renderPaint)
             clipAndPushDraw(gpu::PathDraw::Make(
                 m_context,
                 m_stack.back().matrix,
-                path->makeSoftenedCopyForFeathering(paint->getFeather(),
-                                                    matrixMaxScale),
+                path->getSoftenedCopyForFeathering(paint->getFeather(),
+                                                   matrixMaxScale),
                 path->getFillRule(),
                 paint,
                 &m_scratchPath));
@@ -376,17 +377,69 @@ void RiveRenderer::drawImage(const RenderImage* renderImage,
             m_unitRectPath->line({1, 1});
             m_unitRectPath->line({0, 1});
         }
+        RenderPath* rectPath = m_unitRectPath.get();
+
+        if (image->atlasPage() != nullptr &&
+            imageSampler.wrapX == ImageWrap::clamp &&
+            imageSampler.wrapY == ImageWrap::clamp)
+        {
+            // Sample the image's region of its atlas page instead, so this
+            // draw can batch with draws of other images on the same page. The
+            // region path is in page coordinates, so undo the atlas transform
+            // to land it back on the unit square; the image paint then samples
+            // the page at the region's coordinates.
+            rcp<gpu::Texture> atlasTexture =
+                image->atlasPage()->refTexture(m_context->impl());
+            Mat2D pageToImage;
+            if (atlasTexture != nullptr &&
+                image->atlasTransform().invert(&pageToImage))
+            {
+                transform(pageToImage);
+                imageTexture = std::move(atlasTexture);
+                rectPath = image->atlasRegionPath();
+            }
+        }
 
         RiveRenderPaint paint;
         paint.image(std::move(imageTexture), opacity);
         paint.blendMode(blendMode);
         paint.imageSampler(imageSampler);
-        drawPath(m_unitRectPath.get(), &paint);
+        drawPath(rectPath, &paint);
     }
 
     restore();
 }
 
+void RiveRenderer::drawPicture(const Picture& picture)
+{
+    RIVE_PROF_SCOPE()
+    if (picture.empty() || m_stack.back().clipIsEmpty)
+    {
+        return;
+    }
+
+    // Skip the entire stream if the picture's bounds are offscreen. (Clips are
+    // discarded in clockwiseAtomic mode, so its content may exceed the bounds
+    // there.)
+    if (picture.hasBounds() &&
+        m_context->frameInterlockMode() != gpu::InterlockMode::clockwiseAtomic)
+    {
+        AABB devBounds =
+            m_stack.back().matrix.mapBoundingBox(picture.bounds());
+        const gpu::RenderContext::FrameDescriptor& desc =
+            m_context->frameDescriptor();
+        // Use positive logic so NaN bounds are never culled.
+        if (devBounds.right() <= 0 || devBounds.bottom() <= 0 ||
+            devBounds.left() >= static_cast<float>(desc.renderTargetWidth) ||
+            devBounds.top() >= static_cast<float>(desc.renderTargetHeight))
+        {
+            return;
+        }
+    }
+
+    picture.playback(this);
+}
+
 void RiveRenderer::drawImageMesh(const RenderImage* renderImage,
                                  ImageSampler imageSampler,
                                  rcp<RenderBuffer> vertices_f32,
@@ -400,7 +453,24 @@ void RiveRenderer::drawImageMesh(const RenderImage* renderImage,
     RIVE_PROF_SCOPE()
     LITE_RTTI_CAST_OR_RETURN(image, const RiveRenderImage*, renderImage);
 
-    rcp<gpu::Texture> imageTexture = image->refTexture();
+    // With a clamped sampler, draw atlased images from their page. The shader
+    // clamps the mesh's UVs to the image and maps them into its region, so
+    // neighboring images never get sampled. Wrapped samplers need the
+    // standalone texture.
+    rcp<gpu::Texture> imageTexture;
+    const Mat2D* atlasTransform = nullptr;
+    if (image->atlasPage() != nullptr &&
+        imageSampler.wrapX == ImageWrap::clamp &&
+        imageSampler.wrapY == ImageWrap::clamp)
+    {
+        imageTexture = image->atlasPage()->refTexture(m_context->impl());
+        atlasTransform = &image->atlasTransform();
+    }
+    if (imageTexture == nullptr)
+    {
+        imageTexture = image->refTexture();
+        atlasTransform = nullptr;
+    }
     if (imageTexture == nullptr)
     {
         // imageTexture may be null if the backend uses a custom factory and/or
@@ -428,7 +498,8 @@ void RiveRenderer::drawImageMesh(const RenderImage* renderImage,
                                             std::move(uvCoords_f32),
                                             std::move(indices_u16),
                                             indexCount,
-                                            opacity)));
+                                            opacity,
+                                            atlasTransform)));
 }
 
 void RiveRenderer::clipAndPushDraw(gpu::DrawUniquePtr draw)
@@ -749,8 +749,17 @@ ATOMIC_PLS_MAIN_WITH_IMAGE_UNIFORMS(@drawFragmentMain)
     // @imageTexture binding is liable to change, and furthermore in the case of
     // imageMeshes, we can't calculate UV coordinates based on fragment
     // position.
+    float2 texCoord = v_texCoord;
+    if (imageDrawUniforms.atlasRegion.x != .0)
+    {
+        // Clamp to the image before mapping into its atlas region, so
+        // neighboring images never get sampled.
+        texCoord = clamp(texCoord, make_float2(.0), make_float2(1.)) *
+                       imageDrawUniforms.atlasRegion.xy +
+                   imageDrawUniforms.atlasRegion.zw;
+    }
     half4 imageColor =
-        TEXTURE_SAMPLE_DYNAMIC(@imageTexture, imageSampler, v_texCoord);
+        TEXTURE_SAMPLE_DYNAMIC(@imageTexture, imageSampler, texCoord);
     half imageCoverage = 1.;
 #ifdef @DRAW_IMAGE_RECT
     imageCoverage = min(v_edgeCoverage, imageCoverage);
@@ -362,6 +362,12 @@ float2 clipRectInverseTranslate;
 uint clipID;
 uint blendMode;
 uint zIndex;
+uint padding1;
+uint padding2;
+uint padding3;
+// Scale (xy) and translation (zw) from the image's texture coordinates to its
+// region of an atlas page, or all zeros if the image isn't atlased.
+float4 atlasRegion;
 UNIFORM_BLOCK_END(imageDrawUniforms)
 #endif
 #endif
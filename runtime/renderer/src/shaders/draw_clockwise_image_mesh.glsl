@@ -59,8 +59,17 @@ FRAG_DATA_MAIN(half4, @drawFragmentMain)
 {
     VARYING_UNPACK(v_texCoord, float2);
 
+    float2 texCoord = v_texCoord;
+    if (imageDrawUniforms.atlasRegion.x != .0)
+    {
+        // Clamp to the image before mapping into its atlas region, so
+        // neighboring images never get sampled.
+        texCoord = clamp(texCoord, make_float2(.0), make_float2(1.)) *
+                       imageDrawUniforms.atlasRegion.xy +
+                   imageDrawUniforms.atlasRegion.zw;
+    }
     half4 meshColor =
-        TEXTURE_SAMPLE_DYNAMIC(@imageTexture, imageSampler, v_texCoord);
+        TEXTURE_SAMPLE_DYNAMIC(@imageTexture, imageSampler, texCoord);
     meshColor = make_half4(unmultiply_rgb(meshColor),
                            meshColor.a * imageDrawUniforms.opacity);
 
@@ -121,8 +121,16 @@ PLS_MAIN_WITH_IMAGE_UNIFORMS(@drawFragmentMain)
     VARYING_UNPACK(v_clipRect, float4);
 #endif
 
-    half4 color =
-        TEXTURE_SAMPLE_DYNAMIC(@imageTexture, imageSampler, v_texCoord);
+    float2 texCoord = v_texCoord;
+    if (imageDrawUniforms.atlasRegion.x != .0)
+    {
+        // Clamp to the image before mapping into its atlas region, so
+        // neighboring images never get sampled.
+        texCoord = clamp(texCoord, make_float2(.0), make_float2(1.)) *
+                       imageDrawUniforms.atlasRegion.xy +
+                   imageDrawUniforms.atlasRegion.zw;
+    }
+    half4 color = TEXTURE_SAMPLE_DYNAMIC(@imageTexture, imageSampler, texCoord);
     half coverage = 1.;
 
 #ifdef @ENABLE_CLIP_RECT
@@ -176,8 +184,17 @@ FRAG_DATA_MAIN(half4, @drawFragmentMain)
 {
     VARYING_UNPACK(v_texCoord, float2);
 
+    float2 texCoord = v_texCoord;
+    if (imageDrawUniforms.atlasRegion.x != .0)
+    {
+        // Clamp to the image before mapping into its atlas region, so
+        // neighboring images never get sampled.
+        texCoord = clamp(texCoord, make_float2(.0), make_float2(1.)) *
+                       imageDrawUniforms.atlasRegion.xy +
+                   imageDrawUniforms.atlasRegion.zw;
+    }
     half4 color =
-        TEXTURE_SAMPLE_DYNAMIC(@imageTexture, imageSampler, v_texCoord) *
+        TEXTURE_SAMPLE_DYNAMIC(@imageTexture, imageSampler, texCoord) *
         imageDrawUniforms.opacity;
 
 #if defined(@ENABLE_ADVANCED_BLEND) && !defined(@FIXED_FUNCTION_COLOR_OUTPUT)
@@ -0,0 +1,98 @@
+/*
+ * Copyright 2025 Rive
+ */
+
+#include "tessellation_cache.hpp"
+
+#include <string_view>
+
+namespace rive::gpu
+{
+// Number of slots in the direct-mapped table, and upper bound on how much data
+// the cache holds onto between frames.
+constexpr static size_t kSlotCount = 4096;
+constexpr static size_t kMaxSizeInBytes = 16 * 1024 * 1024;
+static_assert((kSlotCount & (kSlotCount - 1)) == 0);
+
+TessellationCache::Key::Key(uint64_t rawPathMutationID_,
+                            const Mat2D& matrix,
+                            float strokeRadius,
+                            float featherRadius,
+                            StrokeJoin join,
+                            StrokeCap cap) :
+    rawPathMutationID(rawPathMutationID_),
+    matrixBits{math::bit_cast<uint32_t>(matrix.xx()),
+               math::bit_cast<uint32_t>(matrix.xy()),
+               math::bit_cast<uint32_t>(matrix.yx()),
+               math::bit_cast<uint32_t>(matrix.yy())},
+    strokeRadiusBits(math::bit_cast<uint32_t>(strokeRadius)),
+    featherRadiusBits(math::bit_cast<uint32_t>(featherRadius)),
+    joinAndCap((static_cast<uint32_t>(join) << 16) |
+               static_cast<uint32_t>(cap))
+{}
+
+size_t TessellationCache::Hash(const Key& key)
+{
+    return std::hash<std::string_view>()(
+        std::string_view(reinterpret_cast<const char*>(&key), sizeof(Key)));
+}
+
+const PathDraw::MidpointFanData* TessellationCache::find(const Key& key,
+                                                         bool* shouldInsert)
+{
+    if (m_slots.empty())
+    {
+        m_slots.resize(kSlotCount);
+    }
+    size_t hash = Hash(key);
+    Slot& slot = m_slots[hash & (kSlotCount - 1)];
+    if (slot.entry != nullptr && slot.entry->key == key)
+    {
+        m_entries.splice(m_entries.begin(), m_entries, slot.entry->listIter);
+        *shouldInsert = false;
+        return &slot.entry->data;
+    }
+    *shouldInsert = slot.hash == hash;
+    slot.hash = hash;
+    return nullptr;
+}
+
+void TessellationCache::insert(const Key& key, PathDraw::MidpointFanData&& data)
+{
+    size_t slotIdx = Hash(key) & (kSlotCount - 1);
+    Slot& slot = m_slots[slotIdx];
+    if (slot.entry != nullptr)
+    {
+        // Evict the key that was in our slot.
+        assert(!(slot.entry->key == key));
+        eraseEntry(slot.entry);
+    }
+    size_t sizeInBytes = sizeof(Entry) + data.sizeInBytes();
+    m_entries.push_front({key, std::move(data), sizeInBytes, slotIdx, {}});
+    m_entries.front().listIter = m_entries.begin();
+    slot.entry = &m_entries.front();
+    m_sizeInBytes += sizeInBytes;
+
+    // Purge least recently used entries until we're under budget. Never purge
+    // the entry we just inserted, even if it's too big on its own.
+    while (m_entries.size() > 1 && m_sizeInBytes > kMaxSizeInBytes)
+    {
+        eraseEntry(&m_entries.back());
+    }
+}
+
+void TessellationCache::clear()
+{
+    m_entries.clear();
+    m_slots.clear();
+    m_slots.shrink_to_fit();
+    m_sizeInBytes = 0;
+}
+
+void TessellationCache::eraseEntry(Entry* entry)
+{
+    m_slots[entry->slotIdx].entry = nullptr;
+    m_sizeInBytes -= entry->sizeInBytes;
+    m_entries.erase(entry->listIter);
+}
+} // namespace rive::gpu
@@ -0,0 +1,93 @@
+/*
+ * Copyright 2025 Rive
+ */
+
+#pragma once
+
+#include "rive/renderer/draw.hpp"
+
+#include <cstring>
+#include <list>
+#include <vector>
+
+namespace rive::gpu
+{
+// LRU cache of the CPU-side work done by PathDraw::initForMidpointFan(), so
+// paths that hold still between frames don't have to be chopped, measured with
+// Wang's formula, and have their rotations counted all over again.
+//
+// Entries are keyed on the path's mutation ID and everything else that affects
+// the result: the linear terms of the matrix, and the stroke or feather.
+// Translation doesn't factor in, so paths that only move still hit. (Final
+// tessellation spans are not cached since their contour IDs and texture
+// locations change every flush.)
+class TessellationCache
+{
+public:
+    struct Key
+    {
+        Key() = default;
+        Key(uint64_t rawPathMutationID,
+            const Mat2D&,
+            float strokeRadius,
+            float featherRadius,
+            StrokeJoin,
+            StrokeCap);
+
+        bool operator==(const Key& other) const
+        {
+            return memcmp(this, &other, sizeof(Key)) == 0;
+        }
+
+        uint64_t rawPathMutationID;
+        // Bit patterns of the floats, so the comparison is exact and NaN
+        // equals itself.
+        uint32_t matrixBits[4];
+        uint32_t strokeRadiusBits;
+        uint32_t featherRadiusBits;
+        uint32_t joinAndCap;
+        uint32_t padding = 0;
+    };
+
+    // Returns the saved data for "key", or null on a miss.
+    //
+    // Data only gets saved once a key has missed twice, so paths that mutate
+    // every frame don't pay to copy out data that will never be used. On a
+    // miss, "shouldInsert" is set if the caller should pass its results to
+    // insert().
+    const PathDraw::MidpointFanData* find(const Key&, bool* shouldInsert);
+
+    // Saves data for the key most recently passed to find().
+    void insert(const Key&, PathDraw::MidpointFanData&&);
+
+    void clear();
+
+private:
+    struct Entry
+    {
+        Key key;
+        PathDraw::MidpointFanData data;
+        size_t sizeInBytes;
+        size_t slotIdx;
+        std::list<Entry>::iterator listIter;
+    };
+
+    // The cache is direct mapped: every key has exactly one slot, chosen by
+    // its hash, so a lookup only has to touch one slot. "hash" is the most
+    // recent key to miss in the slot.
+    struct Slot
+    {
+        size_t hash = 0;
+        Entry* entry = nullptr;
+    };
+
+    static size_t Hash(const Key&);
+
+    void eraseEntry(Entry*);
+
+    // Most recently used entries are at the front.
+    std::list<Entry> m_entries;
+    std::vector<Slot> m_slots;
+    size_t m_sizeInBytes = 0;
+};
+} // namespace rive::gpu
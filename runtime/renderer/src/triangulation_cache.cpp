@@ -0,0 +1,106 @@
+/*
+ * Copyright 2025 Rive
+ */
+
+#include "triangulation_cache.hpp"
+
+#include <string_view>
+
+namespace rive::gpu
+{
+// Number of slots in the direct-mapped table, and upper bound on how much
+// memory the cache holds onto between frames. Only large fills get
+// triangulated, so there are far fewer of them than tessellated paths.
+constexpr static size_t kSlotCount = 1024;
+constexpr static size_t kMaxSizeInBytes = 32 * 1024 * 1024;
+static_assert((kSlotCount & (kSlotCount - 1)) == 0);
+
+TriangulationCache::Key::Key(uint64_t rawPathMutationID_,
+                             const Mat2D& matrix,
+                             FillRule fillRule,
+                             bool horizontalAxis,
+                             bool negateWinding) :
+    rawPathMutationID(rawPathMutationID_),
+    matrixBits{math::bit_cast<uint32_t>(matrix.xx()),
+               math::bit_cast<uint32_t>(matrix.xy()),
+               math::bit_cast<uint32_t>(matrix.yx()),
+               math::bit_cast<uint32_t>(matrix.yy())},
+    fillRuleAxisAndWinding((static_cast<uint32_t>(fillRule) << 2) |
+                           (static_cast<uint32_t>(horizontalAxis) << 1) |
+                           static_cast<uint32_t>(negateWinding))
+{}
+
+size_t TriangulationCache::Hash(const Key& key)
+{
+    return std::hash<std::string_view>()(
+        std::string_view(reinterpret_cast<const char*>(&key), sizeof(Key)));
+}
+
+const GrInnerFanTriangulator* TriangulationCache::find(const Key& key,
+                                                       bool* shouldInsert)
+{
+    if (m_slots.empty())
+    {
+        m_slots.resize(kSlotCount);
+    }
+    size_t hash = Hash(key);
+    Slot& slot = m_slots[hash & (kSlotCount - 1)];
+    if (slot.entry != nullptr && slot.entry->key == key)
+    {
+        m_entries.splice(m_entries.begin(), m_entries, slot.entry->listIter);
+        *shouldInsert = false;
+        return slot.entry->triangulator;
+    }
+    *shouldInsert = slot.hash == hash;
+    slot.hash = hash;
+    return nullptr;
+}
+
+void TriangulationCache::insert(const Key& key,
+                                std::unique_ptr<TrivialBlockAllocator> arena,
+                                const GrInnerFanTriangulator* triangulator)
+{
+    size_t slotIdx = Hash(key) & (kSlotCount - 1);
+    Slot& slot = m_slots[slotIdx];
+    if (slot.entry != nullptr)
+    {
+        // Evict the key that was in our slot.
+        assert(!(slot.entry->key == key));
+        evictEntry(slot.entry);
+    }
+    size_t sizeInBytes = sizeof(Entry) + arena->reservedSizeInBytes();
+    m_entries.push_front(
+        {key, std::move(arena), triangulator, sizeInBytes, slotIdx, {}});
+    m_entries.front().listIter = m_entries.begin();
+    slot.entry = &m_entries.front();
+    m_sizeInBytes += sizeInBytes;
+
+    // Purge least recently used entries until we're under budget. Never purge
+    // the entry we just inserted, even if it's too big on its own.
+    while (m_entries.size() > 1 && m_sizeInBytes > kMaxSizeInBytes)
+    {
+        evictEntry(&m_entries.back());
+    }
+}
+
+void TriangulationCache::releaseEvictedEntries() { m_evictedEntries.clear(); }
+
+void TriangulationCache::clear()
+{
+    m_entries.clear();
+    m_evictedEntries.clear();
+    m_slots.clear();
+    m_slots.shrink_to_fit();
+    m_sizeInBytes = 0;
+}
+
+void TriangulationCache::evictEntry(Entry* entry)
+{
+    m_slots[entry->slotIdx].entry = nullptr;
+    m_sizeInBytes -= entry->sizeInBytes;
+    // The triangulator may still be referenced by a draw in the current frame.
+    m_evictedEntries.splice(m_evictedEntries.end(),
+                            m_entries,
+                            entry->listIter);
+}
+} // namespace rive::gpu
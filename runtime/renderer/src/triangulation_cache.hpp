@@ -0,0 +1,106 @@
+/*
+ * Copyright 2025 Rive
+ */
+
+#pragma once
+
+#include "rive/math/mat2d.hpp"
+#include "rive/math/path_types.hpp"
+#include "rive/renderer/trivial_block_allocator.hpp"
+
+#include <cstring>
+#include <list>
+#include <memory>
+#include <vector>
+
+namespace rive
+{
+class GrInnerFanTriangulator;
+} // namespace rive
+
+namespace rive::gpu
+{
+// LRU cache of the interior triangulations built by
+// PathDraw::initForInteriorTriangulation(), so large fills that don't change
+// between frames don't have to run through GrTriangulator all over again.
+//
+// Each entry owns the arena its triangulator was built in. Translation doesn't
+// factor into the triangulation, so paths that only move still hit. PathDraws
+// in the current frame may still reference an entry after it gets evicted, so
+// evicted entries stay alive until releaseEvictedEntries().
+class TriangulationCache
+{
+public:
+    struct Key
+    {
+        Key() = default;
+        Key(uint64_t rawPathMutationID,
+            const Mat2D&,
+            FillRule,
+            bool horizontalAxis,
+            bool negateWinding);
+
+        bool operator==(const Key& other) const
+        {
+            return memcmp(this, &other, sizeof(Key)) == 0;
+        }
+
+        uint64_t rawPathMutationID;
+        // Bit patterns of the floats, so the comparison is exact and NaN
+        // equals itself.
+        uint32_t matrixBits[4];
+        uint32_t fillRuleAxisAndWinding;
+        uint32_t padding = 0;
+    };
+
+    // Returns the saved triangulator for "key", or null on a miss.
+    //
+    // Triangulations only get saved once a key has missed twice, so paths that
+    // mutate every frame don't pay for an arena of their own. On a miss,
+    // "shouldInsert" is set if the caller should build its triangulator in a
+    // new arena and pass both to insert().
+    const GrInnerFanTriangulator* find(const Key&, bool* shouldInsert);
+
+    // Saves the triangulator for the key most recently passed to find(), along
+    // with the arena that holds it.
+    void insert(const Key&,
+                std::unique_ptr<TrivialBlockAllocator> arena,
+                const GrInnerFanTriangulator*);
+
+    // Frees the entries that were evicted since the last call. Must only be
+    // called once no draws reference them anymore.
+    void releaseEvictedEntries();
+
+    void clear();
+
+private:
+    struct Entry
+    {
+        Key key;
+        std::unique_ptr<TrivialBlockAllocator> arena;
+        const GrInnerFanTriangulator* triangulator;
+        size_t sizeInBytes;
+        size_t slotIdx;
+        std::list<Entry>::iterator listIter;
+    };
+
+    // The cache is direct mapped: every key has exactly one slot, chosen by
+    // its hash, so a lookup only has to touch one slot. "hash" is the most
+    // recent key to miss in the slot.
+    struct Slot
+    {
+        size_t hash = 0;
+        Entry* entry = nullptr;
+    };
+
+    static size_t Hash(const Key&);
+
+    void evictEntry(Entry*);
+
+    // Most recently used entries are at the front.
+    std::list<Entry> m_entries;
+    std::list<Entry> m_evictedEntries;
+    std::vector<Slot> m_slots;
+    size_t m_sizeInBytes = 0;
+};
+} // namespace rive::gpu
@@ -0,0 +1,99 @@
+/*
+ * Copyright 2025 Rive
+ */
+
+#include "worker_pool.hpp"
+
+namespace rive::gpu
+{
+WorkerPool::WorkerPool(uint32_t threadCount)
+{
+    m_threads.reserve(threadCount);
+    for (uint32_t i = 0; i < threadCount; ++i)
+    {
+        m_threads.emplace_back([this]() { workerLoop(); });
+    }
+}
+
+WorkerPool::~WorkerPool()
+{
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_shutdown = true;
+    }
+    m_wakeWorkers.notify_all();
+    for (auto& thread : m_threads)
+    {
+        thread.join();
+    }
+}
+
+void WorkerPool::run(size_t count, const std::function<void(size_t)>& task)
+{
+    if (count == 0)
+    {
+        return;
+    }
+    if (count == 1 || m_threads.empty())
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            task(i);
+        }
+        return;
+    }
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_task = &task;
+        m_taskCount = count;
+        m_nextTask.store(0, std::memory_order_relaxed);
+        ++m_generation;
+    }
+    m_wakeWorkers.notify_all();
+    runTasks();
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_workersIdle.wait(lock, [this]() { return m_busyWorkers == 0; });
+    m_task = nullptr;
+}
+
+void WorkerPool::workerLoop()
+{
+    uint64_t seenGeneration = 0;
+    std::unique_lock<std::mutex> lock(m_mutex);
+    for (;;)
+    {
+        m_wakeWorkers.wait(lock, [&]() {
+            return m_shutdown || m_generation != seenGeneration;
+        });
+        if (m_shutdown)
+        {
+            return;
+        }
+        seenGeneration = m_generation;
+        // Late wakeups for a run whose tasks are all claimed must not touch it;
+        // run() may already have returned.
+        if (m_nextTask.load(std::memory_order_relaxed) >= m_taskCount)
+        {
+            continue;
+        }
+        ++m_busyWorkers;
+        lock.unlock();
+        runTasks();
+        lock.lock();
+        if (--m_busyWorkers == 0)
+        {
+            m_workersIdle.notify_one();
+        }
+    }
+}
+
+void WorkerPool::runTasks()
+{
+    for (size_t i = m_nextTask.fetch_add(1, std::memory_order_relaxed);
+         i < m_taskCount;
+         i = m_nextTask.fetch_add(1, std::memory_order_relaxed))
+    {
+        (*m_task)(i);
+    }
+}
+} // namespace rive::gpu
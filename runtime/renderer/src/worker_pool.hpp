@@ -0,0 +1,50 @@
+/*
+ * Copyright 2025 Rive
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace rive::gpu
+{
+// Fixed set of threads that execute batches of independent tasks. The thread
+// that calls run() participates in the work, so a pool with zero threads runs
+// everything serially on the caller.
+class WorkerPool
+{
+public:
+    WorkerPool(uint32_t threadCount);
+    ~WorkerPool();
+
+    // Number of threads that execute tasks, including the caller of run().
+    uint32_t concurrency() const
+    {
+        return static_cast<uint32_t>(m_threads.size()) + 1;
+    }
+
+    // Calls task(i) for every i in [0, count) and returns once all calls have
+    // finished.
+    void run(size_t count, const std::function<void(size_t)>& task);
+
+private:
+    void workerLoop();
+    void runTasks();
+
+    std::vector<std::thread> m_threads;
+    std::mutex m_mutex;
+    std::condition_variable m_wakeWorkers;
+    std::condition_variable m_workersIdle;
+    const std::function<void(size_t)>* m_task = nullptr;
+    size_t m_taskCount = 0;
+    std::atomic<size_t> m_nextTask{0};
+    uint64_t m_generation = 0;
+    uint32_t m_busyWorkers = 0;
+    bool m_shutdown = false;
+};
+} // namespace rive::gpu
@@ -0,0 +1,189 @@
+/*
+ * Copyright 2025 Rive
+ */
+
+// Replays interior polygons recorded by "flush_bench --trace-triangulations"
+// through GrInnerFanTriangulator, and reports the time spent per path.
+//
+//   triangulation_bench [--iterations N] trace.txt...
+//
+// Each iteration triangulates every path and emits its triangles, allocating
+// from one arena that gets reset between iterations, the same way
+// RenderContext resets its per-frame allocator between frames. Also prints a
+// checksum of the emitted triangles and grout, which must not change when
+// optimizing GrTriangulator.
+
+#include "gr_inner_fan_triangulator.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <vector>
+
+using namespace rive;
+using namespace rive::gpu;
+
+struct TracePath
+{
+    RawPath path;
+    FillRule fillRule;
+    bool horizontalAxis;
+};
+
+static bool load_trace(const char* path, std::vector<TracePath>* paths)
+{
+    FILE* in = fopen(path, "r");
+    if (in == nullptr)
+    {
+        fprintf(stderr, "%s: failed to open\n", path);
+        return false;
+    }
+    char type[8];
+    while (fscanf(in, "%7s", type) == 1)
+    {
+        if (!strcmp(type, "path"))
+        {
+            int evenOdd, horizontalAxis;
+            if (fscanf(in, "%d %d", &evenOdd, &horizontalAxis) != 2)
+            {
+                break;
+            }
+            paths->push_back({RawPath(),
+                              evenOdd ? FillRule::evenOdd : FillRule::nonZero,
+                              horizontalAxis != 0});
+        }
+        else if ((!strcmp(type, "M") || !strcmp(type, "L")) && !paths->empty())
+        {
+            Vec2D pt;
+            if (fscanf(in, "%f %f", &pt.x, &pt.y) != 2)
+            {
+                break;
+            }
+            if (type[0] == 'M')
+            {
+                paths->back().path.move(pt);
+            }
+            else
+            {
+                paths->back().path.line(pt);
+            }
+        }
+        else
+        {
+            break;
+        }
+    }
+    bool success = feof(in);
+    fclose(in);
+    if (!success)
+    {
+        fprintf(stderr, "%s: malformed trace\n", path);
+    }
+    return success;
+}
+
+static double seconds_now()
+{
+    return std::chrono::duration<double>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+static uint64_t hash_bytes(uint64_t hash, const void* data, size_t sizeInBytes)
+{
+    // FNV-1a.
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < sizeInBytes; ++i)
+    {
+        hash = (hash ^ bytes[i]) * 0x100000001b3ull;
+    }
+    return hash;
+}
+
+int main(int argc, const char** argv)
+{
+    int iterations = 20;
+    std::vector<TracePath> paths;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (!strcmp(argv[i], "--iterations") && i + 1 < argc)
+        {
+            iterations = atoi(argv[++i]);
+        }
+        else if (!load_trace(argv[i], &paths))
+        {
+            return 1;
+        }
+    }
+    if (paths.empty() || iterations <= 0)
+    {
+        fprintf(stderr,
+                "usage: triangulation_bench [--iterations N] trace.txt...\n");
+        return 1;
+    }
+
+    size_t pointCount = 0;
+    for (const TracePath& path : paths)
+    {
+        pointCount += path.path.points().size();
+    }
+
+    TrivialBlockAllocator arena(GrTriangulator::kArenaDefaultChunkSize);
+    std::unique_ptr<TriangleVertex[]> vertices;
+    size_t vertexCapacity = 0;
+    uint64_t checksum = 0;
+    size_t vertexCount = 0;
+    double bestSeconds = std::numeric_limits<double>::infinity();
+    for (int i = 0; i < iterations; ++i)
+    {
+        checksum = 0xcbf29ce484222325ull;
+        vertexCount = 0;
+        double t0 = seconds_now();
+        for (const TracePath& path : paths)
+        {
+            auto* triangulator = arena.make<GrInnerFanTriangulator>(
+                path.path,
+                Mat2D(),
+                path.horizontalAxis
+                    ? GrTriangulator::Comparator::Direction::kHorizontal
+                    : GrTriangulator::Comparator::Direction::kVertical,
+                path.fillRule,
+                &arena);
+            if (vertexCapacity < triangulator->maxVertexCount())
+            {
+                vertexCapacity = triangulator->maxVertexCount();
+                vertices.reset(new TriangleVertex[vertexCapacity]);
+            }
+            WriteOnlyMappedMemory<TriangleVertex> mappedMemory(vertices.get(),
+                                                               vertexCapacity);
+            size_t count = triangulator->polysToTriangles(1,
+                                                          WindingFaces::all,
+                                                          &mappedMemory);
+            checksum = hash_bytes(checksum,
+                                  vertices.get(),
+                                  count * sizeof(TriangleVertex));
+            for (auto* node = triangulator->groutList().head(); node;
+                 node = node->fNext)
+            {
+                checksum = hash_bytes(checksum, node->fPts, sizeof(node->fPts));
+            }
+            vertexCount += count;
+        }
+        bestSeconds = std::min(seconds_now() - t0, bestSeconds);
+        arena.reset();
+    }
+
+    printf("%zu paths, %zu points, %zu triangle vertices\n",
+           paths.size(),
+           pointCount,
+           vertexCount);
+    printf("best of %d: %.3f ms (%.1f us per path)\n",
+           iterations,
+           bestSeconds * 1e3,
+           bestSeconds * 1e6 / static_cast<double>(paths.size()));
+    printf("checksum %016llx\n", static_cast<unsigned long long>(checksum));
+    return 0;
+}
@@ -37,6 +37,7 @@ void AnimationReset::complete()
 
 void AnimationReset::apply(Artboard* artboard)
 {
+    artboard->markDrawingDirty();
     m_binaryReader.reset(&m_WriteBuffer.front());
     while (!m_binaryReader.isEOF())
     {
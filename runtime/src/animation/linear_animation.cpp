@@ -60,6 +60,9 @@ void LinearAnimation::apply(Artboard* artboard, float time, float mix) const
         float ffps = (float)fps();
         time = std::floor(time * ffps) / ffps;
     }
+    // Keyed properties are set directly, and some (e.g. colors) don't dirty
+    // their components.
+    artboard->markDrawingDirty();
     for (const auto& object : m_KeyedObjects)
     {
         object->apply(artboard, time, mix);
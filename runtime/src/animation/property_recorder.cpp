@@ -342,6 +342,7 @@ void PropertyRecorder::apply(StateMachineInstance* stateMachineInstace)
 
 void PropertyRecorder::apply(Artboard* artboard)
 {
+    artboard->markDrawingDirty();
     m_binaryReader.reset(&m_WriteBuffer.front());
     while (!m_binaryReader.isEOF())
     {
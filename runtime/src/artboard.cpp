@@ -13,6 +13,7 @@
 #include "rive/drawable.hpp"
 #include "rive/animation/keyed_object.hpp"
 #include "rive/factory.hpp"
+#include "rive/picture.hpp"
 #include "rive/renderer.hpp"
 #include "rive/shapes/paint/shape_paint.hpp"
 #include "rive/importers/import_stack.hpp"
@@ -597,6 +598,7 @@ uint32_t Artboard::idOf(Core* object) const
 void Artboard::onComponentDirty(Component* component)
 {
     m_Dirt |= ComponentDirt::Components;
+    markDrawingDirty();
 
     /// If the order of the component is less than the current dirt
     /// depth, update the dirt depth so that the update loop can break
@@ -610,6 +612,7 @@ void Artboard::onComponentDirty(Component* component)
 void Artboard::onDirty(ComponentDirt dirt)
 {
     m_Dirt |= ComponentDirt::Components;
+    markDrawingDirty();
 }
 
 #ifdef WITH_RIVE_LAYOUT
@@ -798,6 +801,7 @@ void Artboard::updateDataBinds()
         }
         dataBind->dirt(ComponentDirt::None);
         dataBind->update(d);
+        markDrawingDirty();
     }
 }
 
@@ -807,6 +811,7 @@ bool Artboard::updateComponents()
     {
         return false;
     }
+    markDrawingDirty();
     const int maxSteps = 100;
     int step = 0;
     auto count = m_DependencyOrder.size();
@@ -1171,6 +1176,78 @@ void Artboard::draw(Renderer* renderer, DrawOption option)
     {
         return;
     }
+    if (!m_usePictureCache)
+    {
+        drawInternal(renderer, option);
+        return;
+    }
+
+    uint64_t generation = drawGeneration();
+    if (m_cachedPicture != nullptr &&
+        m_cachedPictureGeneration == generation &&
+        m_cachedPictureOption == option)
+    {
+        renderer->drawPicture(*m_cachedPicture);
+        return;
+    }
+    m_cachedPicture = nullptr;
+
+    // Don't record while something is changing or waiting to be updated.
+    bool isStable = generation == m_lastDrawGeneration &&
+                    !hasDirt(ComponentDirt::Components);
+    m_lastDrawGeneration = generation;
+    if (!isStable)
+    {
+        drawInternal(renderer, option);
+        return;
+    }
+
+    PictureRecorder recorder;
+    if (clip())
+    {
+        // The clip bounds everything the artboard draws.
+        recorder.bounds(bounds());
+    }
+    drawInternal(&recorder, option);
+    m_cachedPicture = recorder.finishRecording();
+    m_cachedPictureGeneration = generation;
+    m_cachedPictureOption = option;
+    renderer->drawPicture(*m_cachedPicture);
+}
+
+void Artboard::usePictureCache(bool value)
+{
+    m_usePictureCache = value;
+    if (!value)
+    {
+        m_cachedPicture = nullptr;
+    }
+}
+
+uint64_t Artboard::drawGeneration()
+{
+    // Mix in the generations of hosted artboards, since their content is
+    // drawn as part of ours.
+    uint64_t generation = m_drawGeneration;
+    for (auto artboardHost : m_ArtboardHosts)
+    {
+        size_t count = artboardHost->artboardCount();
+        for (size_t i = 0; i < count; i++)
+        {
+            ArtboardInstance* instance =
+                artboardHost->artboardInstance(static_cast<int>(i));
+            if (instance != nullptr)
+            {
+                generation = (generation ^ instance->drawGeneration()) *
+                             0x100000001b3ull;
+            }
+        }
+    }
+    return generation;
+}
+
+void Artboard::drawInternal(Renderer* renderer, DrawOption option)
+{
     bool save = clip() || m_FrameOrigin;
     if (save)
     {
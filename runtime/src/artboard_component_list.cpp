@@ -8,6 +8,7 @@
 #include "rive/viewmodel/viewmodel_instance_symbol_list_index.hpp"
 #include "rive/world_transform_component.hpp"
 #include "rive/layout/layout_data.hpp"
+#include <unordered_set>
 
 using namespace rive;
 
@@ -204,11 +205,30 @@ void ArtboardComponentList::linkStateMachineToArtboard(
 void ArtboardComponentList::updateList(
     std::vector<rcp<ViewModelInstanceListItem>>* list)
 {
+    if (list->size() == m_listItems.size() &&
+        std::equal(list->begin(), list->end(), m_listItems.begin()))
+    {
+        // Nothing was inserted, removed or moved since the last update, but
+        // an item's view model may still have been swapped for one with a
+        // different artboard, so keep its index and size current, and only
+        // redo layout if a size actually changed.
+        std::vector<Vec2D> oldSizes;
+        oldSizes.swap(m_artboardSizes);
+        updateItemIndicesAndSizes();
+        if (oldSizes != m_artboardSizes)
+        {
+            computeLayoutBounds();
+            syncLayoutChildren();
+            markLayoutNodeDirty();
+            markWorldTransformDirty();
+            addDirt(ComponentDirt::Components);
+        }
+        return;
+    }
     m_oldItems.clear();
-    m_oldItems.assign(m_listItems.begin(), m_listItems.end());
-    m_listItems.clear();
+    m_oldItems.swap(m_listItems);
     m_listItems.assign(list->begin(), list->end());
-    m_artboardSizes.clear();
+    updateItemIndicesAndSizes();
 
     auto p = layoutParent();
     if (p != nullptr)
@@ -217,17 +237,80 @@ void ArtboardComponentList::updateList(
         p->clearLayoutChildren();
 #endif
     }
+    // Diff the old items against the new ones by key. Instances are stored by
+    // list item so retained items keep their artboard and state machine no
+    // matter where they moved to. Removed items that show up again wrapped in
+    // a new list item (same view model instance) hand their instances over
+    // instead of being destroyed and recreated.
     // We need to dispose old items after the layout children of the parent have
     // updated to ensure no bad YGNodes are being hosted from the old data
     // during clearLayoutChildren.
-    for (auto item : m_oldItems)
+    bool canAdopt = !virtualizationEnabled();
+    std::unordered_set<ViewModelInstanceListItem*> retainedItems;
+    retainedItems.reserve(m_listItems.size());
+    for (auto& item : m_listItems)
     {
-        auto it = std::find(m_listItems.begin(), m_listItems.end(), item);
-        if (it == m_listItems.end())
+        retainedItems.insert(item.get());
+    }
+    std::unordered_multimap<ViewModelInstance*, rcp<ViewModelInstanceListItem>>
+        orphanedItems;
+    for (auto& item : m_oldItems)
+    {
+        if (retainedItems.count(item.get()) != 0)
+        {
+            continue;
+        }
+        auto viewModelInstance = item->viewModelInstance();
+        if (canAdopt && viewModelInstance != nullptr &&
+            m_artboardInstancesMap.count(item) != 0)
+        {
+            orphanedItems.emplace(viewModelInstance.get(), item);
+        }
+        else
         {
             disposeListItem(item);
         }
     }
+    // Layout children are synced once below instead of once per created
+    // artboard.
+    m_deferLayoutSync = true;
+    uint32_t index = 0;
+    for (auto& item : m_listItems)
+    {
+        auto viewModelInstance = item->viewModelInstance();
+        auto itr = m_artboardInstancesMap.find(item);
+        if (!virtualizationEnabled() && itr == m_artboardInstancesMap.end())
+        {
+            auto orphan = viewModelInstance != nullptr
+                              ? orphanedItems.find(viewModelInstance.get())
+                              : orphanedItems.end();
+            if (orphan != orphanedItems.end())
+            {
+                adoptArtboard(orphan->second, item);
+                orphanedItems.erase(orphan);
+            }
+            else
+            {
+                createArtboardAt(index);
+            }
+        }
+        index++;
+    }
+    m_deferLayoutSync = false;
+    for (auto& orphan : orphanedItems)
+    {
+        disposeListItem(orphan.second);
+    }
+    computeLayoutBounds();
+    syncLayoutChildren();
+    markLayoutNodeDirty();
+    markWorldTransformDirty();
+    addDirt(ComponentDirt::Components);
+}
+
+void ArtboardComponentList::updateItemIndicesAndSizes()
+{
+    m_artboardSizes.clear();
     uint32_t index = 0;
     for (auto& item : m_listItems)
     {
@@ -248,22 +331,37 @@ void ArtboardComponentList::updateList(
             m_artboardSizes.push_back(
                 Vec2D(artboard->width(), artboard->height()));
         }
-        auto itr = m_artboardInstancesMap.find(item);
-        if (!virtualizationEnabled() && itr == m_artboardInstancesMap.end())
-        {
-            createArtboardAt(index);
-        }
         index++;
     }
-    computeLayoutBounds();
-    syncLayoutChildren();
-    markLayoutNodeDirty();
-    markWorldTransformDirty();
-    addDirt(ComponentDirt::Components);
+}
+
+void ArtboardComponentList::adoptArtboard(
+    const rcp<ViewModelInstanceListItem>& from,
+    const rcp<ViewModelInstanceListItem>& to)
+{
+    // Both items wrap the same view model instance, so the artboard is already
+    // bound to the right data and its override (keyed by view model) still
+    // applies.
+    auto artboardItr = m_artboardInstancesMap.find(from);
+    if (artboardItr != m_artboardInstancesMap.end())
+    {
+        m_artboardInstancesMap[to] = std::move(artboardItr->second);
+        m_artboardInstancesMap.erase(artboardItr);
+    }
+    auto smItr = m_stateMachinesMap.find(from);
+    if (smItr != m_stateMachinesMap.end())
+    {
+        m_stateMachinesMap[to] = std::move(smItr->second);
+        m_stateMachinesMap.erase(smItr);
+    }
 }
 
 void ArtboardComponentList::syncLayoutChildren()
 {
+    if (m_deferLayoutSync)
+    {
+        return;
+    }
     auto p = layoutParent();
     if (p != nullptr)
     {
@@ -4,34 +4,48 @@
 
 #include "rive/command_queue.hpp"
 
+#include <chrono>
+#include <cmath>
+
 namespace rive
 {
-namespace
-{
-// RAII utility to lock a mutex, and call notify_one() on a condition variable
-// immediately before unlocking.
-class AutoLockAndNotify
+// RAII utility to lock the command mutex, and call notify_one() on the command
+// condition variable immediately before unlocking. While metrics are enabled,
+// it also timestamps whatever command gets recorded under the lock.
+class CommandQueue::AutoLockAndNotify
 {
 public:
-    AutoLockAndNotify(std::mutex& mutex, std::condition_variable& cv) :
-        m_mutex(mutex), m_cv(cv)
+    AutoLockAndNotify(CommandQueue* queue) : m_queue(queue)
     {
-        m_mutex.lock();
+        m_queue->m_commandMutex.lock();
+        if (m_queue->m_metricsEnabled)
+        {
+            m_commandOffset = m_queue->m_commandStream.bytesWritten();
+            m_enqueueTime = Metrics::now();
+        }
     }
 
     ~AutoLockAndNotify()
     {
-        m_cv.notify_one();
-        m_mutex.unlock();
+        // Nothing is written for commands that were coalesced into an earlier
+        // one, so only stamp when the stream actually grew.
+        if (m_enqueueTime != 0 &&
+            m_queue->m_commandStream.bytesWritten() != m_commandOffset)
+        {
+            m_queue->m_commandTimestamps
+                << CommandTimestamp{m_commandOffset, m_enqueueTime};
+        }
+        m_queue->m_commandConditionVariable.notify_one();
+        m_queue->m_commandMutex.unlock();
     }
 
 private:
-    std::mutex& m_mutex;
-    std::condition_variable& m_cv;
+    CommandQueue* m_queue;
+    uint64_t m_commandOffset = 0;
+    uint64_t m_enqueueTime = 0;
 };
-}; // namespace
 
-CommandQueue::CommandQueue() {}
+CommandQueue::CommandQueue() : m_metrics(rivestd::make_unique<Metrics>()) {}
 
 CommandQueue::~CommandQueue() {}
 
@@ -49,7 +63,7 @@ FileHandle CommandQueue::loadFile(std::vector<uint8_t> rivBytes,
         registerListener(handle, listener);
     }
 
-    AutoLockAndNotify lock(m_commandMutex, m_commandConditionVariable);
+    AutoLockAndNotify lock(this);
     m_commandStream << Command::loadFile;
     m_commandStream << handle;
     m_commandStream << requestId;
@@ -60,7 +74,7 @@ FileHandle CommandQueue::loadFile(std::vector<uint8_t> rivBytes,
 
 void CommandQueue::deleteFile(FileHandle fileHandle, uint64_t requestId)
 {
-    AutoLockAndNotify lock(m_commandMutex, m_commandConditionVariable);
+    AutoLockAndNotify lock(this);
     m_commandStream << Command::deleteFile;
     m_commandStream << fileHandle;
     m_commandStream << requestId;
@@ -70,7 +84,7 @@ void CommandQueue::addGlobalImageAsset(std::string name,
                                        RenderImageHandle handle,
                                        uint64_t requestId)
 {
-    AutoLockAndNotify lock(m_commandMutex, m_commandConditionVariable);
+    AutoLockAndNotify lock(this);
     m_commandStream << Command::addImageFileAsset;
     m_commandStream << handle;
     m_commandStream << requestId;
@@ -81,7 +95,7 @@ void CommandQueue::addGlobalFontAsset(std::string name,
                                       FontHandle handle,
                                       uint64_t requestId)
 {
-    AutoLockAndNotify lock(m_commandMutex, m_commandConditionVariable);
+    AutoLockAndNotify lock(this);
     m_commandStream << Command::addFontFileAsset;
     m_commandStream << handle;
     m_commandStream << requestId;
@@ -92,7 +106,7 @@ void CommandQueue::addGlobalAudioAsset(std::string name,
                                        AudioSourceHandle handle,
                                        uint64_t requestId)
 {
-    AutoLockAndNotify lock(m_commandMutex, m_commandConditionVariable);
+    AutoLockAndNotify lock(this);
     m_commandStream << Command::addAudioFileAsset;
     m_commandStream << handle;
     m_commandStream << requestId;
@@ -101,7 +115,7 @@ void CommandQueue::addGlobalAudioAsset(std::string name,
 
 void CommandQueue::removeGlobalImageAsset(std::string name, uint64_t requestId)
 {
-    AutoLockAndNotify lock(m_commandMutex, m_commandConditionVariable);
+    AutoLockAndNotify lock(this);
     m_commandStream << Command::removeImageFileAsset;
     m_commandStream << requestId;
     m_names << name;
@@ -109,7 +123,7 @@ void CommandQueue::removeGlobalImageAsset(std::string name, uint64_t requestId)
 
 void CommandQueue::removeGlobalFontAsset(std::string name, uint64_t requestId)
 {
-    AutoLockAndNotify lock(m_commandMutex, m_commandConditionVariable);
+    AutoLockAndNotify lock(this);
     m_commandStream << Command::removeFontFileAsset;
     m_commandStream << requestId;
     m_names << name;
@@ -117,7 +131,7 @@ void CommandQueue::removeGlobalFontAsset(std::string name, uint64_t requestId)
 
 void CommandQueue::removeGlobalAudioAsset(std::string name, uint64_t requestId)
 {
-    AutoLockAndNotify lock(m_commandMutex, m_commandConditionVariable);
+    AutoLockAndNotify lock(this);
     m_commandStream << Command::removeAudioFileAsset;
     m_commandStream << requestId;
     m_names << name;
@@ -140,7 +154,7 @@ ArtboardHandle CommandQueue::instantiateArtboardNamed(
         registerListener(handle, listener);
     }
 
-    AutoLockAndNotify lock(m_commandMutex, m_commandConditionVariable);
+    AutoLockAndNotify lock(this);
     m_commandStream << Command::instantiateArtboard;
     m_commandStream << handle;
     m_commandStream << fileHandle;
@@ -153,7 +167,7 @@ ArtboardHandle CommandQueue::instantiateArtboardNamed(
 void CommandQueue::deleteArtboard(ArtboardHandle artboardHandle,
                                   uint64_t requestId)
 {
-    AutoLockAndNotify lock(m_commandMutex, m_commandConditionVariable);
+    AutoLockAndNotify lock(this);
     m_commandStream << Command::deleteArtboard;
     m_commandStream << artboardHandle;
     m_commandStream << requestId;
@@ -174,7 +188,7 @@ ViewModelInstanceHandle CommandQueue::instantiateBlankViewModelInstance(
         listener->m_owningQueue = ref_rcp(this);
         registerListener(viewHandle, listener);
     }
-    AutoLockAndNotify lock(m_commandMutex, m_commandConditionVariable);
+    AutoLockAndNotify lock(this);
     m_commandStream << Command::instantiateBlankViewModelForArtboard;
     m_commandStream << fileHandle;
     m_commandStream << artboardHandle;
@@ -199,7 +213,7 @@ ViewModelInstanceHandle CommandQueue::instantiateBlankViewModelInstance(
         listener->m_owningQueue = ref_rcp(this);
         registerListener(viewHandle, listener);
     }
-    AutoLockAndNotify lock(m_commandMutex, m_commandConditionVariable);
+    AutoLockAndNotify lock(this);
     m_commandStream << Command::instantiateBlankViewModel;
     m_commandStream << fileHandle;
     m_commandStream << viewHandle;
@@ -225,7 +239,7 @@ ViewModelInstanceHandle CommandQueue::instantiateViewModelInstanceNamed(
         listener->m_owningQueue = ref_rcp(this);
         registerListener(viewHandle, listener);
     }
-    AutoLockAndNotify lock(m_commandMutex, m_commandConditionVariable);
+    AutoLockAndNotify lock(this);
     m_commandStream << Command::instantiateViewModelForArtboard;
     m_commandStream << fileHandle;
     m_commandStream << artboardHandle;
@@ -252,7 +266,7 @@ ViewModelInstanceHandle CommandQueue::instantiateViewModelInstanceNamed(
         listener->m_owningQueue = ref_rcp(this);
         registerListener(viewHandle, listener);
     }
-    AutoLockAndNotify lock(m_commandMutex, m_commandConditionVariable);
+    AutoLockAndNotify lock(this);
     m_commandStream << Command::instantiateViewModel;
     m_commandStream << fileHandle;
     m_commandStream << viewHandle;
@@ -278,7 +292,7 @@ ViewModelInstanceHandle CommandQueue::referenceNestedViewModelInstance(
         listener->m_owningQueue = ref_rcp(this);
         registerListener(viewHandle, listener);
     }
-    AutoLockAndNotify lock(m_commandMutex, m_commandConditionVariable);
+    AutoLockAndNotify lock(this);
     m_commandStream << Command::refNestedViewModel;
     m_commandStream << handle;
     m_commandStream << viewHandle;
@@ -304,7 +318,7 @@ ViewModelInstanceHandle CommandQueue::referenceListViewModelInstance(
         listener->m_owningQueue = ref_rcp(this);
         registerListener(viewHandle, listener);
     }
-    AutoLockAndNotify lock(m_commandMutex, m_commandConditionVariable);
+    AutoLockAndNotify lock(this);
     m_commandStream << Command::refListViewModel;
     m_commandStream << handle;
     m_commandStream << index;
@@ -319,7 +333,7 @@ void CommandQueue::fireViewModelTrigger(ViewModelInstanceHandle handle,
                                         std::string path,
                                         uint64_t requestId)
 {
-    AutoLockAndNotify lock(m_commandMutex, m_commandConditionVariable);
+    AutoLockAndNotify lock(this);
     m_commandStream << Command::setViewModelInstanceValue;
     m_commandStream << handle;
     m_commandStream << DataType::trigger;
@@ -327,18 +341,243 @@ void CommandQueue::fireViewModelTrigger(ViewModelInstanceHandle handle,
     m_names << path;
 }
 
-void CommandQueue::setViewModelInstanceBool(ViewModelInstanceHandle handle,
+void CommandQueue::setCommandCoalescing(bool enabled)
+{
+    std::unique_lock<std::mutex> lock(m_commandMutex);
+    m_coalesceCommands = enabled;
+    m_coalescedWrites.clear();
+    m_lastPointerMove = {};
+}
+
+void CommandQueue::setMetricsEnabled(bool enabled)
+{
+    std::unique_lock<std::mutex> lock(m_commandMutex);
+    m_metricsEnabled = enabled;
+}
+
+CommandQueue::Metrics CommandQueue::metrics() const
+{
+    std::unique_lock<std::mutex> lock(m_metricsMutex);
+    return *m_metrics;
+}
+
+void CommandQueue::resetMetrics()
+{
+    std::unique_lock<std::mutex> lock(m_metricsMutex);
+    *m_metrics = Metrics();
+}
+
+void CommandQueue::setMetricsReporting(float intervalSeconds,
+                                       MetricsCallback callback)
+{
+    std::unique_lock<std::mutex> lock(m_commandMutex);
+    m_metricsReportInterval =
+        callback ? static_cast<uint64_t>(std::max(intervalSeconds, 0.f) * 1e9f)
+                 : 0;
+    m_metricsCallback = std::move(callback);
+}
+
+uint64_t CommandQueue::Metrics::Histogram::percentileNs(float percentile) const
+{
+    if (count == 0)
+    {
+        return 0;
+    }
+    uint64_t target = static_cast<uint64_t>(
+        std::ceil(std::min(std::max(percentile, 0.f), 1.f) * count));
+    uint64_t seen = 0;
+    for (size_t i = 0; i < kBucketCount; ++i)
+    {
+        seen += buckets[i];
+        if (seen >= target && seen != 0)
+        {
+            return std::min(maxNs, (uint64_t(1) << i) * 1000);
+        }
+    }
+    return maxNs;
+}
+
+const char* CommandQueue::Metrics::commandName(size_t commandType)
+{
+    switch (static_cast<Command>(commandType))
+    {
+#define COMMAND_NAME(NAME)                                                     \
+    case Command::NAME:                                                        \
+        return #NAME;
+        COMMAND_NAME(loadFile)
+        COMMAND_NAME(deleteFile)
+        COMMAND_NAME(decodeImage)
+        COMMAND_NAME(externalImage)
+        COMMAND_NAME(decodeAudio)
+        COMMAND_NAME(externalAudio)
+        COMMAND_NAME(decodeFont)
+        COMMAND_NAME(externalFont)
+        COMMAND_NAME(deleteImage)
+        COMMAND_NAME(deleteAudio)
+        COMMAND_NAME(deleteFont)
+        COMMAND_NAME(addImageFileAsset)
+        COMMAND_NAME(addAudioFileAsset)
+        COMMAND_NAME(addFontFileAsset)
+        COMMAND_NAME(removeImageFileAsset)
+        COMMAND_NAME(removeAudioFileAsset)
+        COMMAND_NAME(removeFontFileAsset)
+        COMMAND_NAME(instantiateArtboard)
+        COMMAND_NAME(deleteArtboard)
+        COMMAND_NAME(instantiateViewModel)
+        COMMAND_NAME(refNestedViewModel)
+        COMMAND_NAME(refListViewModel)
+        COMMAND_NAME(instantiateBlankViewModel)
+        COMMAND_NAME(instantiateViewModelForArtboard)
+        COMMAND_NAME(instantiateBlankViewModelForArtboard)
+        COMMAND_NAME(setViewModelInstanceValue)
+        COMMAND_NAME(addViewModelListValue)
+        COMMAND_NAME(removeViewModelListValue)
+        COMMAND_NAME(swapViewModelListValue)
+        COMMAND_NAME(subscribeViewModelProperty)
+        COMMAND_NAME(unsubscribeViewModelProperty)
+        COMMAND_NAME(deleteViewModel)
+        COMMAND_NAME(instantiateStateMachine)
+        COMMAND_NAME(deleteStateMachine)
+        COMMAND_NAME(advanceStateMachine)
+        COMMAND_NAME(bindViewModelInstance)
+        COMMAND_NAME(runOnce)
+        COMMAND_NAME(draw)
+        COMMAND_NAME(pointerMove)
+        COMMAND_NAME(pointerDown)
+        COMMAND_NAME(pointerUp)
+        COMMAND_NAME(pointerExit)
+        COMMAND_NAME(disconnect)
+        COMMAND_NAME(commandLoopBreak)
+        COMMAND_NAME(listViewModelEnums)
+        COMMAND_NAME(listArtboards)
+        COMMAND_NAME(listStateMachines)
+        COMMAND_NAME(getDefaultViewModel)
+        COMMAND_NAME(listViewModels)
+        COMMAND_NAME(listViewModelInstanceNames)
+        COMMAND_NAME(listViewModelProperties)
+        COMMAND_NAME(listViewModelPropertyValue)
+        COMMAND_NAME(getViewModelListSize)
+#undef COMMAND_NAME
+    }
+    return "unknown";
+}
+
+uint64_t CommandQueue::Metrics::now()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+CommandQueue::CoalescedWrite* CommandQueue::findCoalescableWrite(
+    const CoalescedWriteKey& key)
+{
+    if (m_commandStream.bytesWritten() != m_coalescedWritesEnd)
+    {
+        // Something other than a value write was recorded since the last
+        // one. Later writes must not jump over it.
+        m_coalescedWrites.clear();
+        return nullptr;
+    }
+    auto itr = m_coalescedWrites.find(key);
+    if (itr == m_coalescedWrites.end() ||
+        itr->second.commandOffset < m_commandStream.bytesRead())
+    {
+        // Not queued, or the server already consumed it.
+        return nullptr;
+    }
+    return &itr->second;
+}
+
+template <typename T>
+void CommandQueue::setViewModelInstanceValue(ViewModelInstanceHandle handle,
+                                             DataType type,
+                                             std::string path,
+                                             T value,
+                                             uint64_t requestId)
+{
+    AutoLockAndNotify lock(this);
+    if (!m_coalesceCommands)
+    {
+        m_commandStream << Command::setViewModelInstanceValue;
+        m_commandStream << handle;
+        m_commandStream << type;
+        m_commandStream << requestId;
+        m_commandStream << value;
+        m_names << std::move(path);
+        return;
+    }
+
+    CoalescedWriteKey key = {handle, type, path};
+    if (auto pending = findCoalescableWrite(key))
+    {
+        m_commandStream.overwrite(pending->requestIdOffset, requestId);
+        m_commandStream.overwrite(pending->valueLocation, value);
+        return;
+    }
+    CoalescedWrite write;
+    write.commandOffset = m_commandStream.bytesWritten();
+    m_commandStream << Command::setViewModelInstanceValue;
+    m_commandStream << handle;
+    m_commandStream << type;
+    write.requestIdOffset = m_commandStream.bytesWritten();
+    m_commandStream << requestId;
+    write.valueLocation = m_commandStream.bytesWritten();
+    m_commandStream << value;
+    m_names << std::move(path);
+    m_coalescedWrites[std::move(key)] = write;
+    m_coalescedWritesEnd = m_commandStream.bytesWritten();
+}
+
+void CommandQueue::setViewModelInstanceText(ViewModelInstanceHandle handle,
+                                            DataType type,
                                             std::string path,
-                                            bool value,
+                                            std::string value,
                                             uint64_t requestId)
 {
-    AutoLockAndNotify lock(m_commandMutex, m_commandConditionVariable);
+    AutoLockAndNotify lock(this);
+    if (!m_coalesceCommands)
+    {
+        m_commandStream << Command::setViewModelInstanceValue;
+        m_commandStream << handle;
+        m_commandStream << type;
+        m_commandStream << requestId;
+        m_names << std::move(path);
+        m_names << std::move(value);
+        return;
+    }
+
+    CoalescedWriteKey key = {handle, type, path};
+    if (auto pending = findCoalescableWrite(key))
+    {
+        m_commandStream.overwrite(pending->requestIdOffset, requestId);
+        m_names.overwrite(pending->valueLocation, std::move(value));
+        return;
+    }
+    CoalescedWrite write;
+    write.commandOffset = m_commandStream.bytesWritten();
     m_commandStream << Command::setViewModelInstanceValue;
     m_commandStream << handle;
-    m_commandStream << DataType::boolean;
+    m_commandStream << type;
+    write.requestIdOffset = m_commandStream.bytesWritten();
     m_commandStream << requestId;
-    m_commandStream << value;
-    m_names << path;
+    m_names << std::move(path);
+    write.valueLocation = m_names.writeCount();
+    m_names << std::move(value);
+    m_coalescedWrites[std::move(key)] = write;
+    m_coalescedWritesEnd = m_commandStream.bytesWritten();
+}
+
+void CommandQueue::setViewModelInstanceBool(ViewModelInstanceHandle handle,
+                                            std::string path,
+                                            bool value,
+                                            uint64_t requestId)
+{
+    setViewModelInstanceValue(handle,
+                              DataType::boolean,
+                              std::move(path),
+                              value,
+                              requestId);
 }
 
 void CommandQueue::setViewModelInstanceNumber(ViewModelInstanceHandle handle,
@@ -346,13 +585,11 @@ void CommandQueue::setViewModelInstanceNumber(ViewModelInstanceHandle handle,
                                               float value,
                                               uint64_t requestId)
 {
-    AutoLockAndNotify lock(m_commandMutex, m_commandConditionVariable);
-    m_commandStream << Command::setViewModelInstanceValue;
-    m_commandStream << handle;
-    m_commandStream << DataType::number;
-    m_commandStream << requestId;
-    m_commandStream << value;
-    m_names << path;
+    setViewModelInstanceValue(handle,
+                              DataType::number,
+                              std::move(path),
+                              value,
+                              requestId);
 }
 
 void CommandQueue::setViewModelInstanceColor(ViewModelInstanceHandle handle,
@@ -360,13 +597,11 @@ void CommandQueue::setViewModelInstanceColor(ViewModelInstanceHandle handle,
                                              ColorInt value,
                                              uint64_t requestId)
 {
-    AutoLockAndNotify lock(m_commandMutex, m_commandConditionVariable);
-    m_commandStream << Command::setViewModelInstanceValue;
-    m_commandStream << handle;
-    m_commandStream << DataType::color;
-    m_commandStream << requestId;
-    m_commandStream << value;
-    m_names << path;
+    setViewModelInstanceValue(handle,
+                              DataType::color,
+                              std::move(path),
+                              value,
+                              requestId);
 }
 
 void CommandQueue::setViewModelInstanceEnum(ViewModelInstanceHandle handle,
@@ -374,13 +609,11 @@ void CommandQueue::setViewModelInstanceEnum(ViewModelInstanceHandle handle,
                                             std::string value,
                                             uint64_t requestId)
 {
-    AutoLockAndNotify lock(m_commandMutex, m_commandConditionVariable);
-    m_commandStream << Command::setViewModelInstanceValue;
-    m_commandStream << handle;
-    m_commandStream << DataType::enumType;
-    m_commandStream << requestId;
-    m_names << path;
-    m_names << value;
+    setViewModelInstanceText(handle,
+                             DataType::enumType,
+                             std::move(path),
+                             std::move(value),
+                             requestId);
 }
 
 void CommandQueue::setViewModelInstanceString(ViewModelInstanceHandle handle,
@@ -388,13 +621,11 @@ void CommandQueue::setViewModelInstanceString(ViewModelInstanceHandle handle,
                                               std::string value,
                                               uint64_t requestId)
 {
-    AutoLockAndNotify lock(m_commandMutex, m_commandConditionVariable);
-    m_commandStream << Command::setViewModelInstanceValue;
-    m_commandStream << handle;
-    m_commandStream << DataType::string;
-    m_commandStream << requestId;
-    m_names << path;
-    m_names << value;
+    setViewModelInstanceText(handle,
+                             DataType::string,
+                             std::move(path),
+                             std::move(value),
+                             requestId);
 }
 
 void CommandQueue::setViewModelInstanceImage(ViewModelInstanceHandle handle,
@@ -402,7 +633,7 @@ void CommandQueue::setViewModelInstanceImage(ViewModelInstanceHandle handle,
                                              RenderImageHandle value,
                                              uint64_t requestId)
 {
-    AutoLockAndNotify lock(m_commandMutex, m_commandConditionVariable);
+    AutoLockAndNotify lock(this);
     m_commandStream << Command::setViewModelInstanceValue;
     m_commandStream << handle;
     m_commandStream << DataType::assetImage;
@@ -416,7 +647,7 @@ void CommandQueue::setViewModelInstanceArtboard(ViewModelInstanceHandle handle,
                                                 ArtboardHandle value,
                                                 uint64_t requestId)
 {
-    AutoLockAndNotify lock(m_commandMutex, m_commandConditionVariable);
+    AutoLockAndNotify lock(this);
     m_commandStream << Command::setViewModelInstanceValue;
     m_commandStream << handle;
     m_commandStream << DataType::artboard;
@@ -431,7 +662,7 @@ void CommandQueue::setViewModelInstanceNestedViewModel(
     ViewModelInstanceHandle value,
     uint64_t requestId)
 {
-    AutoLockAndNotify lock(m_commandMutex, m_commandConditionVariable);
+    AutoLockAndNotify lock(this);
     m_commandStream << Command::setViewModelInstanceValue;
     m_commandStream << handle;
     m_commandStream << DataType::viewModel;
@@ -447,7 +678,7 @@ void CommandQueue::insertViewModelInstanceListViewModel(
     int index,
     uint64_t requestId)
 {
-    AutoLockAndNotify lock(m_commandMutex, m_commandConditionVariable);
+    AutoLockAndNotify lock(this);
     m_commandStream << Command::addViewModelListValue;
     m_commandStream << handle;
     m_commandStream << value;
@@ -463,7 +694,7 @@ void CommandQueue::removeViewModelInstanceListViewModel(
     ViewModelInstanceHandle value,
     uint64_t requestId)
 {
-    AutoLockAndNotify lock(m_commandMutex, m_commandConditionVariable);
+    AutoLockAndNotify lock(this);
     m_commandStream << Command::removeViewModelListValue;
     m_commandStream << handle;
     m_commandStream << value;
@@ -479,7 +710,7 @@ void CommandQueue::swapViewModelInstanceListValues(
     int indexb,
     uint64_t requestId)
 {
-    AutoLockAndNotify lock(m_commandMutex, m_commandConditionVariable);
+    AutoLockAndNotify lock(this);
     m_commandStream << Command::swapViewModelListValue;
     m_commandStream << handle;
     m_commandStream << indexa;
@@ -493,7 +724,7 @@ void CommandQueue::subscribeToViewModelProperty(ViewModelInstanceHandle handle,
                                                 DataType type,
                                                 uint64_t requestId)
 {
-    AutoLockAndNotify lock(m_commandMutex, m_commandConditionVariable);
+    AutoLockAndNotify lock(this);
     m_commandStream << Command::subscribeViewModelProperty;
     m_commandStream << handle;
     m_commandStream << type;
@@ -507,7 +738,7 @@ void CommandQueue::unsubscribeToViewModelProperty(
     DataType type,
     uint64_t requestId)
 {
-    AutoLockAndNotify lock(m_commandMutex, m_commandConditionVariable);
+    AutoLockAndNotify lock(this);
     m_commandStream << Command::unsubscribeViewModelProperty;
     m_commandStream << handle;
     m_commandStream << type;
@@ -518,7 +749,7 @@ void CommandQueue::unsubscribeToViewModelProperty(
 void CommandQueue::deleteViewModelInstance(ViewModelInstanceHandle handle,
                                            uint64_t requestId)
 {
-    AutoLockAndNotify lock(m_commandMutex, m_commandConditionVariable);
+    AutoLockAndNotify lock(this);
     m_commandStream << Command::deleteViewModel;
     m_commandStream << handle;
     m_commandStream << requestId;
@@ -541,7 +772,7 @@ StateMachineHandle CommandQueue::instantiateStateMachineNamed(
         registerListener(handle, listener);
     }
 
-    AutoLockAndNotify lock(m_commandMutex, m_commandConditionVariable);
+    AutoLockAndNotify lock(this);
     m_commandStream << Command::instantiateStateMachine;
     m_commandStream << handle;
     m_commandStream << artboardHandle;
@@ -555,18 +786,40 @@ void CommandQueue::pointerMove(StateMachineHandle stateMachineHandle,
                                PointerEvent pointerEvent,
                                uint64_t requestId)
 {
-    AutoLockAndNotify lock(m_commandMutex, m_commandConditionVariable);
+    AutoLockAndNotify lock(this);
+    if (m_coalesceCommands)
+    {
+        CoalescedPointerMove& last = m_lastPointerMove;
+        if (last.end == m_commandStream.bytesWritten() &&
+            last.handle == stateMachineHandle &&
+            last.commandOffset >= m_commandStream.bytesRead())
+        {
+            // Still queued and nothing recorded after it: just move it.
+            m_commandStream.overwrite(last.requestIdOffset, requestId);
+            m_pointerEvents.overwrite(last.eventIndex, std::move(pointerEvent));
+            return;
+        }
+        last.handle = stateMachineHandle;
+        last.commandOffset = m_commandStream.bytesWritten();
+        last.requestIdOffset =
+            last.commandOffset + sizeof(Command) + sizeof(StateMachineHandle);
+        last.eventIndex = m_pointerEvents.writeCount();
+    }
     m_commandStream << Command::pointerMove;
     m_commandStream << stateMachineHandle;
     m_commandStream << requestId;
     m_pointerEvents << std::move(pointerEvent);
+    if (m_coalesceCommands)
+    {
+        m_lastPointerMove.end = m_commandStream.bytesWritten();
+    }
 }
 
 void CommandQueue::pointerDown(StateMachineHandle stateMachineHandle,
                                PointerEvent pointerEvent,
                                uint64_t requestId)
 {
-    AutoLockAndNotify lock(m_commandMutex, m_commandConditionVariable);
+    AutoLockAndNotify lock(this);
     m_commandStream << Command::pointerDown;
     m_commandStream << stateMachineHandle;
     m_commandStream << requestId;
@@ -577,7 +830,7 @@ void CommandQueue::pointerUp(StateMachineHandle stateMachineHandle,
                              PointerEvent pointerEvent,
                              uint64_t requestId)
 {
-    AutoLockAndNotify lock(m_commandMutex, m_commandConditionVariable);
+    AutoLockAndNotify lock(this);
     m_commandStream << Command::pointerUp;
     m_commandStream << stateMachineHandle;
     m_commandStream << requestId;
@@ -588,7 +841,7 @@ void CommandQueue::pointerExit(StateMachineHandle stateMachineHandle,
                                PointerEvent pointerEvent,
                                uint64_t requestId)
 {
-    AutoLockAndNotify lock(m_commandMutex, m_commandConditionVariable);
+    AutoLockAndNotify lock(this);
     m_commandStream << Command::pointerExit;
     m_commandStream << stateMachineHandle;
     m_commandStream << requestId;
@@ -599,7 +852,7 @@ void CommandQueue::bindViewModelInstance(StateMachineHandle handle,
                                          ViewModelInstanceHandle viewModel,
                                          uint64_t requestId)
 {
-    AutoLockAndNotify lock(m_commandMutex, m_commandConditionVariable);
+    AutoLockAndNotify lock(this);
     m_commandStream << Command::bindViewModelInstance;
     m_commandStream << handle;
     m_commandStream << viewModel;
@@ -610,7 +863,7 @@ void CommandQueue::advanceStateMachine(StateMachineHandle stateMachineHandle,
                                        float timeToAdvance,
                                        uint64_t requestId)
 {
-    AutoLockAndNotify lock(m_commandMutex, m_commandConditionVariable);
+    AutoLockAndNotify lock(this);
     m_commandStream << Command::advanceStateMachine;
     m_commandStream << stateMachineHandle;
     m_commandStream << requestId;
@@ -620,7 +873,7 @@ void CommandQueue::advanceStateMachine(StateMachineHandle stateMachineHandle,
 void CommandQueue::deleteStateMachine(StateMachineHandle stateMachineHandle,
                                       uint64_t requestId)
 {
-    AutoLockAndNotify lock(m_commandMutex, m_commandConditionVariable);
+    AutoLockAndNotify lock(this);
     m_commandStream << Command::deleteStateMachine;
     m_commandStream << stateMachineHandle;
     m_commandStream << requestId;
@@ -642,7 +895,7 @@ RenderImageHandle CommandQueue::decodeImage(
         registerListener(handle, listener);
     }
 
-    AutoLockAndNotify lock(m_commandMutex, m_commandConditionVariable);
+    AutoLockAndNotify lock(this);
     m_commandStream << Command::decodeImage;
     m_commandStream << handle;
     m_commandStream << requestId;
@@ -665,7 +918,7 @@ RenderImageHandle CommandQueue::addExternalImage(rcp<RenderImage> externalImage,
         registerListener(handle, listener);
     }
 
-    AutoLockAndNotify lock(m_commandMutex, m_commandConditionVariable);
+    AutoLockAndNotify lock(this);
     m_commandStream << Command::externalImage;
     m_commandStream << handle;
     m_commandStream << requestId;
@@ -675,7 +928,7 @@ RenderImageHandle CommandQueue::addExternalImage(rcp<RenderImage> externalImage,
 
 void CommandQueue::deleteImage(RenderImageHandle handle, uint64_t requestId)
 {
-    AutoLockAndNotify lock(m_commandMutex, m_commandConditionVariable);
+    AutoLockAndNotify lock(this);
     m_commandStream << Command::deleteImage;
     m_commandStream << handle;
     m_commandStream << requestId;
@@ -697,7 +950,7 @@ AudioSourceHandle CommandQueue::decodeAudio(
         registerListener(handle, listener);
     }
 
-    AutoLockAndNotify lock(m_commandMutex, m_commandConditionVariable);
+    AutoLockAndNotify lock(this);
     m_commandStream << Command::decodeAudio;
     m_commandStream << handle;
     m_commandStream << requestId;
@@ -720,7 +973,7 @@ AudioSourceHandle CommandQueue::addExternalAudio(rcp<AudioSource> externalAudio,
         registerListener(handle, listener);
     }
 
-    AutoLockAndNotify lock(m_commandMutex, m_commandConditionVariable);
+    AutoLockAndNotify lock(this);
     m_commandStream << Command::externalAudio;
     m_commandStream << handle;
     m_commandStream << requestId;
@@ -730,7 +983,7 @@ AudioSourceHandle CommandQueue::addExternalAudio(rcp<AudioSource> externalAudio,
 
 void CommandQueue::deleteAudio(AudioSourceHandle handle, uint64_t requestId)
 {
-    AutoLockAndNotify lock(m_commandMutex, m_commandConditionVariable);
+    AutoLockAndNotify lock(this);
     m_commandStream << Command::deleteAudio;
     m_commandStream << handle;
     m_commandStream << requestId;
@@ -750,7 +1003,7 @@ FontHandle CommandQueue::decodeFont(std::vector<uint8_t> imageEncodedBytes,
         registerListener(handle, listener);
     }
 
-    AutoLockAndNotify lock(m_commandMutex, m_commandConditionVariable);
+    AutoLockAndNotify lock(this);
     m_commandStream << Command::decodeFont;
     m_commandStream << handle;
     m_commandStream << requestId;
@@ -772,7 +1025,7 @@ FontHandle CommandQueue::addExternalFont(rcp<Font> externalFont,
         registerListener(handle, listener);
     }
 
-    AutoLockAndNotify lock(m_commandMutex, m_commandConditionVariable);
+    AutoLockAndNotify lock(this);
     m_commandStream << Command::externalFont;
     m_commandStream << handle;
     m_commandStream << requestId;
@@ -782,7 +1035,7 @@ FontHandle CommandQueue::addExternalFont(rcp<Font> externalFont,
 
 void CommandQueue::deleteFont(FontHandle handle, uint64_t requestId)
 {
-    AutoLockAndNotify lock(m_commandMutex, m_commandConditionVariable);
+    AutoLockAndNotify lock(this);
     m_commandStream << Command::deleteFont;
     m_commandStream << handle;
     m_commandStream << requestId;
@@ -791,14 +1044,14 @@ void CommandQueue::deleteFont(FontHandle handle, uint64_t requestId)
 DrawKey CommandQueue::createDrawKey()
 {
     // lock here so we can do this from several threads safely
-    AutoLockAndNotify lock(m_commandMutex, m_commandConditionVariable);
+    AutoLockAndNotify lock(this);
     auto key = reinterpret_cast<DrawKey>(++m_currentDrawKeyIdx);
     return key;
 }
 
 void CommandQueue::draw(DrawKey drawKey, CommandServerDrawCallback callback)
 {
-    AutoLockAndNotify lock(m_commandMutex, m_commandConditionVariable);
+    AutoLockAndNotify lock(this);
     m_commandStream << Command::draw;
     m_commandStream << drawKey;
     m_drawCallbacks << std::move(callback);
@@ -806,7 +1059,7 @@ void CommandQueue::draw(DrawKey drawKey, CommandServerDrawCallback callback)
 #ifdef TESTING
 void CommandQueue::testing_commandLoopBreak()
 {
-    AutoLockAndNotify lock(m_commandMutex, m_commandConditionVariable);
+    AutoLockAndNotify lock(this);
     m_commandStream << Command::commandLoopBreak;
 }
 
@@ -840,21 +1093,21 @@ CommandQueue::StateMachineListener* CommandQueue::
 #endif
 void CommandQueue::runOnce(CommandServerCallback callback)
 {
-    AutoLockAndNotify lock(m_commandMutex, m_commandConditionVariable);
+    AutoLockAndNotify lock(this);
     m_commandStream << Command::runOnce;
     m_callbacks << std::move(callback);
 }
 
 void CommandQueue::disconnect()
 {
-    AutoLockAndNotify lock(m_commandMutex, m_commandConditionVariable);
+    AutoLockAndNotify lock(this);
     m_commandStream << Command::disconnect;
 }
 
 void CommandQueue::requestViewModelNames(FileHandle fileHandle,
                                          uint64_t requestId)
 {
-    AutoLockAndNotify lock(m_commandMutex, m_commandConditionVariable);
+    AutoLockAndNotify lock(this);
     m_commandStream << Command::listViewModels;
     m_commandStream << fileHandle;
     m_commandStream << requestId;
@@ -863,7 +1116,7 @@ void CommandQueue::requestViewModelNames(FileHandle fileHandle,
 void CommandQueue::requestArtboardNames(FileHandle fileHandle,
                                         uint64_t requestId)
 {
-    AutoLockAndNotify lock(m_commandMutex, m_commandConditionVariable);
+    AutoLockAndNotify lock(this);
     m_commandStream << Command::listArtboards;
     m_commandStream << fileHandle;
     m_commandStream << requestId;
@@ -872,7 +1125,7 @@ void CommandQueue::requestArtboardNames(FileHandle fileHandle,
 void CommandQueue::requestViewModelEnums(FileHandle fileHandle,
                                          uint64_t requestId)
 {
-    AutoLockAndNotify lock(m_commandMutex, m_commandConditionVariable);
+    AutoLockAndNotify lock(this);
     m_commandStream << Command::listViewModelEnums;
     m_commandStream << fileHandle;
     m_commandStream << requestId;
@@ -883,7 +1136,7 @@ void CommandQueue::requestViewModelPropertyDefinitions(
     std::string viewModelName,
     uint64_t requestId)
 {
-    AutoLockAndNotify lock(m_commandMutex, m_commandConditionVariable);
+    AutoLockAndNotify lock(this);
     m_commandStream << Command::listViewModelProperties;
     m_commandStream << handle;
     m_commandStream << requestId;
@@ -894,7 +1147,7 @@ void CommandQueue::requestViewModelInstanceNames(FileHandle handle,
                                                  std::string viewModelName,
                                                  uint64_t requestId)
 {
-    AutoLockAndNotify lock(m_commandMutex, m_commandConditionVariable);
+    AutoLockAndNotify lock(this);
     m_commandStream << Command::listViewModelInstanceNames;
     m_commandStream << handle;
     m_commandStream << requestId;
@@ -905,7 +1158,7 @@ void CommandQueue::requestViewModelInstanceBool(ViewModelInstanceHandle handle,
                                                 std::string path,
                                                 uint64_t requestId)
 {
-    AutoLockAndNotify lock(m_commandMutex, m_commandConditionVariable);
+    AutoLockAndNotify lock(this);
     m_commandStream << Command::listViewModelPropertyValue;
     m_commandStream << DataType::boolean;
     m_commandStream << handle;
@@ -918,7 +1171,7 @@ void CommandQueue::requestViewModelInstanceNumber(
     std::string path,
     uint64_t requestId)
 {
-    AutoLockAndNotify lock(m_commandMutex, m_commandConditionVariable);
+    AutoLockAndNotify lock(this);
     m_commandStream << Command::listViewModelPropertyValue;
     m_commandStream << DataType::number;
     m_commandStream << handle;
@@ -930,7 +1183,7 @@ void CommandQueue::requestViewModelInstanceColor(ViewModelInstanceHandle handle,
                                                  std::string path,
                                                  uint64_t requestId)
 {
-    AutoLockAndNotify lock(m_commandMutex, m_commandConditionVariable);
+    AutoLockAndNotify lock(this);
     m_commandStream << Command::listViewModelPropertyValue;
     m_commandStream << DataType::color;
     m_commandStream << handle;
@@ -942,7 +1195,7 @@ void CommandQueue::requestViewModelInstanceEnum(ViewModelInstanceHandle handle,
                                                 std::string path,
                                                 uint64_t requestId)
 {
-    AutoLockAndNotify lock(m_commandMutex, m_commandConditionVariable);
+    AutoLockAndNotify lock(this);
     m_commandStream << Command::listViewModelPropertyValue;
     m_commandStream << DataType::enumType;
     m_commandStream << handle;
@@ -955,7 +1208,7 @@ void CommandQueue::requestViewModelInstanceString(
     std::string path,
     uint64_t requestId)
 {
-    AutoLockAndNotify lock(m_commandMutex, m_commandConditionVariable);
+    AutoLockAndNotify lock(this);
     m_commandStream << Command::listViewModelPropertyValue;
     m_commandStream << DataType::string;
     m_commandStream << handle;
@@ -968,7 +1221,7 @@ void CommandQueue::requestViewModelInstanceListSize(
     std::string path,
     uint64_t requestId)
 {
-    AutoLockAndNotify lock(m_commandMutex, m_commandConditionVariable);
+    AutoLockAndNotify lock(this);
     m_commandStream << Command::getViewModelListSize;
     m_commandStream << handle;
     m_commandStream << requestId;
@@ -978,7 +1231,7 @@ void CommandQueue::requestViewModelInstanceListSize(
 void CommandQueue::requestStateMachineNames(ArtboardHandle artboardHandle,
                                             uint64_t requestId)
 {
-    AutoLockAndNotify lock(m_commandMutex, m_commandConditionVariable);
+    AutoLockAndNotify lock(this);
     m_commandStream << Command::listStateMachines;
     m_commandStream << artboardHandle;
     m_commandStream << requestId;
@@ -988,7 +1241,7 @@ void CommandQueue::requestDefaultViewModelInfo(ArtboardHandle artboardHandle,
                                                FileHandle fileHandle,
                                                uint64_t requestId)
 {
-    AutoLockAndNotify lock(m_commandMutex, m_commandConditionVariable);
+    AutoLockAndNotify lock(this);
     m_commandStream << Command::getDefaultViewModel;
     m_commandStream << fileHandle;
     m_commandStream << artboardHandle;
@@ -1006,6 +1259,9 @@ void CommandQueue::processMessages()
     // in while we're processing the existing ones, we won't loop forever.
     m_messageStream << Message::messageLoopBreak;
 
+    uint64_t roundTripStart = m_messageRoundTripStart;
+    m_messageRoundTripStart = 0;
+
     do
     {
         Message message;
@@ -1015,7 +1271,29 @@ void CommandQueue::processMessages()
         {
             case Message::messageLoopBreak:
                 lock.unlock();
+                if (roundTripStart != 0)
+                {
+                    uint64_t roundTrip = Metrics::now() - roundTripStart;
+                    std::unique_lock<std::mutex> metricsLock(m_metricsMutex);
+                    m_metrics->messageRoundTrip.record(roundTrip);
+                }
                 return;
+            case Message::metricsReported:
+            {
+                lock.unlock();
+                // setMetricsReporting may be replacing the callback on another
+                // thread, so call a copy.
+                MetricsCallback callback;
+                {
+                    std::unique_lock<std::mutex> commandLock(m_commandMutex);
+                    callback = m_metricsCallback;
+                }
+                if (callback)
+                {
+                    callback(metrics());
+                }
+                break;
+            }
             case Message::viewModelEnumsListed:
             {
                 size_t numEnums;
@@ -10,6 +10,16 @@
 #include "rive/assets/font_asset.hpp"
 #include "rive/viewmodel/runtime/viewmodel_runtime.hpp"
 #include "rive/animation/state_machine_instance.hpp"
+#include "rive/viewmodel/viewmodel_instance_boolean.hpp"
+#include "rive/viewmodel/viewmodel_instance_color.hpp"
+#include "rive/viewmodel/viewmodel_instance_enum.hpp"
+#include "rive/viewmodel/viewmodel_instance_number.hpp"
+#include "rive/viewmodel/viewmodel_instance_string.hpp"
+#include "rive/viewmodel/viewmodel_property_enum.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
 
 namespace rive
 {
@@ -248,17 +258,254 @@ bool CommandServer::testing_globalFontContains(std::string name)
 
 #endif
 
+// Delegate registered on a subscribed view model value. Instead of the server
+// resolving and polling every subscription each frame, the value tells us when
+// it changes and we queue ourselves for the next flush.
+class CommandServer::SubscriptionObserver
+    : public ViewModelInstanceValueDelegate
+{
+public:
+    SubscriptionObserver(CommandServer* server,
+                         uint64_t requestId,
+                         PropertyData data,
+                         ViewModelInstanceHandle rootViewModel,
+                         ViewModelInstanceValueRuntime* property) :
+        m_server(server),
+        m_requestId(requestId),
+        m_data(std::move(data)),
+        m_rootViewModel(rootViewModel),
+        m_property(property),
+        m_value(ref_rcp(property->viewModelInstanceValue()))
+    {
+        m_value->addDelegate(this);
+    }
+
+    ~SubscriptionObserver()
+    {
+        m_value->removeDelegate(this);
+        if (m_isPending)
+        {
+            auto& changed = m_server->m_changedSubscriptions;
+            auto itr = std::find(changed.begin(), changed.end(), this);
+            if (itr != changed.end())
+            {
+                changed.erase(itr);
+            }
+        }
+    }
+
+    void valueChanged() override
+    {
+        // Values may change on worker threads while advancing in parallel.
+        std::unique_lock<std::mutex> lock(
+            m_server->m_changedSubscriptionsMutex);
+        if (!m_isPending)
+        {
+            m_isPending = true;
+            m_server->m_changedSubscriptions.push_back(this);
+        }
+    }
+
+    // Called at flush time, so the runtime property reads as unchanged once
+    // its value has been sent, the same as when subscriptions were polled.
+    void clearPending()
+    {
+        m_isPending = false;
+        m_property->clearChanges();
+    }
+
+    ViewModelInstanceValue* value() const { return m_value.get(); }
+
+    // The runtime property can be rebuilt while the value stays the same (e.g.
+    // when its view model is reached through a replaced parent).
+    void property(ViewModelInstanceValueRuntime* property)
+    {
+        assert(property->viewModelInstanceValue() == m_value.get());
+        m_property = property;
+    }
+
+    uint64_t requestId() const { return m_requestId; }
+    const PropertyData& data() const { return m_data; }
+    ViewModelInstanceHandle rootViewModel() const { return m_rootViewModel; }
+
+    // Reads the current value straight from the view model value. Returns
+    // false if the subscribed type does not carry a readable value.
+    bool readValue(CommandQueue::ViewModelInstanceData& data) const
+    {
+        switch (m_data.type)
+        {
+            // These don't have values but are still valid subscriptions.
+            case DataType::assetImage:
+            case DataType::trigger:
+            case DataType::list:
+                return true;
+            case DataType::boolean:
+                data.boolValue =
+                    m_value->as<ViewModelInstanceBoolean>()->propertyValue();
+                return true;
+            case DataType::color:
+                data.colorValue =
+                    m_value->as<ViewModelInstanceColor>()->propertyValue();
+                return true;
+            case DataType::number:
+                data.numberValue =
+                    m_value->as<ViewModelInstanceNumber>()->propertyValue();
+                return true;
+            case DataType::string:
+                data.stringValue =
+                    m_value->as<ViewModelInstanceString>()->propertyValue();
+                return true;
+            case DataType::enumType:
+            {
+                data.stringValue.clear();
+                auto enumProperty = m_value->viewModelProperty()
+                                        ->as<ViewModelPropertyEnum>();
+                auto values = enumProperty->dataEnum()->values();
+                uint32_t index =
+                    m_value->as<ViewModelInstanceEnum>()->propertyValue();
+                if (index < values.size())
+                {
+                    data.stringValue = values[index]->key();
+                }
+                return true;
+            }
+            default:
+                return false;
+        }
+    }
+
+private:
+    CommandServer* const m_server;
+    const uint64_t m_requestId;
+    const PropertyData m_data;
+    const ViewModelInstanceHandle m_rootViewModel;
+    ViewModelInstanceValueRuntime* m_property;
+    const rcp<ViewModelInstanceValue> m_value;
+    bool m_isPending = false;
+};
+
+// Fork/join pool used to advance shards of state machines in parallel. The
+// thread calling run() works on tasks too, so N workers run N + 1 shards at
+// once.
+class CommandServer::WorkerPool
+{
+public:
+    WorkerPool(uint32_t threadCount)
+    {
+        m_threads.reserve(threadCount);
+        for (uint32_t i = 0; i < threadCount; ++i)
+        {
+            m_threads.emplace_back([this]() { workerLoop(); });
+        }
+    }
+
+    ~WorkerPool()
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_shutdown = true;
+        }
+        m_wakeWorkers.notify_all();
+        for (auto& thread : m_threads)
+        {
+            thread.join();
+        }
+    }
+
+    // Calls task(i) for every i in [0, count) and returns once all calls have
+    // finished.
+    void run(size_t count, const std::function<void(size_t)>& task)
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_task = &task;
+            m_taskCount = count;
+            m_nextTask.store(0, std::memory_order_relaxed);
+            ++m_generation;
+        }
+        m_wakeWorkers.notify_all();
+        runTasks();
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_workersIdle.wait(lock, [this]() { return m_busyWorkers == 0; });
+        m_task = nullptr;
+    }
+
+private:
+    void workerLoop()
+    {
+        uint64_t seenGeneration = 0;
+        std::unique_lock<std::mutex> lock(m_mutex);
+        for (;;)
+        {
+            m_wakeWorkers.wait(lock, [&]() {
+                return m_shutdown || m_generation != seenGeneration;
+            });
+            if (m_shutdown)
+            {
+                return;
+            }
+            seenGeneration = m_generation;
+            // Late wakeups for a run whose tasks are all claimed must not
+            // touch it; run() may already have returned.
+            if (m_nextTask.load(std::memory_order_relaxed) >= m_taskCount)
+            {
+                continue;
+            }
+            ++m_busyWorkers;
+            lock.unlock();
+            runTasks();
+            lock.lock();
+            if (--m_busyWorkers == 0)
+            {
+                m_workersIdle.notify_one();
+            }
+        }
+    }
+
+    void runTasks()
+    {
+        for (size_t i = m_nextTask.fetch_add(1, std::memory_order_relaxed);
+             i < m_taskCount;
+             i = m_nextTask.fetch_add(1, std::memory_order_relaxed))
+        {
+            (*m_task)(i);
+        }
+    }
+
+    std::vector<std::thread> m_threads;
+    std::mutex m_mutex;
+    std::condition_variable m_wakeWorkers;
+    std::condition_variable m_workersIdle;
+    const std::function<void(size_t)>* m_task = nullptr;
+    size_t m_taskCount = 0;
+    std::atomic<size_t> m_nextTask{0};
+    uint64_t m_generation = 0;
+    uint32_t m_busyWorkers = 0;
+    bool m_shutdown = false;
+};
+
 CommandServer::CommandServer(rcp<CommandQueue> commandBuffer,
-                             Factory* factory) :
+                             Factory* factory,
+                             uint32_t workerThreadCount) :
     m_commandQueue(std::move(commandBuffer)),
     m_factory(factory),
 #ifndef NDEBUG
     m_threadID(std::this_thread::get_id()),
 #endif
     m_fileAssetLoader(make_rcp<CommandFileAssetLoader>(this))
-{}
+{
+    if (workerThreadCount > 0)
+    {
+        m_workerPool = rivestd::make_unique<WorkerPool>(workerThreadCount);
+    }
+}
 
-CommandServer::~CommandServer() {}
+CommandServer::~CommandServer()
+{
+    // Observers unlink themselves from m_changedSubscriptions, so release them
+    // while it is still alive.
+    m_propertySubscriptions.clear();
+}
 
 File* CommandServer::getFile(FileHandle handle) const
 {
@@ -336,117 +583,336 @@ Vec2D CommandServer::cursorPosForPointerEvent(
     return inverse * pointerEvent.position;
 }
 
-void CommandServer::checkPropertySubscriptions()
+void CommandServer::resolvePropertySubscriptions()
 {
     for (auto& subscription : m_propertySubscriptions)
     {
-        uint64_t requestId = subscription.requestId;
-        ViewModelInstanceHandle handle = subscription.rootViewModel;
-        CommandQueue::ViewModelInstanceData data;
-        data.metaData = subscription.data;
+        auto viewModel = getViewModelInstance(subscription.rootViewModel);
+        auto property = viewModel != nullptr
+                            ? viewModel->property(subscription.data.name)
+                            : nullptr;
+        if (property == nullptr)
+        {
+            subscription.observer.reset();
+        }
+        else if (subscription.observer != nullptr &&
+                 subscription.observer->value() ==
+                     property->viewModelInstanceValue())
+        {
+            subscription.observer->property(property);
+        }
+        else
+        {
+            subscription.observer = rivestd::make_unique<SubscriptionObserver>(
+                this,
+                subscription.requestId,
+                subscription.data,
+                subscription.rootViewModel,
+                property);
+            // The subscriber hasn't seen the new value yet.
+            subscription.observer->valueChanged();
+        }
+    }
+}
 
-        if (auto viewModel = getViewModelInstance(handle))
+void CommandServer::checkPropertySubscriptions()
+{
+    if (m_changedSubscriptions.empty())
+    {
+        return;
+    }
+
+    // Read every changed value first, then write them all to the message
+    // stream under a single lock.
+    m_changedValues.clear();
+    for (auto observer : m_changedSubscriptions)
+    {
+        observer->clearPending();
+        ChangedValue changed;
+        changed.requestId = observer->requestId();
+        changed.rootViewModel = observer->rootViewModel();
+        changed.data.metaData = observer->data();
+        if (!observer->readValue(changed.data))
         {
-            if (auto property = viewModel->property(data.metaData.name))
-            {
-                if (property->hasChanged())
-                {
-                    property->clearChanges();
-                    switch (data.metaData.type)
-                    {
-                        // These don't have values but are still valid
-                        // subscriptions.
-                        case DataType::assetImage:
-                        case DataType::trigger:
-                        case DataType::list:
-                            break;
-                        case DataType::boolean:
-                            if (auto value = static_cast<
-                                    ViewModelInstanceBooleanRuntime*>(property))
-                            {
-                                data.boolValue = value->value();
-                            }
-                            break;
+            ErrorReporter<ViewModelInstanceHandle>(
+                this,
+                changed.rootViewModel,
+                changed.requestId,
+                CommandQueue::Message::viewModelError)
+                << "ERROR : Invalid data type {" << changed.data.metaData.type
+                << "} when checking" << "subscriptions";
+            continue;
+        }
+        m_changedValues.push_back(std::move(changed));
+    }
+    m_changedSubscriptions.clear();
+    if (m_changedValues.empty())
+    {
+        return;
+    }
 
-                        case DataType::color:
-                            if (auto value =
-                                    static_cast<ViewModelInstanceColorRuntime*>(
-                                        property))
-                            {
-                                data.colorValue = value->value();
-                            }
-                            break;
+    std::unique_lock<std::mutex> messageLock(m_commandQueue->m_messageMutex);
+    for (auto& changed : m_changedValues)
+    {
+        auto& data = changed.data;
+        m_commandQueue->m_messageStream
+            << CommandQueue::Message::viewModelPropertyValueReceived;
+        m_commandQueue->m_messageStream << changed.rootViewModel;
+        m_commandQueue->m_messageStream << data.metaData.type;
+        m_commandQueue->m_messageNames << data.metaData.name;
+        m_commandQueue->m_messageStream << changed.requestId;
+        switch (data.metaData.type)
+        {
+            case DataType::assetImage:
+            case DataType::trigger:
+            case DataType::list:
+                break;
+            case DataType::boolean:
+                m_commandQueue->m_messageStream << data.boolValue;
+                break;
+            case DataType::number:
+                m_commandQueue->m_messageStream << data.numberValue;
+                break;
+            case DataType::color:
+                m_commandQueue->m_messageStream << data.colorValue;
+                break;
+            case DataType::enumType:
+            case DataType::string:
+                m_commandQueue->m_messageNames << data.stringValue;
+                break;
+            default:
+                RIVE_UNREACHABLE();
+        }
+    }
+}
 
-                        case DataType::number:
-                            if (auto value = static_cast<
-                                    ViewModelInstanceNumberRuntime*>(property))
-                            {
-                                data.numberValue = value->value();
-                            }
-                            break;
+void CommandServer::rebuildLinkedFileGroups()
+{
+    m_linkedFileGroups.clear();
+    auto findGroup = [this](FileHandle file) {
+        auto itr = m_linkedFileGroups.emplace(file, file).first;
+        while (itr->second != file)
+        {
+            file = itr->second;
+            itr = m_linkedFileGroups.find(file);
+        }
+        return file;
+    };
+    for (const auto& link : m_linkedFiles)
+    {
+        FileHandle a = findGroup(link.first);
+        FileHandle b = findGroup(link.second);
+        if (a != b)
+        {
+            m_linkedFileGroups[a] = b;
+        }
+    }
+    // Point every file straight at its representative.
+    for (auto& group : m_linkedFileGroups)
+    {
+        group.second = findGroup(group.second);
+    }
+}
 
-                        case DataType::enumType:
-                            if (auto value =
-                                    static_cast<ViewModelInstanceEnumRuntime*>(
-                                        property))
-                            {
-                                data.stringValue = value->value();
-                            }
-                            break;
+void CommandServer::linkViewModelFiles(ViewModelInstanceHandle root,
+                                       ViewModelInstanceHandle value)
+{
+    auto rootFile = m_viewModelFiles.find(root);
+    auto valueFile = m_viewModelFiles.find(value);
+    if (rootFile == m_viewModelFiles.end() ||
+        valueFile == m_viewModelFiles.end() ||
+        rootFile->second == valueFile->second)
+    {
+        return;
+    }
+    auto link = std::make_pair(rootFile->second, valueFile->second);
+    if (std::find(m_linkedFiles.begin(), m_linkedFiles.end(), link) ==
+        m_linkedFiles.end())
+    {
+        m_linkedFiles.push_back(link);
+        rebuildLinkedFileGroups();
+    }
+}
 
-                        case DataType::string:
-                            if (auto value = static_cast<
-                                    ViewModelInstanceStringRuntime*>(property))
-                            {
-                                data.stringValue = value->value();
-                            }
-                            break;
-                        default:
-                            ErrorReporter<ViewModelInstanceHandle>(
-                                this,
-                                handle,
-                                requestId,
-                                CommandQueue::Message::viewModelError)
-                                << "ERROR : Invalid data type {"
-                                << data.metaData.type << "} when checking"
-                                << "subscriptions";
-                            continue;
-                    }
+void CommandServer::flushPendingAdvances()
+{
+    if (m_pendingAdvances.empty())
+    {
+        return;
+    }
 
-                    std::unique_lock<std::mutex> messageLock(
-                        m_commandQueue->m_messageMutex);
-                    m_commandQueue->m_messageStream << CommandQueue::Message::
-                            viewModelPropertyValueReceived;
-                    m_commandQueue->m_messageStream << handle;
-                    m_commandQueue->m_messageStream << data.metaData.type;
-                    m_commandQueue->m_messageNames << data.metaData.name;
-                    m_commandQueue->m_messageStream << requestId;
-                    switch (data.metaData.type)
-                    {
-                        case DataType::assetImage:
-                        case DataType::trigger:
-                        case DataType::list:
-                            break;
-                        case DataType::boolean:
-                            m_commandQueue->m_messageStream << data.boolValue;
-                            break;
-                        case DataType::number:
-                            m_commandQueue->m_messageStream << data.numberValue;
-                            break;
-                        case DataType::color:
-                            m_commandQueue->m_messageStream << data.colorValue;
-                            break;
-                        case DataType::enumType:
-                        case DataType::string:
-                            m_commandQueue->m_messageNames << data.stringValue;
-                            break;
-                        default:
-                            RIVE_UNREACHABLE();
-                    }
-                }
+    uint64_t flushStart = m_collectMetrics ? CommandQueue::Metrics::now() : 0;
+
+    // Shard the advances: any two whose artboards or bound view models came
+    // from the same file (or from linked files) end up in the same shard
+    // (union-find over the files) and run in recorded order on one thread.
+    // Linked files are folded into their group's representative up front.
+    std::unordered_map<FileHandle, size_t> fileIndices;
+    std::vector<size_t> parents;
+    auto fileIndex = [&fileIndices, &parents](FileHandle file) {
+        auto index = fileIndices.emplace(file, parents.size());
+        if (index.second)
+        {
+            parents.push_back(parents.size());
+        }
+        return index.first->second;
+    };
+    auto findRoot = [&parents](size_t i) {
+        while (parents[i] != i)
+        {
+            parents[i] = parents[parents[i]];
+            i = parents[i];
+        }
+        return i;
+    };
+    auto unite = [&parents, &findRoot](size_t a, size_t b) {
+        parents[findRoot(a)] = findRoot(b);
+    };
+    auto groupIndex = [this, &fileIndex](FileHandle file) {
+        auto group = m_linkedFileGroups.find(file);
+        return fileIndex(group != m_linkedFileGroups.end() ? group->second
+                                                           : file);
+    };
+    size_t count = m_pendingAdvances.size();
+    // Advances of unknown state machines don't touch anything; they only
+    // report an error later.
+    std::vector<size_t> advanceFiles(count, static_cast<size_t>(-1));
+    for (size_t i = 0; i < count; ++i)
+    {
+        auto itr = m_stateMachineAffinities.find(m_pendingAdvances[i].handle);
+        if (itr == m_stateMachineAffinities.end())
+        {
+            continue;
+        }
+        const StateMachineAffinity& affinity = itr->second;
+        advanceFiles[i] = groupIndex(affinity.artboardFile);
+        if (affinity.viewModelFile != RIVE_NULL_HANDLE)
+        {
+            unite(groupIndex(affinity.viewModelFile), advanceFiles[i]);
+        }
+    }
+    std::vector<std::vector<size_t>> shards;
+    std::unordered_map<size_t, size_t> shardForRoot;
+    for (size_t i = 0; i < count; ++i)
+    {
+        auto shard = shardForRoot.emplace(
+            advanceFiles[i] != static_cast<size_t>(-1)
+                ? findRoot(advanceFiles[i])
+                : parents.size(),
+            shards.size());
+        if (shard.second)
+        {
+            shards.emplace_back();
+        }
+        shards[shard.first->second].push_back(i);
+    }
+    m_lastAdvanceShardCount = shards.size();
+
+    std::function<void(size_t)> advanceShard = [this,
+                                                &shards](size_t shardIdx) {
+        for (size_t i : shards[shardIdx])
+        {
+            PendingAdvance& advance = m_pendingAdvances[i];
+            if (advance.stateMachine != nullptr)
+            {
+                advance.settled = !advance.stateMachine->advanceAndApply(
+                    advance.timeToAdvance);
+            }
+        }
+    };
+    if (m_workerPool != nullptr && shards.size() > 1)
+    {
+        m_workerPool->run(shards.size(), advanceShard);
+    }
+    else
+    {
+        for (size_t i = 0; i < shards.size(); ++i)
+        {
+            advanceShard(i);
+        }
+    }
+
+    if (flushStart != 0)
+    {
+        uint64_t elapsed = CommandQueue::Metrics::now() - flushStart;
+        std::unique_lock<std::mutex> metricsLock(
+            m_commandQueue->m_metricsMutex);
+        m_commandQueue->m_metrics->parallelAdvanceWallTime.record(elapsed);
+    }
+
+    std::unique_lock<std::mutex> messageLock(m_commandQueue->m_messageMutex,
+                                             std::defer_lock);
+    for (const PendingAdvance& advance : m_pendingAdvances)
+    {
+        if (advance.stateMachine == nullptr)
+        {
+            if (messageLock.owns_lock())
+            {
+                messageLock.unlock();
             }
+            ErrorReporter<StateMachineHandle>(
+                this,
+                advance.handle,
+                advance.requestId,
+                CommandQueue::Message::stateMachineError)
+                << "State machine " << advance.handle
+                << " not found for "
+                   "advance.";
+        }
+        else if (advance.settled)
+        {
+            if (!messageLock.owns_lock())
+            {
+                messageLock.lock();
+            }
+            m_commandQueue->m_messageStream
+                << CommandQueue::Message::stateMachineSettled;
+            m_commandQueue->m_messageStream << advance.handle;
+            m_commandQueue->m_messageStream << advance.requestId;
         }
     }
+    m_pendingAdvances.clear();
+}
+
+uint64_t CommandServer::takeCommandEnqueueTime(uint64_t commandOffset)
+{
+    // Timestamps are recorded in command order, but commands recorded while
+    // metrics were off have none, so skip past any stale ones.
+    ObjectStream<CommandQueue::CommandTimestamp>& timestamps =
+        m_commandQueue->m_commandTimestamps;
+    while (m_nextCommandTimestamp.enqueueTime == 0 ||
+           m_nextCommandTimestamp.commandOffset < commandOffset)
+    {
+        if (timestamps.empty())
+        {
+            m_nextCommandTimestamp = {0, 0};
+            return 0;
+        }
+        timestamps >> m_nextCommandTimestamp;
+    }
+    if (m_nextCommandTimestamp.commandOffset != commandOffset)
+    {
+        return 0;
+    }
+    uint64_t enqueueTime = m_nextCommandTimestamp.enqueueTime;
+    m_nextCommandTimestamp = {0, 0};
+    return enqueueTime;
+}
+
+void CommandServer::recordCommandMetrics(CommandQueue::Command command,
+                                         uint64_t enqueueTime,
+                                         uint64_t startTime)
+{
+    uint64_t endTime = CommandQueue::Metrics::now();
+    size_t type = static_cast<size_t>(command);
+    std::unique_lock<std::mutex> metricsLock(m_commandQueue->m_metricsMutex);
+    CommandQueue::Metrics& metrics = *m_commandQueue->m_metrics;
+    ++metrics.commandsExecuted;
+    if (enqueueTime != 0)
+    {
+        metrics.enqueueLatency[type].record(startTime - enqueueTime);
+    }
+    metrics.executionTime[type].record(endTime - startTime);
 }
 
 void CommandServer::serveUntilDisconnect()
@@ -487,6 +953,40 @@ bool CommandServer::processCommands()
     if (commandStream.empty())
         return !m_wasDisconnectReceived;
 
+    m_collectMetrics = m_commandQueue->m_metricsEnabled;
+    uint64_t metricsReportInterval = m_commandQueue->m_metricsReportInterval;
+    uint64_t oldestEnqueueTime = 0;
+    if (m_collectMetrics)
+    {
+        ObjectStream<CommandQueue::CommandTimestamp>& timestamps =
+            m_commandQueue->m_commandTimestamps;
+        uint64_t depthCommands =
+            timestamps.writeCount() - timestamps.readCount() +
+            (m_nextCommandTimestamp.enqueueTime != 0 ? 1 : 0);
+        uint64_t depthBytes =
+            commandStream.bytesWritten() - commandStream.bytesRead();
+        std::unique_lock<std::mutex> metricsLock(
+            m_commandQueue->m_metricsMutex);
+        CommandQueue::Metrics& metrics = *m_commandQueue->m_metrics;
+        ++metrics.batchesExecuted;
+        metrics.lastQueueDepthCommands = depthCommands;
+        metrics.maxQueueDepthCommands =
+            std::max(metrics.maxQueueDepthCommands, depthCommands);
+        metrics.lastQueueDepthBytes = depthBytes;
+        metrics.maxQueueDepthBytes =
+            std::max(metrics.maxQueueDepthBytes, depthBytes);
+    }
+    else if (!m_commandQueue->m_commandTimestamps.empty())
+    {
+        // Metrics were turned off with timestamps still queued.
+        CommandQueue::CommandTimestamp timestamp;
+        while (!m_commandQueue->m_commandTimestamps.empty())
+        {
+            m_commandQueue->m_commandTimestamps >> timestamp;
+        }
+        m_nextCommandTimestamp = {0, 0};
+    }
+
     // Ensure we stop processing messages and get to the draw loop.
     // This avoids a race condition where we never stop processing messages and
     // therefore never draw anything.
@@ -498,9 +998,35 @@ bool CommandServer::processCommands()
     bool shouldProcessCommands = true;
     do
     {
+        uint64_t commandOffset = commandStream.bytesRead();
         CommandQueue::Command command;
         commandStream >> command;
 
+        uint64_t enqueueTime = 0;
+        if (m_collectMetrics)
+        {
+            enqueueTime = takeCommandEnqueueTime(commandOffset);
+            if (enqueueTime != 0 &&
+                (oldestEnqueueTime == 0 || enqueueTime < oldestEnqueueTime))
+            {
+                oldestEnqueueTime = enqueueTime;
+            }
+        }
+
+        if (!m_pendingAdvances.empty() &&
+            command != CommandQueue::Command::advanceStateMachine &&
+            command != CommandQueue::Command::draw)
+        {
+            // Everything recorded before this command has to finish advancing
+            // before it runs.
+            lock.unlock();
+            flushPendingAdvances();
+            lock.lock();
+        }
+
+        uint64_t commandStart =
+            m_collectMetrics ? CommandQueue::Metrics::now() : 0;
+
         switch (command)
         {
             case CommandQueue::Command::loadFile:
@@ -557,6 +1083,17 @@ bool CommandServer::processCommands()
 
                     m_fileDependencies.erase(itr);
                 }
+                auto linksEnd = std::remove_if(
+                    m_linkedFiles.begin(),
+                    m_linkedFiles.end(),
+                    [handle](const std::pair<FileHandle, FileHandle>& link) {
+                        return link.first == handle || link.second == handle;
+                    });
+                if (linksEnd != m_linkedFiles.end())
+                {
+                    m_linkedFiles.erase(linksEnd, m_linkedFiles.end());
+                    rebuildLinkedFileGroups();
+                }
                 std::unique_lock<std::mutex> messageLock(
                     m_commandQueue->m_messageMutex);
                 messageStream << CommandQueue::Message::fileDeleted;
@@ -829,6 +1366,7 @@ bool CommandServer::processCommands()
                         assert(m_fileDependencies.find(fileHandle) !=
                                m_fileDependencies.end());
                         m_fileDependencies[fileHandle].push_back(handle);
+                        m_artboardFiles[handle] = fileHandle;
                         m_artboardDependencies[handle] = {};
                         m_artboards[handle] = std::move(artboard);
                     }
@@ -1036,6 +1574,7 @@ bool CommandServer::processCommands()
                         if (instance)
                         {
                             m_viewModels[viewHandle] = std::move(instance);
+                            m_viewModelFiles[viewHandle] = fileHandle;
                         }
                     }
                 }
@@ -1075,6 +1614,7 @@ bool CommandServer::processCommands()
                                 property->addInstanceAt(viewModel, index);
                             else
                                 property->addInstance(viewModel);
+                            linkViewModelFiles(rootHandle, viewHandle);
                         }
                         else
                         {
@@ -1235,10 +1775,20 @@ bool CommandServer::processCommands()
                             data.type != DataType::none &&
                             data.type != DataType::symbolListIndex)
                         {
-                            if (view->property(data.name) != nullptr)
+                            if (auto property = view->property(data.name))
                             {
+                                auto observer =
+                                    rivestd::make_unique<SubscriptionObserver>(
+                                        this,
+                                        requestId,
+                                        data,
+                                        rootHandle,
+                                        property);
                                 m_propertySubscriptions.push_back(
-                                    {requestId, data, rootHandle});
+                                    {requestId,
+                                     data,
+                                     rootHandle,
+                                     std::move(observer)});
                             }
                             else
                             {
@@ -1315,6 +1865,8 @@ bool CommandServer::processCommands()
                     {
                         m_viewModels[nestedViewHandle] =
                             ref_rcp(nestedViewModel);
+                        m_viewModelFiles[nestedViewHandle] =
+                            m_viewModelFiles[rootViewHandle];
                     }
                     else
                     {
@@ -1367,6 +1919,8 @@ bool CommandServer::processCommands()
                         {
                             m_viewModels[listViewHandle] =
                                 ref_rcp(viewModelInstance);
+                            m_viewModelFiles[listViewHandle] =
+                                m_viewModelFiles[rootViewHandle];
                         }
                         else
                         {
@@ -1413,6 +1967,16 @@ bool CommandServer::processCommands()
                 commandStream >> requestId;
                 lock.unlock();
                 m_viewModels.erase(handle);
+                m_viewModelFiles.erase(handle);
+                // Stop observing values reached through this view model. The
+                // subscriptions themselves stay until unsubscribed.
+                for (auto& subscription : m_propertySubscriptions)
+                {
+                    if (subscription.rootViewModel == handle)
+                    {
+                        subscription.observer.reset();
+                    }
+                }
                 std::unique_lock<std::mutex> messageLock(
                     m_commandQueue->m_messageMutex);
                 messageStream << CommandQueue::Message::viewModelDeleted;
@@ -1439,6 +2003,12 @@ bool CommandServer::processCommands()
                                          : artboard->stateMachineNamed(name))
                     {
                         m_stateMachines[handle] = std::move(stateMachine);
+                        auto artboardFile =
+                            m_artboardFiles.find(artboardHandle);
+                        m_stateMachineAffinities[handle].artboardFile =
+                            artboardFile != m_artboardFiles.end()
+                                ? artboardFile->second
+                                : RIVE_NULL_HANDLE;
                         assert(m_artboardDependencies.find(artboardHandle) !=
                                m_artboardDependencies.end());
                         m_artboardDependencies[artboardHandle].push_back(
@@ -1488,6 +2058,10 @@ bool CommandServer::processCommands()
                     {
                         stateMachine->bindViewModelInstance(
                             viewModelInstance->instance());
+                        auto file = m_viewModelFiles.find(viewModel);
+                        m_stateMachineAffinities[handle].viewModelFile =
+                            file != m_viewModelFiles.end() ? file->second
+                                                           : RIVE_NULL_HANDLE;
                     }
                     else
                     {
@@ -1524,7 +2098,18 @@ bool CommandServer::processCommands()
                 commandStream >> timeToAdvance;
                 lock.unlock();
 
-                if (auto stateMachine = getStateMachineInstance(handle))
+                if (m_workerPool != nullptr)
+                {
+                    // Deferred until the next barrier so consecutive advances
+                    // can run in parallel.
+                    m_pendingAdvances.push_back(
+                        {handle,
+                         requestId,
+                         timeToAdvance,
+                         getStateMachineInstance(handle),
+                         false});
+                }
+                else if (auto stateMachine = getStateMachineInstance(handle))
                 {
                     if (!stateMachine->advanceAndApply(timeToAdvance))
                     {
@@ -1559,6 +2144,7 @@ bool CommandServer::processCommands()
                 commandStream >> requestId;
                 lock.unlock();
                 m_stateMachines.erase(handle);
+                m_stateMachineAffinities.erase(handle);
                 std::unique_lock<std::mutex> messageLock(
                     m_commandQueue->m_messageMutex);
                 messageStream << CommandQueue::Message::stateMachineDeleted;
@@ -2175,9 +2761,17 @@ bool CommandServer::processCommands()
                             if (auto nestedViewModel =
                                     getViewModelInstance(nestedHandle))
                             {
-                                if (!viewModelInstance->replaceViewModel(
+                                if (viewModelInstance->replaceViewModel(
                                         value.metaData.name,
                                         nestedViewModel))
+                                {
+                                    linkViewModelFiles(handle, nestedHandle);
+                                    // Subscriptions whose path goes through
+                                    // the replaced view model now point at a
+                                    // different value.
+                                    resolvePropertySubscriptions();
+                                }
+                                else
                                 {
                                     ErrorReporter<ViewModelInstanceHandle>(
                                         this,
@@ -2732,6 +3326,10 @@ bool CommandServer::processCommands()
 
         // Should have unlocked by now.
         assert(!lock.owns_lock());
+        if (commandStart != 0)
+        {
+            recordCommandMetrics(command, enqueueTime, commandStart);
+        }
         lock.lock();
     } while (!commandStream.empty() && shouldProcessCommands);
 
@@ -2739,15 +3337,47 @@ bool CommandServer::processCommands()
     // unlock here.
     lock.unlock();
 
+    flushPendingAdvances();
+
     for (const auto& drawPair : m_uniqueDraws)
     {
+        uint64_t drawStart =
+            m_collectMetrics ? CommandQueue::Metrics::now() : 0;
         drawPair.second(drawPair.first, this);
+        if (drawStart != 0)
+        {
+            uint64_t elapsed = CommandQueue::Metrics::now() - drawStart;
+            std::unique_lock<std::mutex> metricsLock(
+                m_commandQueue->m_metricsMutex);
+            m_commandQueue->m_metrics->drawCallbackTime.record(elapsed);
+        }
     }
 
     m_uniqueDraws.clear();
 
     checkPropertySubscriptions();
 
+    if (m_collectMetrics)
+    {
+        uint64_t now = CommandQueue::Metrics::now();
+        std::unique_lock<std::mutex> messageLock(
+            m_commandQueue->m_messageMutex);
+        // Anything this batch posted is delivered by the next
+        // processMessages; keep the oldest start if earlier batches are still
+        // waiting as well.
+        if (oldestEnqueueTime != 0 && !messageStream.empty() &&
+            m_commandQueue->m_messageRoundTripStart == 0)
+        {
+            m_commandQueue->m_messageRoundTripStart = oldestEnqueueTime;
+        }
+        if (metricsReportInterval != 0 &&
+            now - m_lastMetricsReport >= metricsReportInterval)
+        {
+            messageStream << CommandQueue::Message::metricsReported;
+            m_lastMetricsReport = now;
+        }
+    }
+
     return !m_wasDisconnectReceived;
 }
 }; // namespace rive
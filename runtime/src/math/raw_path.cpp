@@ -231,6 +231,103 @@ void RawPath::addPoly(Span<const Vec2D> span, bool isClosed)
     }
 }
 
+static int verbPointCount(PathVerb verb)
+{
+    switch (verb)
+    {
+        case PathVerb::move:
+        case PathVerb::line:
+            return 1;
+        case PathVerb::quad:
+            return 2;
+        case PathVerb::cubic:
+            return 3;
+        case PathVerb::close:
+            return 0;
+    }
+    return -1;
+}
+
+void RawPath::addVerbsAndPoints(Span<const PathVerb> verbs,
+                                Span<const Vec2D> points)
+{
+    // Walk the verbs once to find how many of them have all their points and
+    // whether they can be copied as-is.
+    bool isWellFormed = true;
+    bool contourIsOpen = m_contourIsOpen;
+    size_t lastMoveIdx = m_lastMoveIdx;
+    size_t verbCount = 0;
+    size_t pointCount = 0;
+    for (; verbCount < verbs.size(); ++verbCount)
+    {
+        PathVerb verb = verbs[verbCount];
+        int count = verbPointCount(verb);
+        if (count < 0)
+        {
+            isWellFormed = false;
+            continue;
+        }
+        if (pointCount + count > points.size())
+        {
+            break;
+        }
+        switch (verb)
+        {
+            case PathVerb::move:
+                contourIsOpen = true;
+                lastMoveIdx = m_Points.size() + pointCount;
+                break;
+            case PathVerb::close:
+                // A close on a closed contour is dropped by close().
+                isWellFormed = isWellFormed && contourIsOpen;
+                contourIsOpen = false;
+                break;
+            default:
+                isWellFormed = isWellFormed && contourIsOpen;
+                break;
+        }
+        pointCount += count;
+    }
+
+    if (isWellFormed)
+    {
+        m_Verbs.insert(m_Verbs.end(), verbs.begin(), verbs.begin() + verbCount);
+        m_Points.insert(m_Points.end(),
+                        points.begin(),
+                        points.begin() + pointCount);
+        m_contourIsOpen = contourIsOpen;
+        m_lastMoveIdx = lastMoveIdx;
+        return;
+    }
+
+    const Vec2D* pts = points.data();
+    for (size_t i = 0; i < verbCount; ++i)
+    {
+        switch (verbs[i])
+        {
+            case PathVerb::move:
+                move(pts[0]);
+                pts += 1;
+                break;
+            case PathVerb::line:
+                line(pts[0]);
+                pts += 1;
+                break;
+            case PathVerb::quad:
+                quad(pts[0], pts[1]);
+                pts += 2;
+                break;
+            case PathVerb::cubic:
+                cubic(pts[0], pts[1], pts[2]);
+                pts += 3;
+                break;
+            case PathVerb::close:
+                close();
+                break;
+        }
+    }
+}
+
 void RawPath::addPoints(std::vector<Vec2D>::const_reverse_iterator& ptIter,
                         int count,
                         const Mat2D* mat)
@@ -0,0 +1,253 @@
+#include "rive/picture.hpp"
+
+#include <cassert>
+
+using namespace rive;
+
+void Picture::playback(Renderer* renderer) const
+{
+    for (const Op& op : m_ops)
+    {
+        switch (op.type)
+        {
+            case OpType::save:
+                renderer->save();
+                break;
+            case OpType::restore:
+                renderer->restore();
+                break;
+            case OpType::transform:
+                renderer->transform(m_matrices[op.index]);
+                break;
+            case OpType::drawPath:
+            case OpType::clipPath:
+            {
+                RenderPath* path = m_paths[op.index].get();
+                if (op.fillRule != FillRuleState::unknown)
+                {
+                    path->fillRule(static_cast<FillRule>(
+                        static_cast<uint8_t>(op.fillRule) - 1));
+                }
+                if (op.type == OpType::drawPath)
+                {
+                    renderer->drawPath(path, m_paints[op.paintIndex].get());
+                }
+                else
+                {
+                    renderer->clipPath(path);
+                }
+                break;
+            }
+            case OpType::drawImage:
+            {
+                const ImageOp& image = m_images[op.index];
+                renderer->drawImage(image.image.get(),
+                                    image.sampler,
+                                    image.blendMode,
+                                    image.opacity);
+                break;
+            }
+            case OpType::drawImageMesh:
+            {
+                const MeshOp& mesh = m_meshes[op.index];
+                renderer->drawImageMesh(mesh.image.image.get(),
+                                        mesh.image.sampler,
+                                        mesh.vertices,
+                                        mesh.uvCoords,
+                                        mesh.indices,
+                                        mesh.vertexCount,
+                                        mesh.indexCount,
+                                        mesh.image.blendMode,
+                                        mesh.image.opacity);
+                break;
+            }
+        }
+    }
+}
+
+void Picture::playback(Renderer* renderer, const Mat2D& matrix) const
+{
+    renderer->save();
+    renderer->transform(matrix);
+    renderer->drawPicture(*this);
+    renderer->restore();
+}
+
+PictureRecorder::PictureRecorder() : m_picture(make_rcp<Picture>()) {}
+
+PictureRecorder::~PictureRecorder() {}
+
+void PictureRecorder::bounds(const AABB& value)
+{
+    m_picture->m_bounds = value;
+    m_picture->m_hasBounds = true;
+}
+
+rcp<Picture> PictureRecorder::finishRecording()
+{
+    while (!m_saveStack.empty())
+    {
+        restore();
+    }
+
+    // Transforms and clips at the end of the stream don't affect anything.
+    std::vector<Picture::Op>& ops = m_picture->m_ops;
+    while (!ops.empty() && (ops.back().type == Picture::OpType::transform ||
+                            ops.back().type == Picture::OpType::clipPath))
+    {
+        if (ops.back().type == Picture::OpType::transform)
+        {
+            m_picture->m_matrices.pop_back();
+        }
+        else
+        {
+            m_picture->m_paths.pop_back();
+        }
+        ops.pop_back();
+    }
+
+    rcp<Picture> picture = std::move(m_picture);
+    m_picture = make_rcp<Picture>();
+    return picture;
+}
+
+void PictureRecorder::pushOp(Picture::OpType type,
+                             uint32_t index,
+                             uint32_t paintIndex)
+{
+    m_picture->m_ops.push_back(
+        {type, Picture::FillRuleState::unknown, index, paintIndex});
+}
+
+Picture::FillRuleState PictureRecorder::fillRuleOf(const RenderPath* path) const
+{
+    FillRule fillRule;
+    if (!path->peekFillRule(&fillRule))
+    {
+        return Picture::FillRuleState::unknown;
+    }
+    return static_cast<Picture::FillRuleState>(
+        static_cast<uint8_t>(fillRule) + 1);
+}
+
+void PictureRecorder::save()
+{
+    m_saveStack.push_back({m_picture->m_ops.size(),
+                           m_picture->m_matrices.size(),
+                           m_picture->m_paths.size(),
+                           m_picture->m_drawCount});
+    pushOp(Picture::OpType::save, 0);
+}
+
+void PictureRecorder::restore()
+{
+    assert(!m_saveStack.empty());
+    if (m_saveStack.empty())
+    {
+        return;
+    }
+    SaveRecord record = m_saveStack.back();
+    m_saveStack.pop_back();
+    if (record.drawCount == m_picture->m_drawCount)
+    {
+        // Nothing was drawn since the matching save(), so the whole block
+        // (including any transforms and clips inside it) has no effect.
+        m_picture->m_ops.resize(record.opCount);
+        m_picture->m_matrices.resize(record.matrixCount);
+        m_picture->m_paths.resize(record.pathCount);
+        return;
+    }
+    pushOp(Picture::OpType::restore, 0);
+}
+
+void PictureRecorder::transform(const Mat2D& matrix)
+{
+    if (matrix == Mat2D())
+    {
+        return;
+    }
+    std::vector<Picture::Op>& ops = m_picture->m_ops;
+    if (!ops.empty() && ops.back().type == Picture::OpType::transform)
+    {
+        // Transforms are only ever appended along with their op, so the most
+        // recent matrix belongs to the most recent op.
+        assert(ops.back().index + 1 == m_picture->m_matrices.size());
+        m_picture->m_matrices.back() = m_picture->m_matrices.back() * matrix;
+        return;
+    }
+    pushOp(Picture::OpType::transform,
+           static_cast<uint32_t>(m_picture->m_matrices.size()));
+    m_picture->m_matrices.push_back(matrix);
+}
+
+void PictureRecorder::drawPath(RenderPath* path, RenderPaint* paint)
+{
+    if (path == nullptr || paint == nullptr)
+    {
+        return;
+    }
+    pushOp(Picture::OpType::drawPath,
+           static_cast<uint32_t>(m_picture->m_paths.size()),
+           static_cast<uint32_t>(m_picture->m_paints.size()));
+    m_picture->m_ops.back().fillRule = fillRuleOf(path);
+    m_picture->m_paths.push_back(ref_rcp(path));
+    m_picture->m_paints.push_back(ref_rcp(paint));
+    ++m_picture->m_drawCount;
+}
+
+void PictureRecorder::clipPath(RenderPath* path)
+{
+    if (path == nullptr)
+    {
+        return;
+    }
+    pushOp(Picture::OpType::clipPath,
+           static_cast<uint32_t>(m_picture->m_paths.size()));
+    m_picture->m_ops.back().fillRule = fillRuleOf(path);
+    m_picture->m_paths.push_back(ref_rcp(path));
+}
+
+void PictureRecorder::drawImage(const RenderImage* image,
+                                ImageSampler sampler,
+                                BlendMode blendMode,
+                                float opacity)
+{
+    // Use inverse logic to ensure we also drop NaN opacity. A fully
+    // transparent image leaves the destination unchanged in every blend mode.
+    if (image == nullptr || !(opacity > 0))
+    {
+        return;
+    }
+    pushOp(Picture::OpType::drawImage,
+           static_cast<uint32_t>(m_picture->m_images.size()));
+    m_picture->m_images.push_back(
+        {ref_rcp(image), sampler, blendMode, opacity});
+    ++m_picture->m_drawCount;
+}
+
+void PictureRecorder::drawImageMesh(const RenderImage* image,
+                                    ImageSampler sampler,
+                                    rcp<RenderBuffer> vertices_f32,
+                                    rcp<RenderBuffer> uvCoords_f32,
+                                    rcp<RenderBuffer> indices_u16,
+                                    uint32_t vertexCount,
+                                    uint32_t indexCount,
+                                    BlendMode blendMode,
+                                    float opacity)
+{
+    if (image == nullptr || vertices_f32 == nullptr ||
+        uvCoords_f32 == nullptr || indices_u16 == nullptr || indexCount == 0 ||
+        !(opacity > 0))
+    {
+        return;
+    }
+    pushOp(Picture::OpType::drawImageMesh,
+           static_cast<uint32_t>(m_picture->m_meshes.size()));
+    m_picture->m_meshes.push_back({{ref_rcp(image), sampler, blendMode, opacity},
+                                   std::move(vertices_f32),
+                                   std::move(uvCoords_f32),
+                                   std::move(indices_u16),
+                                   vertexCount,
+                                   indexCount});
+    ++m_picture->m_drawCount;
+}
@@ -1,4 +1,5 @@
 #include "rive/math/mat2d.hpp"
+#include "rive/picture.hpp"
 #include "rive/renderer.hpp"
 #include "rive/text_engine.hpp"
 
@@ -98,6 +99,8 @@ void Renderer::rotate(float radians)
     this->transform(Mat2D(c, s, -s, c, 0, 0));
 }
 
+void Renderer::drawPicture(const Picture& picture) { picture.playback(this); }
+
 RenderBuffer::RenderBuffer(RenderBufferType type,
                            RenderBufferFlags flags,
                            size_t sizeInBytes) :
@@ -48,6 +48,9 @@ bool TextStylePaint::addPath(const RawPath& rawPath, float opacity)
 
 void TextStylePaint::draw(Renderer* renderer, const Mat2D& worldTransform)
 {
+    // Each translucent draw gets its own pooled paint (rather than reusing
+    // them for every shape paint), so a recorded Picture can replay them.
+    uint32_t paintIndex = 0;
     for (auto shapePaint : m_ShapePaints)
     {
         if (!shapePaint->shouldDraw())
@@ -64,17 +67,16 @@ void TextStylePaint::draw(Renderer* renderer, const Mat2D& worldTransform)
             shapePaint->draw(renderer, &path, worldTransform, true);
         }
 
-        if (m_paintPool.size() < m_opacityPaths.size())
+        if (m_paintPool.size() < paintIndex + m_opacityPaths.size())
         {
-            m_paintPool.reserve(m_opacityPaths.size());
+            m_paintPool.reserve(paintIndex + m_opacityPaths.size());
             Factory* factory = artboard()->factory();
-            while (m_paintPool.size() < m_opacityPaths.size())
+            while (m_paintPool.size() < paintIndex + m_opacityPaths.size())
             {
                 m_paintPool.emplace_back(factory->makeRenderPaint());
             }
         }
 
-        uint32_t paintIndex = 0;
         for (itr = m_opacityPaths.begin(); itr != m_opacityPaths.end(); itr++)
         {
             // Don't render opaque paths twice
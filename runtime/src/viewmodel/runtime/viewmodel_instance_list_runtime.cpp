@@ -104,6 +104,57 @@ void ViewModelInstanceListRuntime::swap(uint32_t a, uint32_t b)
     instanceList->swap(a, b);
 }
 
+void ViewModelInstanceListRuntime::replaceInstances(
+    const std::vector<ViewModelInstanceRuntime*>& instances)
+{
+    auto instanceList = m_viewModelInstanceValue->as<ViewModelInstanceList>();
+    std::unordered_multimap<ViewModelInstance*, rcp<ViewModelInstanceListItem>>
+        reusableItems;
+    for (auto& item : instanceList->listItems())
+    {
+        reusableItems.emplace(item->viewModelInstance().get(), item);
+    }
+
+    std::vector<rcp<ViewModelInstanceListItem>> items;
+    items.reserve(instances.size());
+    std::unordered_map<rcp<ViewModelInstanceListItem>,
+                       rcp<ViewModelInstanceRuntime>>
+        itemsMap;
+    for (auto instanceRuntime : instances)
+    {
+        if (instanceRuntime == nullptr)
+        {
+            continue;
+        }
+        rcp<ViewModelInstanceListItem> listItem;
+        auto reusable = reusableItems.find(instanceRuntime->instance().get());
+        if (reusable != reusableItems.end())
+        {
+            listItem = reusable->second;
+            reusableItems.erase(reusable);
+        }
+        else
+        {
+            listItem = make_rcp<ViewModelInstanceListItem>();
+            listItem->viewModelInstance(instanceRuntime->instance());
+        }
+        itemsMap[listItem] = ref_rcp(instanceRuntime);
+        items.push_back(listItem);
+    }
+    m_itemsMap = std::move(itemsMap);
+    instanceList->replaceItems(std::move(items));
+}
+
+void ViewModelInstanceListRuntime::beginBatch()
+{
+    m_viewModelInstanceValue->as<ViewModelInstanceList>()->beginBatch();
+}
+
+void ViewModelInstanceListRuntime::endBatch()
+{
+    m_viewModelInstanceValue->as<ViewModelInstanceList>()->endBatch();
+}
+
 size_t ViewModelInstanceListRuntime::size() const
 {
     auto listItems =
@@ -12,6 +12,11 @@ ViewModelInstanceList::~ViewModelInstanceList() {}
 
 void ViewModelInstanceList::propertyValueChanged()
 {
+    if (m_batchDepth > 0)
+    {
+        m_batchChanged = true;
+        return;
+    }
     addDirt(ComponentDirt::Bindings);
     onValueChanged();
 }
@@ -79,6 +84,28 @@ void ViewModelInstanceList::swap(uint32_t index1, uint32_t index2)
     }
 }
 
+void ViewModelInstanceList::replaceItems(
+    std::vector<rcp<ViewModelInstanceListItem>> items)
+{
+    m_ListItems = std::move(items);
+    propertyValueChanged();
+}
+
+void ViewModelInstanceList::beginBatch() { m_batchDepth++; }
+
+void ViewModelInstanceList::endBatch()
+{
+    if (m_batchDepth == 0)
+    {
+        return;
+    }
+    if (--m_batchDepth == 0 && m_batchChanged)
+    {
+        m_batchChanged = false;
+        propertyValueChanged();
+    }
+}
+
 Core* ViewModelInstanceList::clone() const
 {
     auto cloned = new ViewModelInstanceList();
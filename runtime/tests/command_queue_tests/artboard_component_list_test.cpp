@@ -0,0 +1,206 @@
+/*
+ * Copyright 2025 Rive
+ */
+
+// Keyed diffing of ArtboardComponentList items and batched edits of
+// ViewModelInstanceList. No test asset has an artboard list, so the list is
+// built by hand and hosted by an instance of databinding.riv's artboard, whose
+// Person view model makes it the artboard for Person list items.
+
+#include "test_server.hpp"
+#include "rive/artboard_component_list.hpp"
+#include "rive/file.hpp"
+#include "rive/viewmodel/viewmodel_instance_list.hpp"
+
+using namespace rive;
+using namespace rive_tests;
+
+namespace
+{
+class TestList : public ArtboardComponentList
+{
+public:
+    void clearDirt() { m_Dirt = ComponentDirt::None; }
+};
+
+class ChangeCounter : public ViewModelInstanceValueDelegate
+{
+public:
+    void valueChanged() override { ++changes; }
+
+    int changes = 0;
+};
+
+struct ListFixture
+{
+    ListFixture()
+    {
+        std::vector<uint8_t> bytes = loadAsset("databinding.riv");
+        file = File::import(bytes, &factory);
+        if (file == nullptr)
+        {
+            return;
+        }
+        host = file->artboardDefault();
+        // Parent the list to the host artboard (object 0).
+        list.parentId(0);
+        list.onAddedDirty(host.get());
+        list.file(file.get());
+    }
+
+    bool loaded() const { return host != nullptr; }
+
+    rcp<ViewModelInstanceListItem> makeItem(size_t viewModelIndex)
+    {
+        return makeItem(file->createViewModelInstance(
+            file->viewModel(viewModelIndex)));
+    }
+
+    rcp<ViewModelInstanceListItem> makeItem(rcp<ViewModelInstance> instance)
+    {
+        auto item = make_rcp<ViewModelInstanceListItem>();
+        item->viewModelInstance(instance);
+        return item;
+    }
+
+    NoOpFactory factory;
+    rcp<File> file;
+    std::unique_ptr<ArtboardInstance> host;
+    // Declared after host so it's destroyed first.
+    TestList list;
+};
+
+constexpr size_t kPerson = 0;
+constexpr size_t kPet = 1;
+} // namespace
+
+TEST_CASE(list_reorder_keeps_instances)
+{
+    ListFixture test;
+    CHECK(test.loaded());
+    if (!test.loaded())
+    {
+        return;
+    }
+    auto a = test.makeItem(kPerson);
+    auto b = test.makeItem(kPerson);
+    auto c = test.makeItem(kPerson);
+    std::vector<rcp<ViewModelInstanceListItem>> items = {a, b, c};
+    test.list.updateList(&items);
+    ArtboardInstance* artboardA = test.list.artboardInstance(0);
+    ArtboardInstance* artboardB = test.list.artboardInstance(1);
+    ArtboardInstance* artboardC = test.list.artboardInstance(2);
+    StateMachineInstance* stateMachineC = test.list.stateMachineInstance(2);
+    CHECK(artboardA != nullptr && artboardB != nullptr &&
+          artboardC != nullptr);
+    CHECK(artboardA != artboardB && artboardB != artboardC);
+
+    items = {c, a, b};
+    test.list.updateList(&items);
+    CHECK(test.list.artboardCount() == 3);
+    CHECK(test.list.artboardInstance(0) == artboardC);
+    CHECK(test.list.artboardInstance(1) == artboardA);
+    CHECK(test.list.artboardInstance(2) == artboardB);
+    CHECK(test.list.stateMachineInstance(0) == stateMachineC);
+}
+
+TEST_CASE(list_reinserted_view_model_adopts_instances)
+{
+    ListFixture test;
+    CHECK(test.loaded());
+    if (!test.loaded())
+    {
+        return;
+    }
+    auto a = test.makeItem(kPerson);
+    auto b = test.makeItem(kPerson);
+    std::vector<rcp<ViewModelInstanceListItem>> items = {a, b};
+    test.list.updateList(&items);
+    ArtboardInstance* artboardA = test.list.artboardInstance(0);
+    ArtboardInstance* artboardB = test.list.artboardInstance(1);
+
+    // a is removed and its view model comes back in a new list item, which
+    // takes over a's artboard. The brand new item gets a fresh one.
+    auto reinserted = test.makeItem(a->viewModelInstance());
+    auto added = test.makeItem(kPerson);
+    items = {b, added, reinserted};
+    test.list.updateList(&items);
+    CHECK(test.list.artboardCount() == 3);
+    CHECK(test.list.artboardInstance(0) == artboardB);
+    CHECK(test.list.artboardInstance(1) != nullptr);
+    CHECK(test.list.artboardInstance(1) != artboardA);
+    CHECK(test.list.artboardInstance(2) == artboardA);
+}
+
+TEST_CASE(unchanged_list_relayouts_only_when_sizes_change)
+{
+    ListFixture test;
+    CHECK(test.loaded());
+    if (!test.loaded())
+    {
+        return;
+    }
+    auto a = test.makeItem(kPerson);
+    auto b = test.makeItem(kPerson);
+    std::vector<rcp<ViewModelInstanceListItem>> items = {a, b};
+    test.list.updateList(&items);
+    ArtboardInstance* artboardA = test.list.artboardInstance(0);
+
+    test.list.clearDirt();
+    test.list.updateList(&items);
+    CHECK(!test.list.hasDirt(ComponentDirt::Components));
+    CHECK(!test.list.hasDirt(ComponentDirt::WorldTransform));
+    CHECK(test.list.artboardInstance(0) == artboardA);
+
+    // Swapping a's view model for one no artboard is made for drops its
+    // size, so the list has to lay out again.
+    a->viewModelInstance(
+        test.file->createViewModelInstance(test.file->viewModel(kPet)));
+    test.list.updateList(&items);
+    CHECK(test.list.hasDirt(ComponentDirt::Components));
+    CHECK(test.list.hasDirt(ComponentDirt::WorldTransform));
+}
+
+TEST_CASE(list_batch_reports_one_change)
+{
+    ListFixture test;
+    CHECK(test.loaded());
+    if (!test.loaded())
+    {
+        return;
+    }
+    ViewModelInstanceList list;
+    ChangeCounter counter;
+    list.addDelegate(&counter);
+
+    list.addItem(test.makeItem(kPerson));
+    CHECK(counter.changes == 1);
+
+    list.beginBatch();
+    list.addItem(test.makeItem(kPerson));
+    list.addItemAt(test.makeItem(kPerson), 0);
+    list.swap(0, 2);
+    list.removeItem(1);
+    CHECK(counter.changes == 1);
+    list.endBatch();
+    CHECK(counter.changes == 2);
+    CHECK(list.listItems().size() == 2);
+
+    // Nested batches report once, when the outermost one ends.
+    list.beginBatch();
+    list.beginBatch();
+    list.addItem(test.makeItem(kPerson));
+    list.endBatch();
+    CHECK(counter.changes == 2);
+    list.replaceItems({});
+    list.endBatch();
+    CHECK(counter.changes == 3);
+
+    // A batch without edits reports nothing, and an unmatched endBatch is
+    // ignored.
+    list.beginBatch();
+    list.endBatch();
+    list.endBatch();
+    CHECK(counter.changes == 3);
+    list.removeDelegate(&counter);
+}
@@ -0,0 +1,229 @@
+/*
+ * Copyright 2025 Rive
+ */
+
+// Covers each rule of CommandQueue::setCommandCoalescing(), and the cases that
+// must not be coalesced.
+
+#include "test_server.hpp"
+#include "rive/viewmodel/runtime/viewmodel_runtime.hpp"
+
+using namespace rive;
+using namespace rive_tests;
+
+namespace
+{
+// databinding.riv's default view model ("Person") has a number "age", a string
+// "name" and a trigger "jump".
+struct PersonScene
+{
+    explicit PersonScene(TestServer& test)
+    {
+        file = test.queue->loadFile(loadAsset("databinding.riv"));
+        artboard = test.queue->instantiateDefaultArtboard(file);
+        stateMachine = test.queue->instantiateDefaultStateMachine(artboard);
+        viewModel =
+            test.queue->instantiateDefaultViewModelInstance(file, artboard);
+        test.flush();
+    }
+
+    FileHandle file;
+    ArtboardHandle artboard;
+    StateMachineHandle stateMachine;
+    ViewModelInstanceHandle viewModel;
+};
+
+class ErrorListener : public CommandQueue::ViewModelInstanceListener
+{
+public:
+    void onViewModelInstanceError(const ViewModelInstanceHandle,
+                                  uint64_t requestId,
+                                  std::string) override
+    {
+        errorRequestIds.push_back(requestId);
+    }
+
+    std::vector<uint64_t> errorRequestIds;
+};
+
+class ValueListener : public CommandQueue::ViewModelInstanceListener
+{
+public:
+    void onViewModelDataReceived(
+        const ViewModelInstanceHandle,
+        uint64_t,
+        CommandQueue::ViewModelInstanceData data) override
+    {
+        numbers.push_back(data.numberValue);
+    }
+
+    std::vector<float> numbers;
+};
+
+float age(CommandServer* server, ViewModelInstanceHandle viewModel)
+{
+    return server->getViewModelInstance(viewModel)
+        ->propertyNumber("age")
+        ->value();
+}
+
+CommandQueue::PointerEvent pointerAt(float x, float y)
+{
+    CommandQueue::PointerEvent event;
+    event.screenBounds = Vec2D(500, 500);
+    event.position = Vec2D(x, y);
+    return event;
+}
+} // namespace
+
+TEST_CASE(coalescing_is_off_by_default)
+{
+    TestServer test;
+    PersonScene scene(test);
+    test.queue->setViewModelInstanceNumber(scene.viewModel, "age", 1);
+    test.queue->setViewModelInstanceNumber(scene.viewModel, "age", 2);
+    test.queue->setViewModelInstanceNumber(scene.viewModel, "age", 3);
+    CHECK(test.flushAndCountCommands() == 3);
+}
+
+TEST_CASE(coalescing_keeps_the_last_write_to_a_property)
+{
+    TestServer test;
+    PersonScene scene(test);
+    test.queue->setCommandCoalescing(true);
+    test.queue->setViewModelInstanceNumber(scene.viewModel, "age", 1);
+    test.queue->setViewModelInstanceNumber(scene.viewModel, "age", 2);
+    test.queue->setViewModelInstanceNumber(scene.viewModel, "age", 3);
+    CHECK(test.flushAndCountCommands() == 1);
+    float value = 0;
+    test.inspect([&](CommandServer* server) {
+        value = age(server, scene.viewModel);
+    });
+    CHECK(value == 3);
+}
+
+TEST_CASE(coalescing_keeps_interleaved_properties_apart)
+{
+    TestServer test;
+    PersonScene scene(test);
+    test.queue->setCommandCoalescing(true);
+    test.queue->setViewModelInstanceNumber(scene.viewModel, "age", 1);
+    test.queue->setViewModelInstanceString(scene.viewModel, "name", "a");
+    test.queue->setViewModelInstanceNumber(scene.viewModel, "age", 2);
+    test.queue->setViewModelInstanceString(scene.viewModel, "name", "b");
+    CHECK(test.flushAndCountCommands() == 2);
+    float value = 0;
+    std::string name;
+    test.inspect([&](CommandServer* server) {
+        value = age(server, scene.viewModel);
+        name = server->getViewModelInstance(scene.viewModel)
+                   ->propertyString("name")
+                   ->value();
+    });
+    CHECK(value == 2);
+    CHECK(name == "b");
+}
+
+TEST_CASE(coalescing_keeps_the_latest_request_id)
+{
+    TestServer test;
+    PersonScene scene(test);
+    ErrorListener listener;
+    ViewModelInstanceHandle viewModel =
+        test.queue->instantiateDefaultViewModelInstance(scene.file,
+                                                        scene.artboard,
+                                                        &listener);
+    test.flush();
+    test.queue->setCommandCoalescing(true);
+    test.queue->setViewModelInstanceNumber(viewModel, "missing", 1, 7);
+    test.queue->setViewModelInstanceNumber(viewModel, "missing", 2, 8);
+    test.flush();
+    CHECK(listener.errorRequestIds.size() == 1);
+    CHECK(!listener.errorRequestIds.empty() &&
+          listener.errorRequestIds.back() == 8);
+}
+
+TEST_CASE(coalescing_replaces_consecutive_pointer_moves)
+{
+    TestServer test;
+    PersonScene scene(test);
+    test.queue->setCommandCoalescing(true);
+    test.queue->pointerMove(scene.stateMachine, pointerAt(10, 10));
+    test.queue->pointerMove(scene.stateMachine, pointerAt(20, 20));
+    test.queue->pointerMove(scene.stateMachine, pointerAt(30, 30));
+    CHECK(test.flushAndCountCommands() == 1);
+}
+
+TEST_CASE(coalescing_keeps_pointer_moves_to_other_state_machines)
+{
+    TestServer test;
+    PersonScene scene(test);
+    StateMachineHandle other =
+        test.queue->instantiateDefaultStateMachine(scene.artboard);
+    test.flush();
+    test.queue->setCommandCoalescing(true);
+    test.queue->pointerMove(scene.stateMachine, pointerAt(10, 10));
+    test.queue->pointerMove(other, pointerAt(20, 20));
+    test.queue->pointerMove(scene.stateMachine, pointerAt(30, 30));
+    CHECK(test.flushAndCountCommands() == 3);
+}
+
+TEST_CASE(coalescing_keeps_pointer_moves_around_other_pointer_events)
+{
+    TestServer test;
+    PersonScene scene(test);
+    test.queue->setCommandCoalescing(true);
+    test.queue->pointerMove(scene.stateMachine, pointerAt(10, 10));
+    test.queue->pointerDown(scene.stateMachine, pointerAt(10, 10));
+    test.queue->pointerMove(scene.stateMachine, pointerAt(20, 20));
+    CHECK(test.flushAndCountCommands() == 3);
+}
+
+TEST_CASE(coalescing_stops_at_a_subscribe)
+{
+    TestServer test;
+    PersonScene scene(test);
+    ValueListener listener;
+    ViewModelInstanceHandle viewModel =
+        test.queue->instantiateDefaultViewModelInstance(scene.file,
+                                                        scene.artboard,
+                                                        &listener);
+    test.flush();
+    test.queue->setCommandCoalescing(true);
+    test.queue->setViewModelInstanceNumber(viewModel, "age", 1);
+    test.queue->subscribeToViewModelProperty(viewModel,
+                                             "age",
+                                             DataType::number);
+    test.queue->setViewModelInstanceNumber(viewModel, "age", 2);
+    CHECK(test.flushAndCountCommands() == 3);
+    // The second write happened after subscribing, so it is reported.
+    CHECK(listener.numbers.size() == 1);
+    CHECK(!listener.numbers.empty() && listener.numbers.back() == 2);
+}
+
+TEST_CASE(coalescing_stops_at_a_trigger)
+{
+    TestServer test;
+    PersonScene scene(test);
+    test.queue->setCommandCoalescing(true);
+    test.queue->setViewModelInstanceNumber(scene.viewModel, "age", 1);
+    test.queue->fireViewModelTrigger(scene.viewModel, "jump");
+    test.queue->setViewModelInstanceNumber(scene.viewModel, "age", 2);
+    CHECK(test.flushAndCountCommands() == 3);
+}
+
+TEST_CASE(coalescing_stops_at_a_flush)
+{
+    TestServer test;
+    PersonScene scene(test);
+    test.queue->setCommandCoalescing(true);
+    test.queue->setViewModelInstanceNumber(scene.viewModel, "age", 1);
+    CHECK(test.flushAndCountCommands() == 1);
+    test.queue->setViewModelInstanceNumber(scene.viewModel, "age", 2);
+    CHECK(test.flushAndCountCommands() == 1);
+    float value = 0;
+    test.inspect([&](CommandServer* server) {
+        value = age(server, scene.viewModel);
+    });
+    CHECK(value == 2);
+}
@@ -0,0 +1,153 @@
+/*
+ * Copyright 2025 Rive
+ */
+
+// Sharding of parallel state machine advances. State machines that can reach
+// the same view model instance must never be advanced concurrently.
+
+#include "test_server.hpp"
+#include "rive/viewmodel/runtime/viewmodel_runtime.hpp"
+
+using namespace rive;
+using namespace rive_tests;
+
+namespace
+{
+// A state machine on its own artboard, bound to its own "Person" instance.
+struct PersonScene
+{
+    PersonScene(TestServer& test, FileHandle file)
+    {
+        artboard = test.queue->instantiateDefaultArtboard(file);
+        stateMachine = test.queue->instantiateDefaultStateMachine(artboard);
+        person =
+            test.queue->instantiateDefaultViewModelInstance(file, artboard);
+        pet = test.queue->referenceNestedViewModelInstance(person, "pet");
+        test.queue->bindViewModelInstance(stateMachine, person);
+    }
+
+    ArtboardHandle artboard;
+    StateMachineHandle stateMachine;
+    ViewModelInstanceHandle person;
+    ViewModelInstanceHandle pet;
+};
+
+size_t advance(TestServer& test, const std::vector<PersonScene>& scenes)
+{
+    for (const PersonScene& scene : scenes)
+    {
+        test.queue->advanceStateMachine(scene.stateMachine, 1.0f / 60);
+    }
+    test.flush();
+    return test.server.testing_lastAdvanceShardCount();
+}
+} // namespace
+
+TEST_CASE(parallel_advance_splits_independent_files)
+{
+    TestServer test(4);
+    FileHandle fileA = test.queue->loadFile(loadAsset("databinding.riv"));
+    FileHandle fileB = test.queue->loadFile(loadAsset("databinding.riv"));
+    std::vector<PersonScene> scenes = {PersonScene(test, fileA),
+                                       PersonScene(test, fileB)};
+    CHECK(advance(test, scenes) == 2);
+}
+
+TEST_CASE(parallel_advance_keeps_a_shared_view_model_on_one_shard)
+{
+    TestServer test(4);
+    FileHandle file = test.queue->loadFile(loadAsset("databinding.riv"));
+    std::vector<PersonScene> scenes = {PersonScene(test, file),
+                                       PersonScene(test, file)};
+    // Both people now own the same pet.
+    test.queue->setViewModelInstanceNestedViewModel(scenes[1].person,
+                                                    "pet",
+                                                    scenes[0].pet);
+    CHECK(advance(test, scenes) == 1);
+    // Writes through either person land in the one shared pet.
+    test.queue->setViewModelInstanceString(scenes[1].person, "pet/name", "x");
+    CHECK(advance(test, scenes) == 1);
+    std::string name;
+    test.inspect([&](CommandServer* server) {
+        name = server->getViewModelInstance(scenes[0].person)
+                   ->propertyString("pet/name")
+                   ->value();
+    });
+    CHECK(name == "x");
+}
+
+TEST_CASE(parallel_advance_keeps_linked_files_on_one_shard)
+{
+    TestServer test(4);
+    FileHandle fileA = test.queue->loadFile(loadAsset("databinding.riv"));
+    FileHandle fileB = test.queue->loadFile(loadAsset("databinding.riv"));
+    std::vector<PersonScene> scenes = {PersonScene(test, fileA),
+                                       PersonScene(test, fileB)};
+    CHECK(advance(test, scenes) == 2);
+    // Moving file B's pet into file A's person links the two graphs.
+    test.queue->setViewModelInstanceNestedViewModel(scenes[0].person,
+                                                    "pet",
+                                                    scenes[1].pet);
+    CHECK(advance(test, scenes) == 1);
+}
+
+TEST_CASE(parallel_advance_drops_links_of_deleted_files)
+{
+    TestServer test(4);
+    FileHandle fileA = test.queue->loadFile(loadAsset("databinding.riv"));
+    FileHandle fileB = test.queue->loadFile(loadAsset("databinding.riv"));
+    FileHandle fileC = test.queue->loadFile(loadAsset("databinding.riv"));
+    std::vector<PersonScene> scenes = {PersonScene(test, fileA),
+                                       PersonScene(test, fileB),
+                                       PersonScene(test, fileC)};
+    // A links to B and B links to C, so all three share a shard.
+    test.queue->setViewModelInstanceNestedViewModel(scenes[0].person,
+                                                    "pet",
+                                                    scenes[1].pet);
+    test.queue->setViewModelInstanceNestedViewModel(scenes[1].person,
+                                                    "pet",
+                                                    scenes[2].pet);
+    CHECK(advance(test, scenes) == 1);
+    // Without B, nothing connects A and C any more.
+    test.queue->deleteFile(fileB);
+    CHECK(advance(test, {scenes[0], scenes[2]}) == 2);
+}
+
+TEST_CASE(parallel_advance_matches_serial_advance)
+{
+    TestServer serial;
+    TestServer parallel(4);
+    std::vector<std::string> names;
+    for (TestServer* test : {&serial, &parallel})
+    {
+        FileHandle file = test->queue->loadFile(loadAsset("databinding.riv"));
+        std::vector<PersonScene> scenes;
+        for (int i = 0; i < 8; ++i)
+        {
+            scenes.emplace_back(*test, file);
+        }
+        for (int i = 1; i < 8; ++i)
+        {
+            test->queue->setViewModelInstanceNestedViewModel(scenes[i].person,
+                                                             "pet",
+                                                             scenes[0].pet);
+        }
+        for (int frame = 0; frame < 30; ++frame)
+        {
+            test->queue->setViewModelInstanceString(
+                scenes[frame % 8].person,
+                "pet/name",
+                std::to_string(frame));
+            advance(*test, scenes);
+        }
+        std::string name;
+        test->inspect([&](CommandServer* server) {
+            name = server->getViewModelInstance(scenes[0].pet)
+                       ->propertyString("name")
+                       ->value();
+        });
+        names.push_back(name);
+    }
+    CHECK(names[0] == "29");
+    CHECK(names[0] == names[1]);
+}
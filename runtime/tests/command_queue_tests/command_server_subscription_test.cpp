@@ -0,0 +1,97 @@
+/*
+ * Copyright 2025 Rive
+ */
+
+// View model property subscriptions, in particular ones whose path goes
+// through a nested view model that gets replaced.
+
+#include "test_server.hpp"
+#include "rive/viewmodel/runtime/viewmodel_runtime.hpp"
+
+using namespace rive;
+using namespace rive_tests;
+
+namespace
+{
+class StringListener : public CommandQueue::ViewModelInstanceListener
+{
+public:
+    void onViewModelDataReceived(
+        const ViewModelInstanceHandle,
+        uint64_t,
+        CommandQueue::ViewModelInstanceData data) override
+    {
+        strings.push_back(data.stringValue);
+    }
+
+    std::vector<std::string> strings;
+};
+} // namespace
+
+TEST_CASE(subscription_reports_changes_once_per_flush)
+{
+    TestServer test;
+    StringListener listener;
+    FileHandle file = test.queue->loadFile(loadAsset("databinding.riv"));
+    ViewModelInstanceHandle person =
+        test.queue->instantiateDefaultViewModelInstance(file,
+                                                        "Person",
+                                                        &listener);
+    test.queue->subscribeToViewModelProperty(person,
+                                             "pet/name",
+                                             DataType::string);
+    test.flush();
+    test.queue->setViewModelInstanceString(person, "pet/name", "a");
+    test.queue->setViewModelInstanceString(person, "pet/name", "b");
+    test.flush();
+    CHECK(listener.strings.size() == 1);
+    CHECK(!listener.strings.empty() && listener.strings.back() == "b");
+
+    // Sending the value clears the runtime property's change flag.
+    bool hasChanged = true;
+    test.inspect([&](CommandServer* server) {
+        hasChanged = server->getViewModelInstance(person)
+                         ->property("pet/name")
+                         ->hasChanged();
+    });
+    CHECK(!hasChanged);
+
+    test.flush();
+    CHECK(listener.strings.size() == 1);
+}
+
+TEST_CASE(subscription_follows_a_replaced_nested_view_model)
+{
+    TestServer test;
+    StringListener listener;
+    FileHandle file = test.queue->loadFile(loadAsset("databinding.riv"));
+    ViewModelInstanceHandle person =
+        test.queue->instantiateDefaultViewModelInstance(file,
+                                                        "Person",
+                                                        &listener);
+    ViewModelInstanceHandle oldPet =
+        test.queue->referenceNestedViewModelInstance(person, "pet");
+    ViewModelInstanceHandle newPet =
+        test.queue->instantiateDefaultViewModelInstance(file, "Pet");
+    test.queue->setViewModelInstanceString(newPet, "name", "new");
+    test.queue->subscribeToViewModelProperty(person,
+                                             "pet/name",
+                                             DataType::string);
+    test.flush();
+    CHECK(listener.strings.empty());
+
+    // The subscriber gets the new pet's current name when it is swapped in.
+    test.queue->setViewModelInstanceNestedViewModel(person, "pet", newPet);
+    test.flush();
+    CHECK(listener.strings.size() == 1);
+    CHECK(!listener.strings.empty() && listener.strings.back() == "new");
+
+    // Changes to the new pet are reported, changes to the old one aren't.
+    test.queue->setViewModelInstanceString(newPet, "name", "newer");
+    test.flush();
+    CHECK(listener.strings.size() == 2);
+    CHECK(!listener.strings.empty() && listener.strings.back() == "newer");
+    test.queue->setViewModelInstanceString(oldPet, "name", "old");
+    test.flush();
+    CHECK(listener.strings.size() == 2);
+}
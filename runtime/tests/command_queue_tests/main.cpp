@@ -0,0 +1,82 @@
+/*
+ * Copyright 2025 Rive
+ */
+
+// Runs every TEST_CASE linked into the binary, or only the ones whose names
+// are given on the command line.
+//
+//   command_queue_tests [--assets dir] [test_name...]
+
+#include "test_server.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+namespace rive_tests
+{
+static std::string assetsDir = "test/assets";
+
+std::vector<TestCase>& registeredTests()
+{
+    static std::vector<TestCase> tests;
+    return tests;
+}
+
+int checkFailures = 0;
+
+std::vector<uint8_t> loadAsset(const char* name)
+{
+    std::string path = assetsDir + "/" + name;
+    std::ifstream stream(path, std::ios::binary);
+    if (!stream)
+    {
+        fprintf(stderr, "failed to open %s\n", path.c_str());
+        ++checkFailures;
+        return {};
+    }
+    return {std::istreambuf_iterator<char>(stream), {}};
+}
+} // namespace rive_tests
+
+int main(int argc, const char** argv)
+{
+    std::vector<const char*> filters;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (!strcmp(argv[i], "--assets") && i + 1 < argc)
+        {
+            rive_tests::assetsDir = argv[++i];
+        }
+        else
+        {
+            filters.push_back(argv[i]);
+        }
+    }
+
+    int testCount = 0;
+    int failedTests = 0;
+    for (const rive_tests::TestCase& test : rive_tests::registeredTests())
+    {
+        if (!filters.empty() &&
+            std::find_if(filters.begin(),
+                         filters.end(),
+                         [&test](const char* filter) {
+                             return !strcmp(filter, test.name);
+                         }) == filters.end())
+        {
+            continue;
+        }
+        int failuresBefore = rive_tests::checkFailures;
+        test.function();
+        ++testCount;
+        if (rive_tests::checkFailures != failuresBefore)
+        {
+            fprintf(stderr, "FAILED %s\n", test.name);
+            ++failedTests;
+        }
+    }
+    printf("%d tests, %d failed\n", testCount, failedTests);
+    return failedTests == 0 ? 0 : 1;
+}
@@ -0,0 +1,311 @@
+/*
+ * Copyright 2025 Rive
+ */
+
+// PictureRecorder simplifies the stream it records. Each test makes the same
+// calls directly on a logging renderer and through a recorded picture, then
+// checks that both draw the same things under the same transform and clips,
+// and that the replayed calls were simplified as expected.
+
+#include "test_server.hpp"
+#include "rive/picture.hpp"
+
+using namespace rive;
+using namespace rive_tests;
+
+namespace
+{
+const char* fillRuleName(FillRule fillRule)
+{
+    switch (fillRule)
+    {
+        case FillRule::nonZero:
+            return "nonZero";
+        case FillRule::evenOdd:
+            return "evenOdd";
+        case FillRule::clockwise:
+            return "clockwise";
+    }
+    return "?";
+}
+
+class LoggingPath : public RenderPath
+{
+public:
+    LoggingPath(const char* name, bool reportsFillRule = true) :
+        name(name), m_reportsFillRule(reportsFillRule)
+    {}
+
+    void rewind() override {}
+    void fillRule(FillRule value) override { currentFillRule = value; }
+    void addPath(CommandPath*, const Mat2D&) override {}
+    void addRenderPath(RenderPath*, const Mat2D&) override {}
+    void moveTo(float, float) override {}
+    void lineTo(float, float) override {}
+    void cubicTo(float, float, float, float, float, float) override {}
+    void close() override {}
+    void addRawPath(const RawPath&) override {}
+
+    bool peekFillRule(FillRule* fillRule) const override
+    {
+        if (!m_reportsFillRule)
+        {
+            return false;
+        }
+        *fillRule = currentFillRule;
+        return true;
+    }
+
+    std::string describe() const
+    {
+        return name + "/" + fillRuleName(currentFillRule);
+    }
+
+    std::string name;
+    FillRule currentFillRule = FillRule::nonZero;
+
+private:
+    bool m_reportsFillRule;
+};
+
+// Logs the name of every call in 'calls', and every draw in 'draws' along with
+// the transform and clips it is drawn under.
+class LoggingRenderer : public Renderer
+{
+public:
+    LoggingRenderer() { m_stack.push_back(State()); }
+
+    void save() override
+    {
+        calls.push_back("save");
+        m_stack.push_back(m_stack.back());
+    }
+
+    void restore() override
+    {
+        calls.push_back("restore");
+        m_stack.pop_back();
+    }
+
+    void transform(const Mat2D& matrix) override
+    {
+        calls.push_back("transform");
+        m_stack.back().matrix = m_stack.back().matrix * matrix;
+    }
+
+    void drawPath(RenderPath* path, RenderPaint*) override
+    {
+        calls.push_back("drawPath");
+        draws.push_back(static_cast<LoggingPath*>(path)->describe() + " " +
+                        state());
+    }
+
+    void clipPath(RenderPath* path) override
+    {
+        calls.push_back("clipPath");
+        m_stack.back().clips +=
+            static_cast<LoggingPath*>(path)->describe() + "@" +
+            matrixString(m_stack.back().matrix) + " ";
+    }
+
+    void drawImage(const RenderImage*, ImageSampler, BlendMode, float) override
+    {
+        calls.push_back("drawImage");
+        draws.push_back("image " + state());
+    }
+
+    void drawImageMesh(const RenderImage*,
+                       ImageSampler,
+                       rcp<RenderBuffer>,
+                       rcp<RenderBuffer>,
+                       rcp<RenderBuffer>,
+                       uint32_t,
+                       uint32_t,
+                       BlendMode,
+                       float) override
+    {
+        calls.push_back("drawImageMesh");
+        draws.push_back("mesh " + state());
+    }
+
+    std::vector<std::string> calls;
+    std::vector<std::string> draws;
+
+private:
+    struct State
+    {
+        Mat2D matrix;
+        std::string clips;
+    };
+
+    static std::string matrixString(const Mat2D& matrix)
+    {
+        char buffer[128];
+        snprintf(buffer,
+                 sizeof(buffer),
+                 "[%g %g %g %g %g %g]",
+                 matrix[0],
+                 matrix[1],
+                 matrix[2],
+                 matrix[3],
+                 matrix[4],
+                 matrix[5]);
+        return buffer;
+    }
+
+    std::string state() const
+    {
+        return matrixString(m_stack.back().matrix) + " clips: " +
+               m_stack.back().clips;
+    }
+
+    std::vector<State> m_stack;
+};
+
+using Calls = std::vector<std::string>;
+
+// Runs 'calls' directly and through a picture, checks that both draw the same
+// things, and returns the replayed calls.
+template <typename Function> Calls directAndReplayed(Function calls)
+{
+    LoggingRenderer direct;
+    calls(&direct);
+
+    PictureRecorder recorder;
+    calls(&recorder);
+    rcp<Picture> picture = recorder.finishRecording();
+    LoggingRenderer replayed;
+    picture->playback(&replayed);
+
+    CHECK(!direct.draws.empty());
+    CHECK(replayed.draws == direct.draws);
+    CHECK(picture->drawCount() == direct.draws.size());
+    return replayed.calls;
+}
+
+rcp<RenderPaint> makePaint()
+{
+    NoOpFactory noOpFactory;
+    Factory& factory = noOpFactory;
+    return factory.makeRenderPaint();
+}
+
+const Mat2D kScale = Mat2D::fromScale(2, 3);
+const Mat2D kTranslate = Mat2D::fromTranslate(10, 20);
+const Mat2D kRotate = Mat2D::fromRotation(0.5f);
+} // namespace
+
+TEST_CASE(picture_restore_drops_blocks_that_never_draw)
+{
+    rcp<RenderPaint> paint = makePaint();
+    LoggingPath shape("shape");
+    LoggingPath clip("clip");
+    Calls calls = directAndReplayed([&](Renderer* renderer) {
+        renderer->save();
+        renderer->transform(kScale);
+        renderer->clipPath(&clip);
+        renderer->save();
+        renderer->transform(kTranslate);
+        renderer->restore();
+        renderer->restore();
+
+        renderer->save();
+        renderer->clipPath(&clip);
+        renderer->save();
+        renderer->transform(kRotate);
+        renderer->restore();
+        renderer->drawPath(&shape, paint.get());
+        renderer->restore();
+    });
+    CHECK((calls == Calls{"save", "clipPath", "drawPath", "restore"}));
+}
+
+TEST_CASE(picture_merges_transforms_around_dropped_blocks)
+{
+    rcp<RenderPaint> paint = makePaint();
+    LoggingPath shape("shape");
+    LoggingPath clip("clip");
+    Calls calls = directAndReplayed([&](Renderer* renderer) {
+        renderer->transform(kScale);
+        renderer->save();
+        renderer->transform(kRotate);
+        renderer->clipPath(&clip);
+        renderer->restore();
+        renderer->transform(kTranslate);
+        renderer->transform(Mat2D());
+        renderer->drawPath(&shape, paint.get());
+    });
+    // The rotation was inside the dropped block, so only scale * translate
+    // remains, as one transform.
+    CHECK((calls == Calls{"transform", "drawPath"}));
+}
+
+TEST_CASE(picture_strips_trailing_transforms_and_clips)
+{
+    rcp<RenderPaint> paint = makePaint();
+    LoggingPath shape("shape");
+    LoggingPath clip("clip");
+    Calls calls = directAndReplayed([&](Renderer* renderer) {
+        renderer->save();
+        renderer->drawPath(&shape, paint.get());
+        renderer->restore();
+        renderer->transform(kScale);
+        renderer->clipPath(&clip);
+        renderer->transform(kTranslate);
+        // Left open: finishRecording() closes it, and with nothing drawn
+        // inside, drops it.
+        renderer->save();
+        renderer->clipPath(&clip);
+    });
+    CHECK((calls == Calls{"save", "drawPath", "restore"}));
+
+    // A picture of nothing but state changes is empty.
+    PictureRecorder recorder;
+    recorder.transform(kScale);
+    recorder.clipPath(&clip);
+    rcp<Picture> picture = recorder.finishRecording();
+    LoggingRenderer replayed;
+    picture->playback(&replayed);
+    CHECK(picture->empty());
+    CHECK(replayed.calls.empty());
+}
+
+TEST_CASE(picture_captures_fill_rules_at_record_time)
+{
+    rcp<RenderPaint> paint = makePaint();
+    LoggingPath shape("shape");
+    LoggingPath clip("clip");
+    auto calls = [&](Renderer* renderer) {
+        clip.fillRule(FillRule::clockwise);
+        renderer->clipPath(&clip);
+        shape.fillRule(FillRule::evenOdd);
+        renderer->drawPath(&shape, paint.get());
+        shape.fillRule(FillRule::nonZero);
+        renderer->drawPath(&shape, paint.get());
+    };
+    LoggingRenderer direct;
+    calls(&direct);
+
+    PictureRecorder recorder;
+    calls(&recorder);
+    rcp<Picture> picture = recorder.finishRecording();
+    // Playback restores the rules each call was recorded with.
+    clip.fillRule(FillRule::nonZero);
+    shape.fillRule(FillRule::clockwise);
+    LoggingRenderer replayed;
+    picture->playback(&replayed);
+    CHECK(replayed.draws == direct.draws);
+    CHECK(shape.currentFillRule == FillRule::nonZero);
+
+    // A path that doesn't report its rule is drawn with whatever it has at
+    // playback time.
+    LoggingPath untracked("untracked", false);
+    untracked.fillRule(FillRule::evenOdd);
+    recorder.drawPath(&untracked, paint.get());
+    picture = recorder.finishRecording();
+    untracked.fillRule(FillRule::clockwise);
+    LoggingRenderer later;
+    picture->playback(&later);
+    CHECK(later.draws.size() == 1);
+    CHECK(later.draws[0].find("untracked/clockwise ") == 0);
+}
@@ -0,0 +1,108 @@
+/*
+ * Copyright 2025 Rive
+ */
+
+#pragma once
+
+#include "rive/animation/state_machine_instance.hpp"
+#include "rive/command_queue.hpp"
+#include "rive/command_server.hpp"
+#include "utils/no_op_factory.hpp"
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// Minimal test registry: TEST_CASE defines a function that main() runs, and
+// CHECK records a failure without stopping the test.
+namespace rive_tests
+{
+using TestFunction = void (*)();
+
+struct TestCase
+{
+    const char* name;
+    TestFunction function;
+};
+
+std::vector<TestCase>& registeredTests();
+extern int checkFailures;
+
+struct RegisterTest
+{
+    RegisterTest(const char* name, TestFunction function)
+    {
+        registeredTests().push_back({name, function});
+    }
+};
+
+// Reads a file from the test assets directory (test/assets by default).
+std::vector<uint8_t> loadAsset(const char* name);
+
+// A CommandQueue and a CommandServer that share the calling thread. flush()
+// runs everything recorded so far on the server, then delivers the messages
+// it produced to the queue's listeners.
+class TestServer
+{
+public:
+    explicit TestServer(uint32_t workerThreadCount = 0) :
+        queue(rive::make_rcp<rive::CommandQueue>()),
+        server(queue, &factory, workerThreadCount)
+    {
+        queue->setMetricsEnabled(true);
+    }
+
+    ~TestServer()
+    {
+        queue->disconnect();
+        server.processCommands();
+    }
+
+    void flush()
+    {
+        server.processCommands();
+        queue->processMessages();
+    }
+
+    // Flushes and returns how many recorded commands the server executed,
+    // not counting the loop break each flush appends.
+    uint64_t flushAndCountCommands()
+    {
+        rive::CommandQueue::Metrics before = queue->metrics();
+        flush();
+        rive::CommandQueue::Metrics after = queue->metrics();
+        return (after.commandsExecuted - before.commandsExecuted) -
+               (after.batchesExecuted - before.batchesExecuted);
+    }
+
+    // Runs fn on the server, after every command recorded so far.
+    template <typename Fn> void inspect(Fn fn)
+    {
+        queue->runOnce([fn](rive::CommandServer* server) { fn(server); });
+        flush();
+    }
+
+    rive::NoOpFactory factory;
+    rive::rcp<rive::CommandQueue> queue;
+    rive::CommandServer server;
+};
+} // namespace rive_tests
+
+#define TEST_CASE(name)                                                        \
+    static void name();                                                        \
+    static rive_tests::RegisterTest name##_registration(#name, name);          \
+    static void name()
+
+#define CHECK(condition)                                                       \
+    do                                                                         \
+    {                                                                          \
+        if (!(condition))                                                      \
+        {                                                                      \
+            fprintf(stderr,                                                    \
+                    "%s:%d: CHECK(%s) failed\n",                               \
+                    __FILE__,                                                  \
+                    __LINE__,                                                  \
+                    #condition);                                               \
+            ++rive_tests::checkFailures;                                       \
+        }                                                                      \
+    } while (0)
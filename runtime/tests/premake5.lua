@@ -0,0 +1,36 @@
+-- Builds the runtime's C++ tests. The runtime is compiled with TESTING, which
+-- also needs text support, e.g.:
+--
+--   premake5 --file=tests/premake5.lua --with_rive_text --with_rive_layout gmake2
+--
+-- Run the tests from the repository root so they can find test/assets.
+defines({ 'TESTING' })
+
+dofile(path.join(path.getabsolute('..'), 'premake5_v2.lua'))
+
+project('command_queue_tests')
+do
+    dependson('rive')
+
+    kind('ConsoleApp')
+    cppdialect('C++11')
+    includedirs({ '../include' })
+    defines({ 'YOGA_EXPORT=', '_RIVE_INTERNAL_' })
+
+    fatalwarnings({ 'All' })
+
+    files({ 'command_queue_tests/**.cpp', '../utils/no_op_factory.cpp' })
+
+    links({ 'rive', 'rive_harfbuzz', 'rive_sheenbidi', 'rive_yoga' })
+
+    filter('system:windows')
+    do
+        architecture('x64')
+        defines({ '_USE_MATH_DEFINES' })
+    end
+
+    filter('system:linux')
+    do
+        links({ 'pthread' })
+    end
+end